@@ -0,0 +1,108 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Bench {
+using Clock = std::chrono::steady_clock;
+
+/// Runs func 'iterations' times and returns average nanoseconds per call.
+template <class Func> double Measure(uint64_t iterations, Func&& func)
+{
+    auto start = Clock::now();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        func(i);
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+inline double SecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+inline void Report(const char* name, double value, const char* unit)
+{
+    printf("%-48s %14.3f %s\n", name, value, unit);
+}
+
+/// Asks the kernel to drop the file from the page cache so reads hit the disk, best effort.
+inline void EvictFromCache(const std::filesystem::path& file)
+{
+#ifndef _WIN32
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#endif
+}
+
+/// Results kept for regression tracking, printed like Report and written as one json document:
+/// { "benchmark": "...", "results": [ { "name": "...", "value": 1.0, "unit": "..." }, ... ] }
+class JsonResults
+{
+public:
+    explicit JsonResults(std::string benchmark)
+        : m_benchmark(std::move(benchmark))
+    {
+    }
+
+    void Add(const std::string& name, double value, const char* unit)
+    {
+        Report(name.c_str(), value, unit);
+        m_results.push_back({ name, value, unit });
+    }
+
+    bool Write(const char* path) const
+    {
+        FILE* file = fopen(path, "w");
+        if (!file)
+            return false;
+
+        fprintf(file, "{\n  \"benchmark\": \"%s\",\n  \"results\": [", Escape(m_benchmark).c_str());
+        for (size_t i = 0; i < m_results.size(); i++) {
+            fprintf(file, "%s\n    { \"name\": \"%s\", \"value\": %.6g, \"unit\": \"%s\" }", i ? "," : "",
+                    Escape(m_results[i].Name).c_str(), m_results[i].Value, Escape(m_results[i].Unit).c_str());
+        }
+        fprintf(file, "\n  ]\n}\n");
+        return fclose(file) == 0;
+    }
+
+private:
+    struct Result
+    {
+        std::string Name;
+        double Value;
+        std::string Unit;
+    };
+
+    static std::string Escape(const std::string& text)
+    {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    std::string m_benchmark;
+    std::vector<Result> m_results;
+};
+}
+
+#endif
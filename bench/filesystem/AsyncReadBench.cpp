@@ -0,0 +1,121 @@
+#include "Common.h"
+#include "filesystem/AsyncFileReader.h"
+#include "filesystem/IFileSystem.h"
+#include <filesystem>
+
+namespace {
+const uint32_t SmallFileCount = 4000;
+const size_t SmallFileSize    = 4096;
+const uint32_t LargeFileCount = 4;
+const size_t LargeFileSize    = 64u << 20;
+const size_t LargeChunkSize   = 1u << 20;
+
+struct FileSet
+{
+    core::Vector<io::Path> SmallFiles;
+    core::Vector<io::Path> LargeFiles;
+};
+
+FileSet WriteFiles(io::IFileSystem* fs)
+{
+    FileSet files;
+    core::TByteArray contents(LargeFileSize);
+    for (size_t i = 0; i < contents.size(); i++) {
+        contents[i] = (uint8_t)(i * 31);
+    }
+
+    fs->CreateDirectory(io::Path(core::String("small")));
+    for (uint32_t i = 0; i < SmallFileCount; i++) {
+        files.SmallFiles.push_back(core::string::format("small/file{}.bin", i));
+        fs->OpenWrite(files.SmallFiles.back())->Write(contents, SmallFileSize);
+    }
+
+    for (uint32_t i = 0; i < LargeFileCount; i++) {
+        files.LargeFiles.push_back(core::string::format("large{}.bin", i));
+        fs->OpenWrite(files.LargeFiles.back())->Write(contents);
+    }
+    return files;
+}
+
+/// Seconds for reading every small file whole.
+double ReadSmall(io::AsyncFileReader& reader, const FileSet& files, core::TByteArray& destination)
+{
+    auto start = Bench::Clock::now();
+    for (uint32_t i = 0; i < files.SmallFiles.size(); i++) {
+        io::AsyncReadRequest request;
+        request.File        = files.SmallFiles[i];
+        request.Length      = SmallFileSize;
+        request.Destination = destination.data() + i * SmallFileSize;
+        request.OnComplete  = [](std::intmax_t bytesRead) {
+            if (bytesRead != SmallFileSize)
+                printf("short read\n");
+        };
+        reader.Submit(core::Move(request));
+    }
+    reader.WaitAll();
+    return Bench::SecondsSince(start);
+}
+
+/// Seconds for reading every large file in 1 MiB chunks.
+double ReadLarge(io::AsyncFileReader& reader, const FileSet& files, core::TByteArray& destination)
+{
+    auto start = Bench::Clock::now();
+    for (uint32_t i = 0; i < files.LargeFiles.size(); i++) {
+        for (size_t offset = 0; offset < LargeFileSize; offset += LargeChunkSize) {
+            io::AsyncReadRequest request;
+            request.File        = files.LargeFiles[i];
+            request.Offset      = offset;
+            request.Length      = LargeChunkSize;
+            request.Destination = destination.data() + offset;
+            request.OnComplete  = [](std::intmax_t bytesRead) {
+                if (bytesRead != LargeChunkSize)
+                    printf("short read\n");
+            };
+            reader.Submit(core::Move(request));
+        }
+    }
+    reader.WaitAll();
+    return Bench::SecondsSince(start);
+}
+
+void Run(io::IFileSystem* fs, const FileSet& files, uint32_t queueDepth, bool allowIoUring)
+{
+    io::AsyncFileReader reader(fs, queueDepth, allowIoUring);
+    if (allowIoUring && reader.GetBackend() != io::AsyncReadBackend::IoUring)
+        return;
+
+    core::TByteArray destination(std::max(SmallFileCount * SmallFileSize, LargeFileSize));
+    auto name = core::string::format("{} qd{}", allowIoUring ? "io_uring" : "threads", queueDepth);
+
+    // the page cache is warm after the first pass, this measures submission and completion overhead
+    ReadSmall(reader, files, destination);
+    auto smallSeconds = ReadSmall(reader, files, destination);
+    auto largeSeconds = ReadLarge(reader, files, destination);
+
+    Bench::Report((name + " small files").c_str(), SmallFileCount / smallSeconds, "files/s");
+    Bench::Report((name + " large files").c_str(),
+                  LargeFileCount * (LargeFileSize / 1048576.0) / largeSeconds, "MiB/s");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto directory = std::filesystem::temp_directory_path() / "async_read_bench";
+    std::filesystem::create_directories(directory);
+
+    auto fs = io::CreateFileSystem(io::Path(core::String(argv[0])));
+    fs->AddSearchDirectory(directory.string());
+    fs->SetWriteDirectory(directory.string());
+
+    auto files = WriteFiles(fs.get());
+
+    for (bool allowIoUring : { true, false }) {
+        for (uint32_t queueDepth : { 1u, 8u, 64u }) {
+            Run(fs.get(), files, queueDepth, allowIoUring);
+        }
+    }
+
+    fs.reset();
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "Common.h"
+#include "filesystem/BlockCompression.h"
+#include "filesystem/IFileSystem.h"
+#include <filesystem>
+#include <random>
+
+namespace {
+const size_t FileSize      = 64u << 20;
+const size_t ChunkSize     = 1u << 20;
+const uint32_t RandomReads = 20000;
+const size_t RandomSize    = 4096;
+
+/// Half mesh like vertex data with quantized positions, half json like text.
+core::TByteArray MakeAssetData()
+{
+    core::TByteArray data;
+    data.reserve(FileSize);
+    std::mt19937 random(5);
+
+    while (data.size() < FileSize / 2) {
+        float vertex[8] = { (random() % 1024) / 64.0f, (random() % 1024) / 64.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+                            (random() % 256) / 255.0f, (random() % 256) / 255.0f };
+        data.insert(data.end(), (uint8_t*)vertex, (uint8_t*)(vertex + 8));
+    }
+
+    while (data.size() < FileSize) {
+        auto line = core::string::format("{{\"name\":\"node{}\",\"mesh\":{},\"children\":[{},{}]}},\n",
+                                         random() % 5000, random() % 300, random() % 5000,
+                                         random() % 5000);
+        data.insert(data.end(), line.begin(), line.end());
+    }
+
+    data.resize(FileSize);
+    return data;
+}
+
+void Run(io::IFileSystem* fs, const std::filesystem::path& native, const io::Path& path,
+         const char* name)
+{
+    core::TByteArray buffer(ChunkSize);
+
+    Bench::EvictFromCache(native);
+    auto start = Bench::Clock::now();
+    auto file  = fs->OpenRead(path);
+    while (file->Read(buffer.data(), ChunkSize) > 0) {
+    }
+    Bench::Report((core::String(name) + " sequential, cold").c_str(),
+                  FileSize / 1048576.0 / Bench::SecondsSince(start), "MiB/s");
+
+    start = Bench::Clock::now();
+    file  = fs->OpenRead(path);
+    while (file->Read(buffer.data(), ChunkSize) > 0) {
+    }
+    Bench::Report((core::String(name) + " sequential, cached").c_str(),
+                  FileSize / 1048576.0 / Bench::SecondsSince(start), "MiB/s");
+
+    std::mt19937 random(9);
+    auto ns = Bench::Measure(RandomReads, [&](uint64_t) {
+        file->Seek(random() % (FileSize - RandomSize));
+        file->Read(buffer.data(), RandomSize);
+    });
+    Bench::Report((core::String(name) + " random 4 KiB").c_str(), ns, "ns/read");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto directory = std::filesystem::temp_directory_path() / "block_compression_bench";
+    std::filesystem::create_directories(directory);
+
+    auto fs = io::CreateFileSystem(io::Path(core::String(argv[0])));
+    fs->AddSearchDirectory(directory.string());
+    fs->SetWriteDirectory(directory.string());
+
+    auto data = MakeAssetData();
+    fs->OpenWrite(core::String("raw.bin"))->Write(data);
+
+    core::TByteArray compressed;
+    auto start = Bench::Clock::now();
+    io::compression::CompressFile(data.data(), data.size(), compressed);
+    Bench::Report("compress", FileSize / 1048576.0 / Bench::SecondsSince(start), "MiB/s");
+    fs->OpenWrite(core::String("compressed.bin"))->Write(compressed);
+
+    Bench::Report("raw size", data.size() / 1048576.0, "MiB");
+    Bench::Report("compressed size", compressed.size() / 1048576.0, "MiB");
+    Bench::Report("size reduction", 100.0 * (1.0 - (double)compressed.size() / data.size()), "%");
+
+    Run(fs.get(), directory / "raw.bin", core::String("raw.bin"), "raw");
+    Run(fs.get(), directory / "compressed.bin", core::String("compressed.bin"), "compressed");
+
+    fs.reset();
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "Common.h"
+#include "filesystem/BufferedFileWriter.h"
+#include "filesystem/IFileSystem.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+const uint32_t WriteCount = 1000000;
+
+/// Latency the calling thread sees per write, like a logger on the render thread would.
+void Run(const char* name, io::IFileWriter* writer, const core::Vector<core::String>& lines)
+{
+    core::Vector<float> latencies(WriteCount);
+
+    auto start = Bench::Clock::now();
+    for (uint32_t i = 0; i < WriteCount; i++) {
+        auto writeStart = Bench::Clock::now();
+        writer->Write(lines[i % lines.size()]);
+        latencies[i] = std::chrono::duration<float, std::nano>(Bench::Clock::now() - writeStart).count();
+    }
+    auto writeSeconds = Bench::SecondsSince(start);
+
+    auto flushStart = Bench::Clock::now();
+    writer->Flush();
+    auto flushSeconds = Bench::SecondsSince(flushStart);
+
+    std::sort(latencies.begin(), latencies.end());
+
+    auto label = [&](const char* what) {
+        static core::String text;
+        text = core::string::format("{}, {}", name, what);
+        return text.c_str();
+    };
+    Bench::Report(label("mean"), writeSeconds * 1e9 / WriteCount, "ns/write");
+    Bench::Report(label("p99"), latencies[uint64_t(WriteCount) * 99 / 100], "ns/write");
+    Bench::Report(label("p99.99"), latencies[uint64_t(WriteCount) * 9999 / 10000], "ns/write");
+    Bench::Report(label("max"), latencies.back() / 1000, "us/write");
+    Bench::Report(label("final flush"), flushSeconds * 1000, "ms");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto directory = std::filesystem::temp_directory_path() / "buffered_write_bench";
+    std::filesystem::create_directories(directory);
+
+    auto fs = io::CreateFileSystem(io::Path(core::String(argv[0])));
+    fs->SetWriteDirectory(directory.string());
+
+    core::Vector<core::String> lines;
+    for (uint32_t i = 0; i < 64; i++) {
+        lines.push_back(core::string::format("[{:08}] frame {} took {} us\n", i * 7919, i, i * 31 % 977));
+    }
+
+    Run("unbuffered", fs->OpenWrite(core::String("unbuffered.log")).get(), lines);
+
+    for (size_t bufferSize : { 4 * 1024, 64 * 1024, 1024 * 1024 }) {
+        io::BufferedFileWriter writer(fs->OpenWrite(core::string::format("buffered{}.log", bufferSize)),
+                                      bufferSize);
+        auto name = core::string::format("buffered {} KiB", bufferSize / 1024);
+        Run(name.c_str(), &writer, lines);
+    }
+
+    fs.reset();
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "Common.h"
+#include "filesystem/IFileSystem.h"
+#include <filesystem>
+
+namespace {
+/// Sums every 64th byte so both paths touch each page of the contents like a parser would.
+uint64_t Touch(const uint8_t* data, size_t size)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i += 64) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+void RunFile(io::IFileSystem* fs, const io::Path& path, size_t size)
+{
+    const uint32_t iterations = 10;
+    uint64_t checksum = 0;
+
+    auto readNs = Bench::Measure(iterations, [&](uint64_t) {
+        core::TByteArray contents;
+        fs->OpenRead(path)->Read(contents);
+        checksum += Touch(contents.data(), contents.size());
+    });
+
+    auto mapNs = Bench::Measure(iterations, [&](uint64_t) {
+        auto mapping = fs->MapFile(path);
+        checksum += Touch(mapping->GetData(), mapping->GetSize());
+    });
+
+    auto mib = size / 1048576.0;
+    Bench::Report(core::string::format("{} MiB read", mib).c_str(), mib / (readNs / 1e9), "MiB/s");
+    Bench::Report(core::string::format("{} MiB map", mib).c_str(), mib / (mapNs / 1e9), "MiB/s");
+    Bench::Report(core::string::format("{} MiB speedup", mib).c_str(), readNs / mapNs, "x");
+
+    // keeps the touch loops from being optimized out
+    if (checksum == 1)
+        printf("\n");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto directory = std::filesystem::temp_directory_path() / "file_mapping_bench";
+    std::filesystem::create_directories(directory);
+
+    auto fs = io::CreateFileSystem(io::Path(core::String(argv[0])));
+    fs->AddSearchDirectory(directory.string());
+    fs->SetWriteDirectory(directory.string());
+
+    for (size_t size : { 1u << 20, 16u << 20, 64u << 20, 256u << 20 }) {
+        auto path = core::string::format("file{}.bin", size);
+        {
+            core::TByteArray contents(size);
+            for (size_t i = 0; i < size; i++) {
+                contents[i] = (uint8_t)(i * 31);
+            }
+            fs->OpenWrite(path)->Write(contents);
+        }
+
+        RunFile(fs.get(), path, size);
+    }
+
+    fs.reset();
+    std::filesystem::remove_all(directory);
+    return 0;
+}
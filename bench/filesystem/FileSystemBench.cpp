@@ -0,0 +1,151 @@
+#include "Common.h"
+#include "filesystem/IFileSystem.h"
+#include <algorithm>
+#include <filesystem>
+#include <random>
+
+/// Regression suite for IFileSystem, file sets are generated in a temporary directory.
+/// Usage: FileSystemBench [results.json]
+namespace {
+struct FileSet
+{
+    const char* Name;
+    uint32_t Directories;
+    uint32_t FilesPerDirectory;
+    size_t FileSize;
+};
+
+const FileSet FileSets[] = {
+    { "small", 20, 100, 4u << 10 },
+    { "medium", 4, 50, 256u << 10 },
+    { "large", 1, 4, 32u << 20 },
+};
+
+const size_t ChunkSize     = 1u << 20;
+const size_t RandomSize    = 4096;
+const uint32_t RandomReads = 20000;
+
+double Percentile(core::Vector<double>& samples, double percentile)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min<size_t>(samples.size() - 1, (size_t)(samples.size() * percentile))];
+}
+
+void Run(io::IFileSystem* fs, const FileSet& set, Bench::JsonResults& results)
+{
+    auto name = [&](const char* metric) { return core::String(set.Name) + " " + metric; };
+
+    core::Vector<core::String> directories;
+    core::Vector<io::Path> files;
+    for (uint32_t d = 0; d < set.Directories; d++) {
+        directories.push_back(core::string::format("{}/dir{}", set.Name, d));
+        for (uint32_t f = 0; f < set.FilesPerDirectory; f++) {
+            files.push_back(core::String(core::string::format("{}/file{}.bin", directories.back(), f)));
+        }
+    }
+
+    core::TByteArray contents(set.FileSize);
+    for (size_t i = 0; i < contents.size(); i++) {
+        contents[i] = (uint8_t)(i * 131);
+    }
+
+    fs->CreateDirectory(core::String(set.Name));
+    for (auto& directory : directories) {
+        fs->CreateDirectory(directory);
+    }
+
+    auto start = Bench::Clock::now();
+    for (auto& file : files) {
+        fs->OpenWrite(file)->Write(contents);
+    }
+    auto totalMiB = files.size() * set.FileSize / 1048576.0;
+    results.Add(name("write"), totalMiB / Bench::SecondsSince(start), "MiB/s");
+
+    core::Vector<double> openSamples;
+    for (auto& file : files) {
+        auto openStart = Bench::Clock::now();
+        auto reader    = fs->OpenRead(file);
+        openSamples.push_back(Bench::SecondsSince(openStart) * 1e9);
+    }
+    double openMean = 0;
+    for (auto sample : openSamples) {
+        openMean += sample / openSamples.size();
+    }
+    results.Add(name("OpenRead mean"), openMean, "ns");
+    results.Add(name("OpenRead p99"), Percentile(openSamples, 0.99), "ns");
+
+    core::TByteArray buffer(ChunkSize);
+    start = Bench::Clock::now();
+    for (auto& file : files) {
+        auto reader = fs->OpenRead(file);
+        while (reader->Read(buffer.data(), ChunkSize) > 0) {
+        }
+    }
+    results.Add(name("sequential read"), totalMiB / Bench::SecondsSince(start), "MiB/s");
+
+    // readers are opened up front so only the reads are measured
+    core::Vector<core::UniquePtr<io::IFileReader>> readers;
+    auto readerCount = std::min<size_t>(files.size(), 256);
+    for (size_t i = 0; i < readerCount; i++) {
+        readers.push_back(fs->OpenRead(files[i * files.size() / readerCount]));
+    }
+    std::mt19937 random(7);
+    auto readSize = std::min(RandomSize, set.FileSize);
+    auto readNs   = Bench::Measure(RandomReads, [&](uint64_t) {
+        auto& reader = readers[random() % readers.size()];
+        reader->Seek(random() % (set.FileSize - readSize + 1) / readSize * readSize);
+        reader->Read(buffer.data(), readSize);
+    });
+    results.Add(name("random read"), readSize / 1048576.0 / (readNs / 1e9), "MiB/s");
+    readers.clear();
+
+    auto existsNs = Bench::Measure(files.size() * 10, [&](uint64_t i) {
+        fs->FileExists(files[i % files.size()]);
+    });
+    results.Add(name("FileExists hit"), 1e9 / existsNs, "calls/s");
+
+    core::Vector<io::Path> missing;
+    for (auto& file : files) {
+        missing.push_back(core::String(file.AsString() + ".missing"));
+    }
+    auto missingNs = Bench::Measure(missing.size() * 10, [&](uint64_t i) {
+        fs->FileExists(missing[i % missing.size()]);
+    });
+    results.Add(name("FileExists miss"), 1e9 / missingNs, "calls/s");
+
+    size_t listed = 0;
+    start         = Bench::Clock::now();
+    for (uint32_t i = 0; i < 10; i++) {
+        for (auto& directory : directories) {
+            listed += fs->GetFilesInDirectory(directory).size();
+        }
+    }
+    results.Add(name("GetFilesInDirectory"), listed / Bench::SecondsSince(start), "files/s");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto output    = argc > 1 ? argv[1] : "FileSystemBench.json";
+    auto directory = std::filesystem::temp_directory_path() / "file_system_bench";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    auto fs = io::CreateFileSystem(io::Path(core::String(argv[0])));
+    fs->AddSearchDirectory(directory.string());
+    fs->SetWriteDirectory(directory.string());
+
+    Bench::JsonResults results("FileSystemBench");
+    for (auto& set : FileSets) {
+        Run(fs.get(), set, results);
+    }
+
+    fs.reset();
+    std::filesystem::remove_all(directory);
+
+    if (!results.Write(output)) {
+        printf("Could not write results to '%s'\n", output);
+        return 1;
+    }
+    return 0;
+}
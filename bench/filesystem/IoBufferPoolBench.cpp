@@ -0,0 +1,144 @@
+#include "Common.h"
+#include "filesystem/IFileSystem.h"
+#include "filesystem/IoBufferPool.h"
+#include <atomic>
+#include <filesystem>
+#include <new>
+#include <random>
+
+namespace {
+const uint32_t FileCount = 4000;
+const uint32_t Loads     = 5;
+
+std::atomic<uint64_t> g_allocations{ 0 };
+
+/// Stand in for parsing, touches every page so reads can not be optimized away.
+uint64_t Consume(const uint8_t* data, size_t size)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i += 4096) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+/// Mostly small files with a tail of large ones, like configs, materials, meshes and textures.
+size_t MakeFileSize(std::mt19937& random)
+{
+    auto kind = random() % 100;
+    if (kind < 70)
+        return 256 + random() % 8192;
+    if (kind < 95)
+        return 16384 + random() % 131072;
+    return 262144 + random() % 1048576;
+}
+
+template <class Load> void Run(io::IFileSystem* fs, const char* name, Load&& load)
+{
+    uint64_t checksum = load(fs);
+
+    auto allocations = g_allocations.load();
+    auto start       = Bench::Clock::now();
+    for (uint32_t i = 0; i < Loads; i++) {
+        checksum += load(fs);
+    }
+    auto seconds = Bench::SecondsSince(start);
+    allocations  = g_allocations.load() - allocations;
+
+    Bench::Report((core::String(name) + " level load").c_str(), seconds * 1000.0 / Loads, "ms");
+    Bench::Report((core::String(name) + " allocations per file").c_str(),
+                  (double)allocations / (Loads * FileCount), "allocs");
+    if (checksum == 0)
+        printf("unexpected checksum\n");
+}
+} // namespace
+
+void* operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* data = std::malloc(size ? size : 1))
+        return data;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    auto align = static_cast<size_t>(alignment);
+    if (void* data = std::aligned_alloc(align, (size + align - 1) / align * align))
+        return data;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* data) noexcept
+{
+    std::free(data);
+}
+
+void operator delete(void* data, size_t) noexcept
+{
+    std::free(data);
+}
+
+void operator delete(void* data, std::align_val_t) noexcept
+{
+    std::free(data);
+}
+
+void operator delete(void* data, size_t, std::align_val_t) noexcept
+{
+    std::free(data);
+}
+
+int main(int argc, char** argv)
+{
+    auto directory = std::filesystem::temp_directory_path() / "io_buffer_pool_bench";
+    std::filesystem::create_directories(directory);
+
+    auto fs = io::CreateFileSystem(io::Path(core::String(argv[0])));
+    fs->AddSearchDirectory(directory.string());
+    fs->SetWriteDirectory(directory.string());
+
+    core::Vector<io::Path> paths;
+    std::mt19937 random(3);
+    size_t totalBytes = 0;
+
+    for (uint32_t i = 0; i < FileCount; i++) {
+        core::TByteArray contents(MakeFileSize(random), static_cast<uint8_t>(i));
+        paths.push_back(core::String(core::string::format("asset{}.bin", i)));
+        fs->OpenWrite(paths.back())->Write(contents);
+        totalBytes += contents.size();
+    }
+    Bench::Report("files", FileCount, "");
+    Bench::Report("total size", totalBytes / 1048576.0, "MiB");
+
+    Run(fs.get(), "byte array", [&](io::IFileSystem* fs) {
+        uint64_t checksum = 0;
+        for (auto& path : paths) {
+            core::TByteArray contents;
+            auto file = fs->OpenRead(path);
+            file->Read(contents);
+            checksum += Consume(contents.data(), contents.size());
+        }
+        return checksum;
+    });
+
+    Run(fs.get(), "pooled", [&](io::IFileSystem* fs) {
+        uint64_t checksum = 0;
+        for (auto& path : paths) {
+            io::IoBuffer contents;
+            auto file = fs->OpenRead(path);
+            file->Read(contents);
+            checksum += Consume(contents.GetData(), contents.GetSize());
+        }
+        return checksum;
+    });
+
+    auto stats = io::IoBufferPool::GetDefault()->GetStats();
+    Bench::Report("pool buffers allocated", stats.Allocations, "");
+    Bench::Report("pool retained", stats.RetainedBytes / 1048576.0, "MiB");
+
+    fs.reset();
+    std::filesystem::remove_all(directory);
+    return 0;
+}
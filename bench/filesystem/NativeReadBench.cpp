@@ -0,0 +1,95 @@
+#include "Common.h"
+#include "filesystem/IFileSystem.h"
+#include <cstdlib>
+#include <filesystem>
+
+namespace {
+const uint32_t SmallFiles = 2000;
+const size_t SmallSize    = 4096;
+const size_t LargeSize    = 256u << 20;
+const size_t ChunkSize    = 4u << 20;
+
+void Run(const char* argv0, const std::filesystem::path& directory, const io::FileSystemOptions& options,
+         const char* name)
+{
+    auto fs = io::CreateFileSystem(io::Path(core::String(argv0)), options);
+    fs->AddSearchDirectory(directory.string());
+
+    core::Vector<io::Path> paths;
+    for (uint32_t i = 0; i < SmallFiles; i++) {
+        paths.push_back(core::String(core::string::format("small{}.bin", i)));
+    }
+
+    // page aligned, so direct reads can use it
+    core::UniquePtr<uint8_t, void (*)(void*)> buffer((uint8_t*)std::aligned_alloc(4096, ChunkSize), std::free);
+    uint64_t checksum = 0;
+
+    auto openNs = Bench::Measure(SmallFiles, [&](uint64_t i) {
+        auto file = fs->OpenRead(paths[i]);
+        checksum += file->GetLength();
+    });
+    Bench::Report((core::String(name) + " open/close").c_str(), openNs, "ns");
+
+    auto readNs = Bench::Measure(SmallFiles, [&](uint64_t i) {
+        auto file = fs->OpenRead(paths[i]);
+        checksum += file->Read(buffer.get(), SmallSize);
+    });
+    Bench::Report((core::String(name) + " open/read 4 KiB/close").c_str(), readNs, "ns");
+
+    auto file        = fs->OpenRead(paths[0]);
+    auto smallReadNs = Bench::Measure(SmallFiles * 50, [&](uint64_t i) {
+        file->Seek(i % 16 * 256);
+        checksum += file->Read(buffer.get(), 256);
+    });
+    Bench::Report((core::String(name) + " read 256 B").c_str(), smallReadNs, "ns");
+
+    for (bool cold : { false, true }) {
+        if (cold)
+            Bench::EvictFromCache(directory / "large.bin");
+
+        auto start = Bench::Clock::now();
+        file       = fs->OpenRead(core::String("large.bin"));
+        while (file->Read(buffer.get(), ChunkSize) > 0) {
+        }
+        Bench::Report((core::String(name) + (cold ? " sequential, cold" : " sequential, cached")).c_str(),
+                      LargeSize / 1048576.0 / Bench::SecondsSince(start), "MiB/s");
+    }
+
+    if (checksum == 0)
+        printf("unexpected checksum\n");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto directory = std::filesystem::temp_directory_path() / "native_read_bench";
+    std::filesystem::create_directories(directory);
+    {
+        auto fs = io::CreateFileSystem(io::Path(core::String(argv[0])));
+        fs->SetWriteDirectory(directory.string());
+
+        core::TByteArray contents(SmallSize, 1);
+        for (uint32_t i = 0; i < SmallFiles; i++) {
+            fs->OpenWrite(core::String(core::string::format("small{}.bin", i)))->Write(contents);
+        }
+
+        contents.resize(LargeSize);
+        for (size_t i = 0; i < LargeSize; i++) {
+            contents[i] = (uint8_t)(i * 31);
+        }
+        fs->OpenWrite(core::String("large.bin"))->Write(contents);
+    }
+
+    io::FileSystemOptions physfs;
+    physfs.NativeReads = false;
+    io::FileSystemOptions native;
+    io::FileSystemOptions direct;
+    direct.DirectReadThreshold = 1u << 20;
+
+    Run(argv[0], directory, physfs, "physfs");
+    Run(argv[0], directory, native, "native");
+    Run(argv[0], directory, direct, "native O_DIRECT");
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "Common.h"
+#include "filesystem/PathId.h"
+
+namespace {
+const uint32_t PathCount = 4096;
+const uint32_t OpCount   = 1000000;
+
+/// What constructing a Path cost before, Normalize copying even normalized input.
+io::Path OldPath(const core::String& path)
+{
+    io::Path result;
+    result = io::Path(io::path::Normalize(path));
+    return result;
+}
+
+template <class Func> void Run(const char* name, Func&& func)
+{
+    size_t sink = 0;
+    auto ns     = Bench::Measure(OpCount, [&](uint64_t i) { sink += func(i); });
+
+    Bench::Report(name, ns, "ns/op");
+
+    // keeps the work from being optimized out
+    if (sink == 1)
+        printf("\n");
+}
+} // namespace
+
+int main()
+{
+    core::Vector<core::String> strings;
+    core::Vector<io::Path> paths;
+    core::Vector<io::PathId> ids;
+    core::UnorderedMap<core::String, uint32_t> stringMap;
+    core::UnorderedMap<io::PathId, uint32_t> idMap;
+
+    for (uint32_t i = 0; i < PathCount; i++) {
+        strings.push_back(core::string::format("resources/textures/set{}/material{}_albedo.png",
+                                               i % 32, i));
+        paths.emplace_back(strings.back());
+        ids.emplace_back(paths.back());
+        stringMap.emplace(strings.back(), i);
+        idMap.emplace(ids.back(), i);
+    }
+
+    Run("construct, normalize copy", [&](uint64_t i) {
+        return OldPath(strings[i % PathCount]).AsString().size();
+    });
+    Run("construct, normalize in place", [&](uint64_t i) {
+        return io::Path(strings[i % PathCount]).AsString().size();
+    });
+
+    Run("file name, Path", [&](uint64_t i) {
+        return paths[i % PathCount].GetFileName().AsString().size();
+    });
+    Run("file name, view", [&](uint64_t i) {
+        return paths[i % PathCount].GetFileNameView().size();
+    });
+    Run("extension, Path", [&](uint64_t i) {
+        return paths[i % PathCount].GetExtension().AsString().size();
+    });
+    Run("extension, view", [&](uint64_t i) {
+        return paths[i % PathCount].GetExtensionView().size();
+    });
+
+    Run("map lookup, string key", [&](uint64_t i) {
+        return stringMap.find(paths[i % PathCount].AsString())->second;
+    });
+    Run("map lookup, PathId key", [&](uint64_t i) { return idMap.find(ids[i % PathCount])->second; });
+    Run("map lookup, intern then PathId key", [&](uint64_t i) {
+        return idMap.find(io::PathId(paths[i % PathCount]))->second;
+    });
+    Run("id compare, string", [&](uint64_t i) {
+        return paths[i % PathCount] == paths[(i + 1) % PathCount];
+    });
+    Run("id compare, PathId", [&](uint64_t i) { return ids[i % PathCount] == ids[(i + 1) % PathCount]; });
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "Common.h"
+#include "filesystem/IFileSystem.h"
+#include "physfs/src/physfs.h"
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+namespace {
+const uint32_t MountCount    = 4;
+const uint32_t FilesPerMount = 2000;
+const uint32_t CheckCount    = 100000;
+
+/// What FileExists did before the index, a physfs stat walking every mount.
+bool PhysfsFileExists(const io::Path& path)
+{
+    PHYSFS_Stat stat;
+    return PHYSFS_stat(path.AsString().c_str(), &stat) && stat.filetype == PHYSFS_FILETYPE_REGULAR;
+}
+
+void Run(const char* name, const core::Vector<io::Path>& paths,
+         const std::function<bool(const io::Path&)>& exists)
+{
+    uint32_t found = 0;
+    auto ns        = Bench::Measure(CheckCount, [&](uint64_t i) {
+        found += exists(paths[i % paths.size()]);
+    });
+
+    Bench::Report(name, ns, "ns/check");
+
+    // keeps the checks from being optimized out
+    if (found == 1)
+        printf("\n");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto directory = std::filesystem::temp_directory_path() / "path_index_bench";
+    core::Vector<io::Path> hits, misses;
+
+    for (uint32_t mount = 0; mount < MountCount; mount++) {
+        for (uint32_t i = 0; i < FilesPerMount; i++) {
+            auto relative = core::string::format("shaders{}/program{}.vert", i % 16, i);
+            auto native   = directory / core::string::format("mount{}", mount) / relative;
+            std::filesystem::create_directories(native.parent_path());
+            std::ofstream(native.string()) << i;
+
+            hits.push_back(relative);
+            misses.push_back(core::string::format("shaders{}/program{}.geom", i % 16, i));
+        }
+    }
+
+    auto fs = io::CreateFileSystem(io::Path(core::String(argv[0])));
+
+    auto start = Bench::Clock::now();
+    for (uint32_t mount = 0; mount < MountCount; mount++) {
+        fs->AddSearchDirectory((directory / core::string::format("mount{}", mount)).string());
+    }
+    Bench::Report("index build", Bench::SecondsSince(start) * 1000, "ms");
+
+    // optional shader stages are the typical miss, they stat every mount
+    Run("physfs stat, existing", hits, PhysfsFileExists);
+    Run("index, existing", hits, [&](const io::Path& path) { return fs->FileExists(path); });
+    Run("physfs stat, missing", misses, PhysfsFileExists);
+    Run("index, missing", misses, [&](const io::Path& path) { return fs->FileExists(path); });
+
+    auto openNs = Bench::Measure(CheckCount / 10, [&](uint64_t i) {
+        fs->OpenRead(hits[i % hits.size()]);
+    });
+    Bench::Report("open through index", openNs, "ns/open");
+
+    fs.reset();
+    std::filesystem::remove_all(directory);
+    return 0;
+}
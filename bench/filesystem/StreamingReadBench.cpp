@@ -0,0 +1,91 @@
+#include "Common.h"
+#include "filesystem/IFileSystem.h"
+#include "filesystem/StreamingFileReader.h"
+#include <filesystem>
+
+namespace {
+const size_t FileSize  = 256u << 20;
+const size_t ReadSize  = 256u << 10;
+const size_t ChunkSize = 1u << 20;
+
+/// Stand-in for decoding what was read, roughly a fast decompressor's cost per byte.
+uint64_t Consume(const uint8_t* data, size_t size)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        sum = (sum ^ word) * 0x100000001b3ull;
+    }
+    return sum;
+}
+
+void Run(const char* name, io::IFileReader* reader, bool consume)
+{
+    core::TByteArray buffer(ReadSize);
+    uint64_t sum   = 0;
+    auto start     = Bench::Clock::now();
+    double stalled = 0.0;
+
+    while (true) {
+        auto readStart = Bench::Clock::now();
+        auto bytesRead = reader->Read(buffer.data(), ReadSize);
+        stalled += Bench::SecondsSince(readStart);
+
+        if (bytesRead <= 0)
+            break;
+        if (consume)
+            sum += Consume(buffer.data(), bytesRead);
+    }
+
+    auto seconds = Bench::SecondsSince(start);
+    auto label   = core::string::format("{}{}", name, consume ? ", with decode" : "");
+
+    Bench::Report((label + " throughput").c_str(), FileSize / 1048576.0 / seconds, "MiB/s");
+    Bench::Report((label + " time in Read").c_str(), stalled * 1000, "ms");
+
+    // keeps the decode from being optimized out
+    if (sum == 1)
+        printf("\n");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto directory = std::filesystem::temp_directory_path() / "streaming_read_bench";
+    std::filesystem::create_directories(directory);
+
+    auto fs = io::CreateFileSystem(io::Path(core::String(argv[0])));
+    fs->AddSearchDirectory(directory.string());
+    fs->SetWriteDirectory(directory.string());
+
+    io::Path file(core::String("stream.bin"));
+    {
+        core::TByteArray contents(FileSize);
+        for (size_t i = 0; i < contents.size(); i++) {
+            contents[i] = (uint8_t)(i * 31 + i / 4093);
+        }
+        fs->OpenWrite(file)->Write(contents);
+    }
+
+    for (bool consume : { false, true }) {
+        Bench::EvictFromCache(directory / "stream.bin");
+        Run("direct", fs->OpenRead(file).get(), consume);
+
+        for (uint32_t chunkCount : { 2u, 3u }) {
+            Bench::EvictFromCache(directory / "stream.bin");
+            io::StreamingFileReader reader(fs->OpenRead(file), ChunkSize, chunkCount);
+            auto name = core::string::format("read-ahead x{}", chunkCount);
+            Run(name.c_str(), &reader, consume);
+
+            auto stats = reader.GetStats();
+            Bench::Report((name + " stalls").c_str(), stats.Stalls, "");
+            Bench::Report((name + " stall time").c_str(), stats.StallSeconds * 1000, "ms");
+            Bench::Report((name + " prefetched").c_str(), stats.BytesPrefetched / 1048576.0, "MiB");
+        }
+    }
+
+    fs.reset();
+    std::filesystem::remove_all(directory);
+    return 0;
+}
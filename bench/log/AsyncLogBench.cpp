@@ -0,0 +1,109 @@
+#include "Common.h"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+namespace {
+const uint32_t ProducerCount       = 4;
+const uint32_t MessagesPerProducer = 100000;
+
+/// File log like a game would keep, flushed by the logger after every record or batch.
+class FileLogStream : public elog::ILogStream
+{
+  public:
+    FileLogStream()
+        : m_file(std::tmpfile())
+    {
+    }
+
+    ~FileLogStream() override
+    {
+        std::fclose(m_file);
+    }
+
+    void Log(const elog::LogSource source, const elog::LogSeverity severity,
+             const core::String& logString) override
+    {
+        std::fprintf(m_file, "[%d] %s\n", (int)severity, logString.c_str());
+    }
+
+    void Flush() override
+    {
+        std::fflush(m_file);
+    }
+
+  private:
+    FILE* m_file;
+};
+
+/// Latency the producing threads see per Log call, messages are built before the clock starts.
+void Run(const char* name)
+{
+    core::Vector<core::Vector<float>> latencies(ProducerCount, core::Vector<float>(MessagesPerProducer));
+    core::Vector<std::thread> producers;
+
+    auto start = Bench::Clock::now();
+    for (uint32_t p = 0; p < ProducerCount; p++) {
+        producers.emplace_back([p, &latencies]() {
+            for (uint32_t i = 0; i < MessagesPerProducer; i++) {
+                auto message  = core::string::format("worker {} imported node {} with {} vertices", p, i, i * 37 % 4096);
+                auto logStart = Bench::Clock::now();
+                elog::Log(elog::LogSource::Engine, elog::LogSeverity::Info, core::Move(message));
+                latencies[p][i] = std::chrono::duration<float, std::nano>(Bench::Clock::now() - logStart).count();
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    auto produceSeconds = Bench::SecondsSince(start);
+    elog::FlushLog();
+    auto totalSeconds = Bench::SecondsSince(start);
+
+    core::Vector<float> all;
+    for (auto& producerLatencies : latencies) {
+        all.insert(all.end(), producerLatencies.begin(), producerLatencies.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    double mean = 0;
+    for (auto latency : all) {
+        mean += latency / all.size();
+    }
+
+    auto label = [&](const char* what) {
+        static core::String text;
+        text = core::string::format("{}, {}", name, what);
+        return text.c_str();
+    };
+    Bench::Report(label("mean"), mean, "ns/log");
+    Bench::Report(label("p99"), all[uint64_t(all.size()) * 99 / 100], "ns/log");
+    Bench::Report(label("p99.9"), all[uint64_t(all.size()) * 999 / 1000], "ns/log");
+    Bench::Report(label("max"), all.back() / 1000, "us/log");
+    Bench::Report(label("producers done"), produceSeconds * 1000, "ms");
+    Bench::Report(label("all written"), totalSeconds * 1000, "ms");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto stream = core::MakeShared<FileLogStream>();
+    elog::AddLogStream(stream);
+
+    Run("synchronous");
+
+    elog::AsyncLogOptions options;
+    elog::StartAsyncLogging(options);
+    Run("async, block");
+    elog::StopAsyncLogging();
+
+    options.Overflow = elog::LogOverflowPolicy::DropAndCount;
+    elog::StartAsyncLogging(options);
+    auto dropped = elog::GetDroppedLogCount();
+    Run("async, drop with counter");
+    Bench::Report("async, drop with counter, dropped", elog::GetDroppedLogCount() - dropped, "records");
+    elog::StopAsyncLogging();
+
+    elog::ClearStreams();
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "Common.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+const uint64_t Records = 300000;
+
+/// Mix of the messages asset imports log in bulk.
+void LogRecord(uint64_t i)
+{
+    switch (i % 3) {
+    case 0:
+        ELOG_INFO("Bone {} position key count: {}", "spine_03", i & 1023);
+        break;
+    case 1:
+        ELOG_INFO("Bone [{}:{}] = parent: {}, head: {}, tail: {}", i & 63, "forearm.L", int(i & 63) - 1,
+                  glm::vec3(0.1f, i * 0.01f, 1.0f), glm::vec3(0.2f, 0.4f, i * 0.5f));
+        break;
+    default:
+        ELOG_INFO("Image size: {}x{}, channels: {}", 512 << (i & 3), 512 << (i & 3), 4);
+        break;
+    }
+}
+
+void Report(const char* name, double seconds, uint64_t bytes)
+{
+    auto label = [&](const char* what) {
+        static std::string text;
+        text = std::string(name) + ", " + what;
+        return text.c_str();
+    };
+    Bench::Report(label("records"), Records / seconds, "records/s");
+    Bench::Report(label("size"), double(bytes) / Records, "bytes/record");
+}
+
+/// DefaultCoutLogPipe writing into a file instead of the terminal.
+void RunText(const char* name, const std::filesystem::path& path, bool async)
+{
+    std::ofstream textFile(path, std::ios::binary);
+    auto coutBuffer = std::cout.rdbuf(textFile.rdbuf());
+    auto stream     = core::MakeShared<elog::DefaultCoutLogPipe>();
+    elog::AddLogStream(stream);
+    if (async)
+        elog::StartAsyncLogging();
+
+    auto start = Bench::Clock::now();
+    for (uint64_t i = 0; i < Records; i++) {
+        LogRecord(i);
+    }
+    elog::FlushLog();
+    auto seconds = Bench::SecondsSince(start);
+
+    elog::StopAsyncLogging();
+    elog::ClearStreams();
+    std::cout.rdbuf(coutBuffer);
+    textFile.close();
+    Report(name, seconds, std::filesystem::file_size(path));
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto directory = std::filesystem::temp_directory_path();
+    auto textPath  = directory / "binary_log_bench.txt";
+    auto binPath   = directory / "binary_log_bench.elog";
+
+    RunText("text, DefaultCoutLogPipe", textPath, false);
+    RunText("text, DefaultCoutLogPipe async", textPath, true);
+
+    {
+        auto sink = elog::BinaryLogSink::Open(binPath.string());
+        elog::SetBinaryLogSink(sink);
+
+        auto start = Bench::Clock::now();
+        for (uint64_t i = 0; i < Records; i++) {
+            LogRecord(i);
+        }
+        sink->Flush();
+        auto seconds = Bench::SecondsSince(start);
+
+        elog::SetBinaryLogSink(nullptr);
+        Report("binary, BinaryLogSink", seconds, std::filesystem::file_size(binPath));
+    }
+
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(binPath);
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "Common.h"
+#include <cmath>
+
+// Built with ENGINE_LOG_MIN_LEVEL=1, see CMakeLists.txt, so debug statements are compiled out.
+
+namespace {
+const uint64_t Iterations = 2000000;
+
+/// Counts what reaches it, so the enabled case pays for dispatch but not for output.
+class CountingLogStream : public elog::ILogStream
+{
+  public:
+    void Log(const elog::LogSource source, const elog::LogSeverity severity,
+             const core::String& logString) override
+    {
+        Count++;
+    }
+
+    uint64_t Count = 0;
+};
+
+/// Stand in for a skinning or import loop body, the log statements are in the same spot.
+float Work(uint64_t i)
+{
+    return std::sqrt(float(i)) * 0.5f + float(i & 7);
+}
+
+volatile float Sink;
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto stream = core::MakeShared<CountingLogStream>();
+    elog::AddLogStream(stream);
+    elog::SetLogLevel(elog::LogSource::Engine, elog::LogSeverity::Warn);
+
+    float sum = 0;
+    auto none = Bench::Measure(Iterations, [&](uint64_t i) {
+        sum += Work(i);
+    });
+    Bench::Report("no log statement", none, "ns/iteration");
+
+    auto eager = Bench::Measure(Iterations, [&](uint64_t i) {
+        auto weight = Work(i);
+        elog::LogInfo(core::string::format("vertex {} weight {}", i, weight));
+        sum += weight;
+    });
+    Bench::Report("LogInfo(format(...)), filtered at runtime", eager, "ns/iteration");
+
+    auto filtered = Bench::Measure(Iterations, [&](uint64_t i) {
+        auto weight = Work(i);
+        ELOG_INFO("vertex {} weight {}", i, weight);
+        sum += weight;
+    });
+    Bench::Report("ELOG_INFO, filtered at runtime", filtered, "ns/iteration");
+
+    auto compiledOut = Bench::Measure(Iterations, [&](uint64_t i) {
+        auto weight = Work(i);
+        ELOG_DEBUG("vertex {} weight {}", i, weight);
+        sum += weight;
+    });
+    Bench::Report("ELOG_DEBUG, compiled out", compiledOut, "ns/iteration");
+
+    auto enabled = Bench::Measure(Iterations / 10, [&](uint64_t i) {
+        auto weight = Work(i);
+        ELOG_WARNING("vertex {} weight {}", i, weight);
+        sum += weight;
+    });
+    Bench::Report("ELOG_WARNING, enabled", enabled, "ns/iteration");
+
+    Sink = sum;
+    Bench::Report("records dispatched", stream->Count, "records");
+
+    elog::ClearStreams();
+    return 0;
+}
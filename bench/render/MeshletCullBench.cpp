@@ -0,0 +1,77 @@
+#include "Common.h"
+#include "render/BaseMesh.h"
+#include "render/Meshlet.h"
+#include "resource_management/mesh/MeshletBuilder.h"
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+/// UV sphere of radius 1, rings*rings*2 quads.
+void MakeSphere(render::BaseMesh& mesh, uint32_t rings)
+{
+    uint32_t segments = rings * 2;
+
+    for (uint32_t r = 0; r <= rings; r++) {
+        for (uint32_t s = 0; s <= segments; s++) {
+            float theta = M_PI * r / rings;
+            float phi   = 2 * M_PI * s / segments;
+            mesh.VertexBuffer.push_back(glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta),
+                                                  std::sin(theta) * std::sin(phi)));
+        }
+    }
+
+    for (uint32_t r = 0; r < rings; r++) {
+        for (uint32_t s = 0; s < segments; s++) {
+            uint32_t a = r * (segments + 1) + s, b = a + segments + 1;
+            mesh.IndexBuffer.insert(mesh.IndexBuffer.end(), { a, a + 1, b, a + 1, b + 1, b });
+        }
+    }
+}
+
+void RunView(const char* name, const render::BaseMesh& mesh, glm::vec3 eye, glm::vec3 target)
+{
+    auto projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.01f, 100.f);
+    auto mvp        = projection * glm::lookAt(eye, target, glm::vec3(0, 1, 0));
+
+    core::Vector<render::DrawRange> ranges;
+    render::MeshletCullStats stats;
+
+    auto ns = Bench::Measure(1000, [&](uint64_t) {
+        ranges.clear();
+        stats = render::CullMeshlets(mesh.Meshlets, mvp, eye, ranges);
+    });
+
+    uint32_t drawnIndices = 0;
+    for (const auto& range : ranges) {
+        drawnIndices += range.IndexCount;
+    }
+
+    auto total = (double)mesh.Meshlets.size();
+    printf("%s\n", name);
+    Bench::Report("  cull pass", ns / 1e3, "us");
+    Bench::Report("  cull cost per meshlet", ns / total, "ns");
+    Bench::Report("  visible meshlets", stats.Visible / total * 100, "%");
+    Bench::Report("  frustum culled", stats.FrustumCulled / total * 100, "%");
+    Bench::Report("  cone culled", stats.ConeCulled / total * 100, "%");
+    Bench::Report("  triangles drawn", drawnIndices * 100.0 / mesh.IndexBuffer.size(), "%");
+    Bench::Report("  draw ranges after merge", ranges.size(), "draws");
+}
+} // namespace
+
+int main()
+{
+    render::BaseMesh mesh;
+    MakeSphere(mesh, 512);
+
+    auto start = Bench::Clock::now();
+    res::mesh::MeshletBuilder::Build(mesh);
+    Bench::Report("build", Bench::SecondsSince(start) * 1e3, "ms");
+    Bench::Report("triangles", mesh.IndexBuffer.size() / 3, "");
+    Bench::Report("meshlets", mesh.Meshlets.size(), "");
+    Bench::Report("triangles per meshlet", mesh.IndexBuffer.size() / 3.0 / mesh.Meshlets.size(), "");
+
+    RunView("whole sphere in view", mesh, glm::vec3(0, 0, 4), glm::vec3(0));
+    RunView("close up", mesh, glm::vec3(0, 0, 1.3f), glm::vec3(0));
+    RunView("looking away", mesh, glm::vec3(0, 0, 4), glm::vec3(0, 0, 8));
+    return 0;
+}
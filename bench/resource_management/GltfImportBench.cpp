@@ -0,0 +1,186 @@
+#include "Common.h"
+#include "render/AnimatedMesh.h"
+#include "resource_management/mesh/AssimpImport.h"
+#include "resource_management/mesh/GltfImport.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+template <class T> uint32_t Append(core::TByteArray& bin, const core::Vector<T>& values)
+{
+    uint32_t offset = bin.size();
+    bin.resize(offset + values.size() * sizeof(T));
+    memcpy(bin.data() + offset, values.data(), values.size() * sizeof(T));
+    return offset;
+}
+
+/// Skinned grid of side*side vertices bent by two joints, plus a 'keys' long animation.
+core::TByteArray MakeSkinnedGlb(uint32_t side, uint32_t keys)
+{
+    core::Vector<float> positions, normals, uvs, weights, times, rotations;
+    core::Vector<uint8_t> joints;
+    core::Vector<uint32_t> indices;
+
+    for (uint32_t y = 0; y < side; y++) {
+        for (uint32_t x = 0; x < side; x++) {
+            float u = (float)x / (side - 1), v = (float)y / (side - 1);
+            positions.insert(positions.end(), { u, v, 0 });
+            normals.insert(normals.end(), { 0, 0, 1 });
+            uvs.insert(uvs.end(), { u, v });
+            joints.insert(joints.end(), { 0, 1, 0, 0 });
+            weights.insert(weights.end(), { 1 - v, v, 0, 0 });
+        }
+    }
+
+    for (uint32_t y = 0; y + 1 < side; y++) {
+        for (uint32_t x = 0; x + 1 < side; x++) {
+            uint32_t a = y * side + x, b = a + side;
+            indices.insert(indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+        }
+    }
+
+    for (uint32_t i = 0; i < keys; i++) {
+        float angle = (float)i / keys * M_PI;
+        times.push_back(i / 30.f);
+        rotations.insert(rotations.end(), { std::sin(angle / 2), 0, 0, std::cos(angle / 2) });
+    }
+
+    core::TByteArray bin;
+    uint32_t vertexCount = side * side;
+    uint32_t offsets[]   = { Append(bin, positions), Append(bin, normals), Append(bin, uvs),
+                             Append(bin, joints),    Append(bin, weights), Append(bin, indices),
+                             Append(bin, times),     Append(bin, rotations) };
+
+    auto json = core::string::format(R"({{
+        "asset": {{"version": "2.0"}},
+        "scene": 0,
+        "scenes": [{{"nodes": [0]}}],
+        "nodes": [
+            {{"name": "Armature", "children": [1, 3]}},
+            {{"name": "Root", "children": [2]}},
+            {{"name": "Tip", "translation": [0, 0.5, 0]}},
+            {{"name": "Grid", "mesh": 0, "skin": 0}}
+        ],
+        "skins": [{{"joints": [1, 2]}}],
+        "buffers": [{{"byteLength": {}}}],
+        "bufferViews": [
+            {{"buffer": 0, "byteOffset": {}, "byteLength": {}}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": {}}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": {}}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": {}}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": {}}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": {}}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": {}}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": {}}}
+        ],
+        "accessors": [
+            {{"bufferView": 0, "componentType": 5126, "count": {}, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]}},
+            {{"bufferView": 1, "componentType": 5126, "count": {}, "type": "VEC3"}},
+            {{"bufferView": 2, "componentType": 5126, "count": {}, "type": "VEC2"}},
+            {{"bufferView": 3, "componentType": 5121, "count": {}, "type": "VEC4"}},
+            {{"bufferView": 4, "componentType": 5126, "count": {}, "type": "VEC4"}},
+            {{"bufferView": 5, "componentType": 5125, "count": {}, "type": "SCALAR"}},
+            {{"bufferView": 6, "componentType": 5126, "count": {}, "type": "SCALAR", "min": [0], "max": [{}]}},
+            {{"bufferView": 7, "componentType": 5126, "count": {}, "type": "VEC4"}}
+        ],
+        "meshes": [{{"primitives": [{{"attributes": {{"POSITION": 0, "NORMAL": 1, "TEXCOORD_0": 2,
+            "JOINTS_0": 3, "WEIGHTS_0": 4}}, "indices": 5}}]}}],
+        "animations": [{{"name": "Bend", "samplers": [{{"input": 6, "output": 7}}],
+            "channels": [{{"sampler": 0, "target": {{"node": 2, "path": "rotation"}}}}]}}]
+    }})",
+        bin.size(), offsets[0], positions.size() * 4, offsets[1], normals.size() * 4, offsets[2],
+        uvs.size() * 4, offsets[3], joints.size(), offsets[4], weights.size() * 4, offsets[5],
+        indices.size() * 4, offsets[6], times.size() * 4, offsets[7], rotations.size() * 4,
+        vertexCount, vertexCount, vertexCount, vertexCount, vertexCount, indices.size(), keys,
+        times.back(), keys);
+
+    while (json.size() % 4)
+        json += ' ';
+    while (bin.size() % 4)
+        bin.push_back(0);
+
+    core::TByteArray glb;
+    auto put = [&](uint32_t v) { glb.insert(glb.end(), (uint8_t*)&v, (uint8_t*)&v + 4); };
+    put(0x46546c67);
+    put(2);
+    put(12 + 8 + json.size() + 8 + bin.size());
+    put(json.size());
+    put(0x4e4f534a);
+    glb.insert(glb.end(), json.begin(), json.end());
+    put(bin.size());
+    put(0x004e4942);
+    glb.insert(glb.end(), bin.begin(), bin.end());
+    return glb;
+}
+
+core::UniquePtr<render::AnimatedMesh> ImportNative(const core::String& path)
+{
+    return res::mesh::GltfImport::ImportGlbFile(path);
+}
+
+core::UniquePtr<render::AnimatedMesh> ImportAssimp(const core::String& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    core::TByteArray contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return res::mesh::AssimpImport::ImportWithAssimp(io::Path(path), contents);
+}
+
+/// Imports in a child process so peak resident memory of each importer is isolated.
+/// Without import function nothing is loaded, giving the rss baseline.
+void RunImport(const char* name, const core::String& path,
+               core::UniquePtr<render::AnimatedMesh> (*import)(const core::String&))
+{
+    const uint32_t iterations = 10;
+
+    fflush(stdout);
+    auto pid = fork();
+    if (pid == 0) {
+        auto start = Bench::Clock::now();
+
+        for (uint32_t i = 0; i < iterations && import; i++) {
+            if (!import(path)) {
+                printf("%s import failed\n", name);
+                break;
+            }
+        }
+
+        if (import)
+            Bench::Report(core::string::format("{} load", name).c_str(),
+                          Bench::SecondsSince(start) / iterations * 1e3, "ms");
+        fflush(stdout);
+        _exit(0);
+    }
+
+    int status;
+    rusage usage;
+    wait4(pid, &status, 0, &usage);
+    Bench::Report(core::string::format("{} peak rss", name).c_str(), usage.ru_maxrss / 1024.0, "MiB");
+}
+} // namespace
+
+int main()
+{
+    auto directory = std::filesystem::temp_directory_path() / "gltf_import_bench";
+    std::filesystem::create_directories(directory);
+
+    for (uint32_t side : { 64u, 256u, 1024u }) {
+        auto path = (directory / core::string::format("grid{}.glb", side)).string();
+        {
+            auto glb = MakeSkinnedGlb(side, 600);
+            std::ofstream(path, std::ios::binary).write((const char*)glb.data(), glb.size());
+            printf("%s: %u vertices, %.2f MiB\n", path.c_str(), side * side, glb.size() / 1048576.0);
+        }
+
+        RunImport("baseline", path, nullptr);
+        RunImport("native", path, ImportNative);
+        RunImport("assimp", path, ImportAssimp);
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include "Common.h"
+#include "filesystem/IFileReader.h"
+#include "resource_management/ImageLoader.h"
+#include "resource_management/PixelConversion.h"
+#include "stb_image/stb_image.h"
+#include <cstring>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+/// Reader over an in-memory file, keeps storage latency out of the measurement.
+class MemoryReader : public io::IFileReader
+{
+    public:
+    MemoryReader(const core::TByteArray& data)
+        : m_data(data)
+        , m_position(0)
+    {
+    }
+
+    std::intmax_t GetLength() const override
+    {
+        return m_data.size();
+    }
+
+    std::intmax_t GetPosition() const override
+    {
+        return m_position;
+    }
+
+    std::intmax_t Read(core::TByteArray& array, std::uintmax_t size) override
+    {
+        array.resize(std::min<std::uintmax_t>(size, m_data.size() - m_position));
+        return Read((void*)array.data(), array.size());
+    }
+
+    std::intmax_t Read(std::string& string, std::uintmax_t size) override
+    {
+        string.resize(std::min<std::uintmax_t>(size, m_data.size() - m_position));
+        return Read((void*)string.data(), string.size());
+    }
+
+    std::intmax_t Read(void* buffer, std::uintmax_t size) override
+    {
+        size = std::min<std::uintmax_t>(size, m_data.size() - m_position);
+        memcpy(buffer, m_data.data() + m_position, size);
+        m_position += size;
+        return size;
+    }
+
+    bool Seek(std::uintmax_t position) override
+    {
+        m_position = std::min<std::uintmax_t>(position, m_data.size());
+        return true;
+    }
+
+    private:
+    const core::TByteArray& m_data;
+    std::uintmax_t m_position;
+};
+
+uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+void PutU32(core::TByteArray& out, uint32_t v)
+{
+    out.insert(out.end(), { (uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v });
+}
+
+void PutChunk(core::TByteArray& out, const char* type, const core::TByteArray& data)
+{
+    PutU32(out, data.size());
+    auto start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    PutU32(out, Crc32(out.data() + start, out.size() - start));
+}
+
+/// PNG with stored deflate blocks, decoding cost is dominated by unfiltering and conversion.
+core::TByteArray MakePng(uint32_t w, uint32_t h, uint32_t channels)
+{
+    const uint8_t colorTypes[] = { 0, 0, 4, 2, 6 };
+    core::TByteArray raw;
+
+    for (uint32_t y = 0; y < h; y++) {
+        raw.push_back(0);
+        for (uint32_t x = 0; x < w * channels; x++) {
+            raw.push_back((uint8_t)(x * 7 + y * 13 + ((x * y) >> 5)));
+        }
+    }
+
+    core::TByteArray zlib = { 0x78, 0x01 };
+    for (size_t pos = 0; pos < raw.size(); pos += 65535) {
+        uint16_t len = std::min<size_t>(65535, raw.size() - pos);
+        zlib.push_back(pos + len == raw.size());
+        zlib.insert(zlib.end(), { (uint8_t)len, (uint8_t)(len >> 8), (uint8_t)~len, (uint8_t)(~len >> 8) });
+        zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + len);
+    }
+
+    uint32_t a = 1, b = 0;
+    for (auto c : raw) {
+        a = (a + c) % 65521;
+        b = (b + a) % 65521;
+    }
+    PutU32(zlib, (b << 16) | a);
+
+    core::TByteArray header;
+    PutU32(header, w);
+    PutU32(header, h);
+    header.insert(header.end(), { 8, colorTypes[channels], 0, 0, 0 });
+
+    core::TByteArray png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    PutChunk(png, "IHDR", header);
+    PutChunk(png, "IDAT", zlib);
+    PutChunk(png, "IEND", {});
+    return png;
+}
+
+/// Previous loader behaviour: whole file copied into memory, RGB widened by stb's scalar code
+/// so the output matches streaming decode.
+void DecodeFromMemoryCopy(const core::TByteArray& png)
+{
+    MemoryReader reader(png);
+    core::TByteArray contents;
+    reader.Read(contents, std::numeric_limits<std::uintmax_t>::max());
+
+    int w, h, c;
+    stbi_info_from_memory(contents.data(), contents.size(), &w, &h, &c);
+    auto pixels = stbi_load_from_memory(contents.data(), contents.size(), &w, &h, &c, c == 3 ? 4 : 0);
+    stbi_image_free(pixels);
+}
+
+void DecodeStreaming(const core::TByteArray& png)
+{
+    MemoryReader reader(png);
+    res::ImageLoader::DecodeImage(&reader);
+}
+
+/// Runs decode in a child process so peak resident memory of each mode is isolated.
+/// Without decode function only the test image is generated, giving the rss baseline.
+void RunDecode(const char* name, uint32_t channels, void (*decode)(const core::TByteArray&))
+{
+    const uint32_t size = 2048, iterations = 10;
+
+    fflush(stdout);
+    auto pid = fork();
+    if (pid == 0) {
+        auto png   = MakePng(size, size, channels);
+        auto start = Bench::Clock::now();
+
+        for (uint32_t i = 0; i < iterations && decode; i++) {
+            decode(png);
+        }
+
+        if (decode) {
+            auto seconds = Bench::SecondsSince(start);
+            auto pixels  = (double)size * size * iterations;
+            Bench::Report(core::string::format("{} {}ch decode+convert", name, channels).c_str(),
+                          pixels / seconds / 1e6, "Mpx/s");
+        }
+        fflush(stdout);
+        _exit(0);
+    }
+
+    int status;
+    rusage usage;
+    wait4(pid, &status, 0, &usage);
+    Bench::Report(core::string::format("{} {}ch peak rss", name, channels).c_str(),
+                  usage.ru_maxrss / 1024.0, "MiB");
+}
+
+template <class Kernel>
+void RunKernel(const char* name, uint32_t srcChannels, uint32_t dstChannels, Kernel kernel)
+{
+    const size_t pixelCount = 4096 * 4096;
+    core::TByteArray src(pixelCount * srcChannels, 0x80), dst(pixelCount * dstChannels);
+
+    auto ns = Bench::Measure(10, [&](uint64_t) { kernel(src.data(), dst.data(), pixelCount); });
+    Bench::Report(name, pixelCount / ns * 1e3, "Mpx/s");
+}
+} // namespace
+
+int main()
+{
+    using namespace res::pixel;
+
+    RunKernel("RgbToRgba", 3, 4, RgbToRgba);
+    RunKernel("GrayToRgba", 1, 4, GrayToRgba);
+    RunKernel("GrayAlphaToRgba", 2, 4, GrayAlphaToRgba);
+    RunKernel("PremultiplyRgba", 4, 4, [](const uint8_t*, uint8_t* dst, size_t n) { PremultiplyRgba(dst, n); });
+    RunKernel("PremultiplyGrayAlpha", 2, 2, [](const uint8_t*, uint8_t* dst, size_t n) { PremultiplyGrayAlpha(dst, n); });
+
+    for (uint32_t channels : { 1u, 3u, 4u }) {
+        RunDecode("baseline", channels, nullptr);
+        RunDecode("memory copy", channels, DecodeFromMemoryCopy);
+        RunDecode("streaming", channels, DecodeStreaming);
+    }
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include "Common.h"
+#include "filesystem/IFileSystem.h"
+#include "render/AnimatedMesh.h"
+#include "resource_management/mesh/AssimpImport.h"
+#include "util/ThreadPool.h"
+#include <cmath>
+#include <filesystem>
+#include <thread>
+
+namespace {
+constexpr uint32_t ModelCount = 100;
+
+/// UV sphere as wavefront obj, 'rings' controls the size, 64 rings is ~4k vertices.
+core::String MakeSphereObj(uint32_t rings)
+{
+    core::String obj;
+    uint32_t segments = rings * 2;
+
+    for (uint32_t r = 0; r <= rings; r++) {
+        for (uint32_t s = 0; s <= segments; s++) {
+            float theta = M_PI * r / rings;
+            float phi   = 2 * M_PI * s / segments;
+            float x = std::sin(theta) * std::cos(phi), y = std::cos(theta), z = std::sin(theta) * std::sin(phi);
+
+            obj += core::string::format("v {} {} {}\nvn {} {} {}\nvt {} {}\n", x, y, z, x, y, z,
+                                        (float)s / segments, (float)r / rings);
+        }
+    }
+
+    for (uint32_t r = 0; r < rings; r++) {
+        for (uint32_t s = 0; s < segments; s++) {
+            uint32_t a = r * (segments + 1) + s + 1, b = a + segments + 1;
+            obj += core::string::format("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2} {3}/{3}/{3}\n", a, b,
+                                        b + 1, a + 1);
+        }
+    }
+
+    return obj;
+}
+}
+
+int main(int argc, char** argv)
+{
+    auto directory = std::filesystem::temp_directory_path() / "mesh_import_bench";
+    std::filesystem::create_directories(directory);
+
+    auto fs = io::CreateFileSystem(io::Path(core::String(argv[0])));
+    fs->AddSearchDirectory(directory.string());
+    fs->SetWriteDirectory(directory.string());
+
+    core::Vector<io::Path> paths;
+    for (uint32_t i = 0; i < ModelCount; i++) {
+        // mix of sizes so workers do not finish in lockstep
+        auto path = core::string::format("model{}.obj", i);
+        auto obj  = MakeSphereObj(16 + (i % 4) * 16);
+        fs->OpenWrite(path)->Write(obj);
+        paths.push_back(path);
+    }
+
+    res::mesh::AssimpImport importer(fs.get(), nullptr);
+    double singleThreaded = 0;
+    uint32_t maxThreads   = std::max(1u, std::thread::hardware_concurrency());
+
+    core::Vector<uint32_t> threadCounts;
+    for (uint32_t threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    for (auto threads : threadCounts) {
+        util::ThreadPool workers(threads);
+
+        // warm up per thread importers and the page cache
+        importer.ImportMeshes(paths, &workers);
+
+        auto start  = Bench::Clock::now();
+        auto meshes = importer.ImportMeshes(paths, &workers);
+        auto ms     = Bench::SecondsSince(start) * 1000;
+
+        uint64_t vertices = 0;
+        for (auto& mesh : meshes) {
+            vertices += mesh ? mesh->VertexBuffer.size() : 0;
+        }
+
+        if (threads == 1)
+            singleThreaded = ms;
+
+        auto name = core::string::format("import {} models, {} threads", ModelCount, threads);
+        Bench::Report(name.c_str(), ms, "ms");
+        Bench::Report("  speedup", singleThreaded / ms, "x");
+        Bench::Report("  vertices per second", vertices / ms * 1000, "vert/s");
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
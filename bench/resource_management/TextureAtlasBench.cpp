@@ -0,0 +1,87 @@
+#include "Common.h"
+#include "resource_management/atlas/TextureAtlas.h"
+#include <random>
+
+using namespace res::atlas;
+
+namespace {
+struct Image
+{
+    uint32_t w, h;
+};
+
+core::Vector<Image> MakeImages(uint32_t count, uint32_t minSize, uint32_t maxSize)
+{
+    std::mt19937 rng(1337);
+    std::uniform_int_distribution<uint32_t> dist(minSize, maxSize);
+    core::Vector<Image> images;
+
+    for (uint32_t i = 0; i < count; i++) {
+        images.push_back(Image{ dist(rng), dist(rng) });
+    }
+
+    return images;
+}
+
+void RunInsert(const char* name, uint32_t count, uint32_t minSize, uint32_t maxSize)
+{
+    auto images = MakeImages(count, minSize, maxSize);
+    core::TByteArray pixels(maxSize * maxSize * 4, 0x7f);
+
+    AtlasDescriptor desc;
+    desc.MaxPages = 64;
+    TextureAtlas atlas(desc);
+
+    uint32_t failed = 0;
+    auto start      = Bench::Clock::now();
+
+    for (const auto& img : images) {
+        if (atlas.Insert(pixels.data(), img.w, img.h) == TextureAtlas::InvalidId)
+            failed++;
+    }
+
+    auto seconds = Bench::SecondsSince(start);
+
+    printf("%s: %u images %u-%upx\n", name, count, minSize, maxSize);
+    Bench::Report("  insert throughput", count / seconds, "images/s");
+    Bench::Report("  pages", atlas.GetPageCount(), "");
+    Bench::Report("  occupancy", atlas.GetOccupancy() * 100.0, "%");
+    Bench::Report("  failed inserts", failed, "");
+}
+
+void RunChurn(uint32_t count)
+{
+    auto images = MakeImages(count, 8, 96);
+    core::TByteArray pixels(96 * 96 * 4, 0x7f);
+
+    AtlasDescriptor desc;
+    desc.MaxPages = 4;
+    TextureAtlas atlas(desc);
+    core::Vector<uint32_t> ids;
+
+    for (const auto& img : images) {
+        ids.push_back(atlas.Insert(pixels.data(), img.w, img.h));
+    }
+
+    // free every other image, then refill so repacking has to kick in
+    for (uint32_t i = 0; i < ids.size(); i += 2) {
+        atlas.Remove(ids[i]);
+    }
+
+    Bench::Report("churn: fragmentation after removal", atlas.GetFragmentation() * 100.0, "%");
+
+    auto start = Bench::Clock::now();
+    atlas.Repack();
+    Bench::Report("churn: repack time", Bench::SecondsSince(start) * 1000.0, "ms");
+    Bench::Report("churn: occupancy after repack", atlas.GetOccupancy() * 100.0, "%");
+}
+} // namespace
+
+int main()
+{
+    RunInsert("icons", 4000, 16, 32);
+    RunInsert("decals", 2000, 32, 128);
+    RunInsert("mixed", 2000, 8, 256);
+    RunChurn(3000);
+    return 0;
+}
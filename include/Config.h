@@ -1,9 +1,19 @@
 #ifndef THEPROJECT2_CONFIG_H
 #define THEPROJECT2_CONFIG_H
 
+#include <cstdint>
+
 #define ENGINE_DEBUG true
+
+/// Log statements made through the ELOG macros below this level are compiled out,
+/// 0 debug, 1 info, 2 warning, 3 error, 4 critical.
+#ifndef ENGINE_LOG_MIN_LEVEL
+#define ENGINE_LOG_MIN_LEVEL 0
+#endif
+
 namespace config {
-constexpr bool EngineDebug = ENGINE_DEBUG;
+constexpr bool EngineDebug     = ENGINE_DEBUG;
+constexpr uint32_t LogMinLevel = ENGINE_LOG_MIN_LEVEL;
 };
 
 #endif // THEPROJECT2_CONFIG_H
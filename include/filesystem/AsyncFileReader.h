@@ -0,0 +1,70 @@
+#ifndef ASYNC_FILE_READER_H
+#define ASYNC_FILE_READER_H
+
+#include "filesystem/Path.h"
+#include <functional>
+
+namespace io {
+class IFileSystem;
+class IAsyncReadBackend;
+struct AsyncRead;
+
+struct AsyncReadRequest
+{
+  Path File;
+  uint64_t Offset = 0;
+  /// Destination has to hold Length bytes and stay valid until the read completes.
+  uint64_t Length   = 0;
+  void* Destination = nullptr;
+  /// Bytes read, short at the end of file, -1 on failure.
+  std::function<void(std::intmax_t bytesRead)> OnComplete;
+};
+
+enum class AsyncReadBackend
+{
+  IoUring,
+  ThreadPool
+};
+
+/// Batched asynchronous reads. At most 'queueDepth' reads are in flight, the rest wait in
+/// submission order. Callbacks only run inside Poll, which the owning thread calls once per frame,
+/// so they need no synchronization. On linux loose files are read through io_uring, files inside
+/// archives, block compressed files and kernels without io_uring fall back to worker threads.
+class AsyncFileReader
+{
+  public:
+  AsyncFileReader(IFileSystem* fileSystem, uint32_t queueDepth = 64, bool allowIoUring = true);
+  /// Waits for reads in flight, their callbacks are not run.
+  ~AsyncFileReader();
+
+  AsyncFileReader(const AsyncFileReader&) = delete;
+  AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+  void Submit(AsyncReadRequest request);
+  void Submit(core::Vector<AsyncReadRequest> requests);
+
+  /// Runs callbacks of finished reads and starts queued ones, never blocks.
+  /// Returns the number of completed reads.
+  uint32_t Poll();
+  /// Polls until every submitted read has completed.
+  void WaitAll();
+
+  uint32_t GetPendingCount() const;
+  /// Backend used for loose files.
+  AsyncReadBackend GetBackend() const;
+
+  private:
+  void StartQueued();
+  uint32_t Complete(bool wait);
+
+  private:
+  IFileSystem* m_fileSystem;
+  uint32_t m_queueDepth;
+  core::Queue<AsyncReadRequest> m_queued;
+  core::UniquePtr<IAsyncReadBackend> m_uring;
+  core::UniquePtr<IAsyncReadBackend> m_threads;
+  core::Vector<core::UniquePtr<AsyncRead>> m_done;
+};
+} // namespace io
+
+#endif
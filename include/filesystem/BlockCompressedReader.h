@@ -0,0 +1,74 @@
+#ifndef BLOCK_COMPRESSED_READER_H
+#define BLOCK_COMPRESSED_READER_H
+
+#include "filesystem/IFileReader.h"
+#include <future>
+
+namespace util {
+class ThreadPool;
+}
+
+namespace io {
+/// Reads the uncompressed contents of a block compressed file, see BlockCompression.h.
+/// Seeking is free, reads decompress only the blocks they touch. Once reads go through the blocks
+/// in order, up to 'window' blocks ahead are read with one call and decompressed on 'pool'.
+class BlockCompressedReader : public IFileReader
+{
+  public:
+  /// 'reader' has to be positioned at the header. Returns nullptr if it is not a valid container.
+  static core::UniquePtr<BlockCompressedReader> Open(
+      core::UniquePtr<IFileReader> reader, core::SharedPtr<util::ThreadPool> pool = nullptr,
+      uint32_t window = 8);
+  virtual ~BlockCompressedReader();
+
+  virtual std::intmax_t GetLength() const;
+  virtual std::intmax_t GetPosition() const;
+  virtual std::intmax_t Read(core::TByteArray& array,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual std::intmax_t Read(std::string& string,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual std::intmax_t Read(void* buffer,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual bool Seek(std::uintmax_t position);
+
+  /// Size of the container on disk.
+  uint64_t GetCompressedSize() const
+  {
+    return m_offsets.back();
+  }
+
+  private:
+  struct PendingBlock
+  {
+    uint64_t Index;
+    core::SharedPtr<core::TByteArray> Data;
+    std::future<bool> Done;
+  };
+
+  BlockCompressedReader(core::UniquePtr<IFileReader> reader, core::SharedPtr<util::ThreadPool> pool,
+                        uint32_t window);
+
+  template <class T> std::intmax_t ReadInto(T& buffer, std::uintmax_t size);
+  /// Makes 'index' the current block, false if it could not be read or decompressed.
+  bool LoadBlock(uint64_t index);
+  /// Reads blocks [first, first + count) with one call and queues their decompression.
+  void Schedule(uint64_t first, uint64_t count);
+
+  core::UniquePtr<IFileReader> m_reader;
+  core::SharedPtr<util::ThreadPool> m_pool;
+  uint32_t m_window;
+  uint32_t m_blockSize;
+  uint64_t m_length;
+  core::Vector<uint64_t> m_offsets;
+  uint64_t m_position;
+  /// Where m_reader is, sequential schedules need no seek.
+  uint64_t m_readerPosition;
+
+  core::SharedPtr<core::TByteArray> m_block;
+  uint64_t m_blockIndex;
+  /// Consecutive blocks following the current one, in order.
+  core::Queue<PendingBlock> m_pending;
+};
+} // namespace io
+
+#endif
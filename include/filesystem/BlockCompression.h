@@ -0,0 +1,38 @@
+#ifndef BLOCK_COMPRESSION_H
+#define BLOCK_COMPRESSION_H
+
+/// Container for loose files that compress well. The payload is split into blocks compressed
+/// independently with a small LZ77 codec, an offset table after the header locates every block, so
+/// any position can be read by decompressing one block. Blocks that do not shrink are stored raw.
+/// Files are recognized by their header, so compressed assets keep their names.
+/// Data is stored in host byte order, files are not portable between endiannesses.
+namespace io::compression {
+constexpr uint32_t FormatVersion    = 1;
+constexpr uint32_t DefaultBlockSize = 64 * 1024;
+/// Largest offset the codec can encode, blocks are capped to it.
+constexpr uint32_t MaxBlockSize = 64 * 1024;
+
+struct Header
+{
+  char Magic[4];
+  uint32_t Version;
+  uint32_t BlockSize;
+  uint32_t BlockCount;
+  uint64_t UncompressedSize;
+  /// Followed by BlockCount + 1 uint64_t offsets from the start of the file, block n spans
+  /// offsets n to n + 1.
+};
+
+/// Needs at least sizeof(Header) bytes, only checks magic and version.
+bool IsCompressed(const void* data, size_t size);
+
+void CompressFile(const uint8_t* data, size_t size, core::TByteArray& out,
+                  uint32_t blockSize = DefaultBlockSize);
+
+/// Returns the compressed size, 0 if the result would not fit into 'capacity'.
+size_t CompressBlock(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity);
+/// Fails on corrupt input or if it does not decompress to exactly 'size' bytes.
+bool DecompressBlock(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t size);
+} // namespace io::compression
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef BUFFERED_FILE_WRITER_H
+#define BUFFERED_FILE_WRITER_H
+
+#include "filesystem/IFileWriter.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace io {
+/// Write-behind wrapper around another writer. Writes are copied into a buffer and return right
+/// away, full buffers are written out on a background thread while the caller fills the next one.
+/// The caller only waits when it gets a whole buffer ahead of the disk, or at a Seek or Flush.
+/// Background write errors are reported by the next Write, Seek or Flush.
+class BufferedFileWriter : public IFileWriter
+{
+  public:
+  static constexpr size_t DefaultBufferSize = 64 * 1024;
+
+  BufferedFileWriter(core::UniquePtr<IFileWriter> writer, size_t bufferSize = DefaultBufferSize);
+  /// Writes out what is still buffered, without syncing it to disk.
+  virtual ~BufferedFileWriter();
+
+  BufferedFileWriter(const BufferedFileWriter&) = delete;
+  BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+
+  /// Position including bytes not yet written out.
+  virtual std::intmax_t GetPosition() const;
+  virtual std::intmax_t Write(const core::TByteArray& array,
+                              std::intmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual std::intmax_t Write(const std::string& string,
+                              std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  /// Waits for buffered bytes to be written before moving.
+  virtual bool Seek(std::uintmax_t position);
+  /// Barrier, waits for buffered bytes to be written and synced to disk.
+  virtual bool Flush();
+  /// Hands the buffered bytes to the background thread, only waits for a previous hand off.
+  void FlushAsync();
+
+  private:
+  template <class T> std::intmax_t Append(const T& buffer, std::uintmax_t size);
+  /// Swaps the filled buffer with the background one, waits if that is still being written.
+  void Submit();
+  void WaitIdle();
+  void Run();
+
+  core::UniquePtr<IFileWriter> m_writer;
+  size_t m_bufferSize;
+  /// Filled by the caller, only touched by the background thread while m_pending is set.
+  core::TByteArray m_front;
+  core::TByteArray m_back;
+  std::intmax_t m_position;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_idle;
+  bool m_pending;
+  bool m_stop;
+  std::atomic<bool> m_failed;
+  std::thread m_thread;
+};
+} // namespace io
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include "filesystem/IFileSystem.h"
+#include <chrono>
+
+namespace io {
+/// Reports files changed on disk below search directories of a file system, for reloading content
+/// while the game runs. Events are collected without blocking whenever TakeChanged is called, a
+/// path is handed out once no event arrived for it during the quiet period, so bursts like an
+/// editor writing a temporary file and renaming it show up as one change. Linux only, uses
+/// inotify. Not thread safe, meant to be polled once a frame from the main thread.
+class FileWatcher
+{
+  public:
+  FileWatcher(IFileSystem* fileSystem,
+              std::chrono::milliseconds quietPeriod = std::chrono::milliseconds(100));
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher&) = delete;
+  FileWatcher& operator=(const FileWatcher&) = delete;
+
+  /// Watches 'directory' and everything below it, 'directory' is a native path also mounted with
+  /// IFileSystem::AddSearchDirectory. Fails where watching is not supported.
+  bool AddDirectory(const Path& directory);
+
+  /// Files created, written, renamed or deleted that settled since the last call, relative to their
+  /// search directory, so they can be passed to the file system as they are. The file system is
+  /// rescanned first if files appeared or disappeared.
+  core::Vector<Path> TakeChanged();
+
+  private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Change
+  {
+    Clock::time_point LastEvent;
+  };
+
+  /// Drains the event queue without waiting.
+  void ReadEvents();
+  /// Watches 'nativeDirectory' and its subdirectories, their paths start with 'prefix'. Files found
+  /// are reported as changed if 'reportFiles' is set, for directories moved in after the fact.
+  void WatchTree(const core::String& nativeDirectory, const core::String& prefix, bool reportFiles);
+  void MarkChanged(const core::String& path, Clock::time_point time);
+
+  IFileSystem* m_fileSystem;
+  std::chrono::milliseconds m_quietPeriod;
+  int m_inotify;
+  /// Watch descriptors mapped to the native directory and prefix of paths below it.
+  core::UnorderedMap<int, std::pair<core::String, core::String>> m_watches;
+  core::UnorderedMap<core::String, Change> m_changes;
+  /// Files appeared or disappeared since the last rescan.
+  bool m_needsRescan;
+};
+} // namespace io
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef IFILE_MAPPING_H
+#define IFILE_MAPPING_H
+
+namespace io {
+/// Read only view of whole file contents, valid for as long as the mapping object lives.
+class IFileMapping
+{
+  public:
+  virtual ~IFileMapping()
+  {
+  }
+  virtual const uint8_t* GetData() const = 0;
+  virtual size_t GetSize() const         = 0;
+};
+} // namespace io
+
+#endif
@@ -2,6 +2,8 @@
 #define IFILE_READER_H
 
 namespace io {
+class IoBuffer;
+
 class IFileReader
 {
   public:
@@ -17,6 +19,11 @@ class IFileReader
   virtual std::intmax_t Read(void* buffer,
                              std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max()) = 0;
   virtual bool Seek(std::uintmax_t position)                                                   = 0;
+
+  /// Reads into a pooled buffer, which is resized to the bytes read. Its memory is reused if it is
+  /// large enough, see IoBuffer::Reserve.
+  std::intmax_t Read(IoBuffer& buffer,
+                     std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
 };
 } // namespace io
 
@@ -1,11 +1,18 @@
 #ifndef IFILE_SYSTEM_H
 #define IFILE_SYSTEM_H
 
+#include "IFileMapping.h"
 #include "IFileReader.h"
 #include "IFileWriter.h"
 #include "Path.h"
 
 namespace io {
+/// All methods may be called from any thread. Mount changes (AddSearchDirectory and
+/// SetWriteDirectory) are serialized and publish a new snapshot of the mounts, lookups already
+/// running finish against the snapshot they started with. OpenRead, FileExists, DirectoryExists,
+/// MapFile and GetNativePath resolve loose files against the snapshot without taking a lock, files
+/// in archives and the remaining calls are serialized inside physfs. Readers and writers are not
+/// thread safe, each belongs to one thread at a time.
 class IFileSystem
 {
   public:
@@ -16,16 +23,36 @@ class IFileSystem
   virtual Path GetWriteDirectory()                                      = 0;
   virtual Path GetWorkingDirectory()                                    = 0;
   virtual bool AddSearchDirectory(const Path& path)                     = 0;
+  /// Loose directories are indexed when mounted and kept current through this file system.
+  /// Files added or removed by other means are only seen after a rescan.
+  virtual void RescanMounts()                                           = 0;
   virtual bool DirectoryExists(const Path& path)                        = 0;
   virtual bool FileExists(const Path& path)                             = 0;
   virtual bool CreateDirectory(const Path& path)                        = 0;
   virtual bool Delete(const Path& path)                                 = 0;
   virtual core::UniquePtr<IFileWriter> OpenWrite(const Path& path, bool append = false)      = 0;
   virtual core::UniquePtr<IFileReader> OpenRead(const Path& path)       = 0;
+  /// Whole file contents without a read copy. Loose files are memory mapped, files inside archives
+  /// are read into a recycled buffer. Returns nullptr if the file does not exist.
+  virtual core::UniquePtr<IFileMapping> MapFile(const Path& path)       = 0;
   virtual core::Vector<Path> GetFilesInDirectory(const Path& directory) = 0;
+  /// Native location of a file as seen through the mounts. For files inside archives this is not
+  /// an existing file, callers have to be ready for opening it to fail. Empty if not found.
+  virtual core::String GetNativePath(const Path& path)                  = 0;
 };
 
-core::UniquePtr<IFileSystem> CreateFileSystem(const Path& argv0);
+struct FileSystemOptions
+{
+  /// Loose files are read with plain positional reads instead of through physfs, which sanitizes
+  /// paths, locks and copies on every call. Archives and the write directory always use physfs.
+  bool NativeReads = true;
+  /// Native reads of at least this many bytes bypass the page cache with O_DIRECT where the file
+  /// system supports it, 0 never does. Meant for large assets read once, like streamed audio.
+  uint64_t DirectReadThreshold = 0;
+};
+
+core::UniquePtr<IFileSystem> CreateFileSystem(const Path& argv0,
+                                              const FileSystemOptions& options = {});
 } // namespace io
 
 #endif
\ No newline at end of file
@@ -14,6 +14,8 @@ class IFileWriter
   virtual std::intmax_t Write(const std::string& string,
                               std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max()) = 0;
   virtual bool Seek(std::uintmax_t position)                                                    = 0;
+  /// Blocks until everything written so far reached the storage device (fsync).
+  virtual bool Flush()                                                                          = 0;
 };
 } // namespace io
 
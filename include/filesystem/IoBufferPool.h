@@ -0,0 +1,107 @@
+#ifndef IO_BUFFER_POOL_H
+#define IO_BUFFER_POOL_H
+
+#include "filesystem/IFileMapping.h"
+#include <mutex>
+
+namespace io {
+class IFileReader;
+class IoBufferPool;
+
+/// Uninitialized, Alignment aligned memory from an IoBufferPool, goes back to its pool when
+/// destroyed. Move only.
+class IoBuffer
+{
+  public:
+  IoBuffer();
+  IoBuffer(IoBuffer&& other) noexcept;
+  IoBuffer& operator=(IoBuffer&& other) noexcept;
+  ~IoBuffer();
+
+  uint8_t* GetData()
+  {
+    return m_data;
+  }
+
+  const uint8_t* GetData() const
+  {
+    return m_data;
+  }
+
+  size_t GetSize() const
+  {
+    return m_size;
+  }
+
+  size_t GetCapacity() const
+  {
+    return m_capacity;
+  }
+
+  /// Changes the size within the capacity, contents are left as they are.
+  bool Resize(size_t size);
+  /// Makes room for 'size' bytes and resizes to it. Buffers that are too small are swapped for one
+  /// from the same pool, or the default pool if empty, contents are not kept then.
+  void Reserve(size_t size);
+
+  private:
+  friend class IoBufferPool;
+
+  IoBuffer(core::SharedPtr<IoBufferPool> pool, uint8_t* data, size_t size, size_t capacity);
+  void Release();
+
+  core::SharedPtr<IoBufferPool> m_pool;
+  uint8_t* m_data;
+  size_t m_size;
+  size_t m_capacity;
+};
+
+struct IoBufferPoolStats
+{
+  uint64_t Acquired    = 0;
+  /// Acquires that had to allocate, the rest reused a released buffer.
+  uint64_t Allocations = 0;
+  size_t RetainedBytes = 0;
+};
+
+/// Recycles read buffers so loading many files does not allocate and zero fill one per file.
+/// Capacities are rounded up to size classes, four per power of two from MinCapacity on, so
+/// files of similar size share buffers and at most a quarter is wasted. Thread safe.
+class IoBufferPool : public std::enable_shared_from_this<IoBufferPool>
+{
+  public:
+  static constexpr size_t Alignment   = 64;
+  static constexpr size_t MinCapacity = 4096;
+
+  /// Released buffers beyond 'maxRetainedBytes' in total are freed instead of kept.
+  IoBufferPool(size_t maxRetainedBytes);
+  ~IoBufferPool();
+
+  IoBufferPool(const IoBufferPool&) = delete;
+  IoBufferPool& operator=(const IoBufferPool&) = delete;
+
+  /// Shared by file systems and readers that are not given a pool.
+  static const core::SharedPtr<IoBufferPool>& GetDefault();
+
+  /// Buffer of 'size' bytes with undefined contents.
+  IoBuffer Acquire(size_t size);
+
+  /// Reads the rest of 'file' into a pooled buffer, which returns to the pool with the mapping.
+  core::UniquePtr<IFileMapping> ReadAll(IFileReader* file);
+
+  IoBufferPoolStats GetStats() const;
+
+  private:
+  friend class IoBuffer;
+
+  void Release(uint8_t* data, size_t capacity);
+
+  mutable std::mutex m_mutex;
+  /// Free buffers by size class.
+  core::Vector<core::Vector<uint8_t*>> m_free;
+  size_t m_maxRetainedBytes;
+  IoBufferPoolStats m_stats;
+};
+} // namespace io
+
+#endif
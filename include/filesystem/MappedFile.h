@@ -0,0 +1,39 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "filesystem/IFileMapping.h"
+
+namespace io {
+/// Read only memory mapping of a whole native file, pages are loaded by the os on first access.
+/// Paths are native paths, files inside mounted archives can not be mapped.
+class MappedFile : public IFileMapping
+{
+  public:
+  /// Returns nullptr if file does not exist or can not be mapped.
+  static core::UniquePtr<MappedFile> Open(const core::String& nativePath);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const uint8_t* GetData() const override
+  {
+    return m_data;
+  }
+
+  size_t GetSize() const override
+  {
+    return m_size;
+  }
+
+  private:
+  MappedFile(const uint8_t* data, size_t size, void* handle);
+
+  const uint8_t* m_data;
+  size_t m_size;
+  /// File mapping handle on windows, unused elsewhere.
+  void* m_handle;
+};
+} // namespace io
+
+#endif
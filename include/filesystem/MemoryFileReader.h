@@ -0,0 +1,37 @@
+#ifndef MEMORY_FILE_READER_H
+#define MEMORY_FILE_READER_H
+
+#include "filesystem/IFileReader.h"
+
+namespace io {
+/// Reads from a byte buffer, the buffer can be shared between many readers.
+class MemoryFileReader : public IFileReader
+{
+  public:
+  MemoryFileReader(core::SharedPtr<const core::TByteArray> data);
+  MemoryFileReader(core::TByteArray data);
+  /// Reads 'size' bytes at 'data', which 'owner' keeps alive. Nothing is copied.
+  MemoryFileReader(core::SharedPtr<const void> owner, const uint8_t* data, size_t size);
+  virtual ~MemoryFileReader();
+
+  virtual std::intmax_t GetLength() const;
+  virtual std::intmax_t GetPosition() const;
+  virtual std::intmax_t Read(core::TByteArray& array,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual std::intmax_t Read(std::string& string,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual std::intmax_t Read(void* buffer,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual bool Seek(std::uintmax_t position);
+
+  private:
+  template <class T> std::intmax_t ReadInto(T& buffer, std::uintmax_t size);
+
+  core::SharedPtr<const void> m_owner;
+  const uint8_t* m_data;
+  size_t m_size;
+  std::uintmax_t m_position;
+};
+} // namespace io
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef MEMORY_FILE_SYSTEM_H
+#define MEMORY_FILE_SYSTEM_H
+
+#include "filesystem/IFileSystem.h"
+#include <shared_mutex>
+
+namespace io {
+struct MemoryBlobEntry
+{
+  /// Relative to the mount point of the blob.
+  Path File;
+  uint64_t Offset = 0;
+  uint64_t Size   = 0;
+};
+
+/// File system kept in memory. Files are found with one hash lookup, readers and mappings view the
+/// stored bytes without copying them. Without a fallback it is a standalone file system and writes
+/// land in memory too, the write directory is only remembered. With a fallback it is an overlay:
+/// memory files shadow the fallback, everything not in memory as well as mounts and writes go to
+/// the fallback, a write drops the memory copy of the file. Safe to use from any thread, like
+/// IFileSystem requires.
+class MemoryFileSystem : public IFileSystem
+{
+  public:
+  MemoryFileSystem(core::UniquePtr<IFileSystem> fallback = nullptr);
+  virtual ~MemoryFileSystem();
+
+  /// Adds or replaces a file, missing parent directories are created.
+  void AddFile(const Path& path, core::TByteArray contents);
+  void AddFile(const Path& path, core::SharedPtr<const core::TByteArray> contents);
+  /// Makes every entry a file under 'mountPoint' that views its range of 'blob'.
+  /// Fails without adding anything if an entry does not fit into the blob.
+  bool MountBlob(const Path& mountPoint, core::SharedPtr<const core::TByteArray> blob,
+                 const core::Vector<MemoryBlobEntry>& entries);
+  /// Copies a file of the fallback into memory, so later reads never touch it.
+  bool Pin(const Path& path);
+  IFileSystem* GetFallback() const
+  {
+    return m_fallback.get();
+  }
+
+  virtual bool SetWriteDirectory(const Path& path);
+  virtual Path GetWriteDirectory();
+  virtual Path GetWorkingDirectory();
+  virtual bool AddSearchDirectory(const Path& path);
+  virtual void RescanMounts();
+  virtual bool DirectoryExists(const Path& path);
+  virtual bool FileExists(const Path& path);
+  virtual bool CreateDirectory(const Path& path);
+  virtual bool Delete(const Path& path);
+  virtual core::UniquePtr<IFileWriter> OpenWrite(const Path& path, bool append = false);
+  virtual core::UniquePtr<IFileReader> OpenRead(const Path& path);
+  virtual core::UniquePtr<IFileMapping> MapFile(const Path& path);
+  virtual core::Vector<Path> GetFilesInDirectory(const Path& directory);
+  /// Empty for files in memory, they have no native location.
+  virtual core::String GetNativePath(const Path& path);
+
+  private:
+  struct File
+  {
+    /// Keeps Data alive, a whole blob for mounted files.
+    core::SharedPtr<const core::TByteArray> Owner;
+    const uint8_t* Data = nullptr;
+    size_t Size         = 0;
+  };
+
+  struct Directory
+  {
+    /// Child names mapped to whether they are directories.
+    core::UnorderedMap<core::String, bool> Children;
+  };
+
+  friend class MemoryFileWriter;
+
+  /// Caller holds the lock exclusively.
+  void AddFileLocked(const core::String& key, File file);
+  void RemoveFileLocked(const core::String& key);
+  void AddDirectoryLocked(const core::String& key);
+  core::Optional<File> FindFile(const Path& path);
+
+  core::UniquePtr<IFileSystem> m_fallback;
+  Path m_writeDirectory;
+
+  std::shared_mutex m_mutex;
+  /// Keyed by normalized path without leading separator, the root directory is "".
+  core::UnorderedMap<core::String, File> m_files;
+  core::UnorderedMap<core::String, Directory> m_directories;
+};
+} // namespace io
+
+#endif
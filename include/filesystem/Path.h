@@ -14,22 +14,30 @@ class Path
 {
   public:
   Path(const core::String& path)
+      : m_path(path)
   {
-    m_path = io::path::Normalize(path);
+    io::path::NormalizeInPlace(m_path);
   }
 
-  Path()
-      : m_path("")
+  Path(core::String&& path)
+      : m_path(core::Move(path))
   {
+    io::path::NormalizeInPlace(m_path);
   }
 
-  ~Path()
+  Path()
+      : m_path("")
   {
   }
 
+  Path(const Path&) = default;
+  Path(Path&&)      = default;
+  Path& operator=(const Path&) = default;
+  Path& operator=(Path&&) = default;
+
   Path Append(const Path& path)
   {
-    return io::path::Append(m_path, core::String(path));
+    return io::path::Append(m_path, path.m_path);
   }
 
   Path GetFileName() const
@@ -45,6 +53,20 @@ class Path
     return io::path::GetParentDirectory(m_path);
   }
 
+  /// Non allocating variants, the views live as long as this path.
+  std::string_view GetFileNameView() const
+  {
+    return io::path::GetFileNameView(m_path);
+  }
+  std::string_view GetExtensionView() const
+  {
+    return io::path::GetExtensionView(m_path);
+  }
+  std::string_view GetParentDirectoryView() const
+  {
+    return io::path::GetParentDirectoryView(m_path);
+  }
+
   bool HasFileName() const
   {
     return io::path::HasFileName(m_path);
@@ -57,11 +79,6 @@ class Path
   {
     return m_path;
   }
-  Path& operator=(const Path& other)
-  {
-    m_path = other.m_path;
-    return *this;
-  }
 
   private:
   core::String m_path;
@@ -0,0 +1,78 @@
+#ifndef PATH_ID_H
+#define PATH_ID_H
+
+#include "Path.h"
+
+namespace io {
+/// Handle of a normalized path in the global intern table. Equal paths share one id, so comparing
+/// is an integer compare and hashing reads the hash computed once when the path was interned.
+/// Interned strings are never freed, meant for resource paths and other long lived names.
+class PathId
+{
+  public:
+  /// The empty path.
+  PathId()
+      : m_index(0)
+      , m_hash(0)
+  {
+  }
+
+  /// Interns the path unless it already is. Empty if the intern table is full, the error is
+  /// logged, so callers must not key resources on the result without checking IsEmpty.
+  explicit PathId(const Path& path);
+  explicit PathId(const core::String& path);
+  explicit PathId(std::string_view path);
+
+  /// Returns the empty path if 'path' was never interned, never inserts.
+  static PathId Find(std::string_view path);
+
+  const core::String& AsString() const;
+
+  uint32_t GetIndex() const
+  {
+    return m_index;
+  }
+
+  size_t GetHash() const
+  {
+    return m_hash;
+  }
+
+  bool IsEmpty() const
+  {
+    return m_index == 0;
+  }
+
+  private:
+  PathId(uint32_t index, uint32_t hash)
+      : m_index(index)
+      , m_hash(hash)
+  {
+  }
+
+  uint32_t m_index;
+  uint32_t m_hash;
+};
+
+inline bool operator==(PathId lhs, PathId rhs)
+{
+  return lhs.GetIndex() == rhs.GetIndex();
+}
+
+inline bool operator!=(PathId lhs, PathId rhs)
+{
+  return lhs.GetIndex() != rhs.GetIndex();
+}
+} // namespace io
+
+namespace std {
+template <> struct hash<io::PathId>
+{
+  size_t operator()(io::PathId id) const
+  {
+    return id.GetHash();
+  }
+};
+} // namespace std
+
+#endif
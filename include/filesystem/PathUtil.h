@@ -1,6 +1,8 @@
 #ifndef PATH_EXT_H
 #define PATH_EXT_H
 
+#include <string_view>
+
 namespace io {
 namespace path {
 const auto Separator = '/';
@@ -15,6 +17,14 @@ core::String GetParentDirectory(const core::String& path);
 bool HasFileName(const core::String& path);
 core::String ConvertToUnixPath(const core::String& path);
 core::String Normalize(const core::String& path);
+/// Same as Normalize, already normalized paths are left untouched without allocating.
+void NormalizeInPlace(core::String& path);
+bool IsNormalized(std::string_view path);
+
+/// Views into 'path', valid as long as the viewed string.
+std::string_view GetFileNameView(std::string_view path);
+std::string_view GetExtensionView(std::string_view path);
+std::string_view GetParentDirectoryView(std::string_view path);
 } // namespace path
 } // namespace io
 
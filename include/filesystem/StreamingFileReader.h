@@ -0,0 +1,84 @@
+#ifndef STREAMING_FILE_READER_H
+#define STREAMING_FILE_READER_H
+
+#include "filesystem/IFileReader.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace io {
+struct StreamingReadStats
+{
+  /// Bytes the background thread read ahead, includes chunks dropped by seeks.
+  uint64_t BytesPrefetched = 0;
+  uint64_t BytesRead       = 0;
+  /// Reads that had to wait for the background thread and how long they waited in total.
+  uint32_t Stalls     = 0;
+  double StallSeconds = 0.0;
+};
+
+/// Read-ahead wrapper around another reader for large sequential files. A background thread keeps
+/// 'chunkCount' chunks ahead of the read position filled (two for double, three for triple
+/// buffering), so reads mostly copy from memory. Seeking inside the filled window keeps it, other
+/// seeks restart the read-ahead at the new position. The wrapped reader is only used by the
+/// background thread from then on.
+class StreamingFileReader : public IFileReader
+{
+  public:
+  static constexpr size_t DefaultChunkSize   = 1024 * 1024;
+  static constexpr uint32_t DefaultChunkCount = 3;
+
+  StreamingFileReader(core::UniquePtr<IFileReader> reader, size_t chunkSize = DefaultChunkSize,
+                      uint32_t chunkCount = DefaultChunkCount);
+  virtual ~StreamingFileReader();
+
+  StreamingFileReader(const StreamingFileReader&) = delete;
+  StreamingFileReader& operator=(const StreamingFileReader&) = delete;
+
+  virtual std::intmax_t GetLength() const;
+  virtual std::intmax_t GetPosition() const;
+  virtual std::intmax_t Read(core::TByteArray& array,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual std::intmax_t Read(std::string& string,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual std::intmax_t Read(void* buffer,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual bool Seek(std::uintmax_t position);
+
+  StreamingReadStats GetStats() const;
+
+  private:
+  struct Chunk
+  {
+    core::TByteArray Data;
+    std::uintmax_t Offset = 0;
+    size_t Size           = 0;
+  };
+
+  template <class T> std::intmax_t ReadInto(T& buffer, std::uintmax_t size);
+  void Run();
+
+  core::UniquePtr<IFileReader> m_reader;
+  std::intmax_t m_length;
+  std::uintmax_t m_position;
+  size_t m_chunkSize;
+
+  /// Chunks m_head up to m_tail (modulo the count) are filled, the rest belong to the background
+  /// thread. Bumping m_generation drops chunks that were being read for an old position.
+  core::Vector<Chunk> m_chunks;
+  uint64_t m_head;
+  uint64_t m_tail;
+  uint64_t m_generation;
+  std::uintmax_t m_fillOffset;
+  bool m_failed;
+  bool m_stop;
+  StreamingReadStats m_stats;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_filled;
+  std::condition_variable m_consumed;
+  std::thread m_thread;
+};
+} // namespace io
+
+#endif
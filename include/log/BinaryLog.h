@@ -0,0 +1,284 @@
+#ifndef ENGINE_BINARY_LOG_H
+#define ENGINE_BINARY_LOG_H
+
+#include "ILogStream.h"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+
+namespace elog {
+/// How one argument of a binary log record is stored, fixed per format id.
+enum class LogArgType : uint8_t
+{
+  /// Zigzag varint.
+  Int,
+  /// Varint.
+  UInt,
+  /// One byte.
+  Bool,
+  /// Four bytes, little endian.
+  Float,
+  /// Eight bytes, little endian.
+  Double,
+  /// Varint length and the bytes. Types without an encoding of their own are formatted into one.
+  String,
+  /// Three floats.
+  Vec3
+};
+
+/// Format string and the argument types recorded with it.
+struct LogFormat
+{
+  core::String Format;
+  core::Vector<LogArgType> Types;
+};
+
+/// Returns the id of 'format' with these argument types, registering it if it is new. Ids start
+/// at 1 and are only valid for the running process, binary logs store the formats they use.
+uint32_t RegisterLogFormat(const char* format, const LogArgType* types, uint32_t count);
+/// Nullptr if 'id' was not registered.
+const LogFormat* GetLogFormat(uint32_t id);
+
+/// Format id of one ELOG statement, registered the first time it reaches a binary sink.
+struct LogCallSite
+{
+  std::atomic<uint32_t> Id{ 0 };
+};
+
+/// Writes a compact record per log call instead of text: time, thread, severity, source, format
+/// id and the raw argument bytes. Decode the file with BinaryLogReader or engine_logdecode.
+/// Records are buffered and written when the buffer fills, on Flush, and right away for errors.
+/// Added as a log stream it also keeps plain text records, stored with the format "{}".
+class BinaryLogSink : public ILogStream
+{
+  public:
+  static constexpr size_t BufferSize = 64 * 1024;
+
+  /// Returns nullptr if 'nativePath' can not be created.
+  static core::SharedPtr<BinaryLogSink> Open(const core::String& nativePath);
+  ~BinaryLogSink() override;
+
+  void Log(const LogSource source, const LogSeverity severity,
+           const core::String& logString) override;
+  void Flush() override;
+  /// The buffer is written when full, on errors and on explicit flushes.
+  bool NeedsFlushPerRecord() const override
+  {
+    return false;
+  }
+
+  /// Appends a record, 'args' are encoded as registered for 'formatId'. Thread safe.
+  void Write(LogSource source, LogSeverity severity, uint32_t formatId, const uint8_t* args,
+             size_t size);
+  /// Writes what is buffered and closes the file, later records are dropped.
+  void Close();
+
+  uint64_t GetRecordCount() const;
+  /// File size so far, including what is still buffered.
+  uint64_t GetBytesWritten() const;
+
+  private:
+  BinaryLogSink(FILE* file);
+
+  void WriteFormat(uint32_t formatId);
+  void WriteBuffer();
+
+  mutable std::mutex m_mutex;
+  FILE* m_file;
+  core::Vector<uint8_t> m_buffer;
+  /// Indexed by format id, whether the file already has its definition.
+  core::Vector<bool> m_formatsWritten;
+  int64_t m_lastTime;
+  uint64_t m_recordCount;
+  uint64_t m_bytesWritten;
+};
+
+/// ELOG statements are recorded in 'sink' from then on instead of being formatted for the log
+/// streams. The previous sink is closed, nullptr goes back to text.
+void SetBinaryLogSink(const core::SharedPtr<BinaryLogSink>& sink);
+
+namespace detail {
+/// File layout: the 8 byte magic, u32 version and u64 nanoseconds since the unix epoch at which
+/// the file was opened, then entries that start with a tag byte. Integers are little endian.
+///  - BinaryLogFormatTag, varint id, varint argument count, one LogArgType byte per argument,
+///    the format as a string. Written before the first record that uses the id.
+///  - BinaryLogRecordTag | severity << 3 | source, varint format id, zigzag varint nanoseconds
+///    since the previous record (or the open time), varint thread index, the arguments.
+constexpr char BinaryLogMagic[8]     = { 'E', 'L', 'O', 'G', 'B', 'I', 'N', 0 };
+constexpr uint32_t BinaryLogVersion  = 1;
+constexpr uint8_t BinaryLogFormatTag = 0x01;
+constexpr uint8_t BinaryLogRecordTag = 0x80;
+
+inline std::atomic<BinaryLogSink*> ActiveBinarySink{ nullptr };
+
+/// Small sequential id of the calling thread, 0 is the first thread that logged.
+uint32_t GetLogThreadIndex();
+/// Cleared scratch buffer of the calling thread for encoding arguments.
+core::Vector<uint8_t>& GetLogArgBuffer();
+
+inline void WriteVarint(core::Vector<uint8_t>& out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out.push_back(uint8_t(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(uint8_t(value));
+}
+
+inline uint64_t ZigZag(int64_t value)
+{
+  return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+template <class T> void WriteRaw(core::Vector<uint8_t>& out, const T& value)
+{
+  auto bytes = reinterpret_cast<const uint8_t*>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+inline void WriteString(core::Vector<uint8_t>& out, const char* str, size_t size)
+{
+  WriteVarint(out, size);
+  out.insert(out.end(), str, str + size);
+}
+
+/// Encoding of one argument type, anything fmt can format falls back to a string.
+template <class T, class = void> struct LogArgTraits
+{
+  static constexpr LogArgType Type = LogArgType::String;
+  static void Write(core::Vector<uint8_t>& out, const T& value)
+  {
+    auto text = core::string::format("{}", value);
+    WriteString(out, text.data(), text.size());
+  }
+};
+
+template <class T>
+struct LogArgTraits<T, std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value>>
+{
+  static constexpr LogArgType Type = LogArgType::Int;
+  static void Write(core::Vector<uint8_t>& out, T value)
+  {
+    WriteVarint(out, ZigZag(value));
+  }
+};
+
+template <class T>
+struct LogArgTraits<T, std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value &&
+                                        !std::is_same<T, bool>::value>>
+{
+  static constexpr LogArgType Type = LogArgType::UInt;
+  static void Write(core::Vector<uint8_t>& out, T value)
+  {
+    WriteVarint(out, value);
+  }
+};
+
+template <class T> struct LogArgTraits<T, std::enable_if_t<std::is_enum<T>::value>>
+{
+  static constexpr LogArgType Type = LogArgType::Int;
+  static void Write(core::Vector<uint8_t>& out, T value)
+  {
+    WriteVarint(out, ZigZag((int64_t)value));
+  }
+};
+
+template <> struct LogArgTraits<bool>
+{
+  static constexpr LogArgType Type = LogArgType::Bool;
+  static void Write(core::Vector<uint8_t>& out, bool value)
+  {
+    out.push_back(value);
+  }
+};
+
+/// Characters format as text, not as their code.
+template <> struct LogArgTraits<char>
+{
+  static constexpr LogArgType Type = LogArgType::String;
+  static void Write(core::Vector<uint8_t>& out, char value)
+  {
+    WriteString(out, &value, 1);
+  }
+};
+
+template <> struct LogArgTraits<float>
+{
+  static constexpr LogArgType Type = LogArgType::Float;
+  static void Write(core::Vector<uint8_t>& out, float value)
+  {
+    WriteRaw(out, value);
+  }
+};
+
+template <> struct LogArgTraits<double>
+{
+  static constexpr LogArgType Type = LogArgType::Double;
+  static void Write(core::Vector<uint8_t>& out, double value)
+  {
+    WriteRaw(out, value);
+  }
+};
+
+template <> struct LogArgTraits<const char*>
+{
+  static constexpr LogArgType Type = LogArgType::String;
+  static void Write(core::Vector<uint8_t>& out, const char* value)
+  {
+    WriteString(out, value, std::char_traits<char>::length(value));
+  }
+};
+
+template <> struct LogArgTraits<char*> : LogArgTraits<const char*>
+{
+};
+
+template <size_t N> struct LogArgTraits<char[N]> : LogArgTraits<const char*>
+{
+};
+
+template <> struct LogArgTraits<core::String>
+{
+  static constexpr LogArgType Type = LogArgType::String;
+  static void Write(core::Vector<uint8_t>& out, const core::String& value)
+  {
+    WriteString(out, value.data(), value.size());
+  }
+};
+
+template <> struct LogArgTraits<glm::vec3>
+{
+  static constexpr LogArgType Type = LogArgType::Vec3;
+  static void Write(core::Vector<uint8_t>& out, const glm::vec3& value)
+  {
+    WriteRaw(out, value.x);
+    WriteRaw(out, value.y);
+    WriteRaw(out, value.z);
+  }
+};
+} // namespace detail
+
+/// Records the call in the binary sink, false if there is none. Used by ELOG.
+template <class... T>
+bool LogBinary(LogCallSite& site, const LogSource source, const LogSeverity severity,
+               const char* format, const T&... args)
+{
+  auto sink = detail::ActiveBinarySink.load(std::memory_order_acquire);
+  if (!sink)
+    return false;
+
+  auto id = site.Id.load(std::memory_order_relaxed);
+  if (id == 0) {
+    const LogArgType types[] = { detail::LogArgTraits<T>::Type..., LogArgType::String };
+    id = RegisterLogFormat(format, types, sizeof...(T));
+    site.Id.store(id, std::memory_order_relaxed);
+  }
+
+  auto& buffer = detail::GetLogArgBuffer();
+  (detail::LogArgTraits<T>::Write(buffer, args), ...);
+  sink->Write(source, severity, id, buffer.data(), buffer.size());
+  return true;
+}
+} // namespace elog
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef ENGINE_BINARY_LOG_READER_H
+#define ENGINE_BINARY_LOG_READER_H
+
+#include "log/BinaryLog.h"
+
+namespace io {
+class IFileMapping;
+}
+
+namespace elog {
+/// One decoded argument, the field matching Type is set.
+struct LogArgument
+{
+  LogArgType Type = LogArgType::Int;
+  /// Int and Bool.
+  int64_t Int = 0;
+  uint64_t UInt = 0;
+  /// Float and Double.
+  double Real = 0;
+  core::String Text;
+  glm::vec3 Vec3 = glm::vec3(0);
+};
+
+struct BinaryLogRecord
+{
+  /// Nanoseconds since the unix epoch.
+  uint64_t Time = 0;
+  uint32_t Thread = 0;
+  LogSeverity Severity = LogSeverity::Info;
+  LogSource Source = LogSource::Engine;
+  uint32_t FormatId = 0;
+  core::String Format;
+  core::Vector<LogArgument> Arguments;
+};
+
+/// Reads back the records of a BinaryLogSink file in order.
+class BinaryLogReader
+{
+  public:
+  /// Returns nullptr if the file can not be mapped or is not a binary log.
+  static core::UniquePtr<BinaryLogReader> Open(const core::String& nativePath);
+  static core::UniquePtr<BinaryLogReader> Open(core::UniquePtr<io::IFileMapping> mapping);
+  ~BinaryLogReader();
+
+  /// False at the end of the file or if the rest can not be decoded, see HasError.
+  bool Next(BinaryLogRecord& record);
+  /// The file is truncated or corrupt, records before the damage were returned.
+  bool HasError() const
+  {
+    return m_error;
+  }
+
+  /// Nanoseconds since the unix epoch at which the sink opened the file.
+  uint64_t GetOpenTime() const
+  {
+    return m_openTime;
+  }
+
+  /// The record's format with its arguments filled in, like the text the call would have logged.
+  static core::String FormatMessage(const BinaryLogRecord& record);
+
+  private:
+  BinaryLogReader(core::UniquePtr<io::IFileMapping> mapping, uint64_t openTime);
+
+  bool ReadFormat();
+  bool ReadArgument(LogArgType type, LogArgument& argument);
+  bool ReadVarint(uint64_t& value);
+  bool ReadBytes(void* data, size_t size);
+  bool ReadString(core::String& string);
+
+  core::UniquePtr<io::IFileMapping> m_mapping;
+  const uint8_t* m_position;
+  const uint8_t* m_end;
+  uint64_t m_openTime;
+  /// Nanoseconds since open of the last record, times are stored as differences.
+  int64_t m_time;
+  bool m_error;
+  /// Indexed by format id.
+  core::Vector<core::UniquePtr<LogFormat>> m_formats;
+};
+
+const char* GetSeverityName(LogSeverity severity);
+const char* GetSourceName(LogSource source);
+} // namespace elog
+
+#endif
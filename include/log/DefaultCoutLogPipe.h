@@ -17,7 +17,12 @@ class DefaultCoutLogPipe : public ILogStream
            const core::String& logStr) override
     {
     if (source == elog::LogSource::Engine)
-      std::cout << "Engine log: " << logStr << std::endl;
+      std::cout << "Engine log: " << logStr << '\n';
+    }
+
+    void Flush() override
+    {
+      std::cout.flush();
     }
 };
 
@@ -11,6 +11,17 @@ class ILogStream
     virtual ~ILogStream() = default;
   virtual void Log(const LogSource source, const LogSeverity severity,
                    const core::String& logString) = 0;
+  /// Called after a record, or after a batch of records with asynchronous logging, so buffered
+  /// streams write once per batch.
+  virtual void Flush()
+  {
+  }
+  /// False for streams that buffer on their own and write when they see fit, synchronous logging
+  /// then leaves flushing to them instead of calling Flush after every record.
+  virtual bool NeedsFlushPerRecord() const
+  {
+    return true;
+  }
 };
 } // namespace elog
 
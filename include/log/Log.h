@@ -2,24 +2,106 @@
 #define ENGINE_LOG_H
 
 #include "ILogStream.h"
+#include <atomic>
+
 namespace elog {
+/// What producers do when the asynchronous ring is full.
+enum class LogOverflowPolicy
+{
+  /// Wait for the log thread to make room, nothing is lost.
+  Block,
+  /// Discard the record.
+  Drop,
+  /// Discard the record and count it, the log thread reports how many were lost.
+  DropAndCount
+};
+
+struct AsyncLogOptions
+{
+  /// Records the ring holds, rounded up to a power of two.
+  uint32_t Capacity          = 8192;
+  LogOverflowPolicy Overflow = LogOverflowPolicy::Block;
+};
+
+/// Verbosity order of the severities, Debug is the most verbose. See ENGINE_LOG_MIN_LEVEL.
+constexpr uint32_t GetSeverityLevel(const LogSeverity severity)
+{
+  switch (severity) {
+  case LogSeverity::Debug: return 0;
+  case LogSeverity::Info: return 1;
+  case LogSeverity::Warn: return 2;
+  case LogSeverity::Error: return 3;
+  case LogSeverity::Critical: return 4;
+  }
+  return 0;
+}
+
+namespace detail {
+constexpr size_t LogSourceCount = (size_t)LogSource::Other + 1;
+/// Per source, one bit per severity that is filtered out. All clear, so everything is logged,
+/// until SetLogLevel is called.
+inline std::atomic<uint32_t> FilteredSeverities[LogSourceCount];
+} // namespace detail
+
+/// Drops records of 'source' less severe than 'minimum' before they are formatted or queued.
+void SetLogLevel(const LogSource source, const LogSeverity minimum);
+
+inline bool IsLogEnabled(const LogSource source, const LogSeverity severity)
+{
+  auto filtered = detail::FilteredSeverities[(size_t)source].load(std::memory_order_relaxed);
+  return (filtered & (1u << (uint32_t)severity)) == 0;
+}
+
 void Log(const LogSource source, const LogSeverity severity, const core::String& log);
+/// Moves the message into the asynchronous ring instead of copying it.
+void Log(const LogSource source, const LogSeverity severity, core::String&& log);
 void AddLogStream(const core::WeakPtr<ILogStream>& wlogStream);
 void CleanDeadStreams();
 void ClearStreams();
+
+/// Log calls only push into a lock free ring from then on, a background thread hands the records
+/// to the streams in order. Streams are then called from that thread only.
+void StartAsyncLogging(const AsyncLogOptions& options = AsyncLogOptions());
+/// Dispatches what is still queued and goes back to logging on the calling thread.
+void StopAsyncLogging();
+/// Blocks until every record logged before the call reached the streams.
+void FlushLog();
+/// Records lost to LogOverflowPolicy::DropAndCount so far.
+uint64_t GetDroppedLogCount();
+
 // shorthand methods for engine logs
-inline void LogInfo(const core::String& log)
+inline void LogInfo(core::String log)
 {
-  Log(LogSource::Engine, LogSeverity::Info, log);
+  Log(LogSource::Engine, LogSeverity::Info, core::Move(log));
 }
-inline void LogWarning(const core::String& log)
+inline void LogWarning(core::String log)
 {
-  Log(LogSource::Engine, LogSeverity::Warn, log);
+  Log(LogSource::Engine, LogSeverity::Warn, core::Move(log));
 }
-inline void LogError(const core::String& log)
+inline void LogError(core::String log)
 {
-  Log(LogSource::Engine, LogSeverity::Error, log);
+  Log(LogSource::Engine, LogSeverity::Error, core::Move(log));
 }
 } // namespace elog
 
-#endif
\ No newline at end of file
+/// Logs core::string::format(...) if IsLogEnabled, the message is only formatted and the arguments
+/// only evaluated then. Statements below ENGINE_LOG_MIN_LEVEL compile to nothing. With a binary
+/// sink set the arguments are recorded unformatted instead, see BinaryLog.h.
+#define ELOG(source, severity, ...)                                                                \
+  do {                                                                                             \
+    if constexpr (::elog::GetSeverityLevel(severity) >= ::config::LogMinLevel) {                   \
+      if (::elog::IsLogEnabled(source, severity)) {                                                \
+        static ::elog::LogCallSite elogCallSite;                                                   \
+        if (!::elog::LogBinary(elogCallSite, source, severity, __VA_ARGS__))                       \
+          ::elog::Log(source, severity, ::core::string::format(__VA_ARGS__));                      \
+      }                                                                                            \
+    }                                                                                              \
+  } while (false)
+
+// shorthand macros for engine logs
+#define ELOG_DEBUG(...) ELOG(::elog::LogSource::Engine, ::elog::LogSeverity::Debug, __VA_ARGS__)
+#define ELOG_INFO(...) ELOG(::elog::LogSource::Engine, ::elog::LogSeverity::Info, __VA_ARGS__)
+#define ELOG_WARNING(...) ELOG(::elog::LogSource::Engine, ::elog::LogSeverity::Warn, __VA_ARGS__)
+#define ELOG_ERROR(...) ELOG(::elog::LogSource::Engine, ::elog::LogSeverity::Error, __VA_ARGS__)
+
+#endif
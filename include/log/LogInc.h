@@ -2,4 +2,5 @@
 #include "ELogSource.h"
 #include "ILogStream.h"
 #include "Log.h"
+#include "BinaryLog.h"
 #include "DefaultCoutLogPipe.h"
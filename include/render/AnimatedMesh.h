@@ -37,7 +37,7 @@ class AnimatedMesh : public BaseMesh
 
   void SetArmature(const render::anim::Armature& armature);
 
-  const render::anim::Armature& GetArmature()
+  const render::anim::Armature& GetArmature() const
   {
     return m_armature;
   }
@@ -52,6 +52,11 @@ class AnimatedMesh : public BaseMesh
     return m_animations;
   }
 
+  const core::Vector<render::anim::Animation>& GetAnimations() const
+  {
+    return m_animations;
+  }
+
   protected:
   render::anim::Armature m_armature;
   core::Vector<render::anim::Animation> m_animations;
@@ -45,6 +45,8 @@ class BaseMaterial
   protected:
   core::Array<render::ITexture*, 8> m_textures;
   render::IGpuProgram* m_shader;
+  /// Sampler slots are set again once the program was swapped by a reload.
+  uint32_t m_shaderGeneration;
   bool m_textureListNeedsRebuild;
 };
 } // namespace material
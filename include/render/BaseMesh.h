@@ -3,6 +3,7 @@
 
 #include "glm/glm.hpp"
 #include <render/BufferDescriptor.h>
+#include <render/Meshlet.h>
 
 namespace render {
 struct BufferDescriptor;
@@ -17,6 +18,8 @@ class BaseMesh
   core::Vector<glm::vec3> VertexBuffer;
   core::Vector<glm::vec3> NormalBuffer;
   core::Vector<glm::vec3> ColorBuffer;
+  /// Optional clustering of IndexBuffer, built at import time for large static meshes.
+  core::Vector<Meshlet> Meshlets;
 
   BaseMesh();
   BaseMesh(core::UniquePtr<IGpuBufferArrayObject> vao);
@@ -28,6 +31,8 @@ class BaseMesh
   virtual void UploadSubData(int32_t start, int32_t count);
 
   virtual void Render();
+  /// Draws only the given index ranges with a single multi-draw call.
+  void RenderRanges(const core::Vector<DrawRange>& ranges);
 
   IGpuBufferArrayObject* GetGpuBufferObject()
   {
@@ -10,6 +10,8 @@ enum class TextureFilterMode
 };
 enum class TextureDataFormat
 {
+  R,
+  RG,
   RGB,
   RGBA,
   DEPTH32F
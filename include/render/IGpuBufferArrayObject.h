@@ -4,6 +4,7 @@
 namespace render {
 class IGpuBufferObject;
 struct BufferDescriptor;
+struct DrawRange;
 class IGpuBufferArrayObject
 {
   public:
@@ -16,6 +17,7 @@ class IGpuBufferArrayObject
   virtual uint32_t GetBufferObjectCount()                                     = 0;
   virtual void Render(uint32_t count)                                         = 0;
   virtual void RenderLines(uint32_t count)                                    = 0;
+  virtual void RenderRanges(const core::Vector<DrawRange>& ranges)            = 0;
 };
 } // namespace render
 
@@ -12,6 +12,12 @@ class IGpuProgram
   virtual void Bind()                                                            = 0;
   virtual const core::Vector<core::UniquePtr<IGpuProgramUniform>>& GetUniforms() = 0;
   virtual IGpuProgramUniform* GetUniform(const core::String& name)               = 0;
+
+  /// Takes over the compiled program of 'other', which gets this one's and can be destroyed.
+  /// Used by reloads, everything holding this program uses the new one from then on.
+  virtual void Swap(IGpuProgram& other) = 0;
+  /// Changes with every Swap, uniform values set before it are gone.
+  virtual uint32_t GetGeneration() const = 0;
 };
 } // namespace render
 
@@ -29,6 +29,7 @@ class IRenderContext;
 
 struct BufferDescriptor;
 struct TextureDescriptor;
+struct ShaderProgramSource;
 struct FrameBufferObjectDescriptor;
 class ITexture;
 class BaseMesh;
@@ -44,6 +45,9 @@ class IRenderer
   virtual core::UniquePtr<IGpuProgram> CreateProgram(const core::String& vertSource = "",
                                                      const core::String& fragSource = "",
                                                      const core::String& geomSource = "") = 0;
+  /// Compiles and links all programs as one batch, failed programs are returned as nullptr.
+  virtual core::Vector<core::UniquePtr<IGpuProgram>> CreatePrograms(
+      const core::Vector<ShaderProgramSource>& sources) = 0;
   virtual core::UniquePtr<IGpuBufferArrayObject> CreateBufferArrayObject(
       const core::Vector<BufferDescriptor>& descriptors)                               = 0;
   virtual core::UniquePtr<ITexture> CreateTexture(const TextureDescriptor& descriptor) = 0;
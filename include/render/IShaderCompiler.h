@@ -0,0 +1,35 @@
+#ifndef THEPROJECT2_INCLUDE_RENDER_ISHADERCOMPILER_H_
+#define THEPROJECT2_INCLUDE_RENDER_ISHADERCOMPILER_H_
+
+namespace render {
+enum class ShaderStage
+{
+  Vertex = 0,
+  Fragment,
+  Geometry
+};
+
+constexpr uint32_t ShaderStageCount = 3;
+using ShaderStageHandles            = core::Array<uint32_t, ShaderStageCount>;
+
+/// Thin layer over the graphics api shader calls.
+/// Compile and link calls only issue work, status is queried separately so callers can batch.
+class IShaderCompiler
+{
+  public:
+  virtual ~IShaderCompiler() = default;
+
+  virtual uint32_t CompileShader(ShaderStage stage, const core::String& source) = 0;
+  /// Zero handles are skipped.
+  virtual uint32_t LinkProgram(const ShaderStageHandles& shaders) = 0;
+  /// Non blocking, returns true when status can be queried without stalling.
+  virtual bool IsProgramReady(uint32_t program) = 0;
+  virtual bool GetShaderStatus(uint32_t shader, core::String& log) = 0;
+  virtual bool GetProgramStatus(uint32_t program, core::String& log) = 0;
+  virtual void DetachShaders(uint32_t program, const ShaderStageHandles& shaders) = 0;
+  virtual void DeleteShader(uint32_t shader) = 0;
+  virtual void DeleteProgram(uint32_t program) = 0;
+};
+} // namespace render
+
+#endif // THEPROJECT2_INCLUDE_RENDER_ISHADERCOMPILER_H_
@@ -0,0 +1,45 @@
+#ifndef THEPROJECT2_INCLUDE_RENDER_MESHLET_H_
+#define THEPROJECT2_INCLUDE_RENDER_MESHLET_H_
+
+#include "glm/glm.hpp"
+
+namespace render {
+/// Small cluster of triangles, stored as a contiguous range of the mesh index buffer.
+/// Vertex indices stay global so clusters are drawn with the regular vertex streams.
+struct Meshlet
+{
+  uint32_t IndexOffset;
+  uint32_t IndexCount;
+  uint32_t VertexCount;
+  /// Bounding sphere in mesh space.
+  glm::vec3 Center;
+  float Radius;
+  /// Average triangle normal and sine of the cone half angle. The cluster faces away from any
+  /// camera inside the cone behind it, cutoff is 1 when triangles face too many directions.
+  glm::vec3 ConeAxis;
+  float ConeCutoff;
+};
+
+/// One draw of a multi-draw submission, in indices.
+struct DrawRange
+{
+  uint32_t IndexOffset;
+  uint32_t IndexCount;
+};
+
+struct MeshletCullStats
+{
+  uint32_t Visible       = 0;
+  uint32_t FrustumCulled = 0;
+  uint32_t ConeCulled    = 0;
+};
+
+/// Appends index ranges of meshlets that are inside the frustum and not backfacing, neighbouring
+/// visible meshlets are merged into one range. Camera position is in mesh space, which keeps the
+/// cone test exact for any model transform.
+MeshletCullStats CullMeshlets(const core::Vector<Meshlet>& meshlets,
+                              const glm::mat4& modelViewProjection,
+                              const glm::vec3& cameraPosition, core::Vector<DrawRange>& ranges);
+} // namespace render
+
+#endif // THEPROJECT2_INCLUDE_RENDER_MESHLET_H_
@@ -0,0 +1,43 @@
+#ifndef THEPROJECT2_INCLUDE_RENDER_SHADERPROGRAMBATCH_H_
+#define THEPROJECT2_INCLUDE_RENDER_SHADERPROGRAMBATCH_H_
+
+#include "IShaderCompiler.h"
+
+namespace render {
+struct ShaderProgramSource
+{
+  core::String Vertex;
+  core::String Fragment;
+  core::String Geometry;
+};
+
+struct CompiledShaderProgram
+{
+  bool Linked;
+  uint32_t Program;
+  ShaderStageHandles Shaders;
+};
+
+/// Creates many programs at once without stalling on each one.
+/// Submit() issues every compile and then every link, statuses are only queried in Finish(),
+/// which gives drivers supporting parallel shader compilation the whole batch to work on.
+class ShaderProgramBatch
+{
+  public:
+  ShaderProgramBatch(IShaderCompiler* compiler);
+
+  uint32_t Add(const ShaderProgramSource& source);
+  void Submit();
+  /// Non blocking, can be polled once per frame after Submit().
+  bool IsReady();
+  /// Failed programs are released and returned with Linked == false, in the order they were added.
+  core::Vector<CompiledShaderProgram> Finish();
+
+  private:
+  IShaderCompiler* m_compiler;
+  core::Vector<ShaderProgramSource> m_sources;
+  core::Vector<CompiledShaderProgram> m_programs;
+};
+} // namespace render
+
+#endif // THEPROJECT2_INCLUDE_RENDER_SHADERPROGRAMBATCH_H_
@@ -0,0 +1,42 @@
+#ifndef THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_COOKEDFORMATS_H_
+#define THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_COOKEDFORMATS_H_
+
+#include "ImageLoader.h"
+
+namespace render {
+class AnimatedMesh;
+struct ShaderProgramSource;
+} // namespace render
+
+/// Load-ready binary formats written by engine_cook.
+/// Cooked textures and meshes keep the source file name and are recognized by their header,
+/// so asset paths do not change. Program stages are bundled into one '<program>.prog' file.
+/// Data is stored in host byte order, files are not portable between endiannesses.
+namespace res::cooked {
+constexpr uint32_t FormatVersion = 2;
+constexpr uint32_t HeaderSize    = 8;
+constexpr const char* ProgramExtension = ".prog";
+
+enum class CookedType
+{
+  Texture,
+  Program,
+  Mesh
+};
+
+/// Needs at least HeaderSize bytes, returns nothing for source assets.
+core::Optional<CookedType> Detect(const void* data, size_t size);
+
+void WriteTexture(const LoadedImage& image, core::TByteArray& out);
+/// Reads pixels straight into image memory, file has to be positioned at the header.
+LoadedImage ReadTexture(io::IFileReader* file);
+
+void WriteProgram(const render::ShaderProgramSource& source, core::TByteArray& out);
+bool ReadProgram(const void* data, size_t size, render::ShaderProgramSource& out);
+
+void WriteMesh(const render::AnimatedMesh& mesh, core::TByteArray& out);
+/// Fills cpu side buffers, armature and animations, nothing is uploaded.
+bool ReadMesh(const void* data, size_t size, render::AnimatedMesh& out);
+} // namespace res::cooked
+
+#endif // THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_COOKEDFORMATS_H_
@@ -7,15 +7,52 @@
 
 #include <render/IRenderer.h>
 namespace res {
+namespace atlas {
+class TextureAtlas;
+}
+
+
+/// Decoded pixel data, freed with free().
+struct LoadedImage
+{
+  int32_t channels;
+  core::pod::Vec2<int32_t> size;
+  core::UniquePtr<uint8_t[], void (*)(void*)> data;
+  /// Size of the encoded file.
+  uint64_t encodedBytes;
+
+  LoadedImage();
+};
+
+struct ImageDecodeOptions
+{
+  /// RGB images are widened to RGBA so uploads use 4 byte aligned pixels.
+  bool ExpandRgbToRgba  = true;
+  bool PremultiplyAlpha = false;
+};
+
 class ImageLoader
 {
   private:
   public:
   ImageLoader(io::IFileSystem* fs, render::IRenderer* renderer);
 
+  /// Reads and decodes image on the calling thread, does not touch the renderer.
+  LoadedImage DecodeImage(const io::Path& path,
+                          const ImageDecodeOptions& options = ImageDecodeOptions());
+  /// Decodes while streaming from file, the encoded file is never held in memory as a whole.
+  /// Textures cooked by engine_cook are recognized by their header and read without decoding.
+  static LoadedImage DecodeImage(io::IFileReader* file,
+                                 const ImageDecodeOptions& options = ImageDecodeOptions());
+  core::UniquePtr<render::ITexture> CreateTexture(const LoadedImage& img);
+  /// Replaces the contents of a texture created earlier, for reloading changed images.
+  bool UpdateTexture(render::ITexture* texture, const LoadedImage& img);
+
   core::UniquePtr<render::ITexture> LoadTexture(const io::Path& path);
   core::UniquePtr<render::ITexture> LoadAtlasAs2DTexture(const io::Path& path,
                                                          uint32_t subImageSize);
+  /// Decodes image and packs it into atlas, returns atlas id or TextureAtlas::InvalidId.
+  uint32_t LoadIntoAtlas(atlas::TextureAtlas& atlas, const io::Path& path);
 
   private:
   io::IFileSystem* m_fileSystem;
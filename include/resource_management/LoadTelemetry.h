@@ -0,0 +1,79 @@
+#ifndef THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_LOADTELEMETRY_H_
+#define THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_LOADTELEMETRY_H_
+
+#include "ResourceType.h"
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace res {
+/// One resource request, times are in microseconds.
+struct LoadRecord
+{
+  core::String Path;
+  ResourceType Type;
+  /// Bytes read from the file system, 0 on cache hits.
+  uint64_t Bytes = 0;
+  /// Offset from the start of telemetry session.
+  uint64_t Start = 0;
+  /// Reading, parsing and decoding on the cpu.
+  uint64_t DecodeTime = 0;
+  /// Creating gpu objects.
+  uint64_t UploadTime = 0;
+  bool CacheHit = false;
+  /// Cpu side data was produced ahead of time by the preloader.
+  bool Preloaded = false;
+  /// Small sequential id, 0 is the first thread that requested a resource.
+  uint32_t Thread = 0;
+
+  uint64_t GetTotalTime() const
+  {
+    return DecodeTime + UploadTime;
+  }
+};
+
+enum class TelemetryFormat
+{
+  Csv,
+  Json,
+  /// Trace event format, load with chrome://tracing or Perfetto.
+  ChromeTrace
+};
+
+/// Thread safe table of resource loads for the current session.
+class LoadTelemetry
+{
+  public:
+  LoadTelemetry();
+
+  /// Microseconds since construction, use for LoadRecord::Start.
+  uint64_t Now() const;
+  /// Fills in requesting thread and stores the record.
+  void Record(LoadRecord record);
+
+  core::Vector<LoadRecord> GetRecords() const;
+  core::Vector<LoadRecord> Query(const std::function<bool(const LoadRecord&)>& filter) const;
+  /// Cache hits are excluded, they cost nothing.
+  core::Vector<LoadRecord> GetSlowest(uint32_t count) const;
+  core::Vector<LoadRecord> GetLargest(uint32_t count) const;
+
+  core::String Serialize(TelemetryFormat format) const;
+  bool Write(io::IFileSystem* fs, const io::Path& path, TelemetryFormat format) const;
+
+  /// Logs totals and flags the top 'count' slowest and largest assets.
+  void LogSummary(uint32_t count) const;
+
+  private:
+  core::Vector<LoadRecord> GetTop(uint32_t count,
+                                  bool (*less)(const LoadRecord&, const LoadRecord&)) const;
+
+  private:
+  std::chrono::steady_clock::time_point m_sessionStart;
+  mutable std::mutex m_mutex;
+  core::Vector<LoadRecord> m_records;
+  core::UnorderedMap<std::thread::id, uint32_t> m_threads;
+};
+} // namespace res
+
+#endif // THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_LOADTELEMETRY_H_
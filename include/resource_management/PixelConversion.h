@@ -0,0 +1,19 @@
+#ifndef THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_PIXELCONVERSION_H_
+#define THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_PIXELCONVERSION_H_
+
+/// 8 bit per channel pixel conversion kernels.
+/// SSE2/SSSE3 paths are used on x86-64 when supported, other platforms use scalar code.
+/// Source and destination buffers must not overlap unless stated otherwise.
+namespace res::pixel {
+/// Appends opaque alpha to every pixel.
+void RgbToRgba(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+/// Replicates gray into color channels, alpha is opaque.
+void GrayToRgba(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+void GrayAlphaToRgba(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+
+/// Multiplies color by alpha in place, rounding to nearest.
+void PremultiplyRgba(uint8_t* pixels, size_t pixelCount);
+void PremultiplyGrayAlpha(uint8_t* pixels, size_t pixelCount);
+} // namespace res::pixel
+
+#endif // THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_PIXELCONVERSION_H_
@@ -0,0 +1,60 @@
+#ifndef THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_PRELOADMANIFEST_H_
+#define THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_PRELOADMANIFEST_H_
+
+#include "ResourceType.h"
+#include "util/Timer.h"
+
+namespace res {
+struct PreloadEntry
+{
+  ResourceType Type;
+  core::String Path;
+};
+
+/// Ordered list of resources the game touched at startup.
+/// Stored as text, one '<type> <path>' entry per line, lines starting with '#' are ignored.
+class PreloadManifest
+{
+  public:
+  static core::Optional<PreloadManifest> Read(io::IFileSystem* fs, const io::Path& path);
+  bool Write(io::IFileSystem* fs, const io::Path& path) const;
+
+  /// Entries are kept in first touch order, repeated touches are ignored.
+  void Add(ResourceType type, const core::String& path);
+
+  const core::Vector<PreloadEntry>& GetEntries() const
+  {
+    return m_entries;
+  }
+
+  bool Empty() const
+  {
+    return m_entries.empty();
+  }
+
+  private:
+  core::Vector<PreloadEntry> m_entries;
+};
+
+/// Records resource touches during the first N seconds after construction.
+class PreloadRecorder
+{
+  public:
+  PreloadRecorder(float recordSeconds);
+
+  void Record(ResourceType type, const core::String& path);
+  bool IsRecording();
+
+  const PreloadManifest& GetManifest() const
+  {
+    return m_manifest;
+  }
+
+  private:
+  util::Timer m_timer;
+  float m_recordSeconds;
+  PreloadManifest m_manifest;
+};
+} // namespace res
+
+#endif // THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_PRELOADMANIFEST_H_
@@ -0,0 +1,29 @@
+#ifndef THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_RESOURCEDEPENDENCIES_H_
+#define THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_RESOURCEDEPENDENCIES_H_
+
+#include "filesystem/PathId.h"
+
+namespace res {
+/// Which resources are built from which files and other resources, so a changed file only
+/// invalidates what was derived from it. Files and resources share one namespace, a resource named
+/// like the file it is loaded from depends on itself.
+class ResourceDependencies
+{
+  public:
+  /// 'resource' has to be rebuilt whenever 'dependency', a file or another resource, changes.
+  void Add(io::PathId resource, io::PathId dependency);
+  /// Forgets what 'resource' depends on, resources depending on it keep their edges.
+  void Remove(io::PathId resource);
+
+  /// Resources built from 'changed' directly or through other resources, each once, ordered so
+  /// every resource comes before the resources depending on it.
+  core::Vector<io::PathId> CollectAffected(const core::Vector<io::Path>& changed) const;
+
+  private:
+  /// Reverse edges, what is built from a file or resource.
+  core::UnorderedMap<io::PathId, core::Vector<io::PathId>> m_dependents;
+  core::UnorderedMap<io::PathId, core::Vector<io::PathId>> m_dependencies;
+};
+} // namespace res
+
+#endif // THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_RESOURCEDEPENDENCIES_H_
@@ -1,4 +1,5 @@
 #include "ImageLoader.h"
+#include "PreloadManifest.h"
 #include "ResourceManager.h"
 #include "mesh/AssimpImport.h"
 #include "mesh/MBDLoader.h"
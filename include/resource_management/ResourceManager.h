@@ -1,9 +1,20 @@
 #ifndef THEPROJECT2_RESOURCEMANAGER_H_
 #define THEPROJECT2_RESOURCEMANAGER_H_
 
+#include "LoadTelemetry.h"
+#include "ResourceDependencies.h"
+#include "ResourceType.h"
+#include "filesystem/PathId.h"
+#include "util/Timer.h"
+
 namespace render {
 class IGpuProgram;
 class ITexture;
+class AnimatedMesh;
+}
+
+namespace util {
+class ThreadPool;
 }
 
 namespace material {
@@ -12,6 +23,9 @@ class BaseMaterial;
 
 namespace res {
 class ImageLoader;
+class PreloadManifest;
+class PreloadRecorder;
+class ResourcePreloader;
 
 namespace mesh {
 class AssimpImport;
@@ -40,23 +54,78 @@ public:
                   render::IRenderer* renderer, io::IFileSystem* fileSystem,
                   res::mesh::AssimpImport* assimpImporter);
 
-  ~ResourceManager() = default;
+  ~ResourceManager();
 
   render::ITexture* LoadTexture(core::String path);
+  /// Callers loading the same path repeatedly should intern it once and use the id overloads.
+  /// Fails for the empty id, which is also what interning returns when the table is full.
+  render::ITexture* LoadTexture(io::PathId id);
   /// todo: this should return UniquePtr.
   core::SharedPtr<material::BaseMaterial> LoadMaterial(core::String path);
+  core::SharedPtr<material::BaseMaterial> LoadMaterial(io::PathId id);
+  /// Reads all shader stages in parallel and creates the programs as one batch.
+  core::Vector<core::SharedPtr<material::BaseMaterial>> LoadMaterials(
+      const core::Vector<core::String>& paths);
+  core::Vector<core::SharedPtr<material::BaseMaterial>> LoadMaterials(
+      const core::Vector<io::PathId>& ids);
+  core::UniquePtr<render::AnimatedMesh> LoadMesh(core::String path);
+  /// Imports all meshes on worker threads and uploads them on the calling thread.
+  core::Vector<core::UniquePtr<render::AnimatedMesh>> LoadMeshes(
+      const core::Vector<core::String>& paths);
+
+  /// Records every resource touched during the first 'seconds' of the session.
+  void StartPreloadRecording(float seconds);
+  bool WritePreloadManifest(const io::Path& path);
+  /// Starts fetching and decoding manifest entries in parallel, Load* calls pick the results up.
+  void Preload(const PreloadManifest& manifest);
+  /// Logs and returns milliseconds since construction, only the first call is measured.
+  int32_t MarkFirstInteractiveFrame();
+
+  /// Rebuilds loaded resources built from 'changedFiles', for example from io::FileWatcher.
+  /// Textures are updated in place. Programs are recompiled and swapped into the existing program
+  /// objects, so materials using them pick the change up. A program that fails to compile keeps
+  /// the previous version. Returns every affected resource, including ones registered with
+  /// GetDependencies by callers, so they can rebuild their own.
+  core::Vector<io::PathId> ReloadChanged(const core::Vector<io::Path>& changedFiles);
+
+  /// Files and resources each loaded resource was built from.
+  ResourceDependencies& GetDependencies()
+  {
+    return m_dependencies;
+  }
+
+  /// Per load timings and sizes, summary of the slowest and largest loads is logged on destruction.
+  LoadTelemetry& GetTelemetry()
+  {
+    return m_telemetry;
+  }
 
 private:
-    core::String LoadShaderSource(const core::String& path);
-    render::IGpuProgram* LoadProgram(const core::String& path);
+    core::Vector<core::String> LoadShaderSources(const core::Vector<core::String>& paths);
+    render::IGpuProgram* LoadProgram(io::PathId id);
+    core::Vector<render::IGpuProgram*> LoadPrograms(const core::Vector<io::PathId>& ids);
+    /// Reads, compiles and records the dependencies of programs, nullptr for failed ones.
+    core::Vector<core::UniquePtr<render::IGpuProgram>> CreatePrograms(
+        const core::Vector<core::String>& paths, const core::Vector<io::PathId>& ids);
+    util::ThreadPool* GetWorkers();
+    void RecordAccess(ResourceType type, const core::String& path);
 
 private:
   ImageLoader* m_imageLoader;
-  core::UnorderedMap<core::String, Resource<render::ITexture>> m_textures;
-  core::UnorderedMap<core::String, Resource<render::IGpuProgram>> m_shaders;
+  core::UnorderedMap<io::PathId, Resource<render::ITexture>> m_textures;
+  core::UnorderedMap<io::PathId, Resource<render::IGpuProgram>> m_shaders;
+  ResourceDependencies m_dependencies;
   render::IRenderer* m_renderer;
   io::IFileSystem* m_fileSystem;
   res::mesh::AssimpImport* m_assimpImporter;
+
+  util::Timer m_sessionTimer;
+  bool m_firstFrameMarked;
+  uint32_t m_preloadEntryCount;
+  core::UniquePtr<util::ThreadPool> m_workers;
+  core::UniquePtr<ResourcePreloader> m_preloader;
+  core::UniquePtr<PreloadRecorder> m_recorder;
+  LoadTelemetry m_telemetry;
 };
 } // namespace res
 
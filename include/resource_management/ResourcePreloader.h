@@ -0,0 +1,50 @@
+#ifndef THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_RESOURCEPRELOADER_H_
+#define THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_RESOURCEPRELOADER_H_
+
+#include "ImageLoader.h"
+#include "PreloadManifest.h"
+#include <future>
+
+namespace util {
+class ThreadPool;
+}
+
+namespace res {
+/// Fetches and decodes manifest entries on worker threads.
+/// Results are handed out once through Take* methods, which block only on the requested entry.
+/// Gpu objects are not created here, that is left to the thread which takes the result.
+class ResourcePreloader
+{
+  public:
+  ResourcePreloader(io::IFileSystem* fs, ImageLoader* imageLoader, util::ThreadPool* workers);
+  ~ResourcePreloader();
+
+  void Start(const PreloadManifest& manifest);
+  void Wait();
+
+  /// Returns false when path was not part of manifest or was already taken.
+  bool TakeImage(const core::String& path, LoadedImage& out);
+  bool TakeText(const core::String& path, core::String& out);
+  bool TakeBytes(const core::String& path, core::TByteArray& out);
+
+  private:
+  struct Slot
+  {
+    std::future<void> Ready;
+    LoadedImage Image;
+    core::String Text;
+    core::TByteArray Bytes;
+  };
+
+  void Submit(const core::String& path, ResourceType type);
+  Slot* Acquire(const core::String& path);
+
+  private:
+  io::IFileSystem* m_fileSystem;
+  ImageLoader* m_imageLoader;
+  util::ThreadPool* m_workers;
+  core::UnorderedMap<core::String, core::UniquePtr<Slot>> m_slots;
+};
+} // namespace res
+
+#endif // THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_RESOURCEPRELOADER_H_
@@ -0,0 +1,37 @@
+#ifndef THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_RESOURCETYPE_H_
+#define THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_RESOURCETYPE_H_
+
+namespace res {
+enum class ResourceType
+{
+  Texture,
+  Program,
+  Mesh
+};
+
+inline const char* ToString(ResourceType type)
+{
+  switch (type) {
+  case ResourceType::Texture:
+    return "texture";
+  case ResourceType::Program:
+    return "program";
+  case ResourceType::Mesh:
+    return "mesh";
+  default:
+    return "unknown";
+  }
+}
+
+inline core::Optional<ResourceType> ResourceTypeFromString(const core::String& str)
+{
+  for (auto type : { ResourceType::Texture, ResourceType::Program, ResourceType::Mesh }) {
+    if (str == ToString(type))
+      return type;
+  }
+
+  return {};
+}
+} // namespace res
+
+#endif // THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_RESOURCETYPE_H_
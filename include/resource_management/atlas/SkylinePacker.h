@@ -0,0 +1,53 @@
+#ifndef THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_ATLAS_SKYLINEPACKER_H_
+#define THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_ATLAS_SKYLINEPACKER_H_
+
+namespace res::atlas {
+struct PackedRect
+{
+  uint32_t x, y, w, h;
+};
+
+/// Bottom-left skyline rectangle packer.
+/// Cheap inserts with good occupancy for many small rectangles, freed space is not reused,
+/// see TextureAtlas::Repack for that.
+class SkylinePacker
+{
+  public:
+  SkylinePacker(uint32_t width, uint32_t height);
+
+  core::Optional<PackedRect> Insert(uint32_t w, uint32_t h);
+  void Reset();
+
+  /// Area consumed by inserted rectangles.
+  uint64_t GetUsedArea() const
+  {
+    return m_usedArea;
+  }
+
+  float GetOccupancy() const
+  {
+    return (float)m_usedArea / ((uint64_t)m_width * m_height);
+  }
+
+  core::pod::Vec2<uint32_t> GetSize() const
+  {
+    return { m_width, m_height };
+  }
+
+  private:
+  struct SkylineNode
+  {
+    uint32_t x, y, w;
+  };
+
+  bool Fits(uint32_t nodeIndex, uint32_t w, uint32_t h, uint32_t& y) const;
+  void AddLevel(uint32_t nodeIndex, const PackedRect& rect);
+
+  private:
+  uint32_t m_width, m_height;
+  uint64_t m_usedArea;
+  core::Vector<SkylineNode> m_skyline;
+};
+} // namespace res::atlas
+
+#endif // THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_ATLAS_SKYLINEPACKER_H_
@@ -0,0 +1,107 @@
+#ifndef THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_ATLAS_TEXTUREATLAS_H_
+#define THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_ATLAS_TEXTUREATLAS_H_
+
+#include "SkylinePacker.h"
+
+namespace render {
+class IRenderer;
+class ITexture;
+} // namespace render
+
+namespace res::atlas {
+enum class AtlasPageMode
+{
+  /// Each page is a separate 2D texture.
+  Textures,
+  /// Pages are layers of a single 2D array texture with MaxPages layers.
+  ArrayLayers
+};
+
+struct AtlasDescriptor
+{
+  uint32_t PageSize     = 2048;
+  /// Edge pixels are repeated this many times around each image to prevent bleeding.
+  uint32_t Gutter       = 2;
+  uint32_t MaxPages     = 8;
+  /// Pages are repacked when an insert fails and this fraction of packed area was freed.
+  float RepackThreshold = 0.25f;
+  AtlasPageMode PageMode = AtlasPageMode::Textures;
+};
+
+struct AtlasRegion
+{
+  uint32_t Page;
+  /// Pixel rectangle of the image itself, gutter excluded.
+  PackedRect Rect;
+  core::pod::Vec2<float> UvMin;
+  core::pod::Vec2<float> UvMax;
+};
+
+/// Packs small RGBA images into shared pages so they can be drawn with a single texture bind.
+/// Regions move when atlas is repacked, keep the id and query region again after inserts.
+class TextureAtlas
+{
+  public:
+  static constexpr uint32_t InvalidId = std::numeric_limits<uint32_t>::max();
+
+  TextureAtlas(const AtlasDescriptor& descriptor = AtlasDescriptor());
+  ~TextureAtlas();
+
+  /// Pixels are tightly packed RGBA8, returns InvalidId if image could not be placed.
+  uint32_t Insert(const uint8_t* rgba, uint32_t width, uint32_t height);
+  void Remove(uint32_t id);
+  const AtlasRegion* GetRegion(uint32_t id) const;
+
+  /// Re-inserts all live images, tallest first, reclaiming space of removed images.
+  void Repack();
+
+  /// Share of packed area that belongs to removed images.
+  float GetFragmentation() const;
+  /// Share of total page area used by live images, gutters included.
+  float GetOccupancy() const;
+
+  uint32_t GetPageCount() const
+  {
+    return m_pages.size();
+  }
+
+  const uint8_t* GetPagePixels(uint32_t page) const
+  {
+    return m_pages[page].Pixels.data();
+  }
+
+  /// Creates or updates gpu textures of pages modified since the last upload.
+  void Upload(render::IRenderer* renderer);
+  /// In ArrayLayers mode every page maps to the same texture.
+  render::ITexture* GetTexture(uint32_t page) const;
+
+  private:
+  struct Entry
+  {
+    AtlasRegion Region;
+    bool Alive;
+  };
+
+  struct Page
+  {
+    SkylinePacker Packer;
+    core::TByteArray Pixels;
+    bool Dirty;
+    core::UniquePtr<render::ITexture> Texture;
+  };
+
+  bool Place(Entry& entry, const uint8_t* rgba, bool allowNewPage);
+  void Blit(const AtlasRegion& region, const uint8_t* rgba);
+  uint64_t GetPaddedArea(const AtlasRegion& region) const;
+
+  private:
+  AtlasDescriptor m_descriptor;
+  core::Vector<Page> m_pages;
+  core::Vector<Entry> m_entries;
+  core::Vector<uint32_t> m_freeIds;
+  uint64_t m_liveArea;
+  core::UniquePtr<render::ITexture> m_arrayTexture;
+};
+} // namespace res::atlas
+
+#endif // THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_ATLAS_TEXTUREATLAS_H_
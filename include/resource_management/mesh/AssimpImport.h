@@ -3,12 +3,47 @@
 #include "render/RenderFwd.h"
 #include <render/IRenderer.h>
 
+namespace util {
+class ThreadPool;
+}
+
 namespace res::mesh {
 class AssimpImport
 {
   public:
   AssimpImport(io::IFileSystem* fs, render::IRenderer* renderer);
   core::UniquePtr<render::AnimatedMesh> LoadMesh(io::Path path);
+  /// Imports mesh from file contents that were already read, path is used for logging only.
+  core::UniquePtr<render::AnimatedMesh> LoadMesh(io::Path path, const core::TByteArray& contents);
+
+  /// Cpu only import, safe to call from any thread. Meshes cooked by engine_cook are read directly
+  /// and glb files go through the native GltfImport. Large static meshes are split into meshlets.
+  static core::UniquePtr<render::AnimatedMesh> ImportMesh(const io::Path& path, const void* data,
+                                                          size_t size);
+  static core::UniquePtr<render::AnimatedMesh> ImportMesh(const io::Path& path,
+                                                          const core::TByteArray& contents)
+  {
+    return ImportMesh(path, contents.data(), contents.size());
+  }
+
+  /// Always goes through assimp, for formats without a native loader and for comparisons.
+  static core::UniquePtr<render::AnimatedMesh> ImportWithAssimp(const io::Path& path,
+                                                                const void* data, size_t size);
+  static core::UniquePtr<render::AnimatedMesh> ImportWithAssimp(const io::Path& path,
+                                                                const core::TByteArray& contents)
+  {
+    return ImportWithAssimp(path, contents.data(), contents.size());
+  }
+  /// Moves imported data into a renderer mesh and uploads it, has to run on the render thread.
+  core::UniquePtr<render::AnimatedMesh> CreateGpuMesh(render::AnimatedMesh& cpuMesh);
+
+  /// Maps and imports every file on workers, each worker thread reuses one assimp importer.
+  /// Results are cpu only and in path order, failed imports are nullptr.
+  core::Vector<core::UniquePtr<render::AnimatedMesh>> ImportMeshes(
+      const core::Vector<io::Path>& paths, util::ThreadPool* workers);
+  /// Parallel import followed by upload on the calling thread.
+  core::Vector<core::UniquePtr<render::AnimatedMesh>> LoadMeshes(
+      const core::Vector<io::Path>& paths, util::ThreadPool* workers);
 
   private:
   io::IFileSystem* m_fileSystem;
@@ -0,0 +1,27 @@
+#ifndef THEPROJECT2_GLTFIMPORT_H
+#define THEPROJECT2_GLTFIMPORT_H
+#include "render/RenderFwd.h"
+
+namespace res::mesh {
+/// Native binary glTF 2.0 (.glb) reader, fills AnimatedMesh streams, armature and animations
+/// without building an intermediate scene. Accessors are read straight out of the binary chunk,
+/// tightly packed float streams are copied with a single memcpy.
+/// The first mesh is imported, its triangle primitives are merged into one vertex stream.
+/// Key times are stored in milliseconds at 1000 ticks per second, the same as the assimp path.
+class GltfImport
+{
+  public:
+  static bool IsGlb(const void* data, size_t size);
+  /// Data only has to stay valid during the call, it can point into a memory mapped file.
+  /// Buffers outside of the binary chunk, external files or data uris, are not read. With
+  /// 'unsupported' such files set it and return nullptr without an error, so the caller can use
+  /// another importer.
+  static core::UniquePtr<render::AnimatedMesh> ImportGlb(const void* data, size_t size,
+                                                         const core::String& name,
+                                                         bool* unsupported = nullptr);
+  /// Maps native file into memory and imports it, file contents are never copied as a whole.
+  static core::UniquePtr<render::AnimatedMesh> ImportGlbFile(const core::String& nativePath);
+};
+} // namespace res::mesh
+
+#endif // THEPROJECT2_GLTFIMPORT_H
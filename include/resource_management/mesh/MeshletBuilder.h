@@ -0,0 +1,30 @@
+#ifndef THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_MESH_MESHLETBUILDER_H_
+#define THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_MESH_MESHLETBUILDER_H_
+
+#include "render/Meshlet.h"
+
+namespace render {
+class BaseMesh;
+}
+
+namespace res::mesh {
+struct MeshletLimits
+{
+  uint32_t MaxVertices  = 64;
+  uint32_t MaxTriangles = 124;
+  /// Smaller meshes are left whole, culling them per cluster costs more than it saves.
+  uint32_t MinMeshTriangles = 1024;
+};
+
+/// Splits a mesh into meshlets at import time. Triangles are grown greedily from their neighbours,
+/// preferring the ones that add the fewest new vertices, so clusters stay compact for culling.
+class MeshletBuilder
+{
+  public:
+  /// Reorders triangles of mesh.IndexBuffer so each meshlet is a contiguous range and fills
+  /// mesh.Meshlets. Vertex streams are untouched. Returns false if the mesh was left unclustered.
+  static bool Build(render::BaseMesh& mesh, const MeshletLimits& limits = {});
+};
+} // namespace res::mesh
+
+#endif // THEPROJECT2_INCLUDE_RESOURCE_MANAGEMENT_MESH_MESHLETBUILDER_H_
@@ -0,0 +1,25 @@
+#ifndef THEPROJECT2_INCLUDE_UTIL_HASH_H_
+#define THEPROJECT2_INCLUDE_UTIL_HASH_H_
+
+namespace util {
+constexpr uint64_t Fnv1aOffsetBasis = 0xcbf29ce484222325ull;
+
+/// 64 bit FNV-1a, pass previous result as seed to hash data in chunks.
+inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = Fnv1aOffsetBasis)
+{
+  auto bytes = static_cast<const uint8_t*>(data);
+
+  for (size_t i = 0; i < size; i++) {
+    seed = (seed ^ bytes[i]) * 0x100000001b3ull;
+  }
+
+  return seed;
+}
+
+inline uint64_t HashBytes(const core::TByteArray& data, uint64_t seed = Fnv1aOffsetBasis)
+{
+  return HashBytes(data.data(), data.size(), seed);
+}
+} // namespace util
+
+#endif // THEPROJECT2_INCLUDE_UTIL_HASH_H_
@@ -0,0 +1,77 @@
+#ifndef THEPROJECT2_INCLUDE_UTIL_JSON_H_
+#define THEPROJECT2_INCLUDE_UTIL_JSON_H_
+
+namespace util {
+/// Minimal read only json document, enough for asset metadata such as glTF.
+/// Missing keys and out of range indices return a shared null value, so lookups can be chained.
+class JsonValue
+{
+  public:
+  enum class Type
+  {
+    Null,
+    Bool,
+    Number,
+    String,
+    Array,
+    Object
+  };
+
+  JsonValue();
+
+  /// Returns nothing on malformed input, error is logged with its offset.
+  static core::Optional<JsonValue> Parse(const char* text, size_t size);
+
+  Type GetType() const
+  {
+    return m_type;
+  }
+
+  bool IsNull() const
+  {
+    return m_type == Type::Null;
+  }
+
+  bool Has(const char* key) const;
+  const JsonValue& operator[](const char* key) const;
+  const JsonValue& At(size_t index) const;
+
+  /// Any integer type, negative indices return null.
+  template <class TIndex, class = std::enable_if_t<std::is_integral<TIndex>::value>>
+  const JsonValue& operator[](TIndex index) const
+  {
+    return At(index < 0 ? std::numeric_limits<size_t>::max() : (size_t)index);
+  }
+
+  /// Element count of arrays and objects, 0 for everything else.
+  size_t Size() const;
+
+  double AsNumber(double defaultValue = 0) const;
+  int32_t AsInt(int32_t defaultValue = -1) const;
+  bool AsBool(bool defaultValue = false) const;
+  const core::String& AsString() const;
+
+  const core::Vector<JsonValue>& GetElements() const
+  {
+    return m_elements;
+  }
+
+  const core::Vector<core::String>& GetKeys() const
+  {
+    return m_keys;
+  }
+
+  private:
+  friend class JsonParser;
+
+  Type m_type;
+  bool m_bool;
+  double m_number;
+  core::String m_string;
+  /// Array elements or object values, object keys are stored in the same order in m_keys.
+  core::Vector<JsonValue> m_elements;
+  core::Vector<core::String> m_keys;
+};
+} // namespace util
+
+#endif // THEPROJECT2_INCLUDE_UTIL_JSON_H_
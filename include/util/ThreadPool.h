@@ -0,0 +1,49 @@
+#ifndef THEPROJECT2_INCLUDE_UTIL_THREADPOOL_H_
+#define THEPROJECT2_INCLUDE_UTIL_THREADPOOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace util {
+/// Fixed size pool of worker threads executing tasks in submission order.
+/// Tasks must not touch the GL context, all gpu work stays on the thread that owns it.
+class ThreadPool
+{
+  public:
+  explicit ThreadPool(uint32_t threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  template <class TFunc> auto Submit(TFunc&& func) -> std::future<decltype(func())>
+  {
+    using TResult = decltype(func());
+    auto task = core::MakeShared<std::packaged_task<TResult()>>(std::forward<TFunc>(func));
+    auto future = task->get_future();
+    Enqueue([task]() { (*task)(); });
+    return future;
+  }
+
+  uint32_t GetThreadCount() const
+  {
+    return m_threads.size();
+  }
+
+  private:
+  void Enqueue(std::function<void()> task);
+  void WorkerLoop();
+
+  private:
+  core::Vector<std::thread> m_threads;
+  core::Queue<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_stopping;
+};
+} // namespace util
+
+#endif // THEPROJECT2_INCLUDE_UTIL_THREADPOOL_H_
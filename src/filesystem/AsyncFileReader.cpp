@@ -0,0 +1,474 @@
+#include "filesystem/AsyncFileReader.h"
+#include "filesystem/BlockCompression.h"
+#include "filesystem/IFileSystem.h"
+#include "util/ThreadPool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace io {
+struct AsyncRead
+{
+  AsyncReadRequest Request;
+  std::intmax_t Result = -1;
+  int Fd               = -1;
+#ifdef __linux__
+  iovec Vec;
+#endif
+};
+
+class IAsyncReadBackend
+{
+  public:
+  virtual ~IAsyncReadBackend()
+  {
+  }
+  /// Takes the read unless this backend is full, then 'read' is left untouched.
+  /// Fd of the read is already open for uncompressed loose files and -1 for anything else.
+  virtual bool Start(core::UniquePtr<AsyncRead>& read) = 0;
+  /// Moves finished reads into 'done', with 'wait' blocks until at least one finished.
+  virtual void Reap(core::Vector<core::UniquePtr<AsyncRead>>& done, bool wait) = 0;
+  virtual uint32_t GetInFlight() const = 0;
+};
+
+namespace {
+int OpenNative(IFileSystem* fileSystem, const Path& path)
+{
+  auto nativePath = fileSystem->GetNativePath(path);
+
+  if (nativePath.empty())
+    return -1;
+
+#ifdef _WIN32
+  return _open(nativePath.c_str(), _O_RDONLY | _O_BINARY);
+#else
+  int fd = open(nativePath.c_str(), O_RDONLY | O_CLOEXEC);
+
+  // offsets of block compressed files are into the decompressed contents, only the file system
+  // can read those
+  compression::Header header;
+  if (fd >= 0 && pread(fd, &header, sizeof(header), 0) == sizeof(header) &&
+      compression::IsCompressed(&header, sizeof(header))) {
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+#endif
+}
+
+void CloseNative(int fd)
+{
+#ifdef _WIN32
+  _close(fd);
+#else
+  close(fd);
+#endif
+}
+
+/// Blocking read of one request, positional for native files, through the file system otherwise.
+std::intmax_t ReadBlocking(IFileSystem* fileSystem, AsyncRead& read)
+{
+  auto& request = read.Request;
+
+#ifndef _WIN32
+  if (read.Fd >= 0) {
+    uint64_t total = 0;
+
+    while (total < request.Length) {
+      auto bytes = pread(read.Fd, (uint8_t*)request.Destination + total, request.Length - total,
+                         request.Offset + total);
+      if (bytes < 0)
+        return -1;
+      if (bytes == 0)
+        break;
+      total += bytes;
+    }
+
+    return total;
+  }
+#endif
+
+  auto file = fileSystem->OpenRead(request.File);
+
+  if (!file || !file->Seek(request.Offset))
+    return -1;
+
+  return file->Read(request.Destination, request.Length);
+}
+
+class ThreadPoolBackend : public IAsyncReadBackend
+{
+  public:
+  ThreadPoolBackend(IFileSystem* fileSystem, uint32_t threadCount)
+      : m_fileSystem(fileSystem)
+      , m_inFlight(0)
+      , m_workers(threadCount)
+  {
+  }
+
+  ~ThreadPoolBackend()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]() { return m_inFlight == m_finished.size(); });
+  }
+
+  bool Start(core::UniquePtr<AsyncRead>& read) override
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_inFlight++;
+    }
+
+    // shared pointer because the pool only accepts copyable tasks
+    core::SharedPtr<AsyncRead> task(read.release());
+
+    m_workers.Submit([this, task]() {
+      task->Result = ReadBlocking(m_fileSystem, *task);
+
+      if (task->Fd >= 0)
+        CloseNative(task->Fd);
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_finished.push_back(core::MakeUnique<AsyncRead>(core::Move(*task)));
+      m_condition.notify_all();
+    });
+
+    return true;
+  }
+
+  void Reap(core::Vector<core::UniquePtr<AsyncRead>>& done, bool wait) override
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (wait)
+      m_condition.wait(lock, [this]() { return !m_finished.empty() || m_inFlight == 0; });
+
+    m_inFlight -= m_finished.size();
+
+    for (auto& read : m_finished) {
+      done.push_back(core::Move(read));
+    }
+    m_finished.clear();
+  }
+
+  uint32_t GetInFlight() const override
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_inFlight;
+  }
+
+  private:
+  IFileSystem* m_fileSystem;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  uint32_t m_inFlight;
+  core::Vector<core::UniquePtr<AsyncRead>> m_finished;
+  /// Declared last so workers are joined before the state they use is destroyed.
+  util::ThreadPool m_workers;
+};
+
+#ifdef __linux__
+/// io_uring through raw system calls, liburing is not required. Reads are queued in the
+/// submission ring by Start and handed to the kernel in one batch on the next Reap.
+class IoUringBackend : public IAsyncReadBackend
+{
+  public:
+  static core::UniquePtr<IoUringBackend> Create(IFileSystem* fileSystem, uint32_t entries)
+  {
+    core::UniquePtr<IoUringBackend> backend(new IoUringBackend(fileSystem));
+    return backend->Init(entries) ? core::Move(backend) : nullptr;
+  }
+
+  ~IoUringBackend()
+  {
+    core::Vector<core::UniquePtr<AsyncRead>> done;
+    while (m_inFlight > 0) {
+      Reap(done, true);
+    }
+
+    if (m_sqes)
+      munmap(m_sqes, m_sqesSize);
+    if (m_cqRing && m_cqRing != m_sqRing)
+      munmap(m_cqRing, m_cqRingSize);
+    if (m_sqRing)
+      munmap(m_sqRing, m_sqRingSize);
+    if (m_ringFd >= 0)
+      close(m_ringFd);
+  }
+
+  bool Start(core::UniquePtr<AsyncRead>& read) override
+  {
+    auto head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    auto tail = *m_sqTail;
+
+    // without a native file the worker threads go through the file system instead
+    if (read->Fd < 0 || tail - head >= m_sqEntries || m_inFlight >= m_cqEntries)
+      return false;
+
+    read->Vec.iov_base = read->Request.Destination;
+    read->Vec.iov_len  = read->Request.Length;
+
+    auto index = tail & m_sqMask;
+    auto& sqe  = m_sqes[index];
+    memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode    = IORING_OP_READV;
+    sqe.fd        = read->Fd;
+    sqe.off       = read->Request.Offset;
+    sqe.addr      = (uint64_t)&read->Vec;
+    sqe.len       = 1;
+    sqe.user_data = (uint64_t)read.release();
+
+    m_sqArray[index] = index;
+    __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+    m_unsubmitted++;
+    m_inFlight++;
+    return true;
+  }
+
+  void Reap(core::Vector<core::UniquePtr<AsyncRead>>& done, bool wait) override
+  {
+    bool waitForEvents = wait && m_inFlight > 0 && !HasCompletions();
+
+    if (m_unsubmitted > 0 || waitForEvents) {
+      auto submitted = syscall(__NR_io_uring_enter, m_ringFd, m_unsubmitted, waitForEvents ? 1 : 0,
+                               waitForEvents ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+      if (submitted > 0)
+        m_unsubmitted -= submitted;
+    }
+
+    auto head = *m_cqHead;
+    auto tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+
+    for (; head != tail; head++) {
+      auto& cqe = m_cqes[head & m_cqMask];
+      core::UniquePtr<AsyncRead> read((AsyncRead*)cqe.user_data);
+
+      // regular files only come back short at the end, the rest is read synchronously
+      read->Result = cqe.res;
+      if (cqe.res > 0 && (uint64_t)cqe.res < read->Request.Length)
+        read->Result = FinishShortRead(*read, cqe.res);
+
+      CloseNative(read->Fd);
+      done.push_back(core::Move(read));
+      m_inFlight--;
+    }
+
+    __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+  }
+
+  uint32_t GetInFlight() const override
+  {
+    return m_inFlight;
+  }
+
+  private:
+  IoUringBackend(IFileSystem* fileSystem)
+      : m_fileSystem(fileSystem)
+      , m_ringFd(-1)
+      , m_sqRing(nullptr)
+      , m_cqRing(nullptr)
+      , m_sqes(nullptr)
+      , m_inFlight(0)
+      , m_unsubmitted(0)
+  {
+  }
+
+  bool Init(uint32_t entries)
+  {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    m_ringFd = syscall(__NR_io_uring_setup, entries, &params);
+    if (m_ringFd < 0)
+      return false;
+
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single  = params.features & IORING_FEAT_SINGLE_MMAP;
+
+    if (single)
+      m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+    m_sqRing = Map(m_sqRingSize, IORING_OFF_SQ_RING);
+    m_cqRing = single ? m_sqRing : Map(m_cqRingSize, IORING_OFF_CQ_RING);
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes     = (io_uring_sqe*)Map(m_sqesSize, IORING_OFF_SQES);
+
+    if (!m_sqRing || !m_cqRing || !m_sqes)
+      return false;
+
+    auto sq     = (uint8_t*)m_sqRing;
+    auto cq     = (uint8_t*)m_cqRing;
+    m_sqHead    = (uint32_t*)(sq + params.sq_off.head);
+    m_sqTail    = (uint32_t*)(sq + params.sq_off.tail);
+    m_sqMask    = *(uint32_t*)(sq + params.sq_off.ring_mask);
+    m_sqArray   = (uint32_t*)(sq + params.sq_off.array);
+    m_sqEntries = params.sq_entries;
+    m_cqHead    = (uint32_t*)(cq + params.cq_off.head);
+    m_cqTail    = (uint32_t*)(cq + params.cq_off.tail);
+    m_cqMask    = *(uint32_t*)(cq + params.cq_off.ring_mask);
+    m_cqes      = (io_uring_cqe*)(cq + params.cq_off.cqes);
+    m_cqEntries = params.cq_entries;
+    return true;
+  }
+
+  void* Map(size_t size, uint64_t offset)
+  {
+    auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd,
+                     offset);
+    return data == MAP_FAILED ? nullptr : data;
+  }
+
+  bool HasCompletions() const
+  {
+    return *m_cqHead != __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+  }
+
+  std::intmax_t FinishShortRead(AsyncRead& read, std::intmax_t bytesRead)
+  {
+    AsyncRead rest;
+    rest.Fd                  = read.Fd;
+    rest.Request.Offset      = read.Request.Offset + bytesRead;
+    rest.Request.Length      = read.Request.Length - bytesRead;
+    rest.Request.Destination = (uint8_t*)read.Request.Destination + bytesRead;
+
+    auto restBytes = ReadBlocking(m_fileSystem, rest);
+    return restBytes < 0 ? -1 : bytesRead + restBytes;
+  }
+
+  private:
+  IFileSystem* m_fileSystem;
+  int m_ringFd;
+  void* m_sqRing;
+  void* m_cqRing;
+  io_uring_sqe* m_sqes;
+  size_t m_sqRingSize, m_cqRingSize, m_sqesSize;
+  uint32_t *m_sqHead, *m_sqTail, *m_sqArray, m_sqMask, m_sqEntries;
+  uint32_t *m_cqHead, *m_cqTail, m_cqMask, m_cqEntries;
+  io_uring_cqe* m_cqes;
+  uint32_t m_inFlight;
+  uint32_t m_unsubmitted;
+};
+#endif
+} // namespace
+
+AsyncFileReader::AsyncFileReader(IFileSystem* fileSystem, uint32_t queueDepth, bool allowIoUring)
+    : m_fileSystem(fileSystem)
+    , m_queueDepth(std::max(1u, queueDepth))
+{
+#ifdef __linux__
+  if (allowIoUring) {
+    m_uring = IoUringBackend::Create(fileSystem, m_queueDepth);
+
+    if (!m_uring)
+      elog::LogInfo("io_uring is not available, async reads use worker threads");
+  }
+#endif
+
+  // blocking workers, more threads than this only add contention on the disk
+  m_threads = core::MakeUnique<ThreadPoolBackend>(fileSystem, std::min(m_queueDepth, 16u));
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+}
+
+void AsyncFileReader::Submit(AsyncReadRequest request)
+{
+  m_queued.push(core::Move(request));
+  StartQueued();
+}
+
+void AsyncFileReader::Submit(core::Vector<AsyncReadRequest> requests)
+{
+  for (auto& request : requests) {
+    m_queued.push(core::Move(request));
+  }
+  StartQueued();
+}
+
+uint32_t AsyncFileReader::Poll()
+{
+  return Complete(false);
+}
+
+void AsyncFileReader::WaitAll()
+{
+  while (GetPendingCount() > 0) {
+    Complete(true);
+  }
+}
+
+uint32_t AsyncFileReader::GetPendingCount() const
+{
+  // finished reads count until their callback ran
+  return m_queued.size() + m_done.size() + m_threads->GetInFlight() +
+         (m_uring ? m_uring->GetInFlight() : 0);
+}
+
+AsyncReadBackend AsyncFileReader::GetBackend() const
+{
+  return m_uring ? AsyncReadBackend::IoUring : AsyncReadBackend::ThreadPool;
+}
+
+void AsyncFileReader::StartQueued()
+{
+  auto inFlight = m_threads->GetInFlight() + (m_uring ? m_uring->GetInFlight() : 0);
+
+  for (; inFlight < m_queueDepth && !m_queued.empty(); inFlight++) {
+    auto read     = core::MakeUnique<AsyncRead>();
+    read->Request = core::Move(m_queued.front());
+    read->Fd      = OpenNative(m_fileSystem, read->Request.File);
+    m_queued.pop();
+
+    if (!m_uring || !m_uring->Start(read))
+      m_threads->Start(read);
+  }
+
+  // hands the batch to the kernel right away instead of on the next poll
+  if (m_uring)
+    m_uring->Reap(m_done, false);
+}
+
+uint32_t AsyncFileReader::Complete(bool wait)
+{
+  if (m_uring)
+    m_uring->Reap(m_done, false);
+  m_threads->Reap(m_done, false);
+
+  if (wait && m_done.empty()) {
+    if (m_uring && m_uring->GetInFlight() > 0)
+      m_uring->Reap(m_done, true);
+    else
+      m_threads->Reap(m_done, true);
+  }
+
+  // callbacks may submit more reads, so work on a detached batch
+  auto done = core::Move(m_done);
+  m_done.clear();
+
+  for (auto& read : done) {
+    if (read->Request.OnComplete)
+      read->Request.OnComplete(read->Result < 0 ? -1 : read->Result);
+  }
+
+  StartQueued();
+  return done.size();
+}
+} // namespace io
@@ -0,0 +1,237 @@
+#include "filesystem/BlockCompressedReader.h"
+#include "filesystem/BlockCompression.h"
+#include "util/ThreadPool.h"
+#include <cstring>
+
+namespace io {
+namespace {
+/// Fills 'block' from its bytes at 'offset' in 'compressed', blocks that did not shrink are raw.
+bool Decode(const core::TByteArray& compressed, uint64_t offset, uint64_t compressedSize,
+            core::TByteArray& block)
+{
+  if (compressedSize == block.size()) {
+    memcpy(block.data(), compressed.data() + offset, block.size());
+    return true;
+  }
+
+  return compression::DecompressBlock(compressed.data() + offset, compressedSize, block.data(),
+                                      block.size());
+}
+} // namespace
+
+core::UniquePtr<BlockCompressedReader> BlockCompressedReader::Open(
+    core::UniquePtr<IFileReader> reader, core::SharedPtr<util::ThreadPool> pool, uint32_t window)
+{
+  if (!reader)
+    return nullptr;
+
+  auto start = reader->GetPosition();
+  compression::Header header;
+
+  if (reader->Read(&header, sizeof(header)) != sizeof(header) ||
+      !compression::IsCompressed(&header, sizeof(header)) || header.BlockSize == 0 ||
+      header.BlockSize > compression::MaxBlockSize ||
+      header.BlockCount != (header.UncompressedSize + header.BlockSize - 1) / header.BlockSize) {
+    return nullptr;
+  }
+
+  // a corrupt block count must not size the offset table beyond what the file holds
+  auto tableSize = ((uint64_t)header.BlockCount + 1) * sizeof(uint64_t);
+  if (sizeof(header) + tableSize > (uint64_t)(reader->GetLength() - start)) {
+    elog::LogError("Block compressed file is shorter than its offset table");
+    return nullptr;
+  }
+
+  core::UniquePtr<BlockCompressedReader> result(
+      new BlockCompressedReader(core::Move(reader), core::Move(pool), window));
+  result->m_blockSize = header.BlockSize;
+  result->m_length    = header.UncompressedSize;
+  result->m_offsets.resize(header.BlockCount + 1);
+
+  if (result->m_reader->Read(result->m_offsets.data(), tableSize) != (std::intmax_t)tableSize)
+    return nullptr;
+
+  // offsets are relative to the header and each block is at most its own size
+  auto& offsets = result->m_offsets;
+  bool valid    = offsets[0] == sizeof(header) + tableSize &&
+               start + offsets.back() <= (uint64_t)result->m_reader->GetLength();
+
+  for (uint32_t i = 0; valid && i < header.BlockCount; i++) {
+    auto blockLength = std::min<uint64_t>(header.BlockSize,
+                                          header.UncompressedSize - (uint64_t)i * header.BlockSize);
+    valid = offsets[i] <= offsets[i + 1] && offsets[i + 1] - offsets[i] <= blockLength;
+  }
+
+  if (!valid) {
+    elog::LogError("Block compressed file has a corrupt offset table");
+    return nullptr;
+  }
+
+  for (auto& offset : offsets) {
+    offset += start;
+  }
+
+  result->m_readerPosition = start + sizeof(header) + tableSize;
+  return result;
+}
+
+BlockCompressedReader::BlockCompressedReader(core::UniquePtr<IFileReader> reader,
+                                             core::SharedPtr<util::ThreadPool> pool,
+                                             uint32_t window)
+    : m_reader(core::Move(reader))
+    , m_pool(core::Move(pool))
+    , m_window(std::max<uint32_t>(window, 1))
+    , m_blockSize(0)
+    , m_length(0)
+    , m_position(0)
+    , m_readerPosition(0)
+    , m_blockIndex(~0ull)
+{
+}
+
+BlockCompressedReader::~BlockCompressedReader()
+{
+  // queued decompressions own their buffers, nothing to wait for
+}
+
+std::intmax_t BlockCompressedReader::GetLength() const
+{
+  return m_length;
+}
+
+std::intmax_t BlockCompressedReader::GetPosition() const
+{
+  return m_position;
+}
+
+template <class T> std::intmax_t BlockCompressedReader::ReadInto(T& buffer, std::uintmax_t size)
+{
+  buffer.resize(std::min<std::uintmax_t>(size, m_length - m_position));
+
+  if (Read((void*)buffer.data(), buffer.size()) == (std::intmax_t)buffer.size())
+    return buffer.size();
+
+  // Failed to read, buffer should be empty.
+  T().swap(buffer);
+  return -1;
+}
+
+std::intmax_t BlockCompressedReader::Read(core::TByteArray& array, std::uintmax_t size)
+{
+  return ReadInto(array, size);
+}
+
+std::intmax_t BlockCompressedReader::Read(std::string& string, std::uintmax_t size)
+{
+  return ReadInto(string, size);
+}
+
+std::intmax_t BlockCompressedReader::Read(void* buffer, std::uintmax_t size)
+{
+  size = std::min<std::uintmax_t>(size, m_length - m_position);
+  auto destination      = (uint8_t*)buffer;
+  std::uintmax_t copied = 0;
+
+  while (copied < size) {
+    auto index = m_position / m_blockSize;
+
+    if (!LoadBlock(index))
+      return -1;
+
+    auto blockPosition = m_position - index * m_blockSize;
+    auto count         = std::min<std::uintmax_t>(m_block->size() - blockPosition, size - copied);
+    memcpy(destination + copied, m_block->data() + blockPosition, count);
+
+    copied += count;
+    m_position += count;
+  }
+
+  return copied;
+}
+
+bool BlockCompressedReader::Seek(std::uintmax_t position)
+{
+  // physfs refuses seeking past the end, keep the same behaviour
+  if (position > m_length)
+    return false;
+
+  m_position = position;
+  return true;
+}
+
+bool BlockCompressedReader::LoadBlock(uint64_t index)
+{
+  if (m_block && m_blockIndex == index)
+    return true;
+
+  // the first block or the one after the current one, starts out as ~0
+  bool sequential = m_pool && m_blockIndex + 1 == index;
+  m_blockIndex    = index;
+  m_block.reset();
+
+  while (!m_pending.empty() && m_pending.front().Index < index) {
+    m_pending.pop();
+  }
+
+  // random access drops the read-ahead, the blocks decompressing finish on their own
+  if (!m_pending.empty() && m_pending.front().Index != index)
+    core::Queue<PendingBlock>().swap(m_pending);
+
+  if (m_pending.empty())
+    Schedule(index, sequential ? m_window : 1);
+
+  auto pending = core::Move(m_pending.front());
+  m_pending.pop();
+
+  // keep the window full with reads of at least half its size
+  if (sequential && m_pending.size() < m_window / 2) {
+    auto next = m_pending.empty() ? index + 1 : m_pending.back().Index + 1;
+    Schedule(next, m_window - m_pending.size());
+  }
+
+  if (!pending.Done.get()) {
+    elog::LogError(core::string::format("Failed to decompress block {}", index));
+    return false;
+  }
+
+  m_block = core::Move(pending.Data);
+  return true;
+}
+
+void BlockCompressedReader::Schedule(uint64_t first, uint64_t count)
+{
+  auto blockCount = m_offsets.size() - 1;
+  count           = std::min<uint64_t>(count, blockCount - std::min<uint64_t>(first, blockCount));
+
+  if (count == 0)
+    return;
+
+  auto start      = m_offsets[first];
+  auto compressed = core::MakeShared<core::TByteArray>(m_offsets[first + count] - start);
+
+  bool readOk = (m_readerPosition == start || m_reader->Seek(start)) &&
+                m_reader->Read(compressed->data(), compressed->size()) ==
+                    (std::intmax_t)compressed->size();
+  m_readerPosition = readOk ? start + compressed->size() : ~0ull;
+
+  for (uint64_t i = first; i < first + count; i++) {
+    auto data = core::MakeShared<core::TByteArray>(
+        std::min<uint64_t>(m_blockSize, m_length - i * m_blockSize));
+    auto offset = m_offsets[i] - start;
+    auto size   = m_offsets[i + 1] - m_offsets[i];
+
+    auto decode = [compressed, data, offset, size, readOk]() {
+      return readOk && Decode(*compressed, offset, size, *data);
+    };
+
+    if (m_pool && count > 1) {
+      m_pending.push({ i, data, m_pool->Submit(decode) });
+    }
+    else {
+      std::promise<bool> done;
+      done.set_value(decode());
+      m_pending.push({ i, data, done.get_future() });
+    }
+  }
+}
+} // namespace io
@@ -0,0 +1,243 @@
+#include "filesystem/BlockCompression.h"
+#include <cstring>
+
+namespace io::compression {
+namespace {
+constexpr char Magic[4]     = { 'E', 'B', 'L', 'K' };
+constexpr uint32_t MinMatch = 4;
+constexpr uint32_t HashBits = 14;
+/// Marks an empty hash slot.
+constexpr uint32_t NoPosition = ~0u;
+
+uint32_t Read32(const uint8_t* data)
+{
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint32_t HashOf(uint32_t value)
+{
+  return (value * 2654435761u) >> (32 - HashBits);
+}
+
+/// Writes 'length' minus what fit into the token nibble as a run of 255s and a remainder.
+bool WriteLength(size_t length, uint8_t*& out, const uint8_t* end)
+{
+  while (length >= 255) {
+    if (out == end)
+      return false;
+    *out++ = 255;
+    length -= 255;
+  }
+
+  if (out == end)
+    return false;
+  *out++ = (uint8_t)length;
+  return true;
+}
+
+bool ReadLength(size_t& length, const uint8_t*& in, const uint8_t* end)
+{
+  uint8_t byte;
+  do {
+    if (in == end)
+      return false;
+    byte = *in++;
+    length += byte;
+  } while (byte == 255);
+
+  return true;
+}
+
+/// Sequence format: a token with literal count and match length minus MinMatch in its nibbles,
+/// 15 meaning more length bytes follow, then the literals, then a 16 bit match offset. The last
+/// sequence has literals only.
+bool WriteSequence(const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength,
+                   uint8_t*& out, const uint8_t* end)
+{
+  if (out == end)
+    return false;
+
+  auto token = out++;
+  *token     = (uint8_t)(std::min<size_t>(literalCount, 15) << 4);
+
+  if (literalCount >= 15 && !WriteLength(literalCount - 15, out, end))
+    return false;
+
+  if ((size_t)(end - out) < literalCount)
+    return false;
+  memcpy(out, literals, literalCount);
+  out += literalCount;
+
+  if (matchLength == 0)
+    return true;
+
+  if (end - out < 2)
+    return false;
+
+  uint16_t offset16 = (uint16_t)offset;
+  memcpy(out, &offset16, sizeof(offset16));
+  out += sizeof(offset16);
+
+  auto extra = matchLength - MinMatch;
+  *token |= (uint8_t)std::min<size_t>(extra, 15);
+  return extra < 15 || WriteLength(extra - 15, out, end);
+}
+} // namespace
+
+bool IsCompressed(const void* data, size_t size)
+{
+  if (size < sizeof(Header))
+    return false;
+
+  Header header;
+  memcpy(&header, data, sizeof(header));
+  return memcmp(header.Magic, Magic, sizeof(Magic)) == 0 && header.Version == FormatVersion;
+}
+
+void CompressFile(const uint8_t* data, size_t size, core::TByteArray& out, uint32_t blockSize)
+{
+  blockSize = std::max<uint32_t>(1, std::min(blockSize, MaxBlockSize));
+
+  Header header;
+  memcpy(header.Magic, Magic, sizeof(Magic));
+  header.Version          = FormatVersion;
+  header.BlockSize        = blockSize;
+  header.BlockCount       = (uint32_t)((size + blockSize - 1) / blockSize);
+  header.UncompressedSize = size;
+
+  core::Vector<uint64_t> offsets(header.BlockCount + 1);
+  auto tableSize = offsets.size() * sizeof(uint64_t);
+  auto start     = out.size();
+
+  // worst case is every block stored raw
+  out.resize(start + sizeof(header) + tableSize + size);
+  auto position = sizeof(header) + tableSize;
+
+  for (uint32_t i = 0; i < header.BlockCount; i++) {
+    auto blockStart  = (size_t)i * blockSize;
+    auto blockLength = std::min<size_t>(blockSize, size - blockStart);
+    auto destination = out.data() + start + position;
+
+    // only worth it if it saves something, otherwise the block is stored as is
+    auto compressed = CompressBlock(data + blockStart, blockLength, destination, blockLength - 1);
+    if (compressed == 0) {
+      memcpy(destination, data + blockStart, blockLength);
+      compressed = blockLength;
+    }
+
+    offsets[i] = position;
+    position += compressed;
+  }
+
+  offsets[header.BlockCount] = position;
+  memcpy(out.data() + start, &header, sizeof(header));
+  memcpy(out.data() + start + sizeof(header), offsets.data(), tableSize);
+  out.resize(start + position);
+}
+
+size_t CompressBlock(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity)
+{
+  core::Vector<uint32_t> table(1u << HashBits, NoPosition);
+  auto out       = destination;
+  auto end       = destination + capacity;
+  size_t anchor  = 0;
+  size_t current = 0;
+
+  while (current + MinMatch <= size) {
+    auto hash      = HashOf(Read32(source + current));
+    auto candidate = table[hash];
+    table[hash]    = (uint32_t)current;
+
+    if (candidate == NoPosition || current - candidate > 0xFFFF ||
+        Read32(source + candidate) != Read32(source + current)) {
+      // skip faster through data that does not compress
+      current += 1 + ((current - anchor) >> 6);
+      continue;
+    }
+
+    auto length = MinMatch;
+    while (current + length < size && source[candidate + length] == source[current + length]) {
+      length++;
+    }
+
+    if (!WriteSequence(source + anchor, current - anchor, current - candidate, length, out, end))
+      return 0;
+
+    current += length;
+    anchor = current;
+  }
+
+  if (!WriteSequence(source + anchor, size - anchor, 0, 0, out, end))
+    return 0;
+
+  return out - destination;
+}
+
+bool DecompressBlock(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t size)
+{
+  auto in     = source;
+  auto inEnd  = source + sourceSize;
+  auto out    = destination;
+  auto outEnd = destination + size;
+
+  while (in < inEnd) {
+    auto token          = *in++;
+    size_t literalCount = token >> 4;
+
+    if (literalCount == 15 && !ReadLength(literalCount, in, inEnd))
+      return false;
+
+    if ((size_t)(inEnd - in) < literalCount || (size_t)(outEnd - out) < literalCount)
+      return false;
+
+    // short runs dominate, a fixed size copy is much cheaper where there is room for it
+    if (literalCount <= 16 && inEnd - in >= 16 && outEnd - out >= 16)
+      memcpy(out, in, 16);
+    else
+      memcpy(out, in, literalCount);
+    in += literalCount;
+    out += literalCount;
+
+    if (in == inEnd)
+      break;
+
+    if (inEnd - in < 2)
+      return false;
+
+    uint16_t offset;
+    memcpy(&offset, in, sizeof(offset));
+    in += sizeof(offset);
+
+    size_t length = token & 15;
+    if (length == 15 && !ReadLength(length, in, inEnd))
+      return false;
+    length += MinMatch;
+
+    if (offset == 0 || offset > out - destination || (size_t)(outEnd - out) < length)
+      return false;
+
+    auto match = out - offset;
+    if (offset >= 8 && (size_t)(outEnd - out) >= length + 8) {
+      // 8 byte steps never read what they write, may overshoot into space written later
+      for (size_t i = 0; i < length; i += 8) {
+        memcpy(out + i, match + i, 8);
+      }
+      out += length;
+    }
+    else if (offset >= length) {
+      memcpy(out, match, length);
+      out += length;
+    }
+    else {
+      // overlapping copies repeat the last 'offset' bytes
+      for (size_t i = 0; i < length; i++) {
+        *out++ = match[i];
+      }
+    }
+  }
+
+  return out == outEnd;
+}
+} // namespace io::compression
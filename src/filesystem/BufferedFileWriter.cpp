@@ -0,0 +1,142 @@
+#include "filesystem/BufferedFileWriter.h"
+#include <algorithm>
+
+namespace io {
+BufferedFileWriter::BufferedFileWriter(core::UniquePtr<IFileWriter> writer, size_t bufferSize)
+    : m_writer(core::Move(writer))
+    , m_bufferSize(std::max<size_t>(bufferSize, 1))
+    , m_position(m_writer ? m_writer->GetPosition() : 0)
+    , m_pending(false)
+    , m_stop(false)
+    , m_failed(false)
+{
+  m_front.reserve(m_bufferSize);
+  m_back.reserve(m_bufferSize);
+  m_thread = std::thread([this]() { Run(); });
+}
+
+BufferedFileWriter::~BufferedFileWriter()
+{
+  Submit();
+  WaitIdle();
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_one();
+  m_thread.join();
+}
+
+std::intmax_t BufferedFileWriter::GetPosition() const
+{
+  return m_position;
+}
+
+template <class T> std::intmax_t BufferedFileWriter::Append(const T& buffer, std::uintmax_t size)
+{
+  if (!m_writer || m_failed)
+    return -1;
+
+  std::uintmax_t writeSize = size > buffer.size() ? buffer.size() : size;
+  auto data                = (const uint8_t*)buffer.data();
+  auto remaining           = writeSize;
+
+  // writes larger than the buffer go out in buffer sized pieces to keep memory bounded
+  while (remaining > 0) {
+    if (m_front.size() == m_bufferSize)
+      Submit();
+
+    auto chunk = std::min<std::uintmax_t>(remaining, m_bufferSize - m_front.size());
+    m_front.insert(m_front.end(), data, data + chunk);
+    data += chunk;
+    remaining -= chunk;
+  }
+
+  m_position += writeSize;
+  return writeSize;
+}
+
+std::intmax_t BufferedFileWriter::Write(const core::TByteArray& array, std::intmax_t size)
+{
+  return Append(array, size);
+}
+
+std::intmax_t BufferedFileWriter::Write(const std::string& string, std::uintmax_t size)
+{
+  return Append(string, size);
+}
+
+bool BufferedFileWriter::Seek(std::uintmax_t position)
+{
+  Submit();
+  WaitIdle();
+
+  if (!m_writer || m_failed || !m_writer->Seek(position))
+    return false;
+
+  m_position = position;
+  return true;
+}
+
+bool BufferedFileWriter::Flush()
+{
+  Submit();
+  WaitIdle();
+
+  return m_writer && !m_failed && m_writer->Flush();
+}
+
+void BufferedFileWriter::FlushAsync()
+{
+  Submit();
+}
+
+void BufferedFileWriter::Submit()
+{
+  if (m_front.empty())
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return !m_pending; });
+
+    std::swap(m_front, m_back);
+    m_pending = true;
+  }
+  m_wake.notify_one();
+
+  // the background thread is done with this one
+  m_front.clear();
+}
+
+void BufferedFileWriter::WaitIdle()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle.wait(lock, [this]() { return !m_pending; });
+}
+
+void BufferedFileWriter::Run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (true) {
+    m_wake.wait(lock, [this]() { return m_pending || m_stop; });
+
+    if (!m_pending)
+      return;
+
+    lock.unlock();
+
+    auto written = m_writer->Write(m_back, m_back.size());
+    if (written != (std::intmax_t)m_back.size() && !m_failed.exchange(true)) {
+      elog::LogError(core::string::format("Buffered write of {} bytes failed, wrote {}",
+                                          m_back.size(), written));
+    }
+
+    lock.lock();
+    m_pending = false;
+    m_idle.notify_all();
+  }
+}
+} // namespace io
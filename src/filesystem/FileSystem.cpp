@@ -1,13 +1,259 @@
 #include "FileSystem.h"
 #include "FileReader.h"
 #include "FileWriter.h"
+#include "NativeFileReader.h"
+#include "PathIndex.h"
+#include "filesystem/BlockCompressedReader.h"
+#include "filesystem/BlockCompression.h"
+#include "filesystem/IoBufferPool.h"
+#include "filesystem/MappedFile.h"
+#include "filesystem/MemoryFileReader.h"
 #include "filesystem/Path.h"
 #include "physfs/src/physfs.h"
+#include "util/ThreadPool.h"
+#include <atomic>
+#include <filesystem>
+#include <mutex>
 
 namespace io {
-core::UniquePtr<IFileSystem> CreateFileSystem(const Path& argv0)
+namespace {
+struct Mount
+{
+  core::String Directory;
+  bool IsArchive;
+  /// Where files created in the write directory show up inside this mount, if they do.
+  core::Optional<core::String> WritePrefix;
+};
+
+/// Immutable copy of the physfs search path, replaced as a whole on every mount change.
+struct MountTable
+{
+  /// Highest priority first, physfs searches the same order.
+  core::Vector<Mount> Mounts;
+  core::String WriteDirectory;
+  /// Null with more mounts than the index can track, lookups stat every mount then.
+  core::SharedPtr<const PathIndex> Index;
+  /// Mounts searched before the first archive, only these can answer without physfs.
+  uint64_t LooseMask = ~0ull;
+  bool HasArchives   = false;
+};
+
+/// physfs state is process wide, so is everything guarding it.
+struct PhysfsState
+{
+  /// Serializes init, deinit, mount changes and index updates.
+  std::mutex Mutex;
+  uint32_t Users = 0;
+  core::SharedPtr<const MountTable> Mounts;
+  /// Bumped after every publish so readers only touch the shared pointer when it changed.
+  std::atomic<uint64_t> Generation{ 0 };
+};
+
+core::SharedPtr<MountTable> CreateEmptyMounts()
+{
+  auto mounts   = core::MakeShared<MountTable>();
+  mounts->Index = PathIndex::Build({});
+  return mounts;
+}
+
+PhysfsState& GetPhysfsState()
+{
+  static PhysfsState state{ {}, 0, CreateEmptyMounts() };
+  return state;
+}
+
+/// Snapshot for the calling thread. Unchanged mounts cost one atomic load, no lock and no reference
+/// count traffic. The reference stays valid until the thread calls this again.
+const MountTable& GetMounts()
+{
+  struct Cache
+  {
+    uint64_t Generation = ~0ull;
+    core::SharedPtr<const MountTable> Mounts;
+  };
+  thread_local Cache cache;
+
+  auto& state     = GetPhysfsState();
+  auto generation = state.Generation.load(std::memory_order_acquire);
+
+  if (cache.Generation != generation) {
+    cache.Mounts     = std::atomic_load(&state.Mounts);
+    cache.Generation = generation;
+  }
+
+  return *cache.Mounts;
+}
+
+/// Caller holds the state mutex.
+void PublishMounts(PhysfsState& state, core::SharedPtr<MountTable> mounts)
+{
+  mounts->HasArchives = false;
+  mounts->LooseMask   = ~0ull;
+
+  for (uint32_t i = 0; i < mounts->Mounts.size(); i++) {
+    if (mounts->Mounts[i].IsArchive) {
+      mounts->HasArchives = true;
+      mounts->LooseMask   = (1ull << i) - 1;
+      break;
+    }
+  }
+
+  std::atomic_store(&state.Mounts, core::SharedPtr<const MountTable>(core::Move(mounts)));
+  state.Generation.fetch_add(1, std::memory_order_release);
+}
+
+core::Optional<core::String> GetWritePrefix(const core::String& mount,
+                                            const core::String& writeDirectory)
+{
+  if (writeDirectory.empty())
+    return {};
+
+  std::error_code mountError, writeError;
+  auto mountPath = std::filesystem::weakly_canonical(mount, mountError);
+  auto writePath = std::filesystem::weakly_canonical(writeDirectory, writeError);
+
+  if (mountError || writeError)
+    return {};
+
+  auto relative = writePath.lexically_relative(mountPath);
+
+  if (relative.empty() || *relative.begin() == "..")
+    return {};
+
+  return relative == "." ? "" : relative.generic_string() + "/";
+}
+
+/// Paths physfs would reject or resolve differently are left for it to judge.
+bool IsPlainPath(const core::String& path, size_t start)
 {
-  auto fs    = new FileSystem();
+  if (path.size() <= start || path[start] == '.' || path.back() == '/')
+    return false;
+
+  return path.find("/.", start) == core::String::npos &&
+         path.find(':', start) == core::String::npos &&
+         path.find('\\', start) == core::String::npos;
+}
+
+enum class LooseLookup
+{
+  Found,
+  Missing,
+  /// An archive is searched before the file was found, or the path is one physfs should judge.
+  NeedsPhysfs
+};
+
+/// Resolves a path against the loose directories in search order without touching physfs.
+/// 'nativePath' is only filled in if given.
+LooseLookup FindLoose(const MountTable& mounts, const Path& path, core::String* nativePath,
+                      bool& isDirectory)
+{
+  auto& fullPath = path.AsString();
+  size_t start   = fullPath.size() && fullPath[0] == '/' ? 1 : 0;
+
+  if (!IsPlainPath(fullPath, start))
+    return LooseLookup::NeedsPhysfs;
+
+  if (mounts.Index) {
+    auto entry      = mounts.Index->Find(start ? fullPath.substr(start) : fullPath);
+    auto present    = entry ? (entry->Files | entry->Directories) & mounts.LooseMask : 0;
+    auto incomplete = mounts.Index->GetIncompleteMounts() & mounts.LooseMask;
+
+    if (!present)
+      return mounts.HasArchives || incomplete ? LooseLookup::NeedsPhysfs : LooseLookup::Missing;
+
+    uint32_t mount = 0;
+    while (!(present & (1ull << mount)))
+      mount++;
+
+    // a part of a higher priority mount that was not scanned may shadow the match
+    if (incomplete & ((1ull << mount) - 1))
+      return LooseLookup::NeedsPhysfs;
+
+    isDirectory = entry->Directories & (1ull << mount);
+
+    if (nativePath) {
+      *nativePath =
+          mounts.Mounts[mount].Directory + PHYSFS_getDirSeparator() + fullPath.substr(start);
+    }
+    return LooseLookup::Found;
+  }
+
+  for (auto& mount : mounts.Mounts) {
+    if (mount.IsArchive)
+      return LooseLookup::NeedsPhysfs;
+
+    auto candidate = mount.Directory + PHYSFS_getDirSeparator() + fullPath.substr(start);
+
+    std::error_code error;
+    auto status = std::filesystem::status(candidate, error);
+
+    if (std::filesystem::exists(status)) {
+      isDirectory = std::filesystem::is_directory(status);
+
+      if (nativePath)
+        *nativePath = core::Move(candidate);
+      return LooseLookup::Found;
+    }
+  }
+
+  return LooseLookup::Missing;
+}
+
+/// Keeps the index in step with a path created or deleted in the write directory.
+void RecordWrite(const Path& path, bool exists, bool isDirectory)
+{
+  auto& state = GetPhysfsState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  auto& relative = path.AsString();
+  size_t start   = relative.size() && relative[0] == '/' ? 1 : 0;
+
+  if (!state.Mounts->Index || !IsPlainPath(relative, start))
+    return;
+
+  auto index = state.Mounts->Index;
+
+  for (uint32_t i = 0; i < state.Mounts->Mounts.size(); i++) {
+    auto& prefix = state.Mounts->Mounts[i].WritePrefix;
+
+    if (prefix)
+      index = index->WithPath(*prefix + relative.substr(start), i, exists, isDirectory);
+  }
+
+  if (index != state.Mounts->Index) {
+    auto mounts   = core::MakeShared<MountTable>(*state.Mounts);
+    mounts->Index = core::Move(index);
+    PublishMounts(state, core::Move(mounts));
+  }
+}
+
+/// Shared by every file system, started when the first compressed file is opened.
+core::SharedPtr<util::ThreadPool> GetDecompressionPool()
+{
+  static auto pool = core::MakeShared<util::ThreadPool>();
+  return pool;
+}
+
+/// Returns 'file' rewound, or wrapped in a decompressing reader if it is block compressed.
+core::UniquePtr<IFileReader> DetectCompression(core::UniquePtr<IFileReader> file)
+{
+  compression::Header header;
+  bool compressed = file->Read(&header, sizeof(header)) == sizeof(header) &&
+                    compression::IsCompressed(&header, sizeof(header));
+
+  if (!file->Seek(0))
+    return nullptr;
+
+  if (compressed)
+    return BlockCompressedReader::Open(core::Move(file), GetDecompressionPool());
+
+  return file;
+}
+} // namespace
+
+core::UniquePtr<IFileSystem> CreateFileSystem(const Path& argv0, const FileSystemOptions& options)
+{
+  auto fs    = new FileSystem(options);
   auto fsPtr = core::UniquePtr<IFileSystem>(fs);
 
   if (fs->Init(argv0)) {
@@ -17,33 +263,66 @@ core::UniquePtr<IFileSystem> CreateFileSystem(const Path& argv0)
   return nullptr;
 }
 
-FileSystem::FileSystem()
+FileSystem::FileSystem(const FileSystemOptions& options)
+    : m_options(options)
+    , m_bufferPool(IoBufferPool::GetDefault())
+    , m_initialized(false)
 {
 }
 
 FileSystem::~FileSystem()
 {
-  if (PHYSFS_isInit())
+  if (!m_initialized)
+    return;
+
+  auto& state = GetPhysfsState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  if (--state.Users == 0) {
     PHYSFS_deinit();
+    PublishMounts(state, CreateEmptyMounts());
+  }
 }
 
 bool FileSystem::Init(const Path& argv0)
 {
-  if (PHYSFS_init(argv0.AsString().c_str())) {
+  auto& state = GetPhysfsState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  if (state.Users == 0) {
+    if (!PHYSFS_init(argv0.AsString().c_str()))
+      return false;
     PHYSFS_permitSymbolicLinks(1);
-    return true;
   }
-  return false;
+
+  state.Users++;
+  m_initialized = true;
+  return true;
 }
 
 bool FileSystem::SetWriteDirectory(const Path& path)
 {
-  return PHYSFS_setWriteDir(path.AsString().c_str());
+  auto& state = GetPhysfsState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  if (!PHYSFS_setWriteDir(path.AsString().c_str()))
+    return false;
+
+  auto mounts            = core::MakeShared<MountTable>(*state.Mounts);
+  mounts->WriteDirectory = PHYSFS_getWriteDir();
+
+  for (auto& mount : mounts->Mounts) {
+    mount.WritePrefix = mount.IsArchive ? core::Optional<core::String>()
+                                        : GetWritePrefix(mount.Directory, mounts->WriteDirectory);
+  }
+
+  PublishMounts(state, core::Move(mounts));
+  return true;
 }
 
 Path FileSystem::GetWriteDirectory()
 {
-  return Path(PHYSFS_getWriteDir());
+  return Path(GetMounts().WriteDirectory);
 }
 
 Path FileSystem::GetWorkingDirectory()
@@ -53,11 +332,65 @@ Path FileSystem::GetWorkingDirectory()
 
 bool FileSystem::AddSearchDirectory(const Path& path)
 {
-  return PHYSFS_mount(path.AsString().c_str(), NULL, 0);
+  auto& state = GetPhysfsState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  auto& directory = path.AsString();
+
+  if (!PHYSFS_mount(directory.c_str(), NULL, 0))
+    return false;
+
+  // mounting twice keeps the original position
+  for (auto& mount : state.Mounts->Mounts) {
+    if (mount.Directory == directory)
+      return true;
+  }
+
+  std::error_code error;
+  Mount mount{ directory, !std::filesystem::is_directory(directory, error) };
+
+  if (!mount.IsArchive)
+    mount.WritePrefix = GetWritePrefix(directory, state.Mounts->WriteDirectory);
+
+  auto mounts = core::MakeShared<MountTable>(*state.Mounts);
+  mounts->Mounts.insert(mounts->Mounts.begin(), mount);
+
+  // scanning happens here so lookups never have to
+  if (mounts->Index)
+    mounts->Index = mounts->Index->WithMount(directory, mount.IsArchive);
+
+  PublishMounts(state, core::Move(mounts));
+  return true;
+}
+
+void FileSystem::RescanMounts()
+{
+  auto& state = GetPhysfsState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  core::Vector<core::String> directories;
+  for (auto& mount : state.Mounts->Mounts) {
+    directories.push_back(mount.IsArchive ? "" : mount.Directory);
+  }
+
+  auto mounts   = core::MakeShared<MountTable>(*state.Mounts);
+  mounts->Index = PathIndex::Build(directories);
+  PublishMounts(state, core::Move(mounts));
 }
 
 bool FileSystem::DirectoryExists(const Path& path)
 {
+  bool isDirectory = false;
+
+  switch (FindLoose(GetMounts(), path, nullptr, isDirectory)) {
+    case LooseLookup::Found:
+      return isDirectory;
+    case LooseLookup::Missing:
+      return false;
+    case LooseLookup::NeedsPhysfs:
+      break;
+  }
+
   PHYSFS_Stat stat;
 
   if (PHYSFS_stat(path.AsString().c_str(), &stat)) {
@@ -69,6 +402,17 @@ bool FileSystem::DirectoryExists(const Path& path)
 
 bool FileSystem::FileExists(const Path& path)
 {
+  bool isDirectory = false;
+
+  switch (FindLoose(GetMounts(), path, nullptr, isDirectory)) {
+    case LooseLookup::Found:
+      return !isDirectory;
+    case LooseLookup::Missing:
+      return false;
+    case LooseLookup::NeedsPhysfs:
+      break;
+  }
+
   PHYSFS_Stat stat;
 
   if (PHYSFS_stat(path.AsString().c_str(), &stat)) {
@@ -80,12 +424,20 @@ bool FileSystem::FileExists(const Path& path)
 
 bool FileSystem::CreateDirectory(const Path& path)
 {
-  return PHYSFS_mkdir(path.AsString().c_str());
+  if (!PHYSFS_mkdir(path.AsString().c_str()))
+    return false;
+
+  RecordWrite(path, true, true);
+  return true;
 }
 
 bool FileSystem::Delete(const Path& path)
 {
-  return PHYSFS_delete(path.AsString().c_str());
+  if (!PHYSFS_delete(path.AsString().c_str()))
+    return false;
+
+  RecordWrite(path, false, false);
+  return true;
 }
 
 core::UniquePtr<IFileWriter> FileSystem::OpenWrite(const Path& path, bool append)
@@ -94,11 +446,13 @@ core::UniquePtr<IFileWriter> FileSystem::OpenWrite(const Path& path, bool append
 
   if(append){
     if (fileWriter->OpenAppend(path)) {
+      RecordWrite(path, true, false);
       return fileWriter;
     }
   }
   else {
     if (fileWriter->Open(path)) {
+      RecordWrite(path, true, false);
       return fileWriter;
     }
   }
@@ -110,16 +464,91 @@ core::UniquePtr<IFileWriter> FileSystem::OpenWrite(const Path& path, bool append
 
 core::UniquePtr<IFileReader> FileSystem::OpenRead(const Path& path)
 {
-  auto fileReader = core::MakeUnique<FileReader>();
+  core::String nativePath;
+  bool isDirectory = false;
+
+  auto lookup = FindLoose(GetMounts(), path, &nativePath, isDirectory);
+
+  if (lookup == LooseLookup::Found && !m_options.NativeReads)
+    lookup = isDirectory ? LooseLookup::Missing : LooseLookup::NeedsPhysfs;
 
-  if (fileReader->Open(path)) {
-    return fileReader;
+  switch (lookup) {
+    case LooseLookup::Found: {
+      auto nativeReader = core::MakeUnique<NativeFileReader>();
+
+      if (!isDirectory && nativeReader->Open(nativePath, m_options.DirectReadThreshold)) {
+        return DetectCompression(core::Move(nativeReader));
+      }
+      break;
+    }
+    case LooseLookup::Missing:
+      break;
+    case LooseLookup::NeedsPhysfs: {
+      auto fileReader = core::MakeUnique<FileReader>();
+
+      if (fileReader->Open(path)) {
+        return DetectCompression(core::Move(fileReader));
+      }
+      break;
+    }
   }
 
   elog::LogWarning(core::string::format("File not found: '{}'", path.AsString().c_str()));
   return nullptr;
 }
 
+core::UniquePtr<IFileMapping> FileSystem::MapFile(const Path& path)
+{
+  auto nativePath = GetNativePath(path);
+
+  if (nativePath.empty()) {
+    elog::LogWarning(core::string::format("File not found: '{}'", path.AsString().c_str()));
+    return nullptr;
+  }
+
+  // inside an archive the native path is not a file on disk and mapping fails
+  if (auto mapped = MappedFile::Open(nativePath)) {
+    if (!compression::IsCompressed(mapped->GetData(), mapped->GetSize()))
+      return mapped;
+
+    // decompressed contents can not be mapped, they go into a pooled buffer instead
+    auto data   = mapped->GetData();
+    auto size   = mapped->GetSize();
+    auto reader = BlockCompressedReader::Open(
+        core::MakeUnique<MemoryFileReader>(core::SharedPtr<IFileMapping>(core::Move(mapped)), data,
+                                           size),
+        GetDecompressionPool());
+    return reader ? m_bufferPool->ReadAll(reader.get()) : nullptr;
+  }
+
+  auto file = OpenRead(path);
+  return file ? m_bufferPool->ReadAll(file.get()) : nullptr;
+}
+
+core::String FileSystem::GetNativePath(const Path& path)
+{
+  core::String nativePath;
+  bool isDirectory = false;
+
+  switch (FindLoose(GetMounts(), path, &nativePath, isDirectory)) {
+    case LooseLookup::Found:
+      return nativePath;
+    case LooseLookup::Missing:
+      return "";
+    case LooseLookup::NeedsPhysfs:
+      break;
+  }
+
+  auto realDir = PHYSFS_getRealDir(path.AsString().c_str());
+
+  if (!realDir)
+    return "";
+
+  auto relative = path.AsString();
+  return core::String(realDir) + PHYSFS_getDirSeparator() +
+         (relative.size() && relative[0] == '/' ? relative.substr(1) : relative);
+}
+
 namespace {
 void AppendFiles(void* data, const char* directory, const char* fileName)
 {
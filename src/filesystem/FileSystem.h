@@ -4,23 +4,35 @@
 #include "filesystem/IFileSystem.h"
 
 namespace io {
+class IoBufferPool;
+
+/// physfs backed file system. physfs is initialized by the first instance and shut down with the
+/// last one, all instances share its mounts and write directory.
 class FileSystem : public IFileSystem
 {
   public:
-  FileSystem();
+  FileSystem(const FileSystemOptions& options = {});
   virtual ~FileSystem();
   virtual bool Init(const Path& argv0);
   virtual bool SetWriteDirectory(const Path& path);
   virtual Path GetWriteDirectory();
   virtual Path GetWorkingDirectory();
   virtual bool AddSearchDirectory(const Path& path);
+  virtual void RescanMounts();
   virtual bool DirectoryExists(const Path& path);
   virtual bool FileExists(const Path& path);
   virtual bool CreateDirectory(const Path& path);
   virtual bool Delete(const Path& path);
   virtual core::UniquePtr<IFileWriter> OpenWrite(const Path& path, bool append = false);
   virtual core::UniquePtr<IFileReader> OpenRead(const Path& path);
+  virtual core::UniquePtr<IFileMapping> MapFile(const Path& path);
   virtual core::Vector<Path> GetFilesInDirectory(const Path& directory);
+  virtual core::String GetNativePath(const Path& path);
+
+  private:
+  FileSystemOptions m_options;
+  core::SharedPtr<IoBufferPool> m_bufferPool;
+  bool m_initialized;
 };
 } // namespace io
 
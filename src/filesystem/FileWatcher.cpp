@@ -0,0 +1,181 @@
+#include "filesystem/FileWatcher.h"
+#include <filesystem>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace io {
+#ifdef __linux__
+namespace {
+constexpr uint32_t WatchedEvents = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                                   IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR;
+/// Events that change which files exist, the file system index has to be rescanned for them.
+constexpr uint32_t StructuralEvents = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+} // namespace
+
+FileWatcher::FileWatcher(IFileSystem* fileSystem, std::chrono::milliseconds quietPeriod)
+    : m_fileSystem(fileSystem)
+    , m_quietPeriod(quietPeriod)
+    , m_inotify(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+    , m_needsRescan(false)
+{
+  if (m_inotify < 0)
+    elog::LogError("Could not start watching files, inotify is not available");
+}
+
+FileWatcher::~FileWatcher()
+{
+  if (m_inotify >= 0)
+    close(m_inotify);
+}
+
+bool FileWatcher::AddDirectory(const Path& directory)
+{
+  std::error_code error;
+
+  if (m_inotify < 0 || !std::filesystem::is_directory(directory.AsString(), error))
+    return false;
+
+  WatchTree(directory.AsString(), "", false);
+  return true;
+}
+
+void FileWatcher::WatchTree(const core::String& nativeDirectory, const core::String& prefix,
+                            bool reportFiles)
+{
+  int watch = inotify_add_watch(m_inotify, nativeDirectory.c_str(), WatchedEvents);
+
+  if (watch < 0) {
+    elog::LogWarning(core::string::format("Could not watch directory '{}'", nativeDirectory));
+    return;
+  }
+
+  m_watches[watch] = { nativeDirectory, prefix };
+
+  std::error_code error;
+  auto now = Clock::now();
+
+  for (auto it = std::filesystem::directory_iterator(nativeDirectory, error);
+       !error && it != std::filesystem::directory_iterator(); it.increment(error)) {
+    auto name = it->path().filename().string();
+
+    if (it->is_directory(error))
+      WatchTree(it->path().string(), prefix + name + "/", reportFiles);
+    else if (reportFiles)
+      MarkChanged(prefix + name, now);
+  }
+}
+
+void FileWatcher::MarkChanged(const core::String& path, Clock::time_point time)
+{
+  m_changes[path].LastEvent = time;
+}
+
+void FileWatcher::ReadEvents()
+{
+  // aligned like the kernel expects, holds many events per read
+  alignas(inotify_event) char buffer[16 * 1024];
+  auto now = Clock::now();
+
+  while (true) {
+    auto length = read(m_inotify, buffer, sizeof(buffer));
+
+    if (length <= 0)
+      return;
+
+    for (char* next = buffer; next < buffer + length;) {
+      auto event = reinterpret_cast<const inotify_event*>(next);
+      next += sizeof(inotify_event) + event->len;
+
+      if (event->mask & IN_Q_OVERFLOW) {
+        elog::LogWarning("File watch events were lost, some changes may not be reloaded");
+        m_needsRescan = true;
+        continue;
+      }
+
+      auto watch = m_watches.find(event->wd);
+
+      if (watch == m_watches.end())
+        continue;
+
+      if (event->mask & IN_IGNORED) {
+        m_watches.erase(watch);
+        continue;
+      }
+
+      if (event->len == 0)
+        continue;
+
+      auto path = watch->second.second + event->name;
+
+      if (event->mask & StructuralEvents)
+        m_needsRescan = true;
+
+      // new directories are watched too, files moved in with them count as changed
+      if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+        WatchTree(watch->second.first + "/" + event->name, path + "/", true);
+        continue;
+      }
+
+      if (!(event->mask & IN_ISDIR))
+        MarkChanged(path, now);
+    }
+  }
+}
+
+core::Vector<Path> FileWatcher::TakeChanged()
+{
+  core::Vector<Path> changed;
+
+  if (m_inotify < 0)
+    return changed;
+
+  ReadEvents();
+
+  auto settled = Clock::now() - m_quietPeriod;
+
+  for (auto it = m_changes.begin(); it != m_changes.end();) {
+    if (it->second.LastEvent <= settled) {
+      changed.emplace_back(it->first);
+      it = m_changes.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  // changes still settling happened before this, the rescan covers them too
+  if (!changed.empty() && m_needsRescan) {
+    m_fileSystem->RescanMounts();
+    m_needsRescan = false;
+  }
+
+  return changed;
+}
+#else
+FileWatcher::FileWatcher(IFileSystem* fileSystem, std::chrono::milliseconds quietPeriod)
+    : m_fileSystem(fileSystem)
+    , m_quietPeriod(quietPeriod)
+    , m_inotify(-1)
+    , m_needsRescan(false)
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+}
+
+bool FileWatcher::AddDirectory(const Path& directory)
+{
+  elog::LogWarning("Watching files is only supported on Linux");
+  return false;
+}
+
+core::Vector<Path> FileWatcher::TakeChanged()
+{
+  return {};
+}
+#endif
+} // namespace io
@@ -56,4 +56,10 @@ bool FileWriter::Seek(std::uintmax_t position)
 {
   return PHYSFS_seek(m_fileHandle, position) != 0;
 }
+
+bool FileWriter::Flush()
+{
+  // physfs syncs native files to disk when flushing
+  return m_fileHandle != nullptr && PHYSFS_flush(m_fileHandle) != 0;
+}
 } // namespace io
@@ -18,6 +18,7 @@ class FileWriter : public IFileWriter
   virtual std::intmax_t Write(const std::string& string,
                               std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
   virtual bool Seek(std::uintmax_t position);
+  virtual bool Flush();
 
   private:
   template <class T>
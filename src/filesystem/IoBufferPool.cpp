@@ -0,0 +1,229 @@
+#include "filesystem/IoBufferPool.h"
+#include "filesystem/IFileReader.h"
+#include <new>
+
+namespace io {
+namespace {
+/// Enough to keep buffers of a few large archived assets around between loads.
+constexpr size_t DefaultMaxRetainedBytes = 64 * 1024 * 1024;
+
+/// Rounds 'size' up to its class, MinCapacity or one of four steps between consecutive powers of
+/// two above it.
+size_t GetSizeClass(size_t size, size_t& capacity)
+{
+  if (size <= IoBufferPool::MinCapacity) {
+    capacity = IoBufferPool::MinCapacity;
+    return 0;
+  }
+
+  // 2^(bits - 1) < size <= 2^bits
+  uint32_t bits = 13;
+  while ((size_t(1) << bits) < size)
+    ++bits;
+
+  auto step = size_t(1) << (bits - 3);
+  capacity  = (size + step - 1) & ~(step - 1);
+  return 1 + (bits - 13) * 4 + (capacity >> (bits - 3)) - 5;
+}
+
+class PooledMapping : public IFileMapping
+{
+  public:
+  PooledMapping(IoBuffer buffer)
+      : m_buffer(core::Move(buffer))
+  {
+  }
+
+  const uint8_t* GetData() const override
+  {
+    return m_buffer.GetData();
+  }
+
+  size_t GetSize() const override
+  {
+    return m_buffer.GetSize();
+  }
+
+  private:
+  IoBuffer m_buffer;
+};
+} // namespace
+
+IoBuffer::IoBuffer()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_capacity(0)
+{
+}
+
+IoBuffer::IoBuffer(core::SharedPtr<IoBufferPool> pool, uint8_t* data, size_t size, size_t capacity)
+    : m_pool(core::Move(pool))
+    , m_data(data)
+    , m_size(size)
+    , m_capacity(capacity)
+{
+}
+
+IoBuffer::IoBuffer(IoBuffer&& other) noexcept
+    : m_pool(core::Move(other.m_pool))
+    , m_data(other.m_data)
+    , m_size(other.m_size)
+    , m_capacity(other.m_capacity)
+{
+  other.m_data     = nullptr;
+  other.m_size     = 0;
+  other.m_capacity = 0;
+}
+
+IoBuffer& IoBuffer::operator=(IoBuffer&& other) noexcept
+{
+  if (this != &other) {
+    Release();
+    m_pool           = core::Move(other.m_pool);
+    m_data           = other.m_data;
+    m_size           = other.m_size;
+    m_capacity       = other.m_capacity;
+    other.m_data     = nullptr;
+    other.m_size     = 0;
+    other.m_capacity = 0;
+  }
+  return *this;
+}
+
+IoBuffer::~IoBuffer()
+{
+  Release();
+}
+
+bool IoBuffer::Resize(size_t size)
+{
+  if (size > m_capacity)
+    return false;
+
+  m_size = size;
+  return true;
+}
+
+void IoBuffer::Reserve(size_t size)
+{
+  if (size <= m_capacity) {
+    m_size = size;
+    return;
+  }
+
+  auto pool = m_pool ? m_pool : IoBufferPool::GetDefault();
+  *this     = pool->Acquire(size);
+}
+
+void IoBuffer::Release()
+{
+  if (m_data)
+    m_pool->Release(m_data, m_capacity);
+
+  m_pool.reset();
+  m_data     = nullptr;
+  m_size     = 0;
+  m_capacity = 0;
+}
+
+IoBufferPool::IoBufferPool(size_t maxRetainedBytes)
+    : m_maxRetainedBytes(maxRetainedBytes)
+{
+}
+
+IoBufferPool::~IoBufferPool()
+{
+  for (auto& buffers : m_free)
+    for (auto data : buffers)
+      ::operator delete(data, std::align_val_t(Alignment));
+}
+
+const core::SharedPtr<IoBufferPool>& IoBufferPool::GetDefault()
+{
+  static auto pool = core::MakeShared<IoBufferPool>(DefaultMaxRetainedBytes);
+  return pool;
+}
+
+IoBuffer IoBufferPool::Acquire(size_t size)
+{
+  size_t capacity;
+  auto sizeClass = GetSizeClass(size, capacity);
+  uint8_t* data  = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ++m_stats.Acquired;
+    if (sizeClass < m_free.size() && !m_free[sizeClass].empty()) {
+      data = m_free[sizeClass].back();
+      m_free[sizeClass].pop_back();
+      m_stats.RetainedBytes -= capacity;
+    } else {
+      ++m_stats.Allocations;
+    }
+  }
+
+  if (!data)
+    data = static_cast<uint8_t*>(::operator new(capacity, std::align_val_t(Alignment)));
+
+  return IoBuffer(shared_from_this(), data, size, capacity);
+}
+
+void IoBufferPool::Release(uint8_t* data, size_t capacity)
+{
+  size_t rounded;
+  auto sizeClass = GetSizeClass(capacity, rounded);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_stats.RetainedBytes + capacity <= m_maxRetainedBytes) {
+      if (sizeClass >= m_free.size())
+        m_free.resize(sizeClass + 1);
+
+      m_free[sizeClass].push_back(data);
+      m_stats.RetainedBytes += capacity;
+      return;
+    }
+  }
+
+  ::operator delete(data, std::align_val_t(Alignment));
+}
+
+core::UniquePtr<IFileMapping> IoBufferPool::ReadAll(IFileReader* file)
+{
+  auto remaining = file->GetLength() - file->GetPosition();
+
+  if (remaining < 0)
+    return nullptr;
+
+  auto buffer = Acquire(remaining);
+
+  if (file->Read(buffer.GetData(), remaining) != remaining)
+    return nullptr;
+
+  return core::MakeUnique<PooledMapping>(core::Move(buffer));
+}
+
+IoBufferPoolStats IoBufferPool::GetStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+std::intmax_t IFileReader::Read(IoBuffer& buffer, std::uintmax_t size)
+{
+  auto length   = GetLength();
+  auto position = GetPosition();
+
+  if (length < 0 || position < 0 || position > length) {
+    buffer.Resize(0);
+    return -1;
+  }
+
+  size = std::min<std::uintmax_t>(size, length - position);
+  buffer.Reserve(size);
+
+  auto bytesRead = Read(static_cast<void*>(buffer.GetData()), size);
+  buffer.Resize(bytesRead > 0 ? bytesRead : 0);
+  return bytesRead;
+}
+} // namespace io
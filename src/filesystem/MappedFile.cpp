@@ -0,0 +1,87 @@
+#include "filesystem/MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace io {
+MappedFile::MappedFile(const uint8_t* data, size_t size, void* handle)
+    : m_data(data)
+    , m_size(size)
+    , m_handle(handle)
+{
+}
+
+#ifdef _WIN32
+core::UniquePtr<MappedFile> MappedFile::Open(const core::String& nativePath)
+{
+  auto file = CreateFileA(nativePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (file == INVALID_HANDLE_VALUE)
+    return nullptr;
+
+  LARGE_INTEGER size;
+  HANDLE mapping = nullptr;
+
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  // mapping keeps the file open
+  CloseHandle(file);
+
+  if (!mapping)
+    return nullptr;
+
+  auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+  if (!data) {
+    CloseHandle(mapping);
+    return nullptr;
+  }
+
+  return core::UniquePtr<MappedFile>(
+      new MappedFile((const uint8_t*)data, (size_t)size.QuadPart, mapping));
+}
+
+MappedFile::~MappedFile()
+{
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_handle);
+}
+#else
+core::UniquePtr<MappedFile> MappedFile::Open(const core::String& nativePath)
+{
+  int fd = open(nativePath.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0)
+    return nullptr;
+
+  struct stat info;
+  void* data = MAP_FAILED;
+
+  // empty files can not be mapped
+  if (fstat(fd, &info) == 0 && info.st_size > 0)
+    data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // mapping stays valid after the descriptor is closed
+  close(fd);
+
+  if (data == MAP_FAILED)
+    return nullptr;
+
+  return core::UniquePtr<MappedFile>(
+      new MappedFile((const uint8_t*)data, (size_t)info.st_size, nullptr));
+}
+
+MappedFile::~MappedFile()
+{
+  munmap((void*)m_data, m_size);
+}
+#endif
+} // namespace io
@@ -0,0 +1,74 @@
+#include "filesystem/MemoryFileReader.h"
+#include <cstring>
+
+namespace io {
+MemoryFileReader::MemoryFileReader(core::SharedPtr<const core::TByteArray> data)
+    : MemoryFileReader(data, data->data(), data->size())
+{
+}
+
+MemoryFileReader::MemoryFileReader(core::TByteArray data)
+    : MemoryFileReader(core::MakeShared<const core::TByteArray>(core::Move(data)))
+{
+}
+
+MemoryFileReader::MemoryFileReader(core::SharedPtr<const void> owner, const uint8_t* data,
+                                   size_t size)
+    : m_owner(core::Move(owner))
+    , m_data(data)
+    , m_size(size)
+    , m_position(0)
+{
+}
+
+MemoryFileReader::~MemoryFileReader()
+{
+}
+
+std::intmax_t MemoryFileReader::GetLength() const
+{
+  return m_size;
+}
+
+std::intmax_t MemoryFileReader::GetPosition() const
+{
+  return m_position;
+}
+
+template <class T> std::intmax_t MemoryFileReader::ReadInto(T& buffer, std::uintmax_t size)
+{
+  buffer.resize(std::min<std::uintmax_t>(size, m_size - m_position));
+  return Read((void*)buffer.data(), buffer.size());
+}
+
+std::intmax_t MemoryFileReader::Read(core::TByteArray& array, std::uintmax_t size)
+{
+  return ReadInto(array, size);
+}
+
+std::intmax_t MemoryFileReader::Read(std::string& string, std::uintmax_t size)
+{
+  return ReadInto(string, size);
+}
+
+std::intmax_t MemoryFileReader::Read(void* buffer, std::uintmax_t size)
+{
+  size = std::min<std::uintmax_t>(size, m_size - m_position);
+
+  if (size > 0) {
+    memcpy(buffer, m_data + m_position, size);
+    m_position += size;
+  }
+
+  return size;
+}
+
+bool MemoryFileReader::Seek(std::uintmax_t position)
+{
+  if (position > m_size)
+    return false;
+
+  m_position = position;
+  return true;
+}
+} // namespace io
@@ -0,0 +1,430 @@
+#include "filesystem/MemoryFileSystem.h"
+#include "filesystem/MemoryFileReader.h"
+#include <cstring>
+#include <mutex>
+
+namespace io {
+namespace {
+core::String GetKey(const Path& path)
+{
+  auto& string = path.AsString();
+  auto start   = string.find_first_not_of('/');
+
+  if (start == core::String::npos)
+    return {};
+
+  auto end = string.find_last_not_of('/');
+  return string.substr(start, end - start + 1);
+}
+
+core::String Join(const core::String& directory, const core::String& name)
+{
+  return directory.empty() ? name : directory + '/' + name;
+}
+
+/// Splits 'key' into its parent directory and name, the root directory is "".
+std::pair<core::String, core::String> Split(const core::String& key)
+{
+  auto pos = key.find_last_of('/');
+
+  if (pos == core::String::npos)
+    return { {}, key };
+
+  return { key.substr(0, pos), key.substr(pos + 1) };
+}
+
+class MemoryFileMapping : public IFileMapping
+{
+  public:
+  MemoryFileMapping(core::SharedPtr<const core::TByteArray> owner, const uint8_t* data, size_t size)
+      : m_owner(core::Move(owner))
+      , m_data(data)
+      , m_size(size)
+  {
+  }
+
+  const uint8_t* GetData() const override
+  {
+    return m_data;
+  }
+
+  size_t GetSize() const override
+  {
+    return m_size;
+  }
+
+  private:
+  core::SharedPtr<const core::TByteArray> m_owner;
+  const uint8_t* m_data;
+  size_t m_size;
+};
+} // namespace
+
+/// Writes into a private buffer that replaces the stored file on Flush and when closed, readers
+/// opened before keep seeing the old contents.
+class MemoryFileWriter : public IFileWriter
+{
+  public:
+  MemoryFileWriter(MemoryFileSystem* fileSystem, core::String key, core::TByteArray contents)
+      : m_fileSystem(fileSystem)
+      , m_key(core::Move(key))
+      , m_contents(core::Move(contents))
+      , m_position(m_contents.size())
+  {
+  }
+
+  ~MemoryFileWriter()
+  {
+    Commit(core::MakeShared<const core::TByteArray>(core::Move(m_contents)));
+  }
+
+  std::intmax_t GetPosition() const override
+  {
+    return m_position;
+  }
+
+  std::intmax_t Write(const core::TByteArray& array, std::intmax_t size) override
+  {
+    return WriteBytes(array.data(), std::min<std::uintmax_t>(size, array.size()));
+  }
+
+  std::intmax_t Write(const std::string& string, std::uintmax_t size) override
+  {
+    return WriteBytes(string.data(), std::min<std::uintmax_t>(size, string.size()));
+  }
+
+  bool Seek(std::uintmax_t position) override
+  {
+    if (position > m_contents.size())
+      return false;
+
+    m_position = position;
+    return true;
+  }
+
+  bool Flush() override
+  {
+    Commit(core::MakeShared<const core::TByteArray>(m_contents));
+    return true;
+  }
+
+  private:
+  std::intmax_t WriteBytes(const void* data, size_t size)
+  {
+    if (m_position + size > m_contents.size())
+      m_contents.resize(m_position + size);
+
+    std::memcpy(m_contents.data() + m_position, data, size);
+    m_position += size;
+    return size;
+  }
+
+  void Commit(core::SharedPtr<const core::TByteArray> contents)
+  {
+    std::unique_lock<std::shared_mutex> lock(m_fileSystem->m_mutex);
+    auto data = contents->data();
+    auto size = contents->size();
+    m_fileSystem->AddFileLocked(m_key, { core::Move(contents), data, size });
+  }
+
+  MemoryFileSystem* m_fileSystem;
+  core::String m_key;
+  core::TByteArray m_contents;
+  size_t m_position;
+};
+
+MemoryFileSystem::MemoryFileSystem(core::UniquePtr<IFileSystem> fallback)
+    : m_fallback(core::Move(fallback))
+{
+  m_directories.emplace(core::String(), Directory());
+}
+
+MemoryFileSystem::~MemoryFileSystem()
+{
+}
+
+void MemoryFileSystem::AddFile(const Path& path, core::TByteArray contents)
+{
+  AddFile(path, core::MakeShared<const core::TByteArray>(core::Move(contents)));
+}
+
+void MemoryFileSystem::AddFile(const Path& path, core::SharedPtr<const core::TByteArray> contents)
+{
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  auto data = contents->data();
+  auto size = contents->size();
+  AddFileLocked(GetKey(path), { core::Move(contents), data, size });
+}
+
+bool MemoryFileSystem::MountBlob(const Path& mountPoint,
+                                 core::SharedPtr<const core::TByteArray> blob,
+                                 const core::Vector<MemoryBlobEntry>& entries)
+{
+  for (auto& entry : entries) {
+    if (entry.Offset > blob->size() || entry.Size > blob->size() - entry.Offset) {
+      elog::LogError(core::string::format("Blob entry '{}' does not fit into the blob",
+                                          entry.File.AsString()));
+      return false;
+    }
+  }
+
+  auto mountKey = GetKey(mountPoint);
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+  AddDirectoryLocked(mountKey);
+  for (auto& entry : entries) {
+    AddFileLocked(Join(mountKey, GetKey(entry.File)),
+                  { blob, blob->data() + entry.Offset, (size_t)entry.Size });
+  }
+
+  return true;
+}
+
+bool MemoryFileSystem::Pin(const Path& path)
+{
+  auto mapping = m_fallback ? m_fallback->MapFile(path) : nullptr;
+
+  if (!mapping)
+    return false;
+
+  AddFile(path, core::TByteArray(mapping->GetData(), mapping->GetData() + mapping->GetSize()));
+  return true;
+}
+
+bool MemoryFileSystem::SetWriteDirectory(const Path& path)
+{
+  if (m_fallback)
+    return m_fallback->SetWriteDirectory(path);
+
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  m_writeDirectory = path;
+  return true;
+}
+
+Path MemoryFileSystem::GetWriteDirectory()
+{
+  if (m_fallback)
+    return m_fallback->GetWriteDirectory();
+
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  return m_writeDirectory;
+}
+
+Path MemoryFileSystem::GetWorkingDirectory()
+{
+  return m_fallback ? m_fallback->GetWorkingDirectory() : Path();
+}
+
+bool MemoryFileSystem::AddSearchDirectory(const Path& path)
+{
+  return m_fallback && m_fallback->AddSearchDirectory(path);
+}
+
+void MemoryFileSystem::RescanMounts()
+{
+  if (m_fallback)
+    m_fallback->RescanMounts();
+}
+
+bool MemoryFileSystem::DirectoryExists(const Path& path)
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (m_directories.count(GetKey(path)))
+      return true;
+  }
+
+  return m_fallback && m_fallback->DirectoryExists(path);
+}
+
+bool MemoryFileSystem::FileExists(const Path& path)
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (m_files.count(GetKey(path)))
+      return true;
+  }
+
+  return m_fallback && m_fallback->FileExists(path);
+}
+
+bool MemoryFileSystem::CreateDirectory(const Path& path)
+{
+  if (m_fallback)
+    return m_fallback->CreateDirectory(path);
+
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  AddDirectoryLocked(GetKey(path));
+  return true;
+}
+
+bool MemoryFileSystem::Delete(const Path& path)
+{
+  auto key = GetKey(path);
+
+  {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto file      = m_files.find(key);
+    auto directory = m_directories.find(key);
+
+    // like physfs, only empty directories can be deleted
+    bool deletable = file != m_files.end() ||
+                     (directory != m_directories.end() && !key.empty() &&
+                      directory->second.Children.empty());
+
+    if (deletable) {
+      if (file != m_files.end())
+        m_files.erase(file);
+      else
+        m_directories.erase(directory);
+
+      auto parentAndName = Split(key);
+      m_directories[parentAndName.first].Children.erase(parentAndName.second);
+      return true;
+    }
+  }
+
+  return m_fallback && m_fallback->Delete(path);
+}
+
+core::UniquePtr<IFileWriter> MemoryFileSystem::OpenWrite(const Path& path, bool append)
+{
+  if (m_fallback) {
+    auto writer = m_fallback->OpenWrite(path, append);
+
+    // an added or pinned copy would keep shadowing what is written
+    if (writer) {
+      std::unique_lock<std::shared_mutex> lock(m_mutex);
+      RemoveFileLocked(GetKey(path));
+    }
+
+    return writer;
+  }
+
+  auto key = GetKey(path);
+  core::TByteArray contents;
+
+  {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+    if (key.empty() || m_directories.count(key) || !m_directories.count(Split(key).first)) {
+      elog::LogWarning(
+          core::string::format("File could not be opened for writing: '{}'", path.AsString()));
+      return nullptr;
+    }
+
+    auto file = m_files.find(key);
+    if (append && file != m_files.end())
+      contents.assign(file->second.Data, file->second.Data + file->second.Size);
+
+    // the file exists as soon as it is opened, like on disk
+    if (!append || file == m_files.end()) {
+      auto empty = core::MakeShared<const core::TByteArray>();
+      AddFileLocked(key, { empty, empty->data(), 0 });
+    }
+  }
+
+  return core::MakeUnique<MemoryFileWriter>(this, core::Move(key), core::Move(contents));
+}
+
+core::UniquePtr<IFileReader> MemoryFileSystem::OpenRead(const Path& path)
+{
+  if (auto file = FindFile(path))
+    return core::MakeUnique<MemoryFileReader>(core::Move(file->Owner), file->Data, file->Size);
+
+  if (m_fallback)
+    return m_fallback->OpenRead(path);
+
+  elog::LogWarning(core::string::format("File not found: '{}'", path.AsString()));
+  return nullptr;
+}
+
+core::UniquePtr<IFileMapping> MemoryFileSystem::MapFile(const Path& path)
+{
+  if (auto file = FindFile(path))
+    return core::MakeUnique<MemoryFileMapping>(core::Move(file->Owner), file->Data, file->Size);
+
+  if (m_fallback)
+    return m_fallback->MapFile(path);
+
+  elog::LogWarning(core::string::format("File not found: '{}'", path.AsString()));
+  return nullptr;
+}
+
+core::Vector<Path> MemoryFileSystem::GetFilesInDirectory(const Path& directory)
+{
+  auto key = GetKey(directory);
+  core::Vector<Path> paths;
+  core::UnorderedMap<core::String, bool> names;
+
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_directories.find(key);
+
+    if (it != m_directories.end())
+      names = it->second.Children;
+  }
+
+  for (auto& name : names) {
+    paths.push_back(Path(Join(key, name.first)));
+  }
+
+  if (m_fallback) {
+    for (auto& path : m_fallback->GetFilesInDirectory(directory)) {
+      if (!names.count(Split(GetKey(path)).second))
+        paths.push_back(path);
+    }
+  }
+
+  return paths;
+}
+
+core::String MemoryFileSystem::GetNativePath(const Path& path)
+{
+  if (FindFile(path))
+    return {};
+
+  return m_fallback ? m_fallback->GetNativePath(path) : core::String();
+}
+
+void MemoryFileSystem::AddFileLocked(const core::String& key, File file)
+{
+  auto parentAndName = Split(key);
+  AddDirectoryLocked(parentAndName.first);
+
+  m_directories[parentAndName.first].Children[parentAndName.second] = false;
+  m_files[key] = core::Move(file);
+}
+
+void MemoryFileSystem::RemoveFileLocked(const core::String& key)
+{
+  if (!m_files.erase(key))
+    return;
+
+  auto parentAndName = Split(key);
+  m_directories[parentAndName.first].Children.erase(parentAndName.second);
+}
+
+void MemoryFileSystem::AddDirectoryLocked(const core::String& key)
+{
+  if (m_directories.count(key))
+    return;
+
+  auto parentAndName = Split(key);
+  AddDirectoryLocked(parentAndName.first);
+
+  m_directories[parentAndName.first].Children[parentAndName.second] = true;
+  m_directories.emplace(key, Directory());
+}
+
+core::Optional<MemoryFileSystem::File> MemoryFileSystem::FindFile(const Path& path)
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  auto it = m_files.find(GetKey(path));
+
+  if (it == m_files.end())
+    return {};
+
+  return it->second;
+}
+} // namespace io
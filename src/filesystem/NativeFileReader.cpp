@@ -0,0 +1,217 @@
+#include "NativeFileReader.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace io {
+namespace {
+int OpenFile(const core::String& nativePath)
+{
+#ifdef _WIN32
+  return _open(nativePath.c_str(), _O_RDONLY | _O_BINARY);
+#else
+  return open(nativePath.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+void CloseFile(int file)
+{
+#ifdef _WIN32
+  _close(file);
+#else
+  close(file);
+#endif
+}
+
+std::intmax_t GetFileLength(int file)
+{
+#ifdef _WIN32
+  struct _stat64 status;
+  return _fstat64(file, &status) == 0 ? status.st_size : -1;
+#else
+  struct stat status;
+  return fstat(file, &status) == 0 && S_ISREG(status.st_mode) ? status.st_size : -1;
+#endif
+}
+
+/// Reads until 'size' bytes, the end of the file or an error. Returns the bytes read, -1 on error.
+std::intmax_t ReadAt(int file, uint8_t* buffer, uint64_t size, uint64_t offset)
+{
+  uint64_t total = 0;
+
+#ifdef _WIN32
+  if (_lseeki64(file, offset, SEEK_SET) < 0)
+    return -1;
+#endif
+
+  while (total < size) {
+    // single calls are capped well below any platform limit
+    auto chunk = static_cast<unsigned int>(std::min<uint64_t>(size - total, 1u << 30));
+#ifdef _WIN32
+    auto bytesRead = _read(file, buffer + total, chunk);
+#else
+    auto bytesRead = pread(file, buffer + total, chunk, offset + total);
+    if (bytesRead < 0 && errno == EINTR)
+      continue;
+#endif
+
+    if (bytesRead < 0)
+      return -1;
+    if (bytesRead == 0)
+      break;
+    total += bytesRead;
+  }
+
+  return total;
+}
+} // namespace
+
+NativeFileReader::NativeFileReader()
+    : m_file(-1)
+    , m_length(-1)
+    , m_position(0)
+    , m_directReadThreshold(0)
+{
+}
+
+NativeFileReader::~NativeFileReader()
+{
+  if (m_file >= 0)
+    CloseFile(m_file);
+}
+
+bool NativeFileReader::Open(const core::String& nativePath, uint64_t directReadThreshold)
+{
+  m_file = OpenFile(nativePath);
+
+  if (m_file < 0)
+    return false;
+
+  // files are not expected to change size while open, like with physfs
+  m_length = GetFileLength(m_file);
+
+  if (m_length < 0) {
+    CloseFile(m_file);
+    m_file = -1;
+    return false;
+  }
+
+  // the aligned middle of smaller reads would be too short to be worth it
+  m_directReadThreshold =
+      directReadThreshold ? std::max<uint64_t>(directReadThreshold, 4 * DirectAlignment) : 0;
+  return true;
+}
+
+std::intmax_t NativeFileReader::GetLength() const
+{
+  return m_file >= 0 ? m_length : -1;
+}
+
+std::intmax_t NativeFileReader::GetPosition() const
+{
+  return m_file >= 0 ? (std::intmax_t)m_position : -1;
+}
+
+template <class T> std::intmax_t NativeFileReader::ReadFile(T& dataBuffer, std::uintmax_t size)
+{
+  if (m_file >= 0) {
+    std::uintmax_t readSize = m_position < (std::uintmax_t)m_length ? m_length - m_position : 0;
+    if (size < readSize)
+      readSize = size;
+
+    dataBuffer.resize(readSize);
+
+    auto bytesRead = Read((void*)dataBuffer.data(), readSize);
+
+    if (bytesRead == (std::intmax_t)readSize)
+      return bytesRead;
+  }
+
+  // Failed to read, buffer should be empty.
+  T().swap(dataBuffer);
+  return -1;
+}
+
+std::intmax_t NativeFileReader::Read(core::TByteArray& array, std::uintmax_t size)
+{
+  return ReadFile(array, size);
+}
+
+std::intmax_t NativeFileReader::Read(std::string& string, std::uintmax_t size)
+{
+  return ReadFile(string, size);
+}
+
+std::intmax_t NativeFileReader::Read(void* buffer, std::uintmax_t size)
+{
+  if (m_file < 0)
+    return -1;
+
+  std::uintmax_t readSize = m_position < (std::uintmax_t)m_length ? m_length - m_position : 0;
+  if (size < readSize)
+    readSize = size;
+
+  auto data     = static_cast<uint8_t*>(buffer);
+  uint64_t done = 0;
+
+  if (m_directReadThreshold && readSize >= m_directReadThreshold)
+    done = ReadDirect(data, readSize);
+
+  auto bytesRead = ReadAt(m_file, data + done, readSize - done, m_position + done);
+
+  if (bytesRead < 0)
+    return -1;
+
+  m_position += done + bytesRead;
+  return done + bytesRead;
+}
+
+uint64_t NativeFileReader::ReadDirect(uint8_t* buffer, uint64_t size)
+{
+#ifdef O_DIRECT
+  // memory and file offset can only both be aligned if they are off by the same amount
+  if ((uintptr_t)buffer % DirectAlignment != m_position % DirectAlignment)
+    return 0;
+
+  auto head   = (DirectAlignment - m_position % DirectAlignment) % DirectAlignment;
+  auto middle = (size - head) & ~(DirectAlignment - 1);
+
+  if (ReadAt(m_file, buffer, head, m_position) != (std::intmax_t)head)
+    return 0;
+
+  auto flags = fcntl(m_file, F_GETFL);
+
+  // file systems without direct I/O refuse the flag, they are not asked again
+  if (flags < 0 || fcntl(m_file, F_SETFL, flags | O_DIRECT) != 0) {
+    m_directReadThreshold = 0;
+    return head;
+  }
+
+  auto bytesRead = ReadAt(m_file, buffer + head, middle, m_position + head);
+  fcntl(m_file, F_SETFL, flags);
+
+  // whatever went wrong is repeated with a buffered read
+  return bytesRead == (std::intmax_t)middle ? head + middle : head;
+#else
+  (void)buffer;
+  (void)size;
+  return 0;
+#endif
+}
+
+bool NativeFileReader::Seek(std::uintmax_t position)
+{
+  // physfs refuses seeking past the end, keep the same behaviour
+  if (m_file < 0 || position > (std::uintmax_t)m_length)
+    return false;
+
+  m_position = position;
+  return true;
+}
+} // namespace io
@@ -0,0 +1,44 @@
+#ifndef NATIVE_FILE_READER_H
+#define NATIVE_FILE_READER_H
+
+#include "filesystem/IFileReader.h"
+
+namespace io {
+/// Reader for loose files opened by native path, bypasses physfs and its global state lock.
+/// Reads are positional reads straight into the destination, without a stdio buffer in between.
+class NativeFileReader : public IFileReader
+{
+  public:
+  /// File offsets and memory O_DIRECT transfers have to be aligned to.
+  static constexpr uint64_t DirectAlignment = 4096;
+
+  NativeFileReader();
+  virtual ~NativeFileReader();
+  /// Reads of at least 'directReadThreshold' bytes bypass the page cache with O_DIRECT, as far as
+  /// the destination allows and the file system supports it. 0 disables that.
+  bool Open(const core::String& nativePath, uint64_t directReadThreshold = 0);
+  virtual std::intmax_t GetLength() const;
+  virtual std::intmax_t GetPosition() const;
+  virtual std::intmax_t Read(core::TByteArray& array,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual std::intmax_t Read(std::string& string,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual std::intmax_t Read(void* buffer,
+                             std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  virtual bool Seek(std::uintmax_t position);
+
+  private:
+  template <class T>
+  std::intmax_t ReadFile(T& buffer,
+                         std::uintmax_t size = std::numeric_limits<std::uintmax_t>::max());
+  /// Reads the block aligned part of a large read with O_DIRECT, returns how much it read.
+  uint64_t ReadDirect(uint8_t* buffer, uint64_t size);
+
+  int m_file;
+  std::intmax_t m_length;
+  std::uintmax_t m_position;
+  uint64_t m_directReadThreshold;
+};
+} // namespace io
+
+#endif
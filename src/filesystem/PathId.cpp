@@ -0,0 +1,144 @@
+#include "filesystem/PathId.h"
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
+namespace io {
+namespace {
+constexpr uint32_t ChunkSize = 4096;
+constexpr uint32_t MaxChunks = 4096;
+
+struct InternedPath
+{
+  core::String Path;
+  uint32_t Hash = 0;
+};
+
+/// Strings live in fixed size chunks that never move, so AsString needs no lock and the map can
+/// key on views into them. Lookups of known paths only take the shared lock.
+class PathTable
+{
+  public:
+  PathTable()
+  {
+    // index 0 is the empty path
+    m_chunks[0].store(new InternedPath[ChunkSize]);
+    m_map.emplace(std::string_view(), 0);
+    m_count = 1;
+  }
+
+  ~PathTable()
+  {
+    for (auto& chunk : m_chunks) {
+      delete[] chunk.load();
+    }
+  }
+
+  bool Find(std::string_view path, uint32_t& index, uint32_t& hash)
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+    auto it = m_map.find(path);
+    if (it == m_map.end())
+      return false;
+
+    index = it->second;
+    hash  = Get(index).Hash;
+    return true;
+  }
+
+  void Intern(std::string_view path, uint32_t& index, uint32_t& hash)
+  {
+    if (Find(path, index, hash))
+      return;
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+    auto it = m_map.find(path);
+    if (it != m_map.end()) {
+      index = it->second;
+      hash  = Get(index).Hash;
+      return;
+    }
+
+    index = m_count;
+    auto chunk = index / ChunkSize;
+
+    if (chunk >= MaxChunks) {
+      elog::LogError("Path intern table is full");
+      index = 0;
+      hash  = 0;
+      return;
+    }
+
+    if (!m_chunks[chunk].load(std::memory_order_relaxed))
+      m_chunks[chunk].store(new InternedPath[ChunkSize], std::memory_order_release);
+
+    auto& entry = m_chunks[chunk].load(std::memory_order_relaxed)[index % ChunkSize];
+    entry.Path  = core::String(path);
+    entry.Hash  = (uint32_t)std::hash<std::string_view>()(path);
+    hash        = entry.Hash;
+
+    m_map.emplace(std::string_view(entry.Path), index);
+    m_count++;
+  }
+
+  const InternedPath& Get(uint32_t index) const
+  {
+    return m_chunks[index / ChunkSize].load(std::memory_order_acquire)[index % ChunkSize];
+  }
+
+  private:
+  std::shared_mutex m_mutex;
+  core::UnorderedMap<std::string_view, uint32_t> m_map;
+  std::atomic<InternedPath*> m_chunks[MaxChunks] = {};
+  uint32_t m_count;
+};
+
+PathTable& GetPathTable()
+{
+  static PathTable table;
+  return table;
+}
+} // namespace
+
+PathId::PathId(const Path& path)
+    : PathId(std::string_view(path.AsString()))
+{
+}
+
+PathId::PathId(const core::String& path)
+    : PathId(std::string_view(path))
+{
+}
+
+PathId::PathId(std::string_view path)
+{
+  // callers may pass views of unnormalized strings
+  if (!io::path::IsNormalized(path)) {
+    auto normalized = io::path::Normalize(core::String(path));
+    GetPathTable().Intern(normalized, m_index, m_hash);
+    return;
+  }
+
+  GetPathTable().Intern(path, m_index, m_hash);
+}
+
+PathId PathId::Find(std::string_view path)
+{
+  uint32_t index = 0, hash = 0;
+
+  if (!io::path::IsNormalized(path))
+    return Find(io::path::Normalize(core::String(path)));
+
+  if (GetPathTable().Find(path, index, hash))
+    return PathId(index, hash);
+
+  return PathId();
+}
+
+const core::String& PathId::AsString() const
+{
+  return GetPathTable().Get(m_index).Path;
+}
+} // namespace io
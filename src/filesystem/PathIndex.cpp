@@ -0,0 +1,189 @@
+#include "PathIndex.h"
+#include <filesystem>
+
+namespace io {
+namespace {
+/// Guards against symlink cycles, physfs follows symlinks too.
+constexpr int MaxScanDepth = 32;
+/// Delta entries allowed before they are merged, relative to the base size.
+constexpr size_t MinMergeSize = 256;
+constexpr size_t MergeDivisor = 8;
+} // namespace
+
+PathIndex::PathIndex(core::SharedPtr<const EntryMap> base, core::SharedPtr<const EntryMap> delta,
+                     uint32_t mountCount, uint64_t incompleteMounts)
+    : m_base(core::Move(base))
+    , m_delta(core::Move(delta))
+    , m_mountCount(mountCount)
+    , m_incompleteMounts(incompleteMounts)
+{
+}
+
+core::SharedPtr<const PathIndex> PathIndex::Build(const core::Vector<core::String>& mounts)
+{
+  if (mounts.size() > MaxMounts)
+    return nullptr;
+
+  auto entries       = core::MakeShared<EntryMap>();
+  uint64_t incomplete = 0;
+
+  for (uint32_t i = 0; i < mounts.size(); i++) {
+    if (!mounts[i].empty() && !Scan(*entries, mounts[i], 1ull << i))
+      incomplete |= 1ull << i;
+  }
+
+  return core::SharedPtr<const PathIndex>(new PathIndex(
+      core::Move(entries), core::MakeShared<EntryMap>(), mounts.size(), incomplete));
+}
+
+core::SharedPtr<const PathIndex> PathIndex::WithMount(const core::String& directory,
+                                                      bool isArchive) const
+{
+  if (m_mountCount >= MaxMounts)
+    return nullptr;
+
+  auto entries = core::MakeShared<EntryMap>(Merge());
+
+  for (auto& entry : *entries) {
+    entry.second.Files <<= 1;
+    entry.second.Directories <<= 1;
+  }
+
+  auto incomplete = m_incompleteMounts << 1;
+  if (!isArchive && !Scan(*entries, directory, 1))
+    incomplete |= 1;
+
+  return core::SharedPtr<const PathIndex>(new PathIndex(
+      core::Move(entries), core::MakeShared<EntryMap>(), m_mountCount + 1, incomplete));
+}
+
+core::SharedPtr<const PathIndex> PathIndex::WithPath(const core::String& path, uint32_t mount,
+                                                     bool exists, bool isDirectory) const
+{
+  auto delta = core::MakeShared<EntryMap>(*m_delta);
+  auto bit   = 1ull << mount;
+
+  auto update = [&](const core::String& updatePath, bool directory) {
+    auto current = Find(updatePath);
+    auto entry   = current ? *current : Entry();
+    auto before  = entry;
+
+    // within one mount a path is either a file or a directory
+    entry.Files &= ~bit;
+    entry.Directories &= ~bit;
+
+    if (exists)
+      (directory ? entry.Directories : entry.Files) |= bit;
+
+    if (entry.Files == before.Files && entry.Directories == before.Directories)
+      return false;
+
+    (*delta)[updatePath] = entry;
+    return true;
+  };
+
+  bool changed = update(path, isDirectory);
+
+  // parents of an existing path exist, stop at the first one already known
+  for (auto end = path.rfind('/'); exists && end != core::String::npos && end > 0;
+       end      = path.rfind('/', end - 1)) {
+    if (!update(path.substr(0, end), true))
+      break;
+    changed = true;
+  }
+
+  if (!changed)
+    return shared_from_this();
+
+  auto index = core::SharedPtr<const PathIndex>(
+      new PathIndex(m_base, core::Move(delta), m_mountCount, m_incompleteMounts));
+
+  if (index->m_delta->size() < std::max(MinMergeSize, m_base->size() / MergeDivisor))
+    return index;
+
+  return core::SharedPtr<const PathIndex>(
+      new PathIndex(core::MakeShared<EntryMap>(index->Merge()), core::MakeShared<EntryMap>(),
+                    m_mountCount, m_incompleteMounts));
+}
+
+const PathIndex::Entry* PathIndex::Find(const core::String& path) const
+{
+  const Entry* entry = nullptr;
+
+  auto it = m_delta->find(path);
+  if (it != m_delta->end()) {
+    entry = &it->second;
+  }
+  else {
+    auto baseIt = m_base->find(path);
+    if (baseIt != m_base->end())
+      entry = &baseIt->second;
+  }
+
+  return entry && (entry->Files | entry->Directories) ? entry : nullptr;
+}
+
+bool PathIndex::Scan(EntryMap& entries, const core::String& directory, uint64_t bit)
+{
+  namespace fs = std::filesystem;
+
+  struct Pending
+  {
+    fs::path Path;
+    int Depth;
+  };
+
+  // directories are listed one by one, an error only loses the directory it happened in
+  fs::path root(directory);
+  core::Vector<Pending> pending{ { root, 0 } };
+  bool complete = true;
+
+  while (!pending.empty()) {
+    auto current = core::Move(pending.back());
+    pending.pop_back();
+
+    std::error_code error;
+    fs::directory_iterator it(current.Path, fs::directory_options::skip_permission_denied, error);
+
+    for (fs::directory_iterator end; !error && it != end; it.increment(error)) {
+      // follows symlinks like physfs, broken ones are indexed as files
+      std::error_code statusError;
+      bool isDirectory = it->is_directory(statusError);
+
+      auto& entry = entries[it->path().lexically_relative(root).generic_string()];
+      (isDirectory ? entry.Directories : entry.Files) |= bit;
+
+      if (!isDirectory)
+        continue;
+
+      // deeper directories are left to physfs, lookups can not trust their misses
+      if (current.Depth < MaxScanDepth)
+        pending.push_back({ it->path(), current.Depth + 1 });
+      else
+        complete = false;
+    }
+
+    if (error) {
+      elog::LogWarning(core::string::format("Failed to index '{}': {}, lookups fall back to physfs",
+                                            current.Path.string(), error.message()));
+      complete = false;
+    }
+  }
+
+  return complete;
+}
+
+PathIndex::EntryMap PathIndex::Merge() const
+{
+  auto merged = *m_base;
+
+  for (auto& entry : *m_delta) {
+    if (entry.second.Files | entry.second.Directories)
+      merged[entry.first] = entry.second;
+    else
+      merged.erase(entry.first);
+  }
+
+  return merged;
+}
+} // namespace io
@@ -0,0 +1,65 @@
+#ifndef PATH_INDEX_H
+#define PATH_INDEX_H
+
+namespace io {
+/// Immutable map from relative path to the mounts containing it, so existence checks and open
+/// lookups cost one hash probe instead of a stat per mount. Changes return a new index that shares
+/// the bulk of its entries with the old one, small edits go into a delta merged once it grows.
+/// Mount 0 has the highest priority, archives take up a slot but are never scanned.
+class PathIndex : public std::enable_shared_from_this<PathIndex>
+{
+  public:
+  static constexpr uint32_t MaxMounts = 64;
+
+  struct Entry
+  {
+    /// Bit n is set if mount n contains the path as a file or as a directory.
+    uint64_t Files       = 0;
+    uint64_t Directories = 0;
+  };
+
+  /// Index of 'mounts' in priority order, empty strings stand for archives.
+  /// Returns nullptr if there are more than MaxMounts.
+  static core::SharedPtr<const PathIndex> Build(const core::Vector<core::String>& mounts);
+
+  /// Index with 'directory' prepended as the new highest priority mount, nullptr if full.
+  core::SharedPtr<const PathIndex> WithMount(const core::String& directory, bool isArchive) const;
+  /// Index where 'path' exists or not in 'mount'. Creating a path also creates its parents.
+  /// Returns this index if nothing changes.
+  core::SharedPtr<const PathIndex> WithPath(const core::String& path, uint32_t mount, bool exists,
+                                            bool isDirectory) const;
+
+  /// Entry of a path without leading or trailing separators, nullptr if no mount contains it.
+  const Entry* Find(const core::String& path) const;
+
+  uint32_t GetMountCount() const
+  {
+    return m_mountCount;
+  }
+
+  /// Bit n is set if mount n could not be scanned completely, its misses are not reliable.
+  uint64_t GetIncompleteMounts() const
+  {
+    return m_incompleteMounts;
+  }
+
+  private:
+  using EntryMap = core::UnorderedMap<core::String, Entry>;
+
+  PathIndex(core::SharedPtr<const EntryMap> base, core::SharedPtr<const EntryMap> delta,
+            uint32_t mountCount, uint64_t incompleteMounts);
+
+  /// False if a directory could not be listed or lies too deep, the rest is scanned anyway.
+  static bool Scan(EntryMap& entries, const core::String& directory, uint64_t bit);
+  /// Base and delta folded into one map.
+  EntryMap Merge() const;
+
+  core::SharedPtr<const EntryMap> m_base;
+  /// Overrides base entries, all-zero entries mark paths that are gone.
+  core::SharedPtr<const EntryMap> m_delta;
+  uint32_t m_mountCount;
+  uint64_t m_incompleteMounts;
+};
+} // namespace io
+
+#endif
@@ -22,59 +22,88 @@ core::String Append(const core::String& path, const core::String& pathToAppend)
 
 core::String GetFileName(const core::String& path)
 {
-  auto pos = path.find_last_of(Separator);
+  return core::String(GetFileNameView(path));
+}
 
-  if (pos == core::String::npos)
-    return path;
+core::String GetExtension(const core::String& path)
+{
+  return core::String(GetExtensionView(path));
+}
 
-  return path.substr(pos + 1);
+core::String GetParentDirectory(const core::String& path)
+{
+  return core::String(GetParentDirectoryView(path));
 }
 
-core::String GetExtension(const core::String& path)
+bool HasFileName(const core::String& path)
 {
-  // Note: could avoid creating temp string
-  auto name = GetFileName(path);
+  return GetFileNameView(path).size() > 0;
+}
+
+core::String ConvertToUnixPath(const core::String& path)
+{
+  return core::string::Replace(path, WindowsSeparatorStr, SeparatorStr);
+}
 
-  if (name.size() > 0) {
-    auto pos = name.find_last_of(".");
+core::String Normalize(const core::String& path)
+{
+  auto normalizedPath = path;
+  NormalizeInPlace(normalizedPath);
+  return normalizedPath;
+}
 
-    if (pos != core::String::npos && pos > 0) {
-      return name.substr(pos);
-    }
+void NormalizeInPlace(core::String& path)
+{
+  if (IsNormalized(path))
+    return;
+
+  auto duplicatePred = [](const char a, const char b) { return a == Separator && b == Separator; };
+
+  std::replace(path.begin(), path.end(), WindowsSeparator, Separator);
+  path.erase(std::unique(path.begin(), path.end(), duplicatePred), path.end());
+}
+
+bool IsNormalized(std::string_view path)
+{
+  for (size_t i = 0; i < path.size(); i++) {
+    if (path[i] == WindowsSeparator)
+      return false;
+    if (path[i] == Separator && i + 1 < path.size() && path[i + 1] == Separator)
+      return false;
   }
 
-  return "";
+  return true;
 }
 
-core::String GetParentDirectory(const core::String& path)
+std::string_view GetFileNameView(std::string_view path)
 {
   auto pos = path.find_last_of(Separator);
 
-  if (pos == core::String::npos)
+  if (pos == std::string_view::npos)
     return path;
 
-  return path.substr(0, pos);
+  return path.substr(pos + 1);
 }
 
-bool HasFileName(const core::String& path)
+std::string_view GetExtensionView(std::string_view path)
 {
-  return GetFileName(path).size() > 0;
-}
+  auto name = GetFileNameView(path);
+  auto pos  = name.find_last_of('.');
 
-core::String ConvertToUnixPath(const core::String& path)
-{
-  return core::string::Replace(path, WindowsSeparatorStr, SeparatorStr);
+  if (pos != std::string_view::npos && pos > 0)
+    return name.substr(pos);
+
+  return {};
 }
 
-core::String Normalize(const core::String& path)
+std::string_view GetParentDirectoryView(std::string_view path)
 {
-  auto normalizedPath = ConvertToUnixPath(path);
-  auto duplicatePred  = [](const char a, const char b) { return a == Separator && b == Separator; };
+  auto pos = path.find_last_of(Separator);
 
-  normalizedPath.erase(std::unique(normalizedPath.begin(), normalizedPath.end(), duplicatePred),
-                       normalizedPath.end());
+  if (pos == std::string_view::npos)
+    return path;
 
-  return normalizedPath;
+  return path.substr(0, pos);
 }
 } // namespace path
 } // namespace io
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "filesystem/StreamingFileReader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace io {
+StreamingFileReader::StreamingFileReader(core::UniquePtr<IFileReader> reader, size_t chunkSize,
+                                         uint32_t chunkCount)
+    : m_reader(core::Move(reader))
+    , m_length(m_reader ? m_reader->GetLength() : -1)
+    , m_position(0)
+    , m_chunkSize(std::max<size_t>(chunkSize, 1))
+    , m_chunks(std::max<uint32_t>(chunkCount, 2))
+    , m_head(0)
+    , m_tail(0)
+    , m_generation(0)
+    , m_fillOffset(0)
+    , m_failed(false)
+    , m_stop(false)
+{
+  if (m_length < 0)
+    return;
+
+  m_position   = std::max<std::intmax_t>(m_reader->GetPosition(), 0);
+  m_fillOffset = m_position;
+  m_thread     = std::thread([this]() { Run(); });
+}
+
+StreamingFileReader::~StreamingFileReader()
+{
+  if (!m_thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_consumed.notify_one();
+  m_thread.join();
+}
+
+std::intmax_t StreamingFileReader::GetLength() const
+{
+  return m_length;
+}
+
+std::intmax_t StreamingFileReader::GetPosition() const
+{
+  return m_length < 0 ? -1 : (std::intmax_t)m_position;
+}
+
+template <class T> std::intmax_t StreamingFileReader::ReadInto(T& buffer, std::uintmax_t size)
+{
+  if (m_length >= 0) {
+    std::uintmax_t readSize = m_position < (std::uintmax_t)m_length ? m_length - m_position : 0;
+    if (size < readSize)
+      readSize = size;
+
+    buffer.resize(readSize);
+
+    if (Read((void*)buffer.data(), readSize) == (std::intmax_t)readSize)
+      return readSize;
+  }
+
+  // Failed to read, buffer should be empty.
+  T().swap(buffer);
+  return -1;
+}
+
+std::intmax_t StreamingFileReader::Read(core::TByteArray& array, std::uintmax_t size)
+{
+  return ReadInto(array, size);
+}
+
+std::intmax_t StreamingFileReader::Read(std::string& string, std::uintmax_t size)
+{
+  return ReadInto(string, size);
+}
+
+std::intmax_t StreamingFileReader::Read(void* buffer, std::uintmax_t size)
+{
+  if (m_length < 0)
+    return -1;
+
+  std::uintmax_t readSize = m_position < (std::uintmax_t)m_length ? m_length - m_position : 0;
+  if (size < readSize)
+    readSize = size;
+
+  auto destination      = (uint8_t*)buffer;
+  std::uintmax_t copied = 0;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (copied < readSize) {
+    if (m_head == m_tail) {
+      if (m_failed)
+        break;
+
+      auto start = std::chrono::steady_clock::now();
+      m_filled.wait(lock, [this]() { return m_head != m_tail || m_failed; });
+
+      m_stats.Stalls++;
+      m_stats.StallSeconds +=
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      continue;
+    }
+
+    // the head chunk stays ours until m_head moves past it, no need to hold the lock for copying
+    auto& chunk = m_chunks[m_head % m_chunks.size()];
+    lock.unlock();
+
+    auto chunkPosition = m_position - chunk.Offset;
+    auto count         = std::min<std::uintmax_t>(chunk.Size - chunkPosition, readSize - copied);
+    std::memcpy(destination + copied, chunk.Data.data() + chunkPosition, count);
+    copied += count;
+    m_position += count;
+
+    lock.lock();
+    if (m_position == chunk.Offset + chunk.Size) {
+      m_head++;
+      m_consumed.notify_one();
+    }
+  }
+
+  m_stats.BytesRead += copied;
+  return copied > 0 || !m_failed ? (std::intmax_t)copied : -1;
+}
+
+bool StreamingFileReader::Seek(std::uintmax_t position)
+{
+  // physfs refuses seeking past the end, keep the same behaviour
+  if (m_length < 0 || position > (std::uintmax_t)m_length)
+    return false;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_head != m_tail && position >= m_chunks[m_head % m_chunks.size()].Offset &&
+      position < m_fillOffset) {
+    // inside the filled window, only the chunks before the new position are done
+    while (position >= m_chunks[m_head % m_chunks.size()].Offset +
+                           m_chunks[m_head % m_chunks.size()].Size) {
+      m_head++;
+    }
+  }
+  else if (m_head != m_tail || position != m_fillOffset) {
+    m_generation++;
+    m_head       = m_tail;
+    m_fillOffset = position;
+    m_failed     = false;
+  }
+
+  m_position = position;
+  m_consumed.notify_one();
+  return true;
+}
+
+StreamingReadStats StreamingFileReader::GetStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+void StreamingFileReader::Run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // where the wrapped reader is, so sequential chunks need no seek
+  auto readerPosition = m_fillOffset;
+
+  while (true) {
+    m_consumed.wait(lock, [this]() {
+      return m_stop || (!m_failed && m_tail - m_head < m_chunks.size() &&
+                        m_fillOffset < (std::uintmax_t)m_length);
+    });
+
+    if (m_stop)
+      return;
+
+    auto generation = m_generation;
+    auto offset     = m_fillOffset;
+    auto& chunk     = m_chunks[m_tail % m_chunks.size()];
+    lock.unlock();
+
+    auto size = std::min<std::uintmax_t>(m_chunkSize, m_length - offset);
+    if (chunk.Data.size() < m_chunkSize)
+      chunk.Data.resize(m_chunkSize);
+
+    std::intmax_t bytesRead = -1;
+    if (readerPosition == offset || m_reader->Seek(offset))
+      bytesRead = m_reader->Read(chunk.Data.data(), size);
+
+    readerPosition =
+        bytesRead > 0 ? offset + bytesRead : std::numeric_limits<std::uintmax_t>::max();
+
+    lock.lock();
+
+    if (generation != m_generation)
+      continue;
+
+    // the file is not expected to shrink while open, running short counts as failure
+    if (bytesRead <= 0) {
+      elog::LogError(core::string::format("Read-ahead at offset {} failed", offset));
+      m_failed = true;
+    }
+    else {
+      chunk.Offset = offset;
+      chunk.Size   = bytesRead;
+      m_fillOffset = offset + bytesRead;
+      m_tail++;
+      m_stats.BytesPrefetched += bytesRead;
+    }
+
+    m_filled.notify_one();
+  }
+}
+} // namespace io
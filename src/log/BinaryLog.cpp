@@ -0,0 +1,247 @@
+#include "log/BinaryLog.h"
+#include <chrono>
+
+namespace elog {
+namespace {
+class LogFormatRegistry
+{
+  public:
+  static LogFormatRegistry& Get()
+  {
+    static LogFormatRegistry registry;
+    return registry;
+  }
+
+  uint32_t Register(const char* format, const LogArgType* types, uint32_t count)
+  {
+    core::String key(reinterpret_cast<const char*>(types), count);
+    key += '\0';
+    key += format;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_ids.find(key);
+    if (it != m_ids.end())
+      return it->second;
+
+    auto logFormat    = core::MakeUnique<LogFormat>();
+    logFormat->Format = format;
+    logFormat->Types.assign(types, types + count);
+    m_formats.push_back(core::Move(logFormat));
+
+    uint32_t id = m_formats.size();
+    m_ids.emplace(core::Move(key), id);
+    return id;
+  }
+
+  const LogFormat* Find(uint32_t id)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return id > 0 && id <= m_formats.size() ? m_formats[id - 1].get() : nullptr;
+  }
+
+  private:
+  std::mutex m_mutex;
+  /// Id - 1 to format, entries never move so pointers stay valid.
+  core::Vector<core::UniquePtr<LogFormat>> m_formats;
+  /// Argument types, a null byte and the format to id.
+  core::UnorderedMap<core::String, uint32_t> m_ids;
+};
+
+int64_t SteadyNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+std::atomic<uint32_t> s_threadCount{ 0 };
+
+std::mutex s_sinkMutex;
+core::SharedPtr<BinaryLogSink> s_sink;
+/// Sinks replaced while a thread may still be writing to them, kept until exit.
+core::Vector<core::SharedPtr<BinaryLogSink>> s_retiredSinks;
+} // namespace
+
+uint32_t RegisterLogFormat(const char* format, const LogArgType* types, uint32_t count)
+{
+  return LogFormatRegistry::Get().Register(format, types, count);
+}
+
+const LogFormat* GetLogFormat(uint32_t id)
+{
+  return LogFormatRegistry::Get().Find(id);
+}
+
+core::SharedPtr<BinaryLogSink> BinaryLogSink::Open(const core::String& nativePath)
+{
+  FILE* file = std::fopen(nativePath.c_str(), "wb");
+
+  if (!file) {
+    elog::LogError(core::string::format("Failed to create binary log '{}'", nativePath));
+    return nullptr;
+  }
+
+  // records are buffered here already
+  std::setvbuf(file, nullptr, _IONBF, 0);
+  return core::SharedPtr<BinaryLogSink>(new BinaryLogSink(file));
+}
+
+BinaryLogSink::BinaryLogSink(FILE* file)
+    : m_file(file)
+    , m_lastTime(SteadyNow())
+    , m_recordCount(0)
+    , m_bytesWritten(0)
+{
+  m_buffer.reserve(BufferSize);
+
+  uint64_t openTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+  m_buffer.insert(m_buffer.end(), detail::BinaryLogMagic, detail::BinaryLogMagic + 8);
+  detail::WriteRaw(m_buffer, detail::BinaryLogVersion);
+  detail::WriteRaw(m_buffer, openTime);
+  m_bytesWritten = m_buffer.size();
+}
+
+BinaryLogSink::~BinaryLogSink()
+{
+  Close();
+}
+
+void BinaryLogSink::Log(const LogSource source, const LogSeverity severity,
+                        const core::String& logString)
+{
+  static LogCallSite textSite;
+  auto& buffer = detail::GetLogArgBuffer();
+  detail::WriteString(buffer, logString.data(), logString.size());
+
+  auto id = textSite.Id.load(std::memory_order_relaxed);
+  if (id == 0) {
+    auto type = LogArgType::String;
+    id        = RegisterLogFormat("{}", &type, 1);
+    textSite.Id.store(id, std::memory_order_relaxed);
+  }
+
+  Write(source, severity, id, buffer.data(), buffer.size());
+}
+
+void BinaryLogSink::Flush()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  WriteBuffer();
+
+  if (m_file)
+    std::fflush(m_file);
+}
+
+void BinaryLogSink::Write(LogSource source, LogSeverity severity, uint32_t formatId,
+                          const uint8_t* args, size_t size)
+{
+  auto now    = SteadyNow();
+  auto thread = detail::GetLogThreadIndex();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_file)
+    return;
+
+  if (formatId >= m_formatsWritten.size() || !m_formatsWritten[formatId])
+    WriteFormat(formatId);
+
+  auto start = m_buffer.size();
+  m_buffer.push_back(detail::BinaryLogRecordTag | (uint8_t)severity << 3 | (uint8_t)source);
+  detail::WriteVarint(m_buffer, formatId);
+  detail::WriteVarint(m_buffer, detail::ZigZag(now - m_lastTime));
+  detail::WriteVarint(m_buffer, thread);
+  m_buffer.insert(m_buffer.end(), args, args + size);
+
+  m_lastTime = now;
+  m_recordCount++;
+  m_bytesWritten += m_buffer.size() - start;
+
+  auto important = GetSeverityLevel(severity) >= GetSeverityLevel(LogSeverity::Error);
+  if (important || m_buffer.size() >= BufferSize)
+    WriteBuffer();
+}
+
+void BinaryLogSink::Close()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  WriteBuffer();
+
+  if (m_file) {
+    std::fclose(m_file);
+    m_file = nullptr;
+  }
+}
+
+uint64_t BinaryLogSink::GetRecordCount() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_recordCount;
+}
+
+uint64_t BinaryLogSink::GetBytesWritten() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_bytesWritten;
+}
+
+void BinaryLogSink::WriteFormat(uint32_t formatId)
+{
+  auto format = GetLogFormat(formatId);
+  if (!format)
+    return;
+
+  auto start = m_buffer.size();
+  m_buffer.push_back(detail::BinaryLogFormatTag);
+  detail::WriteVarint(m_buffer, formatId);
+  detail::WriteVarint(m_buffer, format->Types.size());
+  for (auto type : format->Types) {
+    m_buffer.push_back((uint8_t)type);
+  }
+  detail::WriteString(m_buffer, format->Format.data(), format->Format.size());
+  m_bytesWritten += m_buffer.size() - start;
+
+  if (formatId >= m_formatsWritten.size())
+    m_formatsWritten.resize(formatId + 1);
+  m_formatsWritten[formatId] = true;
+}
+
+void BinaryLogSink::WriteBuffer()
+{
+  if (m_file && !m_buffer.empty())
+    std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+  m_buffer.clear();
+}
+
+void SetBinaryLogSink(const core::SharedPtr<BinaryLogSink>& sink)
+{
+  std::lock_guard<std::mutex> lock(s_sinkMutex);
+  if (s_sink == sink)
+    return;
+
+  detail::ActiveBinarySink.store(sink.get(), std::memory_order_release);
+
+  if (s_sink) {
+    s_sink->Close();
+    s_retiredSinks.push_back(core::Move(s_sink));
+  }
+
+  s_sink = sink;
+}
+
+namespace detail {
+uint32_t GetLogThreadIndex()
+{
+  static thread_local uint32_t index = s_threadCount.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+core::Vector<uint8_t>& GetLogArgBuffer()
+{
+  static thread_local core::Vector<uint8_t> buffer;
+  buffer.clear();
+  return buffer;
+}
+} // namespace detail
+} // namespace elog
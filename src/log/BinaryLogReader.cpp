@@ -0,0 +1,256 @@
+#include "log/BinaryLogReader.h"
+#include "filesystem/MappedFile.h"
+#include "fmt/args.h"
+#include <cstring>
+
+namespace elog {
+namespace {
+const size_t HeaderSize = sizeof(detail::BinaryLogMagic) + sizeof(uint32_t) + sizeof(uint64_t);
+/// Format ids are registered per process, a file skips the ids that were never logged to it.
+/// Larger jumps only come from corrupt files and would size the format table.
+const uint64_t MaxFormatIdGap = 1 << 16;
+} // namespace
+
+core::UniquePtr<BinaryLogReader> BinaryLogReader::Open(const core::String& nativePath)
+{
+  auto mapping = io::MappedFile::Open(nativePath);
+
+  if (!mapping) {
+    elog::LogError(core::string::format("Failed to open binary log '{}'", nativePath));
+    return nullptr;
+  }
+
+  return Open(core::UniquePtr<io::IFileMapping>(core::Move(mapping)));
+}
+
+core::UniquePtr<BinaryLogReader> BinaryLogReader::Open(core::UniquePtr<io::IFileMapping> mapping)
+{
+  auto data = mapping->GetData();
+  uint32_t version;
+  uint64_t openTime;
+
+  if (mapping->GetSize() < HeaderSize ||
+      memcmp(data, detail::BinaryLogMagic, sizeof(detail::BinaryLogMagic))) {
+    elog::LogError("Not a binary log, the header does not match");
+    return nullptr;
+  }
+
+  memcpy(&version, data + sizeof(detail::BinaryLogMagic), sizeof(version));
+  memcpy(&openTime, data + sizeof(detail::BinaryLogMagic) + sizeof(version), sizeof(openTime));
+
+  if (version != detail::BinaryLogVersion) {
+    elog::LogError(core::string::format("Unsupported binary log version {}", version));
+    return nullptr;
+  }
+
+  return core::UniquePtr<BinaryLogReader>(new BinaryLogReader(core::Move(mapping), openTime));
+}
+
+BinaryLogReader::BinaryLogReader(core::UniquePtr<io::IFileMapping> mapping, uint64_t openTime)
+    : m_mapping(core::Move(mapping))
+    , m_position(m_mapping->GetData() + HeaderSize)
+    , m_end(m_mapping->GetData() + m_mapping->GetSize())
+    , m_openTime(openTime)
+    , m_time(0)
+    , m_error(false)
+{
+}
+
+BinaryLogReader::~BinaryLogReader() = default;
+
+bool BinaryLogReader::Next(BinaryLogRecord& record)
+{
+  while (!m_error && m_position < m_end) {
+    uint8_t tag = *m_position++;
+
+    if (tag == detail::BinaryLogFormatTag) {
+      m_error = !ReadFormat();
+      continue;
+    }
+
+    uint64_t formatId, delta, thread;
+    if (!(tag & detail::BinaryLogRecordTag) || !ReadVarint(formatId) || !ReadVarint(delta) ||
+        !ReadVarint(thread) || formatId >= m_formats.size() || !m_formats[formatId]) {
+      m_error = true;
+      break;
+    }
+
+    auto severity = (tag >> 3) & 0xF;
+    auto source   = tag & 0x7;
+    if (severity > (uint8_t)LogSeverity::Debug || source > (uint8_t)LogSource::Other) {
+      m_error = true;
+      break;
+    }
+
+    // zigzag
+    m_time += int64_t(delta >> 1) ^ -int64_t(delta & 1);
+
+    auto& format    = *m_formats[formatId];
+    record.Time     = m_openTime + m_time;
+    record.Thread   = thread;
+    record.Severity = (LogSeverity)severity;
+    record.Source   = (LogSource)source;
+    record.FormatId = formatId;
+    record.Format   = format.Format;
+    record.Arguments.resize(format.Types.size());
+
+    for (uint32_t i = 0; i < format.Types.size(); i++) {
+      if (!ReadArgument(format.Types[i], record.Arguments[i])) {
+        m_error = true;
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  if (m_error)
+    elog::LogError("Binary log is truncated or corrupt");
+
+  return false;
+}
+
+core::String BinaryLogReader::FormatMessage(const BinaryLogRecord& record)
+{
+  fmt::dynamic_format_arg_store<fmt::format_context> args;
+
+  for (auto& argument : record.Arguments) {
+    switch (argument.Type) {
+    case LogArgType::Int: args.push_back(argument.Int); break;
+    case LogArgType::UInt: args.push_back(argument.UInt); break;
+    case LogArgType::Bool: args.push_back(argument.Int != 0); break;
+    case LogArgType::Float: args.push_back((float)argument.Real); break;
+    case LogArgType::Double: args.push_back(argument.Real); break;
+    case LogArgType::String: args.push_back(argument.Text); break;
+    case LogArgType::Vec3: args.push_back(argument.Vec3); break;
+    }
+  }
+
+  // the format was never checked by fmt when it was logged
+  try {
+    return fmt::vformat(record.Format, args);
+  }
+  catch (const fmt::format_error&) {
+    return record.Format;
+  }
+}
+
+bool BinaryLogReader::ReadFormat()
+{
+  uint64_t id, count;
+  if (!ReadVarint(id) || !ReadVarint(count) || id == 0 || id > m_formats.size() + MaxFormatIdGap)
+    return false;
+
+  // one byte per argument type
+  if (count > (uint64_t)(m_end - m_position))
+    return false;
+
+  auto format = core::MakeUnique<LogFormat>();
+  format->Types.resize(count);
+
+  for (auto& type : format->Types) {
+    uint8_t value;
+    if (!ReadBytes(&value, 1) || value > (uint8_t)LogArgType::Vec3)
+      return false;
+    type = (LogArgType)value;
+  }
+
+  if (!ReadString(format->Format))
+    return false;
+
+  if (id >= m_formats.size())
+    m_formats.resize(id + 1);
+  m_formats[id] = core::Move(format);
+  return true;
+}
+
+bool BinaryLogReader::ReadArgument(LogArgType type, LogArgument& argument)
+{
+  argument.Type = type;
+  uint64_t value;
+  float real;
+
+  switch (type) {
+  case LogArgType::Int:
+    if (!ReadVarint(value))
+      return false;
+    argument.Int = int64_t(value >> 1) ^ -int64_t(value & 1);
+    return true;
+  case LogArgType::UInt: return ReadVarint(argument.UInt);
+  case LogArgType::Bool: {
+    uint8_t flag;
+    if (!ReadBytes(&flag, 1))
+      return false;
+    argument.Int = flag;
+    return true;
+  }
+  case LogArgType::Float:
+    if (!ReadBytes(&real, sizeof(real)))
+      return false;
+    argument.Real = real;
+    return true;
+  case LogArgType::Double: return ReadBytes(&argument.Real, sizeof(argument.Real));
+  case LogArgType::String: return ReadString(argument.Text);
+  case LogArgType::Vec3: return ReadBytes(&argument.Vec3, sizeof(float) * 3);
+  }
+
+  return false;
+}
+
+bool BinaryLogReader::ReadVarint(uint64_t& value)
+{
+  value = 0;
+
+  for (uint32_t shift = 0; shift < 64 && m_position < m_end; shift += 7) {
+    uint8_t byte = *m_position++;
+    value |= uint64_t(byte & 0x7F) << shift;
+
+    if (!(byte & 0x80))
+      return true;
+  }
+
+  return false;
+}
+
+bool BinaryLogReader::ReadBytes(void* data, size_t size)
+{
+  if (size_t(m_end - m_position) < size)
+    return false;
+
+  memcpy(data, m_position, size);
+  m_position += size;
+  return true;
+}
+
+bool BinaryLogReader::ReadString(core::String& string)
+{
+  uint64_t size;
+  if (!ReadVarint(size) || size > uint64_t(m_end - m_position))
+    return false;
+
+  string.assign(reinterpret_cast<const char*>(m_position), size);
+  m_position += size;
+  return true;
+}
+
+const char* GetSeverityName(LogSeverity severity)
+{
+  switch (severity) {
+  case LogSeverity::Info: return "Info";
+  case LogSeverity::Warn: return "Warn";
+  case LogSeverity::Error: return "Error";
+  case LogSeverity::Critical: return "Critical";
+  case LogSeverity::Debug: return "Debug";
+  }
+  return "Unknown";
+}
+
+const char* GetSourceName(LogSource source)
+{
+  switch (source) {
+  case LogSource::Engine: return "Engine";
+  case LogSource::Other: return "Other";
+  }
+  return "Unknown";
+}
+} // namespace elog
@@ -1,7 +1,112 @@
 #include "log/Log.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace elog {
 namespace {
+struct LogRecord
+{
+  LogSource Source;
+  LogSeverity Severity;
+  core::String Text;
+};
+
+/// Bounded multi producer, single consumer queue. Producers claim a slot with one compare and
+/// swap on the tail, each slot's sequence tells whether it is free, filled or still being written.
+class LogRing
+{
+  public:
+  LogRing(uint32_t capacity)
+      : m_slots(new Slot[capacity])
+      , m_mask(capacity - 1)
+      , m_tail(0)
+      , m_head(0)
+  {
+    for (uint32_t i = 0; i < capacity; i++) {
+      m_slots[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /// 'text' is only moved from if the record was queued.
+  bool TryPush(LogSource source, LogSeverity severity, core::String& text)
+  {
+    auto position = m_tail.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    while (true) {
+      slot          = &m_slots[position & m_mask];
+      auto sequence = slot->Sequence.load(std::memory_order_acquire);
+      auto distance = (int64_t)(sequence - position);
+
+      if (distance == 0) {
+        if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (distance < 0) {
+        return false;
+      }
+      else {
+        position = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->Record.Source   = source;
+    slot->Record.Severity = severity;
+    slot->Record.Text     = core::Move(text);
+    slot->Sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer only.
+  bool TryPop(LogRecord& record)
+  {
+    auto& slot = m_slots[m_head & m_mask];
+
+    if (slot.Sequence.load(std::memory_order_acquire) != m_head + 1)
+      return false;
+
+    record = core::Move(slot.Record);
+    slot.Sequence.store(m_head + m_mask + 1, std::memory_order_release);
+    m_head++;
+    return true;
+  }
+
+  /// Positions handed out to producers so far.
+  uint64_t GetPushed() const
+  {
+    return m_tail.load(std::memory_order_acquire);
+  }
+
+  /// Consumer only.
+  uint64_t GetPopped() const
+  {
+    return m_head;
+  }
+
+  private:
+  struct Slot
+  {
+    std::atomic<uint64_t> Sequence;
+    LogRecord Record;
+  };
+
+  core::UniquePtr<Slot[]> m_slots;
+  uint64_t m_mask;
+  /// Producers and consumer write on separate cache lines.
+  alignas(64) std::atomic<uint64_t> m_tail;
+  alignas(64) uint64_t m_head;
+};
+
+uint32_t RoundUpToPowerOfTwo(uint32_t value)
+{
+  uint32_t capacity = 2;
+  while (capacity < value)
+    capacity *= 2;
+  return capacity;
+}
+
 class Logger
 {
   public:
@@ -14,29 +119,48 @@ class Logger
   public:
   void Log(const LogSource source, const LogSeverity severity, const core::String& str)
   {
+    if (TryLogAsync(source, severity, str))
+      return;
+
+    std::lock_guard<std::mutex> lock(m_streamMutex);
     for (auto wlogStream : m_logStreams) {
       if (!wlogStream.expired()) {
         auto logPipe = wlogStream.lock();
         logPipe->Log(source, severity, str);
+        if (logPipe->NeedsFlushPerRecord())
+          logPipe->Flush();
       }
     }
   }
 
+  void Log(const LogSource source, const LogSeverity severity, core::String&& str)
+  {
+    // core::Move returns by value, str has to stay intact if it is not pushed
+    if (TryLogAsync(source, severity, std::move(str)))
+      return;
+
+    Log(source, severity, static_cast<const core::String&>(str));
+  }
+
   ~Logger(){
+      StopAsync();
       //m_logStreams.clear();
   }
 
   void AttachStream(const core::WeakPtr<ILogStream>& wlogStream)
   {
+    std::lock_guard<std::mutex> lock(m_streamMutex);
     m_logStreams.push_back(wlogStream);
   }
 
   void ClearStreams(){
+      std::lock_guard<std::mutex> lock(m_streamMutex);
       m_logStreams.clear();
   }
 
   void CleanDeadStreams()
   {
+    std::lock_guard<std::mutex> lock(m_streamMutex);
     auto it = std::begin(m_logStreams);
 
     while (it != std::end(m_logStreams)) {
@@ -47,14 +171,249 @@ class Logger
     }
   }
 
+  void StartAsync(const AsyncLogOptions& options)
+  {
+    std::lock_guard<std::mutex> lock(m_controlMutex);
+
+    if (m_async.load())
+      return;
+
+    // rings are kept until exit, a producer that saw the previous one may still touch it
+    m_rings.push_back(core::MakeUnique<LogRing>(RoundUpToPowerOfTwo(options.Capacity)));
+    m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+    m_overflow = options.Overflow;
+    {
+      // counts positions of the new ring, flushes would compare against the previous one
+      std::lock_guard<std::mutex> wakeLock(m_wakeMutex);
+      m_stop       = false;
+      m_dispatched = 0;
+    }
+    m_thread = std::thread([this]() { Run(); });
+    m_async.store(true, std::memory_order_release);
+  }
+
+  void StopAsync()
+  {
+    std::lock_guard<std::mutex> lock(m_controlMutex);
+
+    if (!m_async.load())
+      return;
+
+    // records logged after this are dispatched on their own thread, the ring is drained first
+    m_async.store(false);
+    {
+      std::lock_guard<std::mutex> wakeLock(m_wakeMutex);
+      m_stop = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+  }
+
+  void Flush()
+  {
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+
+    if (!m_async.load() || IsLogThread())
+      return;
+
+    auto target = m_ring.load()->GetPushed();
+    m_wake.notify_one();
+    m_flushed.wait(lock, [&]() { return m_dispatched >= target || m_stop; });
+  }
+
+  uint64_t GetDropped() const
+  {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
   private:
+  static bool& IsLogThread()
+  {
+    thread_local bool logThread = false;
+    return logThread;
+  }
+
+  /// Pushes the record if logging is async, false if the caller has to dispatch it.
+  template <class TText> bool TryLogAsync(LogSource source, LogSeverity severity, TText&& text)
+  {
+    // counted before m_async is read, so a stop either waits for this push or is seen by it
+    m_producers.fetch_add(1);
+    bool async = m_async.load() && !IsLogThread();
+
+    if (async) {
+      core::String owned(std::forward<TText>(text));
+      Push(source, severity, owned);
+    }
+
+    m_producers.fetch_sub(1, std::memory_order_release);
+    return async;
+  }
+
+  void Push(LogSource source, LogSeverity severity, core::String& text)
+  {
+    auto ring = m_ring.load(std::memory_order_acquire);
+
+    while (!ring->TryPush(source, severity, text)) {
+      if (m_overflow == LogOverflowPolicy::Drop)
+        return;
+
+      if (m_overflow == LogOverflowPolicy::DropAndCount) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+
+      // logging was stopped while waiting for room
+      if (!m_async.load(std::memory_order_acquire)) {
+        Log(source, severity, static_cast<const core::String&>(text));
+        return;
+      }
+
+      WakeLogThread();
+      std::this_thread::yield();
+    }
+
+    // pairs with the fence in Run, either the log thread sees the record or this sees it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed))
+      WakeLogThread();
+  }
+
+  void WakeLogThread()
+  {
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wake.notify_one();
+  }
+
+  void Run()
+  {
+    IsLogThread() = true;
+    auto ring     = m_ring.load(std::memory_order_relaxed);
+    LogRecord record;
+    // drops before a restart were reported by the previous log thread
+    uint64_t reportedDrops = GetDropped();
+    core::Vector<core::SharedPtr<ILogStream>> streams;
+
+    while (true) {
+      {
+        // streams are resolved once per batch instead of once per record
+        std::lock_guard<std::mutex> lock(m_streamMutex);
+        streams.clear();
+        for (auto& wlogStream : m_logStreams) {
+          if (auto stream = wlogStream.lock())
+            streams.push_back(core::Move(stream));
+        }
+      }
+
+      bool dispatched = false;
+      while (ring->TryPop(record)) {
+        for (auto& stream : streams) {
+          stream->Log(record.Source, record.Severity, record.Text);
+        }
+        dispatched = true;
+      }
+
+      auto drops = GetDropped();
+      if (drops != reportedDrops) {
+        auto message = core::string::format("{} log messages were dropped, the log ring was full",
+                                            drops - reportedDrops);
+        for (auto& stream : streams) {
+          stream->Log(LogSource::Engine, LogSeverity::Warn, message);
+        }
+        reportedDrops = drops;
+        dispatched    = true;
+      }
+
+      if (dispatched) {
+        for (auto& stream : streams) {
+          stream->Flush();
+        }
+      }
+
+      std::unique_lock<std::mutex> lock(m_wakeMutex);
+      m_dispatched = ring->GetPopped();
+      m_flushed.notify_all();
+
+      if (m_stop) {
+        // producers that raced with the stop may still be pushing or writing their slots
+        while (m_producers.load(std::memory_order_acquire) != 0 ||
+               ring->GetPopped() != ring->GetPushed()) {
+          lock.unlock();
+          while (ring->TryPop(record)) {
+            for (auto& stream : streams) {
+              stream->Log(record.Source, record.Severity, record.Text);
+            }
+          }
+          std::this_thread::yield();
+          lock.lock();
+        }
+        for (auto& stream : streams) {
+          stream->Flush();
+        }
+        m_flushed.notify_all();
+        break;
+      }
+
+      m_sleeping.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      // the timeout only matters if a wake up is lost anyway
+      if (ring->GetPopped() == ring->GetPushed())
+        m_wake.wait_for(lock, std::chrono::milliseconds(10));
+
+      m_sleeping.store(false, std::memory_order_relaxed);
+    }
+
+    IsLogThread() = false;
+  }
+
+  private:
+  std::mutex m_streamMutex;
   core::Vector<core::WeakPtr<ILogStream>> m_logStreams;
+
+  /// Serializes starting and stopping.
+  std::mutex m_controlMutex;
+  std::atomic<bool> m_async{ false };
+  /// Threads between their m_async check and the end of their push.
+  std::atomic<uint32_t> m_producers{ 0 };
+  core::Vector<core::UniquePtr<LogRing>> m_rings;
+  std::atomic<LogRing*> m_ring{ nullptr };
+  LogOverflowPolicy m_overflow = LogOverflowPolicy::Block;
+  std::atomic<uint64_t> m_dropped{ 0 };
+  std::thread m_thread;
+
+  /// Guards m_stop and m_dispatched, the log thread sleeps on m_wake, flushes wait on m_flushed.
+  std::mutex m_wakeMutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_flushed;
+  std::atomic<bool> m_sleeping{ false };
+  bool m_stop              = false;
+  uint64_t m_dispatched    = 0;
 };
 } // namespace
 
+void SetLogLevel(const LogSource source, const LogSeverity minimum)
+{
+  uint32_t filtered = 0;
+
+  for (auto severity : { LogSeverity::Info, LogSeverity::Warn, LogSeverity::Error,
+                         LogSeverity::Critical, LogSeverity::Debug }) {
+    if (GetSeverityLevel(severity) < GetSeverityLevel(minimum))
+      filtered |= 1u << (uint32_t)severity;
+  }
+
+  detail::FilteredSeverities[(size_t)source].store(filtered, std::memory_order_relaxed);
+}
+
 void Log(const LogSource source, const LogSeverity severity, const core::String& log)
 {
-  Logger::Get().Log(source, severity, log);
+  if (IsLogEnabled(source, severity))
+    Logger::Get().Log(source, severity, log);
+}
+
+void Log(const LogSource source, const LogSeverity severity, core::String&& log)
+{
+  if (IsLogEnabled(source, severity))
+    Logger::Get().Log(source, severity, core::Move(log));
 }
 
 void AddLogStream(const core::WeakPtr<ILogStream>& wlogStream)
@@ -70,4 +429,24 @@ void CleanDeadStreams()
 void ClearStreams(){
     Logger::Get().ClearStreams();
 }
-} // namespace elog
\ No newline at end of file
+
+void StartAsyncLogging(const AsyncLogOptions& options)
+{
+  Logger::Get().StartAsync(options);
+}
+
+void StopAsyncLogging()
+{
+  Logger::Get().StopAsync();
+}
+
+void FlushLog()
+{
+  Logger::Get().Flush();
+}
+
+uint64_t GetDroppedLogCount()
+{
+  return Logger::Get().GetDropped();
+}
+} // namespace elog
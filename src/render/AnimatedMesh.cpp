@@ -57,6 +57,7 @@ void AnimatedMesh::Clear()
   NormalBuffer.clear();
   BlendIndexBuffer.clear();
   BlendWeightBuffer.clear();
+  Meshlets.clear();
   Upload();
 }
 
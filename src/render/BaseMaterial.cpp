@@ -12,6 +12,7 @@
 namespace material {
 BaseMaterial::BaseMaterial(render::IGpuProgram* shader)
     : m_shader(shader)
+    , m_shaderGeneration(shader->GetGeneration())
     , RenderMode(MeshRenderMode::Triangles)
     , UseDepthTest(true)
     , m_textures({ nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr })
@@ -23,6 +24,11 @@ void BaseMaterial::Use()
 {
   m_shader->Bind();
 
+  if (m_shaderGeneration != m_shader->GetGeneration()) {
+    m_shaderGeneration        = m_shader->GetGeneration();
+    m_textureListNeedsRebuild = true;
+  }
+
   static const core::String textureSamplerNames[8] = {
     "textureSampler0", "textureSampler1", "textureSampler2", "textureSampler3",
     "textureSampler4", "textureSampler5", "textureSampler6", "textureSampler7",
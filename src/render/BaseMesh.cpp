@@ -52,4 +52,10 @@ void BaseMesh::Render()
   m_vao->Render(IndexBuffer.size());
 }
 
+void BaseMesh::RenderRanges(const core::Vector<DrawRange>& ranges)
+{
+  if (!ranges.empty())
+    m_vao->RenderRanges(ranges);
+}
+
 } // namespace render
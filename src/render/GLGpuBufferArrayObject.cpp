@@ -59,6 +59,13 @@ void GLGpuBufferArrayObject::RenderLines(uint32_t count)
   gl::RenderLines(static_cast<GLGpuBufferObject*>(GetIndexBuffer())->GetHandle(), count);
 }
 
+void GLGpuBufferArrayObject::RenderRanges(const core::Vector<DrawRange>& ranges)
+{
+  gl::BindHandle(m_handle);
+  GetIndexBuffer()->Bind();
+  gl::RenderRanges(static_cast<GLGpuBufferObject*>(GetIndexBuffer())->GetHandle(), ranges);
+}
+
 void GLGpuBufferArrayObject::EnableBuffers()
 {
   gl::BindHandle(m_handle);
@@ -20,6 +20,7 @@ class GLGpuBufferArrayObject : public IGpuBufferArrayObject
   virtual uint32_t GetBufferObjectCount();
   virtual void Render(uint32_t count);
   virtual void RenderLines(uint32_t count);
+  virtual void RenderRanges(const core::Vector<DrawRange>& ranges);
 
   public:
   void EnableBuffers();
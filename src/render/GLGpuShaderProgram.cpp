@@ -5,6 +5,7 @@
 namespace render {
 GLGpuShaderProgram::GLGpuShaderProgram(const gl::gpu_shader_handle& handle)
     : m_handle(handle)
+    , m_generation(0)
 {
   InitUniforms();
 }
@@ -52,4 +53,18 @@ IGpuProgramUniform* GLGpuShaderProgram::GetUniform(const core::String& name)
                                [&name](const auto& uniform) { return uniform->GetName() == name; });
   return it != m_uniforms.end() ? (*it).get() : nullptr;
 }
+
+void GLGpuShaderProgram::Swap(IGpuProgram& other)
+{
+  // programs all come from the same renderer
+  auto& program = static_cast<GLGpuShaderProgram&>(other);
+  std::swap(m_handle, program.m_handle);
+  std::swap(m_uniforms, program.m_uniforms);
+  m_generation++;
+}
+
+uint32_t GLGpuShaderProgram::GetGeneration() const
+{
+  return m_generation;
+}
 } // namespace render
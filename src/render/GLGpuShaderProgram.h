@@ -15,6 +15,8 @@ class GLGpuShaderProgram : public IGpuProgram
   virtual void Bind();
   virtual const core::Vector<core::UniquePtr<IGpuProgramUniform>>& GetUniforms();
   virtual IGpuProgramUniform* GetUniform(const core::String& name);
+  virtual void Swap(IGpuProgram& other);
+  virtual uint32_t GetGeneration() const;
 
   private:
   void InitUniforms();
@@ -22,6 +24,7 @@ class GLGpuShaderProgram : public IGpuProgram
   private:
   gl::gpu_shader_handle m_handle;
   core::Vector<core::UniquePtr<IGpuProgramUniform>> m_uniforms;
+  uint32_t m_generation;
 };
 } // namespace render
 
@@ -5,6 +5,7 @@
 #include "GLGpuShaderProgram.h"
 #include "GLRenderBufferObject.h"
 #include "GLRendererDebugMessageMonitor.h"
+#include "GLShaderCompiler.h"
 #include "GLTexture.h"
 #include "OpenGL.hpp"
 #include "RenderContext.h"
@@ -12,6 +13,7 @@
 #include "render/BaseMesh.h"
 #include "render/CTexture.h"
 #include "render/ICamera.h"
+#include "render/ShaderProgramBatch.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace render {
@@ -27,7 +29,8 @@ GLRenderer::GLRenderer(core::UniquePtr<IRendererDebugMessageMonitor>&& debugMess
   glEnable(GL_DEPTH_TEST);
   glEnable(GL_CULL_FACE);
   glCullFace(GL_BACK);
-  m_renderContext = core::MakeUnique<RenderContext>(this);
+  m_renderContext  = core::MakeUnique<RenderContext>(this);
+  m_shaderCompiler = core::MakeUnique<GLShaderCompiler>();
 }
 GLRenderer::~GLRenderer()
 {
@@ -42,13 +45,38 @@ core::UniquePtr<IGpuProgram> GLRenderer::CreateProgram(const core::String& vertS
                                                        const core::String& fragSource,
                                                        const core::String& geomSource)
 {
-  auto handle = gl::CreatePipelineFromShaderStrings(vertSource.c_str(), fragSource.c_str(),
-                                                    geomSource.c_str());
+  auto programs = CreatePrograms({ ShaderProgramSource{ vertSource, fragSource, geomSource } });
+  return core::Move(programs[0]);
+}
 
-  if (gl::IsHandleValid(handle))
-    return core::MakeUnique<GLGpuShaderProgram>(handle);
-  else
-    return nullptr;
+core::Vector<core::UniquePtr<IGpuProgram>> GLRenderer::CreatePrograms(
+    const core::Vector<ShaderProgramSource>& sources)
+{
+  ShaderProgramBatch batch(m_shaderCompiler.get());
+
+  for (const auto& source : sources) {
+    batch.Add(source);
+  }
+
+  batch.Submit();
+
+  core::Vector<core::UniquePtr<IGpuProgram>> programs;
+  programs.reserve(sources.size());
+
+  for (const auto& compiled : batch.Finish()) {
+    if (compiled.Linked) {
+      gl::gpu_shader_handle handle{ compiled.Program,
+                                    compiled.Shaders[(uint32_t)ShaderStage::Vertex],
+                                    compiled.Shaders[(uint32_t)ShaderStage::Fragment],
+                                    compiled.Shaders[(uint32_t)ShaderStage::Geometry] };
+      programs.push_back(core::MakeUnique<GLGpuShaderProgram>(handle));
+    }
+    else {
+      programs.push_back(nullptr);
+    }
+  }
+
+  return programs;
 }
 
 core::UniquePtr<IGpuBufferArrayObject> GLRenderer::CreateBufferArrayObject(
@@ -216,7 +244,8 @@ void GLRenderer::RenderMesh(BaseMesh* mesh, material::BaseMaterial* material,
   material->SetMat4("MVP", mvp);
 
   if (material->RenderMode == material::MeshRenderMode::Triangles) {
-    mesh->GetGpuBufferObject()->Render(mesh->IndexBuffer.size());
+    if (!RenderVisibleMeshlets(mesh, mvp, transform))
+      mesh->GetGpuBufferObject()->Render(mesh->IndexBuffer.size());
   }
   else {
     mesh->GetGpuBufferObject()->RenderLines(mesh->IndexBuffer.size());
@@ -239,7 +268,23 @@ void GLRenderer::RenderMesh(AnimatedMesh* mesh, material::BaseMaterial* material
   m_renderContext->SetCurrentMaterial(material);
   material->SetMat4("MVP", mvp);
   // material->SetMat4("Bones", anim.current_frame.data(), anim.current_frame.size(), true);
-  mesh->Render();
+  if (!RenderVisibleMeshlets(mesh, mvp, transform))
+    mesh->Render();
+}
+
+bool GLRenderer::RenderVisibleMeshlets(BaseMesh* mesh, const glm::mat4& mvp,
+                                       const glm::mat4& transform)
+{
+  if (mesh->Meshlets.empty())
+    return false;
+
+  auto camera         = m_renderContext->GetCurrentCamera();
+  auto cameraPosition = glm::vec3(glm::inverse(transform) * glm::vec4(camera->GetPosition(), 1));
+
+  m_drawRanges.clear();
+  CullMeshlets(mesh->Meshlets, mvp, cameraPosition, m_drawRanges);
+  mesh->RenderRanges(m_drawRanges);
+  return true;
 }
 
 void GLRenderer::WindowResized(core::pod::Vec2<uint32_t> size)
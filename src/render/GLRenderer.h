@@ -4,10 +4,12 @@
 #include "render/CFrameBufferObject.h"
 #include "render/CRenderBufferObject.h"
 #include "render/IRenderer.h"
+#include "render/Meshlet.h"
 
 namespace render {
 class GLRendererDebugMessageMonitor;
 class GLFrameBufferObject;
+class GLShaderCompiler;
 class IRenderContext;
 class GLRenderer : public IRenderer
 {
@@ -20,6 +22,8 @@ class GLRenderer : public IRenderer
   core::UniquePtr<IGpuProgram> CreateProgram(const core::String& vertSource = "",
                                              const core::String& fragSource = "",
                                              const core::String& geomSource = "") final;
+  core::Vector<core::UniquePtr<IGpuProgram>> CreatePrograms(
+      const core::Vector<ShaderProgramSource>& sources) final;
 
   core::UniquePtr<IGpuBufferArrayObject> CreateBufferArrayObject(
       const core::Vector<BufferDescriptor>& descriptors) final;
@@ -53,9 +57,15 @@ class GLRenderer : public IRenderer
   void WindowResized(core::pod::Vec2<uint32_t> size);
 
   private:
+  /// Culls clustered meshes and draws visible index ranges, false if the mesh has no meshlets.
+  bool RenderVisibleMeshlets(BaseMesh* mesh, const glm::mat4& mvp, const glm::mat4& transform);
+
   core::UniquePtr<IRenderContext> m_renderContext;
   core::SharedPtr<GLFrameBufferObject> m_activeFrameBufferObject;
   core::UniquePtr<IRendererDebugMessageMonitor> m_debugMessageMonitor;
+  core::UniquePtr<GLShaderCompiler> m_shaderCompiler;
+  /// Reused between draws so culling does not allocate every frame.
+  core::Vector<DrawRange> m_drawRanges;
 };
 
 core::UniquePtr<IRenderer> CreateRenderer(
@@ -0,0 +1,117 @@
+#include "GLShaderCompiler.h"
+#include "GLBindingInc.h"
+
+namespace render {
+namespace {
+uint32_t GetGLShaderType(ShaderStage stage)
+{
+  switch (stage) {
+  case ShaderStage::Vertex:
+    return GL_VERTEX_SHADER;
+  case ShaderStage::Fragment:
+    return GL_FRAGMENT_SHADER;
+  case ShaderStage::Geometry:
+    return GL_GEOMETRY_SHADER;
+  default:
+    return GL_VERTEX_SHADER;
+  }
+}
+} // namespace
+
+GLShaderCompiler::GLShaderCompiler()
+{
+  m_parallelCompile = GLAD_GL_ARB_parallel_shader_compile != 0;
+
+  if (m_parallelCompile) {
+    // let the driver pick the number of compiler threads
+    glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+  }
+
+  elog::LogInfo(core::string::format("Parallel shader compilation: {}",
+                                     m_parallelCompile ? "enabled" : "unavailable"));
+}
+
+uint32_t GLShaderCompiler::CompileShader(ShaderStage stage, const core::String& source)
+{
+  const char* sourcePtr = source.c_str();
+  uint32_t shader       = glCreateShader(GetGLShaderType(stage));
+  glShaderSource(shader, 1, &sourcePtr, nullptr);
+  glCompileShader(shader);
+  return shader;
+}
+
+uint32_t GLShaderCompiler::LinkProgram(const ShaderStageHandles& shaders)
+{
+  uint32_t program = glCreateProgram();
+
+  for (auto shader : shaders) {
+    if (shader)
+      glAttachShader(program, shader);
+  }
+
+  glLinkProgram(program);
+  return program;
+}
+
+bool GLShaderCompiler::IsProgramReady(uint32_t program)
+{
+  if (!m_parallelCompile)
+    return true;
+
+  GLint completed = GL_FALSE;
+  glGetProgramiv(program, GL_COMPLETION_STATUS_ARB, &completed);
+  return completed == GL_TRUE;
+}
+
+bool GLShaderCompiler::GetShaderStatus(uint32_t shader, core::String& log)
+{
+  GLint isCompiled = GL_FALSE;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+
+  if (isCompiled == GL_FALSE) {
+    GLint length = 0;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+    log.resize(length > 0 ? length : 0);
+    glGetShaderInfoLog(shader, length, &length, &log[0]);
+    log.resize(length > 0 ? length : 0);
+    return false;
+  }
+
+  return true;
+}
+
+bool GLShaderCompiler::GetProgramStatus(uint32_t program, core::String& log)
+{
+  GLint isLinked = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+
+  if (isLinked == GL_FALSE) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+    log.resize(length > 0 ? length : 0);
+    glGetProgramInfoLog(program, length, &length, &log[0]);
+    log.resize(length > 0 ? length : 0);
+    return false;
+  }
+
+  return true;
+}
+
+void GLShaderCompiler::DetachShaders(uint32_t program, const ShaderStageHandles& shaders)
+{
+  for (auto shader : shaders) {
+    if (shader)
+      glDetachShader(program, shader);
+  }
+}
+
+void GLShaderCompiler::DeleteShader(uint32_t shader)
+{
+  glDeleteShader(shader);
+}
+
+void GLShaderCompiler::DeleteProgram(uint32_t program)
+{
+  glDeleteProgram(program);
+}
+} // namespace render
@@ -0,0 +1,28 @@
+#ifndef THEPROJECT2_SRC_RENDER_GLSHADERCOMPILER_H_
+#define THEPROJECT2_SRC_RENDER_GLSHADERCOMPILER_H_
+
+#include "render/IShaderCompiler.h"
+
+namespace render {
+/// Uses GL_ARB_parallel_shader_compile when available, it shares tokens and semantics with
+/// GL_KHR_parallel_shader_compile.
+class GLShaderCompiler : public IShaderCompiler
+{
+  public:
+  GLShaderCompiler();
+
+  uint32_t CompileShader(ShaderStage stage, const core::String& source) final;
+  uint32_t LinkProgram(const ShaderStageHandles& shaders) final;
+  bool IsProgramReady(uint32_t program) final;
+  bool GetShaderStatus(uint32_t shader, core::String& log) final;
+  bool GetProgramStatus(uint32_t program, core::String& log) final;
+  void DetachShaders(uint32_t program, const ShaderStageHandles& shaders) final;
+  void DeleteShader(uint32_t shader) final;
+  void DeleteProgram(uint32_t program) final;
+
+  private:
+  bool m_parallelCompile;
+};
+} // namespace render
+
+#endif // THEPROJECT2_SRC_RENDER_GLSHADERCOMPILER_H_
@@ -5,10 +5,15 @@ namespace render {
 inline void SetUnpackAlignment(render::TextureDataFormat format)
 {
   switch (format) {
+  case render::TextureDataFormat::R:
   case render::TextureDataFormat::RGB:
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     break;
 
+  case render::TextureDataFormat::RG:
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    break;
+
   case render::TextureDataFormat::RGBA:
     glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     break;
@@ -107,6 +112,17 @@ core::UniquePtr<ITexture> GLTexture::CreateTexture(const TextureDescriptor& desc
   glTexParameteri(handle.type, GL_TEXTURE_MIN_FILTER, handle.filter_min);
   glTexParameteri(handle.type, GL_TEXTURE_MAG_FILTER, handle.filter_mag);
   glTexParameteri(handle.type, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+
+  // gray images are stored as R/RG, swizzle so they sample as gray instead of red
+  if (descriptor.DataFormat == render::TextureDataFormat::R) {
+    GLint swizzle[] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+    glTexParameteriv(handle.type, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+  }
+  else if (descriptor.DataFormat == render::TextureDataFormat::RG) {
+    GLint swizzle[] = { GL_RED, GL_RED, GL_RED, GL_GREEN };
+    glTexParameteriv(handle.type, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+  }
+
   glBindTexture(handle.type, 0);
 
   if (gl::IsHandleValid(handle)) {
@@ -144,7 +160,7 @@ GLTexture::~GLTexture()
 void GLTexture::UploadData(const TextureDataDescriptor& descriptor)
 {
   GLTexture::BindObject(this, 0);
-
+  SetUnpackAlignment(descriptor.format);
 
   if (m_handle.type == GL_TEXTURE_2D_ARRAY) {
     glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, m_handle.width, m_handle.height,
@@ -0,0 +1,67 @@
+#include "render/Meshlet.h"
+
+namespace render {
+namespace {
+/// Gribb-Hartmann frustum planes in mesh space, normals point inside.
+void ExtractPlanes(const glm::mat4& m, glm::vec4 (&planes)[6])
+{
+  glm::vec4 rows[4];
+  for (int i = 0; i < 4; i++) {
+    rows[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+  }
+
+  for (int i = 0; i < 3; i++) {
+    planes[i * 2]     = rows[3] + rows[i];
+    planes[i * 2 + 1] = rows[3] - rows[i];
+  }
+
+  for (auto& plane : planes) {
+    plane /= glm::length(glm::vec3(plane));
+  }
+}
+} // namespace
+
+MeshletCullStats CullMeshlets(const core::Vector<Meshlet>& meshlets,
+                              const glm::mat4& modelViewProjection,
+                              const glm::vec3& cameraPosition, core::Vector<DrawRange>& ranges)
+{
+  MeshletCullStats stats;
+  glm::vec4 planes[6];
+  ExtractPlanes(modelViewProjection, planes);
+
+  for (const auto& meshlet : meshlets) {
+    bool inside = true;
+
+    for (const auto& plane : planes) {
+      if (glm::dot(glm::vec3(plane), meshlet.Center) + plane.w < -meshlet.Radius) {
+        inside = false;
+        break;
+      }
+    }
+
+    if (!inside) {
+      stats.FrustumCulled++;
+      continue;
+    }
+
+    auto toCenter = meshlet.Center - cameraPosition;
+    if (glm::dot(toCenter, meshlet.ConeAxis) >=
+        meshlet.ConeCutoff * glm::length(toCenter) + meshlet.Radius) {
+      stats.ConeCulled++;
+      continue;
+    }
+
+    stats.Visible++;
+
+    if (!ranges.empty() &&
+        ranges.back().IndexOffset + ranges.back().IndexCount == meshlet.IndexOffset) {
+      ranges.back().IndexCount += meshlet.IndexCount;
+    }
+    else {
+      ranges.push_back({ meshlet.IndexOffset, meshlet.IndexCount });
+    }
+  }
+
+  return stats;
+}
+} // namespace render
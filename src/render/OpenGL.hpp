@@ -3,6 +3,7 @@
 #include "GLBindingInc.h"
 #include "render/BufferDescriptor.h"
 #include "render/CTexture.h"
+#include "render/Meshlet.h"
 
 namespace render {
 namespace gl {
@@ -97,61 +98,13 @@ inline void FreeHandle(const gpu_vertex_array_object_handle& handle)
   glDeleteVertexArrays(1, &handle.id);
 }
 
-inline bool CheckAndPrintShaderCompileStatus(uint32_t shader)
-{
-  GLint isCompiled = 0;
-  glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
-
-  if (isCompiled == GL_FALSE) {
-    GLint maxLength     = 1024;
-    char errorLog[1024] = { '\0' };
-    glGetShaderInfoLog(shader, maxLength, &maxLength, &errorLog[0]);
-
-    printf("SHADER COMPILE STATUS: %s \n", errorLog);
-    return false;
-  }
-
-  return true;
-}
-
-inline bool CheckLinkStatus(const gpu_shader_handle& handle)
-{
-  int32_t isLinked = 0;
-  glGetProgramiv(handle.id, GL_LINK_STATUS, (int32_t*)&isLinked);
-
-  if (isLinked == GL_FALSE) {
-    GLint maxLength     = 1024;
-    char errorLog[1024] = { '\0' };
-    glGetProgramiv(handle.id, GL_INFO_LOG_LENGTH, &maxLength);
-    glGetProgramInfoLog(handle.id, maxLength, &maxLength, &errorLog[0]);
-
-    printf("SHADER LINK STATUS: %s \n", errorLog);
-    return false;
-  }
-
-  return true;
-}
-
-inline uint32_t CreateShaderFromString(uint32_t type, const char* source)
-{
-  if (source && source[0] != core::string::NullTerminator) {
-    uint32_t shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-
-    if (CheckAndPrintShaderCompileStatus(shader)) {
-      return shader;
-    }
-    else {
-      glDeleteShader(shader);
-    }
-  }
-  return 0;
-}
-
 inline uint32_t GetSizedTextureFormat(render::TextureDataFormat format)
 {
   switch (format) {
+  case render::TextureDataFormat::R:
+    return GL_R8;
+  case render::TextureDataFormat::RG:
+    return GL_RG8;
   case render::TextureDataFormat::RGB:
     return GL_RGB8;
   case render::TextureDataFormat::RGBA:
@@ -166,6 +119,10 @@ inline uint32_t GetSizedTextureFormat(render::TextureDataFormat format)
 inline uint32_t GetBaseTextureFormat(render::TextureDataFormat format)
 {
   switch (format) {
+  case render::TextureDataFormat::R:
+    return GL_RED;
+  case render::TextureDataFormat::RG:
+    return GL_RG;
   case render::TextureDataFormat::RGB:
     return GL_RGB;
   case render::TextureDataFormat::RGBA:
@@ -177,57 +134,6 @@ inline uint32_t GetBaseTextureFormat(render::TextureDataFormat format)
   }
 }
 
-inline bool LinkProgram(const gpu_shader_handle& handle)
-{
-  if (handle.vertex_program_id)
-    glAttachShader(handle.id, handle.vertex_program_id);
-  if (handle.fragment_program_id)
-    glAttachShader(handle.id, handle.fragment_program_id);
-  if (handle.geometry_program_id)
-    glAttachShader(handle.id, handle.geometry_program_id);
-
-  glLinkProgram(handle.id);
-
-  if (CheckLinkStatus(handle) == false) {
-    return false;
-  }
-
-  if (handle.vertex_program_id)
-    glDetachShader(handle.id, handle.vertex_program_id);
-  if (handle.fragment_program_id)
-    glDetachShader(handle.id, handle.fragment_program_id);
-  if (handle.geometry_program_id)
-    glDetachShader(handle.id, handle.geometry_program_id);
-
-  return true;
-}
-
-inline gpu_shader_handle CreateProgram(uint32_t vert_program, uint32_t frag_program,
-                                       uint32_t geom_program)
-{
-  uint32_t program = glCreateProgram();
-
-  gpu_shader_handle handle{ program, vert_program, frag_program, geom_program };
-
-  if (LinkProgram(handle) == false) {
-    FreeHandle(handle);
-    return gpu_shader_handle{ 0, 0, 0, 0 };
-  }
-
-  return handle;
-}
-
-inline gpu_shader_handle CreatePipelineFromShaderStrings(const char* vertSource,
-                                                         const char* fragSource,
-                                                         const char* geomSource)
-{
-  uint32_t vs = CreateShaderFromString(GL_VERTEX_SHADER, vertSource);
-  uint32_t fs = CreateShaderFromString(GL_FRAGMENT_SHADER, fragSource);
-  uint32_t gs = CreateShaderFromString(GL_GEOMETRY_SHADER, geomSource);
-
-  return CreateProgram(vs, fs, gs);
-}
-
 inline uint32_t GetUniformCount(uint32_t id)
 {
   int32_t count = 0;
@@ -371,6 +277,22 @@ inline void RenderLines(const gpu_buffer_object_handle& handle, uint32_t count)
   glDrawElements(GL_LINES, count, handle.component_type, 0);
 }
 
+inline void RenderRanges(const gpu_buffer_object_handle& handle,
+                         const core::Vector<DrawRange>& ranges)
+{
+  core::Vector<GLsizei> counts(ranges.size());
+  core::Vector<const void*> offsets(ranges.size());
+
+  for (size_t i = 0; i < ranges.size(); i++) {
+    counts[i]  = ranges[i].IndexCount;
+    offsets[i] = (const void*)((size_t)ranges[i].IndexOffset * handle.component_count *
+                                handle.component_size);
+  }
+
+  glMultiDrawElements(GL_TRIANGLES, counts.data(), handle.component_type, offsets.data(),
+                      ranges.size());
+}
+
 inline void SetClearColor(const core::pod::Vec3<int32_t>& color)
 {
   glClearColor(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, 1);
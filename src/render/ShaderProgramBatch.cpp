@@ -0,0 +1,87 @@
+#include "render/ShaderProgramBatch.h"
+
+namespace render {
+ShaderProgramBatch::ShaderProgramBatch(IShaderCompiler* compiler)
+    : m_compiler(compiler)
+{
+}
+
+uint32_t ShaderProgramBatch::Add(const ShaderProgramSource& source)
+{
+  m_sources.push_back(source);
+  return m_sources.size() - 1;
+}
+
+void ShaderProgramBatch::Submit()
+{
+  m_programs.resize(m_sources.size());
+
+  for (uint32_t i = 0; i < m_sources.size(); i++) {
+    const auto& source = m_sources[i];
+    auto& shaders      = m_programs[i].Shaders;
+
+    auto compile = [this](ShaderStage stage, const core::String& stageSource) -> uint32_t {
+      return stageSource.empty() ? 0 : m_compiler->CompileShader(stage, stageSource);
+    };
+
+    shaders[(uint32_t)ShaderStage::Vertex]   = compile(ShaderStage::Vertex, source.Vertex);
+    shaders[(uint32_t)ShaderStage::Fragment] = compile(ShaderStage::Fragment, source.Fragment);
+    shaders[(uint32_t)ShaderStage::Geometry] = compile(ShaderStage::Geometry, source.Geometry);
+  }
+
+  // linking right away is fine, a failed compile only makes the link fail which we report later
+  for (auto& program : m_programs) {
+    program.Program = m_compiler->LinkProgram(program.Shaders);
+    program.Linked  = false;
+  }
+
+  m_sources.clear();
+}
+
+bool ShaderProgramBatch::IsReady()
+{
+  for (const auto& program : m_programs) {
+    if (!m_compiler->IsProgramReady(program.Program))
+      return false;
+  }
+
+  return true;
+}
+
+core::Vector<CompiledShaderProgram> ShaderProgramBatch::Finish()
+{
+  core::String log;
+
+  for (auto& program : m_programs) {
+    bool compiled = true;
+
+    for (auto shader : program.Shaders) {
+      if (shader && !m_compiler->GetShaderStatus(shader, log)) {
+        elog::LogError(core::string::format("Shader compilation failed: {}", log));
+        compiled = false;
+      }
+    }
+
+    program.Linked = compiled && m_compiler->GetProgramStatus(program.Program, log);
+
+    if (compiled && !program.Linked) {
+      elog::LogError(core::string::format("Shader program link failed: {}", log));
+    }
+
+    if (program.Linked) {
+      m_compiler->DetachShaders(program.Program, program.Shaders);
+      continue;
+    }
+
+    m_compiler->DeleteProgram(program.Program);
+    for (auto& shader : program.Shaders) {
+      if (shader)
+        m_compiler->DeleteShader(shader);
+      shader = 0;
+    }
+    program.Program = 0;
+  }
+
+  return core::Move(m_programs);
+}
+} // namespace render
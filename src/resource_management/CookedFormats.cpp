@@ -0,0 +1,326 @@
+#include "resource_management/CookedFormats.h"
+#include "render/AnimatedMesh.h"
+#include "render/ShaderProgramBatch.h"
+#include <cstring>
+
+namespace res::cooked {
+namespace {
+const char* Magics[] = { "ETEX", "EPRG", "EMSH" };
+
+class BinaryWriter
+{
+  public:
+  BinaryWriter(core::TByteArray& out)
+      : m_out(out)
+  {
+  }
+
+  template <class T> void Write(const T& value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain data can be written");
+    WriteBytes(&value, sizeof(T));
+  }
+
+  template <class T> void WriteVector(const core::Vector<T>& values)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain data can be written");
+    Write<uint32_t>(values.size());
+    WriteBytes(values.data(), values.size() * sizeof(T));
+  }
+
+  void WriteString(const core::String& str)
+  {
+    Write<uint32_t>(str.size());
+    WriteBytes(str.data(), str.size());
+  }
+
+  void WriteHeader(CookedType type)
+  {
+    WriteBytes(Magics[(int)type], 4);
+    Write(FormatVersion);
+  }
+
+  private:
+  void WriteBytes(const void* data, size_t size)
+  {
+    auto bytes = static_cast<const uint8_t*>(data);
+    m_out.insert(m_out.end(), bytes, bytes + size);
+  }
+
+  core::TByteArray& m_out;
+};
+
+/// Bounds checked reader, every read after the first failure fails as well.
+class BinaryReader
+{
+  public:
+  BinaryReader(const void* data, size_t size)
+      : m_data(static_cast<const uint8_t*>(data))
+      , m_size(size)
+      , m_position(0)
+      , m_ok(true)
+  {
+  }
+
+  template <class T> bool Read(T& value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain data can be read");
+    return ReadBytes(&value, sizeof(T));
+  }
+
+  template <class T> bool ReadVector(core::Vector<T>& values)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain data can be read");
+    uint32_t count = 0;
+
+    if (!Read(count) || count > Remaining() / sizeof(T))
+      return m_ok = false;
+
+    values.resize(count);
+    return ReadBytes(values.data(), count * sizeof(T));
+  }
+
+  bool ReadString(core::String& str)
+  {
+    uint32_t size = 0;
+
+    if (!Read(size) || size > Remaining())
+      return m_ok = false;
+
+    str.resize(size);
+    return ReadBytes(&str[0], size);
+  }
+
+  bool ReadHeader(CookedType type)
+  {
+    uint32_t version = 0;
+    m_ok       = Detect(m_data, m_size) == type;
+    m_position = 4;
+    return Read(version) && version == FormatVersion;
+  }
+
+  bool Ok() const
+  {
+    return m_ok;
+  }
+
+  private:
+  size_t Remaining() const
+  {
+    return m_size - m_position;
+  }
+
+  bool ReadBytes(void* out, size_t size)
+  {
+    if (!m_ok || size > Remaining())
+      return m_ok = false;
+
+    if (size > 0)
+      memcpy(out, m_data + m_position, size);
+
+    m_position += size;
+    return true;
+  }
+
+  const uint8_t* m_data;
+  size_t m_size;
+  size_t m_position;
+  bool m_ok;
+};
+
+void WriteKeys(BinaryWriter& writer, const render::anim::BoneKeyCollection& keys)
+{
+  writer.Write(keys.BoneIndex);
+  writer.WriteVector(keys.PositionKeys);
+  writer.WriteVector(keys.ScaleKeys);
+  writer.WriteVector(keys.RotationKeys);
+}
+
+bool ReadKeys(BinaryReader& reader, render::anim::BoneKeyCollection& keys)
+{
+  return reader.Read(keys.BoneIndex) && reader.ReadVector(keys.PositionKeys) &&
+         reader.ReadVector(keys.ScaleKeys) && reader.ReadVector(keys.RotationKeys);
+}
+} // namespace
+
+core::Optional<CookedType> Detect(const void* data, size_t size)
+{
+  if (size < HeaderSize)
+    return {};
+
+  for (auto type : { CookedType::Texture, CookedType::Program, CookedType::Mesh }) {
+    if (memcmp(data, Magics[(int)type], 4) == 0)
+      return type;
+  }
+
+  return {};
+}
+
+void WriteTexture(const LoadedImage& image, core::TByteArray& out)
+{
+  BinaryWriter writer(out);
+  writer.WriteHeader(CookedType::Texture);
+  writer.Write<int32_t>(image.size.x);
+  writer.Write<int32_t>(image.size.y);
+  writer.Write<int32_t>(image.channels);
+
+  auto pixelBytes = (size_t)image.size.x * image.size.y * image.channels;
+  out.insert(out.end(), image.data.get(), image.data.get() + pixelBytes);
+}
+
+LoadedImage ReadTexture(io::IFileReader* file)
+{
+  struct
+  {
+    char Magic[4];
+    uint32_t Version;
+    int32_t Width, Height, Channels;
+  } header;
+
+  if (file->Read(&header, sizeof(header)) != sizeof(header) ||
+      Detect(&header, sizeof(header)) != CookedType::Texture || header.Version != FormatVersion ||
+      header.Width <= 0 || header.Height <= 0 || header.Channels < 1 || header.Channels > 4) {
+    return LoadedImage();
+  }
+
+  auto pixelBytes = (size_t)header.Width * header.Height * header.Channels;
+
+  LoadedImage img;
+  img.data = core::UniquePtr<uint8_t[], void (*)(void*)>((uint8_t*)malloc(pixelBytes), free);
+
+  if (file->Read(img.data.get(), pixelBytes) != (std::intmax_t)pixelBytes) {
+    return LoadedImage();
+  }
+
+  img.size         = { header.Width, header.Height };
+  img.channels     = header.Channels;
+  img.encodedBytes = file->GetLength();
+  return img;
+}
+
+void WriteProgram(const render::ShaderProgramSource& source, core::TByteArray& out)
+{
+  BinaryWriter writer(out);
+  writer.WriteHeader(CookedType::Program);
+  writer.WriteString(source.Vertex);
+  writer.WriteString(source.Fragment);
+  writer.WriteString(source.Geometry);
+}
+
+bool ReadProgram(const void* data, size_t size, render::ShaderProgramSource& out)
+{
+  BinaryReader reader(data, size);
+  return reader.ReadHeader(CookedType::Program) && reader.ReadString(out.Vertex) &&
+         reader.ReadString(out.Fragment) && reader.ReadString(out.Geometry);
+}
+
+void WriteMesh(const render::AnimatedMesh& mesh, core::TByteArray& out)
+{
+  BinaryWriter writer(out);
+  writer.WriteHeader(CookedType::Mesh);
+  writer.WriteVector(mesh.IndexBuffer);
+  writer.WriteVector(mesh.UVBuffer);
+  writer.WriteVector(mesh.VertexBuffer);
+  writer.WriteVector(mesh.NormalBuffer);
+  writer.WriteVector(mesh.ColorBuffer);
+  writer.WriteVector(mesh.BlendIndexBuffer);
+  writer.WriteVector(mesh.BlendWeightBuffer);
+  writer.WriteVector(mesh.Meshlets);
+
+  auto& armature = mesh.GetArmature();
+  writer.Write(armature.GetGlobalInverseTransform());
+  writer.Write<uint32_t>(armature.GetBones().size());
+
+  for (const auto& bone : armature.GetBones()) {
+    writer.Write(bone.parent);
+    writer.WriteString(bone.name);
+    writer.Write(bone.pos);
+    writer.Write(bone.rot);
+    writer.Write(bone.scale);
+    writer.Write(bone.offset);
+    writer.Write(bone.bone_end);
+    writer.Write(bone.transform);
+  }
+
+  auto& animations = mesh.GetAnimations();
+  writer.Write<uint32_t>(animations.size());
+
+  for (const auto& animation : animations) {
+    writer.WriteString(animation.Name);
+    writer.Write(animation.Fps);
+    writer.Write(animation.Duration);
+    WriteKeys(writer, animation.ArmatureKeys);
+    writer.Write<uint32_t>(animation.BoneKeys.size());
+
+    for (const auto& keys : animation.BoneKeys) {
+      WriteKeys(writer, keys);
+    }
+  }
+}
+
+bool ReadMesh(const void* data, size_t size, render::AnimatedMesh& out)
+{
+  BinaryReader reader(data, size);
+
+  if (!reader.ReadHeader(CookedType::Mesh))
+    return false;
+
+  reader.ReadVector(out.IndexBuffer);
+  reader.ReadVector(out.UVBuffer);
+  reader.ReadVector(out.VertexBuffer);
+  reader.ReadVector(out.NormalBuffer);
+  reader.ReadVector(out.ColorBuffer);
+  reader.ReadVector(out.BlendIndexBuffer);
+  reader.ReadVector(out.BlendWeightBuffer);
+  reader.ReadVector(out.Meshlets);
+
+  glm::mat4 globalInverse;
+  uint32_t boneCount = 0;
+  reader.Read(globalInverse);
+  reader.Read(boneCount);
+
+  core::Vector<render::anim::Bone> bones;
+  for (uint32_t i = 0; i < boneCount && reader.Ok(); i++) {
+    render::anim::Bone bone;
+    reader.Read(bone.parent);
+    reader.ReadString(bone.name);
+    reader.Read(bone.pos);
+    reader.Read(bone.rot);
+    reader.Read(bone.scale);
+    reader.Read(bone.offset);
+    reader.Read(bone.bone_end);
+    reader.Read(bone.transform);
+    bones.push_back(core::Move(bone));
+  }
+
+  out.SetArmature(render::anim::Armature(globalInverse, core::Move(bones)));
+
+  uint32_t animationCount = 0;
+  reader.Read(animationCount);
+
+  for (uint32_t i = 0; i < animationCount && reader.Ok(); i++) {
+    render::anim::Animation animation;
+    uint32_t boneKeyCount = 0;
+    reader.ReadString(animation.Name);
+    reader.Read(animation.Fps);
+    reader.Read(animation.Duration);
+    ReadKeys(reader, animation.ArmatureKeys);
+    reader.Read(boneKeyCount);
+
+    for (uint32_t k = 0; k < boneKeyCount && reader.Ok(); k++) {
+      animation.BoneKeys.emplace_back();
+      ReadKeys(reader, animation.BoneKeys.back());
+    }
+
+    out.AddAnimation(animation);
+  }
+
+  // meshlet ranges are handed to the gpu as is
+  for (const auto& meshlet : out.Meshlets) {
+    if ((uint64_t)meshlet.IndexOffset + meshlet.IndexCount > out.IndexBuffer.size())
+      return false;
+  }
+
+  return reader.Ok();
+}
+} // namespace res::cooked
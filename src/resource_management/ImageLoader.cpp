@@ -5,41 +5,72 @@
 #include "resource_management/ImageLoader.h"
 #include "filesystem/IFileSystem.h"
 #include "render/ITexture.h"
+#include "resource_management/CookedFormats.h"
+#include "resource_management/PixelConversion.h"
+#include "resource_management/atlas/TextureAtlas.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 namespace res {
 
-struct StbLoadedImage
+LoadedImage::LoadedImage()
+    : channels(0)
+    , size(0, 0)
+    , data(nullptr, stbi_image_free)
+    , encodedBytes(0)
 {
-  int32_t channels;
-  core::pod::Vec2<int32_t> size;
-  core::UniquePtr<uint8_t[], void(*)(void*)> data;
+}
 
-  StbLoadedImage() : data(nullptr, stbi_image_free)
-  {
-  }
-};
+namespace {
+int ReadCallback(void* user, char* data, int size)
+{
+  auto bytesRead = static_cast<io::IFileReader*>(user)->Read(data, size);
+  return bytesRead < 0 ? 0 : bytesRead;
+}
+
+void SkipCallback(void* user, int n)
+{
+  auto file = static_cast<io::IFileReader*>(user);
+  file->Seek(file->GetPosition() + n);
+}
+
+int EofCallback(void* user)
+{
+  auto file = static_cast<io::IFileReader*>(user);
+  return file->GetPosition() >= file->GetLength();
+}
+
+const stbi_io_callbacks FileReaderCallbacks = { ReadCallback, SkipCallback, EofCallback };
+
+/// Replaces pixel data with a buffer of 'channels' channels filled by convert.
+template <class Convert> void Reformat(LoadedImage& img, int32_t channels, Convert convert)
+{
+  size_t pixelCount = (size_t)img.size.x * img.size.y;
+  auto converted    = (uint8_t*)malloc(pixelCount * channels);
+
+  convert(img.data.get(), converted, pixelCount);
+  img.data     = core::UniquePtr<uint8_t[], void (*)(void*)>(converted, free);
+  img.channels = channels;
+}
+} // namespace
 
-StbLoadedImage LoadImage(io::IFileSystem* fs, const io::Path& path)
+LoadedImage LoadImage(io::IFileSystem* fs, const io::Path& path, const ImageDecodeOptions& options)
 {
   auto file = fs->OpenRead(path);
 
   if (!file) {
     elog::LogInfo(core::string::format("Failed to open {}\n", path.AsString().c_str()));
-    return StbLoadedImage();
+    return LoadedImage();
   }
 
-  core::TByteArray testByteArray;
-  auto bytesRead = file->Read(testByteArray);
+  auto img = ImageLoader::DecodeImage(file.get(), options);
 
-  elog::LogInfo(core::string::format("Image size bytes: {}\n", bytesRead));
-  StbLoadedImage img;
-  img.data =
-      core::UniquePtr<uint8_t[], void(*)(void*)>(stbi_load_from_memory((stbi_uc*)testByteArray.data(), bytesRead,
-                                                                       &img.size.w, &img.size.h, &img.channels, 0), stbi_image_free);
-
-  elog::LogInfo(core::string::format("Image size x: {}\n", img.size.x));
-  elog::LogInfo(core::string::format("Image size y: {}\n", img.size.y));
+  if (!img.data) {
+    elog::LogWarning(core::string::format("Failed to decode {}: {}", path.AsString(),
+                                          stbi_failure_reason()));
+  }
+  else {
+    ELOG_DEBUG("Image size: {}x{}, channels: {}", img.size.x, img.size.y, img.channels);
+  }
 
   return img;
 }
@@ -50,15 +81,70 @@ ImageLoader::ImageLoader(io::IFileSystem* fs, render::IRenderer* renderer)
 {
 }
 
-inline render::TextureDataFormat GetImageDataFormat(const StbLoadedImage& img)
+inline render::TextureDataFormat GetImageDataFormat(const LoadedImage& img)
 {
-  return img.channels == 3 ? render::TextureDataFormat::RGB : render::TextureDataFormat::RGBA;
+  switch (img.channels) {
+  case 1:
+    return render::TextureDataFormat::R;
+  case 2:
+    return render::TextureDataFormat::RG;
+  case 3:
+    return render::TextureDataFormat::RGB;
+  default:
+    return render::TextureDataFormat::RGBA;
+  }
+}
+
+LoadedImage ImageLoader::DecodeImage(io::IFileReader* file, const ImageDecodeOptions& options)
+{
+  LoadedImage img;
+  uint8_t header[cooked::HeaderSize];
+  auto headerBytes = file->Read(header, sizeof(header));
+  file->Seek(0);
+
+  if (cooked::Detect(header, headerBytes) == cooked::CookedType::Texture) {
+    img = cooked::ReadTexture(file);
+  }
+  else {
+    img.data = core::UniquePtr<uint8_t[], void (*)(void*)>(
+        stbi_load_from_callbacks(&FileReaderCallbacks, file, &img.size.x, &img.size.y,
+                                 &img.channels, 0),
+        stbi_image_free);
+    img.encodedBytes = file->GetLength();
+  }
+
+  if (!img.data) {
+    return LoadedImage();
+  }
+
+  if (img.channels == 3 && options.ExpandRgbToRgba) {
+    Reformat(img, 4, pixel::RgbToRgba);
+  }
+
+  if (options.PremultiplyAlpha) {
+    size_t pixelCount = (size_t)img.size.x * img.size.y;
+
+    if (img.channels == 4)
+      pixel::PremultiplyRgba(img.data.get(), pixelCount);
+    else if (img.channels == 2)
+      pixel::PremultiplyGrayAlpha(img.data.get(), pixelCount);
+  }
+
+  return img;
+}
+
+LoadedImage ImageLoader::DecodeImage(const io::Path& path, const ImageDecodeOptions& options)
+{
+  return LoadImage(m_fileSystem, path, options);
 }
 
 core::UniquePtr<render::ITexture> ImageLoader::LoadTexture(const io::Path& path)
 {
-  auto img = LoadImage(m_fileSystem, path);
+  return CreateTexture(DecodeImage(path));
+}
 
+core::UniquePtr<render::ITexture> ImageLoader::CreateTexture(const LoadedImage& img)
+{
   if (!img.data) {
     return nullptr;
   }
@@ -73,6 +159,18 @@ core::UniquePtr<render::ITexture> ImageLoader::LoadTexture(const io::Path& path)
   return texture;
 }
 
+bool ImageLoader::UpdateTexture(render::ITexture* texture, const LoadedImage& img)
+{
+  if (!img.data) {
+    return false;
+  }
+
+  auto format = GetImageDataFormat(img);
+  texture->UploadData(render::TextureDataDescriptor(
+      (void*)img.data.get(), core::pod::Vec2<uint32_t>(img.size.x, img.size.y), format));
+  return true;
+}
+
 core::UniquePtr<uint8_t[]> PrepareImageAtlasData(uint8_t* originalData, int originalWidth,
                                                int originalHeight, int numChannels,
                                                int subImageSize)
@@ -120,7 +218,7 @@ core::UniquePtr<uint8_t[]> PrepareImageAtlasData(uint8_t* originalData, int orig
 core::UniquePtr<render::ITexture> ImageLoader::LoadAtlasAs2DTexture(const io::Path& path,
                                                                     uint32_t subImageSize)
 {
-  auto img = LoadImage(m_fileSystem, path);
+  auto img = DecodeImage(path);
 
   if (!img.data) {
     return nullptr;
@@ -148,4 +246,23 @@ core::UniquePtr<render::ITexture> ImageLoader::LoadAtlasAs2DTexture(const io::Pa
   return texture;
 }
 
-} // namespace res
\ No newline at end of file
+uint32_t ImageLoader::LoadIntoAtlas(atlas::TextureAtlas& atlas, const io::Path& path)
+{
+  auto img = DecodeImage(path);
+
+  if (!img.data) {
+    return atlas::TextureAtlas::InvalidId;
+  }
+
+  // atlas pages are RGBA only, gray images are replicated into color channels
+  if (img.channels == 1) {
+    Reformat(img, 4, pixel::GrayToRgba);
+  }
+  else if (img.channels == 2) {
+    Reformat(img, 4, pixel::GrayAlphaToRgba);
+  }
+
+  return atlas.Insert(img.data.get(), img.size.x, img.size.y);
+}
+
+} // namespace res
@@ -0,0 +1,229 @@
+#include "resource_management/LoadTelemetry.h"
+#include "filesystem/IFileSystem.h"
+
+namespace res {
+namespace {
+core::String EscapeJson(const core::String& str)
+{
+  core::String escaped;
+  escaped.reserve(str.size());
+
+  for (auto c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    }
+    else if ((unsigned char)c < 0x20) {
+      escaped += core::string::format("\\u{:04x}", (int)c);
+    }
+    else {
+      escaped += c;
+    }
+  }
+
+  return escaped;
+}
+
+core::String EscapeCsv(const core::String& str)
+{
+  if (str.find_first_of(",\"\n") == core::String::npos)
+    return str;
+
+  core::String escaped = "\"";
+  for (auto c : str) {
+    escaped += c;
+    if (c == '"')
+      escaped += '"';
+  }
+
+  return escaped + "\"";
+}
+
+core::String ToCsv(const core::Vector<LoadRecord>& records)
+{
+  core::String out = "path,type,bytes,start_us,decode_us,upload_us,cache_hit,preloaded,thread\n";
+
+  for (const auto& r : records) {
+    out += core::string::format("{},{},{},{},{},{},{},{},{}\n", EscapeCsv(r.Path), ToString(r.Type),
+                                r.Bytes, r.Start, r.DecodeTime, r.UploadTime, (int)r.CacheHit,
+                                (int)r.Preloaded, r.Thread);
+  }
+
+  return out;
+}
+
+core::String ToJson(const core::Vector<LoadRecord>& records)
+{
+  core::String out = "[\n";
+
+  for (uint32_t i = 0; i < records.size(); i++) {
+    const auto& r = records[i];
+    out += core::string::format(
+        "  {{\"path\": \"{}\", \"type\": \"{}\", \"bytes\": {}, \"start_us\": {}, "
+        "\"decode_us\": {}, \"upload_us\": {}, \"cache_hit\": {}, \"preloaded\": {}, "
+        "\"thread\": {}}}{}\n",
+        EscapeJson(r.Path), ToString(r.Type), r.Bytes, r.Start, r.DecodeTime, r.UploadTime,
+        r.CacheHit, r.Preloaded, r.Thread, i + 1 < records.size() ? "," : "");
+  }
+
+  return out + "]\n";
+}
+
+core::String ToChromeTrace(const core::Vector<LoadRecord>& records)
+{
+  core::Vector<core::String> events;
+
+  auto addSpan = [&](const LoadRecord& r, const char* phase, uint64_t start, uint64_t duration) {
+    events.push_back(core::string::format(
+        "{{\"name\": \"{} {}\", \"cat\": \"{}\", \"ph\": \"X\", \"ts\": {}, \"dur\": {}, "
+        "\"pid\": 0, \"tid\": {}, \"args\": {{\"path\": \"{}\", \"bytes\": {}, "
+        "\"preloaded\": {}}}}}",
+        phase, EscapeJson(r.Path), ToString(r.Type), start, duration, r.Thread,
+        EscapeJson(r.Path), r.Bytes, r.Preloaded));
+  };
+
+  for (const auto& r : records) {
+    if (r.CacheHit) {
+      events.push_back(core::string::format(
+          "{{\"name\": \"hit {}\", \"cat\": \"{}\", \"ph\": \"i\", \"s\": \"t\", \"ts\": {}, "
+          "\"pid\": 0, \"tid\": {}}}",
+          EscapeJson(r.Path), ToString(r.Type), r.Start, r.Thread));
+      continue;
+    }
+
+    addSpan(r, "decode", r.Start, r.DecodeTime);
+    if (r.UploadTime > 0)
+      addSpan(r, "upload", r.Start + r.DecodeTime, r.UploadTime);
+  }
+
+  core::String out = "{\"traceEvents\": [\n";
+  for (uint32_t i = 0; i < events.size(); i++) {
+    out += events[i] + (i + 1 < events.size() ? ",\n" : "\n");
+  }
+
+  return out + "]}\n";
+}
+} // namespace
+
+LoadTelemetry::LoadTelemetry()
+    : m_sessionStart(std::chrono::steady_clock::now())
+{
+}
+
+uint64_t LoadTelemetry::Now() const
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                               m_sessionStart)
+      .count();
+}
+
+void LoadTelemetry::Record(LoadRecord record)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto thread   = m_threads.emplace(std::this_thread::get_id(), m_threads.size()).first;
+  record.Thread = thread->second;
+  m_records.push_back(core::Move(record));
+}
+
+core::Vector<LoadRecord> LoadTelemetry::GetRecords() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_records;
+}
+
+core::Vector<LoadRecord> LoadTelemetry::Query(
+    const std::function<bool(const LoadRecord&)>& filter) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  core::Vector<LoadRecord> result;
+
+  for (const auto& record : m_records) {
+    if (filter(record))
+      result.push_back(record);
+  }
+
+  return result;
+}
+
+core::Vector<LoadRecord> LoadTelemetry::GetTop(
+    uint32_t count, bool (*less)(const LoadRecord&, const LoadRecord&)) const
+{
+  auto records = Query([](const LoadRecord& r) { return !r.CacheHit; });
+  count        = std::min<uint32_t>(count, records.size());
+
+  std::partial_sort(records.begin(), records.begin() + count, records.end(),
+                    [less](const LoadRecord& a, const LoadRecord& b) { return less(b, a); });
+  records.resize(count);
+  return records;
+}
+
+core::Vector<LoadRecord> LoadTelemetry::GetSlowest(uint32_t count) const
+{
+  return GetTop(count, [](const LoadRecord& a, const LoadRecord& b) {
+    return a.GetTotalTime() < b.GetTotalTime();
+  });
+}
+
+core::Vector<LoadRecord> LoadTelemetry::GetLargest(uint32_t count) const
+{
+  return GetTop(count, [](const LoadRecord& a, const LoadRecord& b) { return a.Bytes < b.Bytes; });
+}
+
+core::String LoadTelemetry::Serialize(TelemetryFormat format) const
+{
+  auto records = GetRecords();
+
+  switch (format) {
+  case TelemetryFormat::Csv:
+    return ToCsv(records);
+  case TelemetryFormat::Json:
+    return ToJson(records);
+  case TelemetryFormat::ChromeTrace:
+    return ToChromeTrace(records);
+  default:
+    return "";
+  }
+}
+
+bool LoadTelemetry::Write(io::IFileSystem* fs, const io::Path& path, TelemetryFormat format) const
+{
+  auto file = fs->OpenWrite(path);
+
+  if (!file) {
+    elog::LogWarning(
+        core::string::format("Failed to open '{}' for load telemetry", path.AsString()));
+    return false;
+  }
+
+  auto contents = Serialize(format);
+  return file->Write(contents) == (std::intmax_t)contents.size();
+}
+
+void LoadTelemetry::LogSummary(uint32_t count) const
+{
+  auto records   = GetRecords();
+  uint64_t bytes = 0, time = 0;
+  uint32_t hits  = 0;
+
+  for (const auto& r : records) {
+    bytes += r.Bytes;
+    time += r.GetTotalTime();
+    hits += r.CacheHit;
+  }
+
+  elog::LogInfo(core::string::format(
+      "Resource loads: {}, cache hits: {}, bytes read: {}, load time: {} ms", records.size(), hits,
+      bytes, time / 1000));
+
+  for (const auto& r : GetSlowest(count)) {
+    elog::LogInfo(core::string::format("  slow {} '{}': decode {} us, upload {} us",
+                                       ToString(r.Type), r.Path, r.DecodeTime, r.UploadTime));
+  }
+
+  for (const auto& r : GetLargest(count)) {
+    elog::LogInfo(core::string::format("  large {} '{}': {} bytes", ToString(r.Type), r.Path,
+                                       r.Bytes));
+  }
+}
+} // namespace res
@@ -0,0 +1,213 @@
+#include "resource_management/PixelConversion.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define ENGINE_PIXEL_SSE 1
+#include <tmmintrin.h>
+#endif
+
+namespace res::pixel {
+namespace {
+/// x * a / 255 rounded, exact for all 8 bit inputs.
+inline uint8_t MulDiv255(uint32_t x, uint32_t a)
+{
+  uint32_t t = x * a + 128;
+  return (t + (t >> 8)) >> 8;
+}
+
+void RgbToRgbaScalar(const uint8_t* src, uint8_t* dst, size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; i++, src += 3, dst += 4) {
+    dst[0] = src[0];
+    dst[1] = src[1];
+    dst[2] = src[2];
+    dst[3] = 255;
+  }
+}
+
+void GrayToRgbaScalar(const uint8_t* src, uint8_t* dst, size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; i++, src++, dst += 4) {
+    dst[0] = dst[1] = dst[2] = src[0];
+    dst[3]                   = 255;
+  }
+}
+
+void GrayAlphaToRgbaScalar(const uint8_t* src, uint8_t* dst, size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; i++, src += 2, dst += 4) {
+    dst[0] = dst[1] = dst[2] = src[0];
+    dst[3]                   = src[1];
+  }
+}
+
+void PremultiplyRgbaScalar(uint8_t* pixels, size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; i++, pixels += 4) {
+    pixels[0] = MulDiv255(pixels[0], pixels[3]);
+    pixels[1] = MulDiv255(pixels[1], pixels[3]);
+    pixels[2] = MulDiv255(pixels[2], pixels[3]);
+  }
+}
+
+void PremultiplyGrayAlphaScalar(uint8_t* pixels, size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; i++, pixels += 2) {
+    pixels[0] = MulDiv255(pixels[0], pixels[1]);
+  }
+}
+
+#ifdef ENGINE_PIXEL_SSE
+bool HasSsse3()
+{
+  static const bool supported = __builtin_cpu_supports("ssse3");
+  return supported;
+}
+
+/// Same rounding as MulDiv255 on 16 bit lanes.
+__attribute__((target("sse2"))) inline __m128i MulDiv255(__m128i x, __m128i a)
+{
+  auto t = _mm_add_epi16(_mm_mullo_epi16(x, a), _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+__attribute__((target("ssse3"))) size_t RgbToRgbaSsse3(const uint8_t* src, uint8_t* dst,
+                                                        size_t pixelCount)
+{
+  const auto shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  const auto alpha   = _mm_set1_epi32(0xff000000);
+  size_t i           = 0;
+
+  // every load reads 16 bytes but consumes 12, keep the tail for scalar code
+  for (; i + 6 <= pixelCount; i += 4, src += 12, dst += 16) {
+    auto rgb = _mm_loadu_si128((const __m128i*)src);
+    _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+  }
+
+  return i;
+}
+
+__attribute__((target("sse2"))) size_t GrayToRgbaSse2(const uint8_t* src, uint8_t* dst,
+                                                       size_t pixelCount)
+{
+  const auto alpha = _mm_set1_epi8((char)255);
+  size_t i         = 0;
+
+  for (; i + 16 <= pixelCount; i += 16, src += 16, dst += 64) {
+    auto g  = _mm_loadu_si128((const __m128i*)src);
+    auto gg = _mm_unpacklo_epi8(g, g);
+    auto ga = _mm_unpacklo_epi8(g, alpha);
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(gg, ga));
+    _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(gg, ga));
+
+    gg = _mm_unpackhi_epi8(g, g);
+    ga = _mm_unpackhi_epi8(g, alpha);
+    _mm_storeu_si128((__m128i*)(dst + 32), _mm_unpacklo_epi16(gg, ga));
+    _mm_storeu_si128((__m128i*)(dst + 48), _mm_unpackhi_epi16(gg, ga));
+  }
+
+  return i;
+}
+
+__attribute__((target("sse2"))) size_t GrayAlphaToRgbaSse2(const uint8_t* src, uint8_t* dst,
+                                                            size_t pixelCount)
+{
+  const auto lowByte = _mm_set1_epi16(0x00ff);
+  size_t i           = 0;
+
+  for (; i + 8 <= pixelCount; i += 8, src += 16, dst += 32) {
+    auto ga = _mm_loadu_si128((const __m128i*)src);
+    auto g  = _mm_and_si128(ga, lowByte);
+    auto gg = _mm_or_si128(g, _mm_slli_epi16(g, 8));
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(gg, ga));
+    _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(gg, ga));
+  }
+
+  return i;
+}
+
+__attribute__((target("sse2"))) size_t PremultiplyRgbaSse2(uint8_t* pixels, size_t pixelCount)
+{
+  const auto zero      = _mm_setzero_si128();
+  const auto alphaMask = _mm_set1_epi32(0xff000000);
+  size_t i             = 0;
+
+  auto premultiply = [&](__m128i px) {
+    auto a = _mm_shufflelo_epi16(px, _MM_SHUFFLE(3, 3, 3, 3));
+    a      = _mm_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+    return MulDiv255(px, a);
+  };
+
+  for (; i + 4 <= pixelCount; i += 4, pixels += 16) {
+    auto px = _mm_loadu_si128((const __m128i*)pixels);
+    auto lo = premultiply(_mm_unpacklo_epi8(px, zero));
+    auto hi = premultiply(_mm_unpackhi_epi8(px, zero));
+    auto rgb = _mm_andnot_si128(alphaMask, _mm_packus_epi16(lo, hi));
+    _mm_storeu_si128((__m128i*)pixels, _mm_or_si128(rgb, _mm_and_si128(px, alphaMask)));
+  }
+
+  return i;
+}
+
+__attribute__((target("sse2"))) size_t PremultiplyGrayAlphaSse2(uint8_t* pixels,
+                                                                 size_t pixelCount)
+{
+  const auto lowByte = _mm_set1_epi16(0x00ff);
+  size_t i           = 0;
+
+  for (; i + 8 <= pixelCount; i += 8, pixels += 16) {
+    auto ga = _mm_loadu_si128((const __m128i*)pixels);
+    auto g  = MulDiv255(_mm_and_si128(ga, lowByte), _mm_srli_epi16(ga, 8));
+    _mm_storeu_si128((__m128i*)pixels, _mm_or_si128(g, _mm_andnot_si128(lowByte, ga)));
+  }
+
+  return i;
+}
+#endif
+} // namespace
+
+void RgbToRgba(const uint8_t* src, uint8_t* dst, size_t pixelCount)
+{
+  size_t done = 0;
+#ifdef ENGINE_PIXEL_SSE
+  if (HasSsse3())
+    done = RgbToRgbaSsse3(src, dst, pixelCount);
+#endif
+  RgbToRgbaScalar(src + done * 3, dst + done * 4, pixelCount - done);
+}
+
+void GrayToRgba(const uint8_t* src, uint8_t* dst, size_t pixelCount)
+{
+  size_t done = 0;
+#ifdef ENGINE_PIXEL_SSE
+  done = GrayToRgbaSse2(src, dst, pixelCount);
+#endif
+  GrayToRgbaScalar(src + done, dst + done * 4, pixelCount - done);
+}
+
+void GrayAlphaToRgba(const uint8_t* src, uint8_t* dst, size_t pixelCount)
+{
+  size_t done = 0;
+#ifdef ENGINE_PIXEL_SSE
+  done = GrayAlphaToRgbaSse2(src, dst, pixelCount);
+#endif
+  GrayAlphaToRgbaScalar(src + done * 2, dst + done * 4, pixelCount - done);
+}
+
+void PremultiplyRgba(uint8_t* pixels, size_t pixelCount)
+{
+  size_t done = 0;
+#ifdef ENGINE_PIXEL_SSE
+  done = PremultiplyRgbaSse2(pixels, pixelCount);
+#endif
+  PremultiplyRgbaScalar(pixels + done * 4, pixelCount - done);
+}
+
+void PremultiplyGrayAlpha(uint8_t* pixels, size_t pixelCount)
+{
+  size_t done = 0;
+#ifdef ENGINE_PIXEL_SSE
+  done = PremultiplyGrayAlphaSse2(pixels, pixelCount);
+#endif
+  PremultiplyGrayAlphaScalar(pixels + done * 2, pixelCount - done);
+}
+} // namespace res::pixel
@@ -0,0 +1,95 @@
+#include "resource_management/PreloadManifest.h"
+#include "filesystem/IFileSystem.h"
+#include <sstream>
+
+namespace res {
+namespace {
+const char* ManifestHeader = "# preload manifest v1\n";
+}
+
+core::Optional<PreloadManifest> PreloadManifest::Read(io::IFileSystem* fs, const io::Path& path)
+{
+  if (!fs->FileExists(path)) {
+    return {};
+  }
+
+  auto file = fs->OpenRead(path);
+  core::String contents;
+
+  if (!file || file->Read(contents) < 0) {
+    return {};
+  }
+
+  PreloadManifest manifest;
+  std::istringstream stream(contents);
+  core::String line;
+
+  while (std::getline(stream, line)) {
+    line = core::string::Trim(line);
+
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    auto separator = line.find(' ');
+    auto type      = ResourceTypeFromString(line.substr(0, separator));
+
+    if (separator == core::String::npos || !type) {
+      elog::LogWarning(
+          core::string::format("Skipping malformed preload manifest line: '{}'", line));
+      continue;
+    }
+
+    manifest.Add(type.value(), core::string::TrimBegin(line.substr(separator + 1)));
+  }
+
+  elog::LogInfo(core::string::format("Read preload manifest '{}', entries: {}", path.AsString(),
+                                     manifest.m_entries.size()));
+  return manifest;
+}
+
+bool PreloadManifest::Write(io::IFileSystem* fs, const io::Path& path) const
+{
+  auto file = fs->OpenWrite(path);
+
+  if (!file) {
+    return false;
+  }
+
+  core::String contents = ManifestHeader;
+
+  for (const auto& entry : m_entries) {
+    contents += core::string::format("{} {}\n", ToString(entry.Type), entry.Path);
+  }
+
+  return file->Write(contents) == (std::intmax_t)contents.size();
+}
+
+void PreloadManifest::Add(ResourceType type, const core::String& path)
+{
+  auto it = core::alg::find_if(m_entries, [&](const PreloadEntry& entry) {
+    return entry.Type == type && entry.Path == path;
+  });
+
+  if (it == m_entries.end()) {
+    m_entries.push_back(PreloadEntry{ type, path });
+  }
+}
+
+PreloadRecorder::PreloadRecorder(float recordSeconds)
+    : m_recordSeconds(recordSeconds)
+{
+  m_timer.Start();
+}
+
+void PreloadRecorder::Record(ResourceType type, const core::String& path)
+{
+  if (IsRecording()) {
+    m_manifest.Add(type, path);
+  }
+}
+
+bool PreloadRecorder::IsRecording()
+{
+  return m_timer.SecondsElapsed() <= m_recordSeconds;
+}
+} // namespace res
@@ -0,0 +1,89 @@
+#include "resource_management/ResourceDependencies.h"
+
+namespace res {
+namespace {
+void AddUnique(core::Vector<io::PathId>& ids, io::PathId id)
+{
+  if (std::find(ids.begin(), ids.end(), id) == ids.end())
+    ids.push_back(id);
+}
+
+void EraseValue(core::Vector<io::PathId>& ids, io::PathId id)
+{
+  ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+}
+} // namespace
+
+void ResourceDependencies::Add(io::PathId resource, io::PathId dependency)
+{
+  // empty ids are paths that failed to intern, they would alias each other
+  if (resource.IsEmpty() || dependency.IsEmpty())
+    return;
+
+  AddUnique(m_dependencies[resource], dependency);
+  AddUnique(m_dependents[dependency], resource);
+}
+
+void ResourceDependencies::Remove(io::PathId resource)
+{
+  auto it = m_dependencies.find(resource);
+
+  if (it == m_dependencies.end())
+    return;
+
+  for (auto dependency : it->second) {
+    auto dependents = m_dependents.find(dependency);
+    EraseValue(dependents->second, resource);
+
+    if (dependents->second.empty())
+      m_dependents.erase(dependents);
+  }
+
+  m_dependencies.erase(it);
+}
+
+core::Vector<io::PathId> ResourceDependencies::CollectAffected(
+    const core::Vector<io::Path>& changed) const
+{
+  core::Vector<io::PathId> affected;
+  core::UnorderedMap<io::PathId, bool> visited;
+
+  // post order walk of the dependents, reversed it lists dependencies first
+  struct Frame
+  {
+    io::PathId Id;
+    uint32_t Next;
+  };
+  core::Vector<Frame> stack;
+
+  for (auto& path : changed) {
+    auto root = io::PathId::Find(path.AsString());
+
+    if (root.IsEmpty() || !visited.emplace(root, true).second)
+      continue;
+
+    stack.push_back({ root, 0 });
+
+    while (!stack.empty()) {
+      auto& frame     = stack.back();
+      auto dependents = m_dependents.find(frame.Id);
+
+      if (dependents != m_dependents.end() && frame.Next < dependents->second.size()) {
+        auto next = dependents->second[frame.Next++];
+
+        if (visited.emplace(next, true).second)
+          stack.push_back({ next, 0 });
+        continue;
+      }
+
+      // plain files are not resources
+      if (m_dependencies.count(frame.Id))
+        affected.push_back(frame.Id);
+      stack.pop_back();
+    }
+  }
+
+  std::reverse(affected.begin(), affected.end());
+  return affected;
+}
+} // namespace res
@@ -1,12 +1,21 @@
+#include "filesystem/IoBufferPool.h"
 #include "render/AnimatedMesh.h"
 #include "render/BaseMaterial.h"
 #include "render/IGpuProgram.h"
 #include "render/ITexture.h"
+#include "render/ShaderProgramBatch.h"
 #include "render/animation/AnimationController.h"
+#include "resource_management/CookedFormats.h"
 #include "resource_management/ResourceManagementInc.h"
+#include "resource_management/ResourcePreloader.h"
+#include "util/ThreadPool.h"
 #include <resource_management/ResourceManager.h>
 
 namespace res {
+namespace {
+constexpr uint32_t TelemetrySummaryCount = 5;
+}
+
 ResourceManager::ResourceManager(ImageLoader* imgLoader,
                                  render::IRenderer* renderer, io::IFileSystem* fileSystem,
                                  res::mesh::AssimpImport* assimpImporter)
@@ -15,19 +24,66 @@ ResourceManager::ResourceManager(ImageLoader* imgLoader,
   m_renderer = renderer;
   m_fileSystem = fileSystem;
   m_assimpImporter    = assimpImporter;
+  m_firstFrameMarked  = false;
+  m_preloadEntryCount = 0;
+  m_sessionTimer.Start();
+}
+
+ResourceManager::~ResourceManager()
+{
+  // preloader still has tasks running on the workers
+  m_preloader = nullptr;
+  m_workers   = nullptr;
+
+  m_telemetry.LogSummary(TelemetrySummaryCount);
 }
 
 render::ITexture* ResourceManager::LoadTexture(core::String path)
 {
-  if (auto it = m_textures.find(path); it != m_textures.end()) {
+  return LoadTexture(io::PathId(path));
+}
+
+render::ITexture* ResourceManager::LoadTexture(io::PathId id)
+{
+  if (id.IsEmpty()) {
+    elog::LogError("Failed to load texture, the path is empty or could not be interned");
+    return nullptr;
+  }
+
+  const auto& path = id.AsString();
+  RecordAccess(ResourceType::Texture, path);
+
+  LoadRecord record;
+  record.Path  = path;
+  record.Type  = ResourceType::Texture;
+  record.Start = m_telemetry.Now();
+
+  if (auto it = m_textures.find(id); it != m_textures.end()) {
+    record.CacheHit = true;
+    m_telemetry.Record(core::Move(record));
     return it->second.Res.get();
   }
 
-  auto texture = m_imageLoader->LoadTexture(path);
+  util::Timer timer;
+  LoadedImage image;
+  record.Preloaded = m_preloader && m_preloader->TakeImage(path, image);
+
+  if (!record.Preloaded) {
+    image = m_imageLoader->DecodeImage(path);
+  }
+
+  record.DecodeTime = timer.MicrosecondsElapsed();
+  record.Bytes      = image.encodedBytes;
+
+  timer.Start();
+  auto texture      = m_imageLoader->CreateTexture(image);
+  record.UploadTime = timer.MicrosecondsElapsed();
+  m_telemetry.Record(core::Move(record));
 
   if (texture) {
+    m_dependencies.Add(id, id);
     auto r = texture.get();
-    m_textures.emplace(std::piecewise_construct, std::forward_as_tuple(path),
+    m_textures.emplace(std::piecewise_construct, std::forward_as_tuple(id),
                        std::forward_as_tuple(path, core::Move(texture)));
     return r;
   }
@@ -37,11 +93,14 @@ render::ITexture* ResourceManager::LoadTexture(core::String path)
 
 core::SharedPtr<material::BaseMaterial> ResourceManager::LoadMaterial(core::String path)
 {
-  if (auto it = m_shaders.find(path); it != m_shaders.end()) {
-    return core::MakeShared<material::BaseMaterial>(it->second.Res.get());
-  }
+  return LoadMaterial(io::PathId(path));
+}
 
-  auto shader = LoadProgram(path);
+core::SharedPtr<material::BaseMaterial> ResourceManager::LoadMaterial(io::PathId id)
+{
+  RecordAccess(ResourceType::Program, id.AsString());
+
+  auto shader = LoadProgram(id);
 
   if (shader) {
     return core::MakeShared<material::BaseMaterial>(shader);
@@ -50,45 +109,367 @@ core::SharedPtr<material::BaseMaterial> ResourceManager::LoadMaterial(core::Stri
   return nullptr;
 }
 
-render::IGpuProgram* ResourceManager::LoadProgram(const core::String& path)
+core::Vector<core::SharedPtr<material::BaseMaterial>> ResourceManager::LoadMaterials(
+    const core::Vector<core::String>& paths)
+{
+  core::Vector<io::PathId> ids;
+  ids.reserve(paths.size());
+
+  for (const auto& path : paths) {
+    ids.emplace_back(path);
+  }
+
+  return LoadMaterials(ids);
+}
+
+core::Vector<core::SharedPtr<material::BaseMaterial>> ResourceManager::LoadMaterials(
+    const core::Vector<io::PathId>& ids)
 {
-    if (auto it = m_shaders.find(path); it != m_shaders.end()) {
-        return it->second.Res.get();
+  for (auto id : ids) {
+    RecordAccess(ResourceType::Program, id.AsString());
+  }
+
+  auto programs = LoadPrograms(ids);
+
+  core::Vector<core::SharedPtr<material::BaseMaterial>> materials;
+  materials.reserve(programs.size());
+
+  for (auto program : programs) {
+    materials.push_back(program ? core::MakeShared<material::BaseMaterial>(program) : nullptr);
+  }
+
+  return materials;
+}
+
+render::IGpuProgram* ResourceManager::LoadProgram(io::PathId id)
+{
+  return LoadPrograms({ id })[0];
+}
+
+core::Vector<render::IGpuProgram*> ResourceManager::LoadPrograms(
+    const core::Vector<io::PathId>& ids)
+{
+  core::Vector<core::String> missingPrograms;
+  core::Vector<io::PathId> missingIds;
+
+  for (auto id : ids) {
+    if (id.IsEmpty()) {
+      elog::LogError("Failed to load program, the path is empty or could not be interned");
+      continue;
     }
 
-    auto vertexSource   = LoadShaderSource(path + ".vert");
-    auto fragmentSource = LoadShaderSource(path + ".frag");
-    auto geometrySource = LoadShaderSource(path + ".geom");
+    if (m_shaders.count(id) == 0 && core::alg::find_if(missingIds, [&](const auto& missingId) {
+                                       return missingId == id;
+                                     }) == missingIds.end()) {
+      missingPrograms.push_back(id.AsString());
+      missingIds.push_back(id);
+    }
+  }
 
-    auto gpuProgram = m_renderer->CreateProgram(vertexSource, fragmentSource, geometrySource);
+  auto start = m_telemetry.Now();
 
-    if (gpuProgram) {
-        auto gpuProgramPtr = gpuProgram.get();
+  for (auto id : ids) {
+    if (m_shaders.count(id)) {
+      LoadRecord record;
+      record.Path     = id.AsString();
+      record.Type     = ResourceType::Program;
+      record.Start    = start;
+      record.CacheHit = true;
+      m_telemetry.Record(core::Move(record));
+    }
+  }
 
-        m_shaders.emplace(std::piecewise_construct, std::forward_as_tuple(path),
-                          std::forward_as_tuple(path, core::Move(gpuProgram)));
+  if (!missingPrograms.empty()) {
+    auto gpuPrograms = CreatePrograms(missingPrograms, missingIds);
 
-        return gpuProgramPtr;
+    for (uint32_t i = 0; i < missingPrograms.size(); i++) {
+      if (gpuPrograms[i]) {
+        m_shaders.emplace(std::piecewise_construct, std::forward_as_tuple(missingIds[i]),
+                          std::forward_as_tuple(missingPrograms[i], core::Move(gpuPrograms[i])));
+      }
     }
+  }
 
-    return nullptr;
+  core::Vector<render::IGpuProgram*> programs;
+  programs.reserve(ids.size());
+
+  for (auto id : ids) {
+    auto it = m_shaders.find(id);
+    programs.push_back(it != m_shaders.end() ? it->second.Res.get() : nullptr);
+  }
+
+  return programs;
 }
 
-core::String ResourceManager::LoadShaderSource(const core::String& path)
+core::Vector<core::UniquePtr<render::IGpuProgram>> ResourceManager::CreatePrograms(
+    const core::Vector<core::String>& paths, const core::Vector<io::PathId>& ids)
 {
-    core::String fileContents;
+  auto start = m_telemetry.Now();
+  util::Timer timer;
+  core::Vector<core::String> filePaths;
+
+  for (const auto& path : paths) {
+    filePaths.push_back(path + cooked::ProgramExtension);
+    filePaths.push_back(path + ".vert");
+    filePaths.push_back(path + ".frag");
+    filePaths.push_back(path + ".geom");
+  }
+
+  auto contents     = LoadShaderSources(filePaths);
+  uint64_t readTime = timer.MicrosecondsElapsed();
+
+  core::Vector<render::ShaderProgramSource> sources(paths.size());
+  for (uint32_t i = 0; i < paths.size(); i++) {
+    auto files   = &contents[i * 4];
+    auto& source = sources[i];
 
-    auto file = m_fileSystem->OpenRead(path);
-    if (file) {
-        file->Read(fileContents);
-        // elog::LogInfo(fileContents);
-        elog::LogInfo("Loaded shader: " + path);
+    // cooked bundle takes precedence over stage sources
+    if (!files[0].empty()) {
+      if (!cooked::ReadProgram(files[0].data(), files[0].size(), source)) {
+        elog::LogError("Cooked program file is corrupt: " + filePaths[i * 4]);
+      }
     }
     else {
-        elog::LogInfo("Failed to read shader source: " + path);
+      source = render::ShaderProgramSource{ core::Move(files[1]), core::Move(files[2]),
+                                            core::Move(files[3]) };
     }
 
-    return fileContents;
+    if (source.Vertex.empty() || source.Fragment.empty()) {
+      elog::LogInfo("Failed to read shader source: " + paths[i]);
+    }
+    else {
+      elog::LogInfo("Loaded shader: " + paths[i]);
+    }
+  }
+
+  timer.Start();
+  auto gpuPrograms    = m_renderer->CreatePrograms(sources);
+  uint64_t createTime = timer.MicrosecondsElapsed();
+
+  for (uint32_t i = 0; i < paths.size(); i++) {
+    // programs are read and linked as one batch, per program times are batch averages
+    LoadRecord record;
+    record.Path       = paths[i];
+    record.Type       = ResourceType::Program;
+    record.Start      = start;
+    record.Bytes      = sources[i].Vertex.size() + sources[i].Fragment.size() +
+                        sources[i].Geometry.size();
+    record.DecodeTime = readTime / paths.size();
+    record.UploadTime = createTime / paths.size();
+    m_telemetry.Record(core::Move(record));
+  }
+
+  for (uint32_t i = 0; i < paths.size(); i++) {
+    if (gpuPrograms[i]) {
+      // stages that do not exist yet are tracked too, adding one changes the program
+      for (uint32_t stage = 0; stage < 4; stage++) {
+        m_dependencies.Add(ids[i], io::PathId(filePaths[i * 4 + stage]));
+      }
+    }
+  }
+
+  return gpuPrograms;
+}
+
+core::UniquePtr<render::AnimatedMesh> ResourceManager::LoadMesh(core::String path)
+{
+  return core::Move(LoadMeshes({ path })[0]);
+}
+
+core::Vector<core::UniquePtr<render::AnimatedMesh>> ResourceManager::LoadMeshes(
+    const core::Vector<core::String>& paths)
+{
+  core::Vector<LoadRecord> records(paths.size());
+  core::Vector<core::TByteArray> contents(paths.size());
+  core::Vector<std::future<core::UniquePtr<render::AnimatedMesh>>> imports;
+
+  for (uint32_t i = 0; i < paths.size(); i++) {
+    RecordAccess(ResourceType::Mesh, paths[i]);
+
+    auto& record     = records[i];
+    record.Path      = paths[i];
+    record.Type      = ResourceType::Mesh;
+    record.Start     = m_telemetry.Now();
+    record.Preloaded = m_preloader && m_preloader->TakeBytes(paths[i], contents[i]) &&
+                       !contents[i].empty();
+
+    imports.push_back(GetWorkers()->Submit(
+        [this, &record, &bytes = contents[i]]() -> core::UniquePtr<render::AnimatedMesh> {
+          util::Timer timer;
+          // loaded files go to a pooled buffer, that memory is reused by the next import
+          io::IoBuffer buffer;
+          const void* data = bytes.data();
+          size_t size      = bytes.size();
+
+          if (!record.Preloaded) {
+            auto file = m_fileSystem->OpenRead(record.Path);
+
+            if (!file || file->Read(buffer) < 0) {
+              elog::LogError(core::string::format("Failed to read mesh file '{}'", record.Path));
+              return nullptr;
+            }
+
+            data = buffer.GetData();
+            size = buffer.GetSize();
+          }
+
+          auto mesh         = mesh::AssimpImport::ImportMesh(record.Path, data, size);
+          record.Bytes      = size;
+          record.DecodeTime = timer.MicrosecondsElapsed();
+          bytes             = core::TByteArray();
+          return mesh;
+        }));
+  }
+
+  // gpu objects can only be created here, meshes are uploaded as their imports finish
+  core::Vector<core::UniquePtr<render::AnimatedMesh>> meshes;
+  meshes.reserve(paths.size());
+
+  for (uint32_t i = 0; i < paths.size(); i++) {
+    auto cpuMesh = imports[i].get();
+
+    if (cpuMesh) {
+      util::Timer timer;
+      meshes.push_back(m_assimpImporter->CreateGpuMesh(*cpuMesh));
+      records[i].UploadTime = timer.MicrosecondsElapsed();
+    }
+    else {
+      meshes.push_back(nullptr);
+    }
+
+    m_telemetry.Record(core::Move(records[i]));
+  }
+
+  return meshes;
+}
+
+core::Vector<io::PathId> ResourceManager::ReloadChanged(const core::Vector<io::Path>& changedFiles)
+{
+  auto affected = m_dependencies.CollectAffected(changedFiles);
+  core::Vector<core::String> programPaths;
+  core::Vector<io::PathId> programIds;
+
+  for (auto id : affected) {
+    if (auto texture = m_textures.find(id); texture != m_textures.end()) {
+      if (!m_imageLoader->UpdateTexture(texture->second.Res.get(),
+                                        m_imageLoader->DecodeImage(texture->second.Path))) {
+        elog::LogError("Failed to reload texture: " + texture->second.Path);
+      }
+    }
+    else if (auto shader = m_shaders.find(id); shader != m_shaders.end()) {
+      programPaths.push_back(shader->second.Path);
+      programIds.push_back(id);
+    }
+  }
+
+  if (!programPaths.empty()) {
+    auto programs = CreatePrograms(programPaths, programIds);
+
+    for (uint32_t i = 0; i < programs.size(); i++) {
+      if (!programs[i]) {
+        elog::LogError("Failed to reload shader, keeping the previous program: " +
+                       programPaths[i]);
+        continue;
+      }
+
+      // materials keep their program pointer, the old program is freed with programs[i]
+      m_shaders.at(programIds[i]).Res->Swap(*programs[i]);
+    }
+  }
+
+  elog::LogInfo(core::string::format("Reloaded {} resources for {} changed files", affected.size(),
+                                     changedFiles.size()));
+  return affected;
+}
+
+void ResourceManager::StartPreloadRecording(float seconds)
+{
+  m_recorder = core::MakeUnique<PreloadRecorder>(seconds);
+}
+
+bool ResourceManager::WritePreloadManifest(const io::Path& path)
+{
+  if (!m_recorder) {
+    elog::LogWarning("Preload recording was not started, manifest will not be written");
+    return false;
+  }
+
+  return m_recorder->GetManifest().Write(m_fileSystem, path);
+}
+
+void ResourceManager::Preload(const PreloadManifest& manifest)
+{
+  if (!m_preloader) {
+    m_preloader = core::MakeUnique<ResourcePreloader>(m_fileSystem, m_imageLoader, GetWorkers());
+  }
+
+  m_preloadEntryCount += manifest.GetEntries().size();
+  m_preloader->Start(manifest);
+}
+
+int32_t ResourceManager::MarkFirstInteractiveFrame()
+{
+  if (m_firstFrameMarked)
+    return -1;
+
+  m_firstFrameMarked = true;
+  auto elapsed       = m_sessionTimer.MilisecondsElapsed();
+
+  if (m_preloadEntryCount > 0) {
+    elog::LogInfo(core::string::format(
+        "Time to first interactive frame: {} ms (preload manifest, {} entries)", elapsed,
+        m_preloadEntryCount));
+  }
+  else {
+    elog::LogInfo(core::string::format(
+        "Time to first interactive frame: {} ms (no preload manifest)", elapsed));
+  }
+
+  return elapsed;
+}
+
+void ResourceManager::RecordAccess(ResourceType type, const core::String& path)
+{
+  if (m_recorder && !path.empty()) {
+    m_recorder->Record(type, path);
+  }
+}
+
+core::Vector<core::String> ResourceManager::LoadShaderSources(
+    const core::Vector<core::String>& paths)
+{
+  core::Vector<core::String> sources(paths.size());
+  core::Vector<std::future<void>> pendingReads;
+
+  for (uint32_t i = 0; i < paths.size(); i++) {
+    if (m_preloader && m_preloader->TakeText(paths[i], sources[i]))
+      continue;
+
+    pendingReads.push_back(GetWorkers()->Submit([this, &paths, &sources, i]() {
+      // stages are optional, probe first so missing ones are not reported as errors
+      if (!m_fileSystem->FileExists(paths[i]))
+        return;
+
+      if (auto mapping = m_fileSystem->MapFile(paths[i])) {
+        sources[i].assign((const char*)mapping->GetData(), mapping->GetSize());
+      }
+    }));
+  }
+
+  for (auto& read : pendingReads) {
+    read.get();
+  }
+
+  return sources;
+}
+
+util::ThreadPool* ResourceManager::GetWorkers()
+{
+  if (!m_workers) {
+    m_workers = core::MakeUnique<util::ThreadPool>();
+  }
+
+  return m_workers.get();
 }
 
 } // namespace res
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "resource_management/ResourcePreloader.h"
+#include "filesystem/IFileSystem.h"
+#include "resource_management/CookedFormats.h"
+#include "util/ThreadPool.h"
+
+namespace res {
+namespace {
+/// Cooked bundle first, stage sources are only present in uncooked trees.
+const char* ProgramFileExtensions[] = { cooked::ProgramExtension, ".vert", ".frag", ".geom" };
+
+template <class T> void ReadContents(io::IFileSystem* fs, const core::String& path, T& out)
+{
+  if (!fs->FileExists(path))
+    return;
+
+  if (auto file = fs->OpenRead(path)) {
+    file->Read(out);
+  }
+}
+} // namespace
+
+ResourcePreloader::ResourcePreloader(io::IFileSystem* fs, ImageLoader* imageLoader,
+                                     util::ThreadPool* workers)
+    : m_fileSystem(fs)
+    , m_imageLoader(imageLoader)
+    , m_workers(workers)
+{
+}
+
+ResourcePreloader::~ResourcePreloader()
+{
+  // workers reference slots, they have to finish before slots are freed
+  Wait();
+}
+
+void ResourcePreloader::Start(const PreloadManifest& manifest)
+{
+  for (const auto& entry : manifest.GetEntries()) {
+    if (entry.Type == ResourceType::Program) {
+      for (auto extension : ProgramFileExtensions) {
+        Submit(entry.Path + extension, entry.Type);
+      }
+    }
+    else {
+      Submit(entry.Path, entry.Type);
+    }
+  }
+
+  elog::LogInfo(core::string::format("Preloading {} files from manifest", m_slots.size()));
+}
+
+void ResourcePreloader::Submit(const core::String& path, ResourceType type)
+{
+  if (m_slots.count(path))
+    return;
+
+  auto slot = core::MakeUnique<Slot>();
+  auto s    = slot.get();
+
+  s->Ready = m_workers->Submit([this, s, path, type]() {
+    switch (type) {
+    case ResourceType::Texture:
+      s->Image = m_imageLoader->DecodeImage(path);
+      break;
+    case ResourceType::Program:
+      ReadContents(m_fileSystem, path, s->Text);
+      break;
+    case ResourceType::Mesh:
+      ReadContents(m_fileSystem, path, s->Bytes);
+      break;
+    }
+  });
+
+  m_slots.emplace(path, core::Move(slot));
+}
+
+void ResourcePreloader::Wait()
+{
+  for (auto& it : m_slots) {
+    if (it.second->Ready.valid())
+      it.second->Ready.wait();
+  }
+}
+
+ResourcePreloader::Slot* ResourcePreloader::Acquire(const core::String& path)
+{
+  auto it = m_slots.find(path);
+
+  if (it == m_slots.end() || !it->second->Ready.valid())
+    return nullptr;
+
+  it->second->Ready.get();
+  return it->second.get();
+}
+
+bool ResourcePreloader::TakeImage(const core::String& path, LoadedImage& out)
+{
+  if (auto slot = Acquire(path)) {
+    out = core::Move(slot->Image);
+    return true;
+  }
+
+  return false;
+}
+
+bool ResourcePreloader::TakeText(const core::String& path, core::String& out)
+{
+  if (auto slot = Acquire(path)) {
+    out = core::Move(slot->Text);
+    return true;
+  }
+
+  return false;
+}
+
+bool ResourcePreloader::TakeBytes(const core::String& path, core::TByteArray& out)
+{
+  if (auto slot = Acquire(path)) {
+    out = core::Move(slot->Bytes);
+    return true;
+  }
+
+  return false;
+}
+} // namespace res
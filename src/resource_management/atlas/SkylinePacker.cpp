@@ -0,0 +1,105 @@
+#include "resource_management/atlas/SkylinePacker.h"
+
+namespace res::atlas {
+SkylinePacker::SkylinePacker(uint32_t width, uint32_t height)
+    : m_width(width)
+    , m_height(height)
+{
+  Reset();
+}
+
+void SkylinePacker::Reset()
+{
+  m_usedArea = 0;
+  m_skyline.clear();
+  m_skyline.push_back(SkylineNode{ 0, 0, m_width });
+}
+
+bool SkylinePacker::Fits(uint32_t nodeIndex, uint32_t w, uint32_t h, uint32_t& y) const
+{
+  uint32_t x = m_skyline[nodeIndex].x;
+
+  if (x + w > m_width)
+    return false;
+
+  int64_t widthLeft = w;
+  y                 = m_skyline[nodeIndex].y;
+
+  for (uint32_t i = nodeIndex; widthLeft > 0; i++) {
+    y = std::max(y, m_skyline[i].y);
+
+    if (y + h > m_height)
+      return false;
+
+    widthLeft -= m_skyline[i].w;
+  }
+
+  return true;
+}
+
+core::Optional<PackedRect> SkylinePacker::Insert(uint32_t w, uint32_t h)
+{
+  if (w == 0 || h == 0)
+    return {};
+
+  uint32_t bestIndex = m_skyline.size(), bestTop = m_height + 1, bestWidth = m_width + 1;
+  uint32_t bestY = 0;
+
+  for (uint32_t i = 0; i < m_skyline.size(); i++) {
+    uint32_t y;
+
+    if (!Fits(i, w, h, y))
+      continue;
+
+    // lowest top edge wins, narrower level breaks ties which keeps the skyline flat
+    if (y + h < bestTop || (y + h == bestTop && m_skyline[i].w < bestWidth)) {
+      bestIndex = i;
+      bestTop   = y + h;
+      bestWidth = m_skyline[i].w;
+      bestY     = y;
+    }
+  }
+
+  if (bestIndex == m_skyline.size())
+    return {};
+
+  PackedRect rect{ m_skyline[bestIndex].x, bestY, w, h };
+  AddLevel(bestIndex, rect);
+  m_usedArea += (uint64_t)w * h;
+  return rect;
+}
+
+void SkylinePacker::AddLevel(uint32_t nodeIndex, const PackedRect& rect)
+{
+  m_skyline.insert(m_skyline.begin() + nodeIndex, SkylineNode{ rect.x, rect.y + rect.h, rect.w });
+
+  // shrink or remove nodes now covered by the new level
+  for (uint32_t i = nodeIndex + 1; i < m_skyline.size(); i++) {
+    auto& prev = m_skyline[i - 1];
+    auto& node = m_skyline[i];
+
+    if (node.x >= prev.x + prev.w)
+      break;
+
+    uint32_t shrink = prev.x + prev.w - node.x;
+
+    if (node.w > shrink) {
+      node.x += shrink;
+      node.w -= shrink;
+      break;
+    }
+
+    m_skyline.erase(m_skyline.begin() + i);
+    i--;
+  }
+
+  // merge neighbouring levels of the same height
+  for (uint32_t i = 0; i + 1 < m_skyline.size(); i++) {
+    if (m_skyline[i].y == m_skyline[i + 1].y) {
+      m_skyline[i].w += m_skyline[i + 1].w;
+      m_skyline.erase(m_skyline.begin() + i + 1);
+      i--;
+    }
+  }
+}
+} // namespace res::atlas
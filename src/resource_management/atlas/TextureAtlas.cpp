@@ -0,0 +1,286 @@
+#include "resource_management/atlas/TextureAtlas.h"
+#include "render/IRenderer.h"
+#include "render/ITexture.h"
+#include <cstring>
+
+namespace res::atlas {
+namespace {
+constexpr uint32_t BytesPerPixel = 4;
+}
+
+TextureAtlas::TextureAtlas(const AtlasDescriptor& descriptor)
+    : m_descriptor(descriptor)
+    , m_liveArea(0)
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+}
+
+uint32_t TextureAtlas::Insert(const uint8_t* rgba, uint32_t width, uint32_t height)
+{
+  auto gutter = m_descriptor.Gutter;
+
+  // gutters copy edge pixels, an empty image has none to copy
+  if (width == 0 || height == 0) {
+    elog::LogWarning(core::string::format("Image {}x{} is empty, it is not added to the atlas",
+                                          width, height));
+    return InvalidId;
+  }
+
+  if (width + gutter * 2 > m_descriptor.PageSize || height + gutter * 2 > m_descriptor.PageSize) {
+    elog::LogWarning(core::string::format("Image {}x{} does not fit into atlas page of size {}",
+                                          width, height, m_descriptor.PageSize));
+    return InvalidId;
+  }
+
+  Entry entry;
+  entry.Alive       = true;
+  entry.Region.Rect = PackedRect{ 0, 0, width, height };
+
+  bool placed = Place(entry, rgba, false);
+
+  if (!placed && GetFragmentation() >= m_descriptor.RepackThreshold) {
+    Repack();
+    placed = Place(entry, rgba, false);
+  }
+
+  if (!placed && !Place(entry, rgba, true)) {
+    elog::LogWarning(core::string::format("Texture atlas is full, failed to insert {}x{} image",
+                                          width, height));
+    return InvalidId;
+  }
+
+  m_liveArea += GetPaddedArea(entry.Region);
+
+  if (!m_freeIds.empty()) {
+    auto id = m_freeIds.back();
+    m_freeIds.pop_back();
+    m_entries[id] = entry;
+    return id;
+  }
+
+  m_entries.push_back(entry);
+  return m_entries.size() - 1;
+}
+
+void TextureAtlas::Remove(uint32_t id)
+{
+  if (id >= m_entries.size() || !m_entries[id].Alive)
+    return;
+
+  // pixels are left in place, they are unreachable and get dropped on the next repack
+  m_entries[id].Alive = false;
+  m_liveArea -= GetPaddedArea(m_entries[id].Region);
+  m_freeIds.push_back(id);
+}
+
+const AtlasRegion* TextureAtlas::GetRegion(uint32_t id) const
+{
+  if (id >= m_entries.size() || !m_entries[id].Alive)
+    return nullptr;
+
+  return &m_entries[id].Region;
+}
+
+bool TextureAtlas::Place(Entry& entry, const uint8_t* rgba, bool allowNewPage)
+{
+  auto gutter = m_descriptor.Gutter;
+  auto& rect  = entry.Region.Rect;
+
+  auto tryPage = [&](uint32_t pageIndex) {
+    auto packed = m_pages[pageIndex].Packer.Insert(rect.w + gutter * 2, rect.h + gutter * 2);
+
+    if (!packed)
+      return false;
+
+    float pageSize      = m_descriptor.PageSize;
+    entry.Region.Page   = pageIndex;
+    rect.x              = packed->x + gutter;
+    rect.y              = packed->y + gutter;
+    entry.Region.UvMin  = { rect.x / pageSize, rect.y / pageSize };
+    entry.Region.UvMax  = { (rect.x + rect.w) / pageSize, (rect.y + rect.h) / pageSize };
+    Blit(entry.Region, rgba);
+    return true;
+  };
+
+  for (uint32_t i = 0; i < m_pages.size(); i++) {
+    if (tryPage(i))
+      return true;
+  }
+
+  if (!allowNewPage || m_pages.size() >= m_descriptor.MaxPages)
+    return false;
+
+  auto pageSize = m_descriptor.PageSize;
+  m_pages.push_back(Page{ SkylinePacker(pageSize, pageSize),
+                          core::TByteArray(pageSize * pageSize * BytesPerPixel), true, nullptr });
+
+  return tryPage(m_pages.size() - 1);
+}
+
+void TextureAtlas::Blit(const AtlasRegion& region, const uint8_t* rgba)
+{
+  auto& page     = m_pages[region.Page];
+  auto& rect     = region.Rect;
+  int32_t gutter = m_descriptor.Gutter;
+  auto pitch     = m_descriptor.PageSize * BytesPerPixel;
+  auto rowBytes  = rect.w * BytesPerPixel;
+
+  for (int32_t y = -gutter; y < (int32_t)rect.h + gutter; y++) {
+    int32_t srcY = std::clamp<int32_t>(y, 0, rect.h - 1);
+    auto src     = rgba + srcY * rowBytes;
+    auto dst     = page.Pixels.data() + (rect.y + y) * pitch + rect.x * BytesPerPixel;
+
+    memcpy(dst, src, rowBytes);
+
+    // extrude edge pixels into the gutter so filtering never samples a neighbour
+    for (int32_t g = 1; g <= gutter; g++) {
+      memcpy(dst - g * BytesPerPixel, src, BytesPerPixel);
+      memcpy(dst + rowBytes + (g - 1) * BytesPerPixel, src + rowBytes - BytesPerPixel,
+             BytesPerPixel);
+    }
+  }
+
+  page.Dirty = true;
+}
+
+void TextureAtlas::Repack()
+{
+  struct LiveImage
+  {
+    uint32_t Id;
+    core::TByteArray Pixels;
+  };
+
+  core::Vector<LiveImage> images;
+
+  for (uint32_t id = 0; id < m_entries.size(); id++) {
+    auto& entry = m_entries[id];
+
+    if (!entry.Alive)
+      continue;
+
+    auto& rect  = entry.Region.Rect;
+    auto& page  = m_pages[entry.Region.Page];
+    auto pitch  = m_descriptor.PageSize * BytesPerPixel;
+    auto rowLen = rect.w * BytesPerPixel;
+
+    LiveImage image{ id, core::TByteArray(rect.h * rowLen) };
+    for (uint32_t y = 0; y < rect.h; y++) {
+      memcpy(image.Pixels.data() + y * rowLen,
+             page.Pixels.data() + (rect.y + y) * pitch + rect.x * BytesPerPixel, rowLen);
+    }
+
+    images.push_back(core::Move(image));
+  }
+
+  std::sort(images.begin(), images.end(), [this](const LiveImage& a, const LiveImage& b) {
+    return m_entries[a.Id].Region.Rect.h > m_entries[b.Id].Region.Rect.h;
+  });
+
+  for (auto& page : m_pages) {
+    page.Packer.Reset();
+    std::fill(page.Pixels.begin(), page.Pixels.end(), 0);
+    page.Dirty = true;
+  }
+
+  for (auto& image : images) {
+    auto& entry = m_entries[image.Id];
+
+    // pages were big enough before, so this can only fail if packing order got unlucky
+    if (!Place(entry, image.Pixels.data(), true)) {
+      elog::LogError(core::string::format("Texture atlas repack lost image {}", image.Id));
+      Remove(image.Id);
+    }
+  }
+
+  while (!m_pages.empty() && m_pages.back().Packer.GetUsedArea() == 0) {
+    m_pages.pop_back();
+  }
+
+  elog::LogInfo(core::string::format("Texture atlas repacked {} images into {} pages, occupancy {}",
+                                     images.size(), m_pages.size(), GetOccupancy()));
+}
+
+float TextureAtlas::GetFragmentation() const
+{
+  uint64_t packedArea = 0;
+
+  for (const auto& page : m_pages) {
+    packedArea += page.Packer.GetUsedArea();
+  }
+
+  return packedArea == 0 ? 0.f : 1.f - (float)m_liveArea / packedArea;
+}
+
+float TextureAtlas::GetOccupancy() const
+{
+  if (m_pages.empty())
+    return 0.f;
+
+  uint64_t pageArea = (uint64_t)m_descriptor.PageSize * m_descriptor.PageSize;
+  return (float)m_liveArea / (pageArea * m_pages.size());
+}
+
+uint64_t TextureAtlas::GetPaddedArea(const AtlasRegion& region) const
+{
+  auto gutter = m_descriptor.Gutter;
+  return (uint64_t)(region.Rect.w + gutter * 2) * (region.Rect.h + gutter * 2);
+}
+
+void TextureAtlas::Upload(render::IRenderer* renderer)
+{
+  auto pageSize = m_descriptor.PageSize;
+  core::pod::Vec2<uint32_t> size(pageSize, pageSize);
+
+  if (m_descriptor.PageMode == AtlasPageMode::Textures) {
+    for (auto& page : m_pages) {
+      if (!page.Dirty)
+        continue;
+
+      if (!page.Texture) {
+        page.Texture = renderer->CreateTexture(
+            render::TextureDescriptor(pageSize, pageSize, render::TextureDataFormat::RGBA));
+      }
+
+      page.Texture->UploadData(render::TextureDataDescriptor(
+          page.Pixels.data(), size, render::TextureDataFormat::RGBA));
+      page.Dirty = false;
+    }
+    return;
+  }
+
+  bool anyDirty = std::any_of(m_pages.begin(), m_pages.end(), [](auto& p) { return p.Dirty; });
+  if (!anyDirty)
+    return;
+
+  if (!m_arrayTexture) {
+    render::TextureDescriptor desc(pageSize, pageSize, render::TextureDataFormat::RGBA);
+    desc.type       = render::TextureType::T2DArray;
+    desc.layerCount = m_descriptor.MaxPages;
+    m_arrayTexture  = renderer->CreateTexture(desc);
+  }
+
+  // array textures are uploaded whole, unused layers stay empty
+  auto pageBytes = pageSize * pageSize * BytesPerPixel;
+  core::TByteArray layers(pageBytes * m_descriptor.MaxPages);
+
+  for (uint32_t i = 0; i < m_pages.size(); i++) {
+    memcpy(layers.data() + i * pageBytes, m_pages[i].Pixels.data(), pageBytes);
+    m_pages[i].Dirty = false;
+  }
+
+  m_arrayTexture->UploadData(
+      render::TextureDataDescriptor(layers.data(), size, render::TextureDataFormat::RGBA));
+}
+
+render::ITexture* TextureAtlas::GetTexture(uint32_t page) const
+{
+  if (m_descriptor.PageMode == AtlasPageMode::ArrayLayers)
+    return m_arrayTexture.get();
+
+  return page < m_pages.size() ? m_pages[page].Texture.get() : nullptr;
+}
+} // namespace res::atlas
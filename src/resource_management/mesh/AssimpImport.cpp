@@ -1,6 +1,11 @@
 #include "resource_management/mesh/AssimpImport.h"
 #include "render/animation/Bone.h"
 #include "render/animation/BoneKeyCollection.h"
+#include "resource_management/CookedFormats.h"
+#include "resource_management/mesh/GltfImport.h"
+#include "resource_management/mesh/MeshletBuilder.h"
+#include "util/ThreadPool.h"
+#include <cstring>
 #include <assimp/Importer.hpp> // C++ importer interface
 #include <assimp/include/assimp/cimport.h>
 #include <assimp/postprocess.h> // Post processing flags
@@ -35,6 +40,51 @@ glm::mat4 ToGlm(const aiMatrix4x4 from)
 
   return to;
 }
+
+constexpr uint32_t ImportFlags = aiProcess_Triangulate | aiProcess_PopulateArmatureData |
+                                 aiProcess_CalcTangentSpace | aiProcess_FlipUVs;
+
+/// Importers keep allocations and importer plugins between files, so each thread reuses its own.
+Assimp::Importer& GetThreadImporter()
+{
+  thread_local Assimp::Importer importer;
+  return importer;
+}
+
+void CopyVectors(const aiVector3D* from, uint32_t count, core::Vector<glm::vec3>& to)
+{
+  to.resize(count);
+
+  if constexpr (sizeof(aiVector3D) == sizeof(glm::vec3)) {
+    memcpy(to.data(), from, count * sizeof(glm::vec3));
+  }
+  else {
+    for (uint32_t i = 0; i < count; i++) {
+      to[i] = glm::vec3(from[i].x, from[i].y, from[i].z);
+    }
+  }
+}
+
+void CopyVectors(const aiVector3D* from, uint32_t count, core::Vector<glm::vec2>& to)
+{
+  to.resize(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    to[i] = glm::vec2(from[i].x, from[i].y);
+  }
+}
+
+template <class TValue, class TKey, class TConvert>
+void CopyKeys(const TKey* from, uint32_t count, core::Vector<render::anim::AnimKey<TValue>>& to,
+              TConvert convert)
+{
+  to.resize(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    to[i].Value = convert(from[i].mValue);
+    to[i].Time  = from[i].mTime;
+  }
+}
 } // namespace
 
 template <class TPredicate> core::Optional<int> FindBone(const aiMesh* aMesh, TPredicate callable)
@@ -99,8 +149,8 @@ static void MapBoneWeights(const aiMesh* aMesh, render::AnimatedMesh* mesh)
     }
   }
 
-  mesh->BlendIndexBuffer  = boneIndices;
-  mesh->BlendWeightBuffer = boneWeights;
+  mesh->BlendIndexBuffer  = core::Move(boneIndices);
+  mesh->BlendWeightBuffer = core::Move(boneWeights);
 }
 
 static void MapBoneHierarchy(const aiMesh* aMesh, render::AnimatedMesh* mesh, const aiScene* scene)
@@ -216,63 +266,44 @@ static void ReadAnimations(render::AnimatedMesh* mesh, const aiScene* scene)
     animation.Duration = pAnimation->mDuration;
     animation.BoneKeys.resize(armature.GetBones().size());
 
-    elog::LogInfo(core::string::format("Loading animation '{}', fps: {}, duration: {}",
-                                       animation.Name.c_str(), animation.Fps, animation.Duration));
+    ELOG_INFO("Loading animation '{}', fps: {}, duration: {}", animation.Name.c_str(),
+              animation.Fps, animation.Duration);
 
     for (int nodeAnimIndex = 0; nodeAnimIndex < pAnimation->mNumChannels; nodeAnimIndex++) {
       const aiNodeAnim* pNodeAnim = pAnimation->mChannels[nodeAnimIndex];
-      elog::LogInfo(core::string::format("Scale key count: {}", pNodeAnim->mNumScalingKeys));
-      elog::LogInfo(core::string::format("Position key count: {}", pNodeAnim->mNumPositionKeys));
-      elog::LogInfo(core::string::format("Rotation key count: {}", pNodeAnim->mNumRotationKeys));
+      ELOG_DEBUG("Scale key count: {}", pNodeAnim->mNumScalingKeys);
+      ELOG_DEBUG("Position key count: {}", pNodeAnim->mNumPositionKeys);
+      ELOG_DEBUG("Rotation key count: {}", pNodeAnim->mNumRotationKeys);
 
       core::String boneName(pNodeAnim->mNodeName.C_Str());
       int boneIndex = FindBoneIndex(mesh, boneName);
 
       if (pNodeAnim->mNumScalingKeys == 0 && pNodeAnim->mNumPositionKeys == 0 &&
           pNodeAnim->mNumRotationKeys == 0) {
-        elog::LogInfo(core::string::format("Has no animation keys assigned: {}", boneName.c_str()));
+        ELOG_DEBUG("Has no animation keys assigned: {}", boneName.c_str());
         continue;
       }
 
       render::anim::BoneKeyCollection boneKeys;
 
-      for (int posKeyIndex = 0; posKeyIndex < pNodeAnim->mNumPositionKeys; posKeyIndex++) {
-        auto key = pNodeAnim->mPositionKeys[posKeyIndex];
-        render::anim::AnimKey<glm::vec3> posKey;
-        posKey.Value = glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z);
-        posKey.Time  = key.mTime;
-        boneKeys.PositionKeys.push_back(posKey);
-      }
-
-      for (int rotKeyIndex = 0; rotKeyIndex < pNodeAnim->mNumPositionKeys; rotKeyIndex++) {
-        auto key = pNodeAnim->mRotationKeys[rotKeyIndex];
-        render::anim::AnimKey<glm::quat> rotKey;
-        rotKey.Value = glm::quat(key.mValue.w, key.mValue.x, key.mValue.y, key.mValue.z);
-        rotKey.Time  = key.mTime;
-        boneKeys.RotationKeys.push_back(rotKey);
-      }
-
-      for (int scaleKeyIndex = 0; scaleKeyIndex < pNodeAnim->mNumPositionKeys; scaleKeyIndex++) {
-        auto key = pNodeAnim->mScalingKeys[scaleKeyIndex];
-        render::anim::AnimKey<glm::vec3> scaleKey;
-        scaleKey.Value = glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z);
-        scaleKey.Time  = key.mTime;
-        boneKeys.ScaleKeys.push_back(scaleKey);
-      }
+      CopyKeys(pNodeAnim->mPositionKeys, pNodeAnim->mNumPositionKeys, boneKeys.PositionKeys,
+               [](const aiVector3D& v) { return glm::vec3(v.x, v.y, v.z); });
+      CopyKeys(pNodeAnim->mRotationKeys, pNodeAnim->mNumRotationKeys, boneKeys.RotationKeys,
+               [](const aiQuaternion& q) { return glm::quat(q.w, q.x, q.y, q.z); });
+      CopyKeys(pNodeAnim->mScalingKeys, pNodeAnim->mNumScalingKeys, boneKeys.ScaleKeys,
+               [](const aiVector3D& v) { return glm::vec3(v.x, v.y, v.z); });
 
       if (boneIndex < 0) {
         boneKeys.BoneIndex     = 0;
         animation.ArmatureKeys = boneKeys;
-        elog::LogInfo(core::string::format("Armature bone?: {}", boneName.c_str()));
+        ELOG_DEBUG("Armature bone?: {}", boneName.c_str());
         continue;
       }
 
       boneKeys.BoneIndex            = boneIndex;
       animation.BoneKeys[boneIndex] = boneKeys;
-      elog::LogInfo(core::string::format("Bone {} position key count: {}", boneName.c_str(),
-                                         boneKeys.PositionKeys.size()));
-      elog::LogInfo(core::string::format("Bone {} rotation key count: {}", boneName.c_str(),
-                                         boneKeys.RotationKeys.size()));
+      ELOG_DEBUG("Bone {} position key count: {}", boneName.c_str(), boneKeys.PositionKeys.size());
+      ELOG_DEBUG("Bone {} rotation key count: {}", boneName.c_str(), boneKeys.RotationKeys.size());
     }
 
     mesh->AddAnimation(animation);
@@ -286,24 +317,78 @@ AssimpImport::AssimpImport(io::IFileSystem* fs, render::IRenderer* renderer)
 }
 
 core::UniquePtr<render::AnimatedMesh> AssimpImport::LoadMesh(io::Path path)
+{
+  auto mapping = m_fileSystem->MapFile(path);
+
+  if (!mapping) {
+    elog::LogError(core::string::format("Failed to read mesh file '{}'", path.AsString()));
+    return nullptr;
+  }
+
+  auto mesh = ImportMesh(path, mapping->GetData(), mapping->GetSize());
+
+  if (!mesh) {
+    return nullptr;
+  }
+
+  return CreateGpuMesh(*mesh);
+}
+
+core::UniquePtr<render::AnimatedMesh> AssimpImport::LoadMesh(io::Path path,
+                                                            const core::TByteArray& array)
+{
+  auto mesh = ImportMesh(path, array);
+
+  if (!mesh) {
+    return nullptr;
+  }
+
+  return CreateGpuMesh(*mesh);
+}
+
+core::UniquePtr<render::AnimatedMesh> AssimpImport::ImportMesh(const io::Path& path,
+                                                               const void* data, size_t size)
 {
   auto filename = path.AsString();
-  auto file     = m_fileSystem->OpenRead(path);
-  core::TByteArray array;
-  file->Read(array);
 
-  Assimp::Importer importer;
-  const aiScene* scene =
-      importer.ReadFileFromMemory((const char*)array.data(), array.size(),
-                                  aiProcess_Triangulate | aiProcess_PopulateArmatureData |
-                                      aiProcess_CalcTangentSpace | aiProcess_FlipUVs);
+  if (cooked::Detect(data, size) == cooked::CookedType::Mesh) {
+    auto mesh = core::MakeUnique<render::AnimatedMesh>();
 
-  auto errorstr = importer.GetErrorString();
-  if (errorstr) {
-    elog::LogError(errorstr);
+    if (!cooked::ReadMesh(data, size, *mesh)) {
+      elog::LogError(core::string::format("Cooked mesh file '{}' is corrupt", filename));
+      return nullptr;
+    }
+
+    return mesh;
   }
 
+  core::UniquePtr<render::AnimatedMesh> mesh;
+  bool unsupported = !GltfImport::IsGlb(data, size);
+
+  if (!unsupported)
+    mesh = GltfImport::ImportGlb(data, size, filename, &unsupported);
+
+  // external buffers and data uris are resolved by assimp
+  if (unsupported)
+    mesh = ImportWithAssimp(path, data, size);
+
+  // skinned meshes deform, their clusters would need bounds per frame
+  if (mesh && mesh->GetArmature().GetBones().empty())
+    MeshletBuilder::Build(*mesh);
+
+  return mesh;
+}
+
+core::UniquePtr<render::AnimatedMesh> AssimpImport::ImportWithAssimp(const io::Path& path,
+                                                                     const void* data, size_t size)
+{
+  auto filename  = path.AsString();
+  auto& importer = GetThreadImporter();
+  const aiScene* scene =
+      importer.ReadFileFromMemory(data, size, ImportFlags);
+
   if (!scene) {
+    elog::LogError(importer.GetErrorString());
     elog::LogError(core::string::format("Failed to load mesh from file '{}'", filename.c_str()));
     return nullptr;
   }
@@ -315,11 +400,12 @@ core::UniquePtr<render::AnimatedMesh> AssimpImport::LoadMesh(io::Path path)
 
   if (scene->mNumMeshes < 1) {
     elog::LogError(core::string::format("File '{}' does not contain any meshes", filename.c_str()));
+    return nullptr;
   }
 
   elog::LogInfo(core::string::format("Loading mesh from file '{}'.", filename.c_str()));
 
-  auto mesh = m_renderer->CreateAnimatedMesh();
+  auto mesh = core::MakeUnique<render::AnimatedMesh>();
 
   elog::LogInfo(core::string::format("Scene num meshes: '{}'", scene->mNumMeshes));
 
@@ -337,41 +423,95 @@ core::UniquePtr<render::AnimatedMesh> AssimpImport::LoadMesh(io::Path path)
     elog::LogInfo(core::string::format("Mesh vertex count: '{}'", assimpMesh->mNumVertices));
     elog::LogInfo(core::string::format("Mesh face count: '{}'", assimpMesh->mNumFaces));
 
-    for (auto iVertex = 0; iVertex < assimpMesh->mNumVertices; iVertex++) {
-      auto aVertex = assimpMesh->mVertices[iVertex];
-      mesh->VertexBuffer.emplace_back(aVertex.x, aVertex.y, aVertex.z);
-    }
-
-    //        for(auto iColor = 0; iColor < assimpMesh->mNumVertices; iColor++){
-    //            auto aColor = glm::vec3(iColor % 3 ? 0 : 1,iColor+1 % 3 ? 0 : 1,iColor+2 % 3 ?
-    //            0 : 1); mesh->ColorBuffer.emplace_back(aColor.x, aColor.y, aColor.z);
-    //        }
+    CopyVectors(assimpMesh->mVertices, assimpMesh->mNumVertices, mesh->VertexBuffer);
 
-    for (auto iNormal = 0; iNormal < assimpMesh->mNumVertices; iNormal++) {
-      auto aNormal = assimpMesh->mNormals[iNormal];
-      mesh->NormalBuffer.emplace_back(aNormal.x, aNormal.y, aNormal.z);
+    if (assimpMesh->HasNormals()) {
+      CopyVectors(assimpMesh->mNormals, assimpMesh->mNumVertices, mesh->NormalBuffer);
     }
 
     // load first channel only
-    for (auto iUV = 0; iUV < assimpMesh->mNumVertices; iUV++) {
-      auto aUV = assimpMesh->mTextureCoords[0][iUV];
-      mesh->UVBuffer.emplace_back(aUV.x, aUV.y);
+    if (assimpMesh->HasTextureCoords(0)) {
+      CopyVectors(assimpMesh->mTextureCoords[0], assimpMesh->mNumVertices, mesh->UVBuffer);
     }
 
+    // faces are triangles after aiProcess_Triangulate, point and line primitives may be mixed in
+    mesh->IndexBuffer.reserve(assimpMesh->mNumFaces * 3);
     for (auto iFace = 0; iFace < assimpMesh->mNumFaces; iFace++) {
-      auto aFace = assimpMesh->mFaces[iFace];
-
-      // elog::LogInfo(core::string::format("Mesh face[{}] index count: '{}'", iFace,
-      // aFace.mNumIndices));
-      for (auto iIndex = 0; iIndex < aFace.mNumIndices; iIndex++) {
-        mesh->IndexBuffer.push_back(aFace.mIndices[iIndex]);
-      }
+      auto& aFace = assimpMesh->mFaces[iFace];
+      mesh->IndexBuffer.insert(mesh->IndexBuffer.end(), aFace.mIndices,
+                               aFace.mIndices + aFace.mNumIndices);
     }
 
     MapBoneHierarchy(assimpMesh, mesh.get(), scene);
     ReadAnimations(mesh.get(), scene);
   }
 
+  // scene memory is released here, the importer itself stays around for the next file
+  importer.FreeScene();
+  return mesh;
+}
+
+core::Vector<core::UniquePtr<render::AnimatedMesh>> AssimpImport::ImportMeshes(
+    const core::Vector<io::Path>& paths, util::ThreadPool* workers)
+{
+  core::Vector<std::future<core::UniquePtr<render::AnimatedMesh>>> futures;
+  futures.reserve(paths.size());
+
+  for (const auto& path : paths) {
+    futures.push_back(workers->Submit([this, path]() -> core::UniquePtr<render::AnimatedMesh> {
+      auto mapping = m_fileSystem->MapFile(path);
+
+      if (!mapping) {
+        elog::LogError(core::string::format("Failed to read mesh file '{}'", path.AsString()));
+        return nullptr;
+      }
+
+      return ImportMesh(path, mapping->GetData(), mapping->GetSize());
+    }));
+  }
+
+  core::Vector<core::UniquePtr<render::AnimatedMesh>> meshes;
+  meshes.reserve(paths.size());
+
+  for (auto& future : futures) {
+    meshes.push_back(future.get());
+  }
+
+  return meshes;
+}
+
+core::Vector<core::UniquePtr<render::AnimatedMesh>> AssimpImport::LoadMeshes(
+    const core::Vector<io::Path>& paths, util::ThreadPool* workers)
+{
+  auto meshes = ImportMeshes(paths, workers);
+
+  for (auto& mesh : meshes) {
+    if (mesh) {
+      mesh = CreateGpuMesh(*mesh);
+    }
+  }
+
+  return meshes;
+}
+
+core::UniquePtr<render::AnimatedMesh> AssimpImport::CreateGpuMesh(render::AnimatedMesh& cpuMesh)
+{
+  auto mesh = m_renderer->CreateAnimatedMesh();
+
+  mesh->IndexBuffer       = core::Move(cpuMesh.IndexBuffer);
+  mesh->UVBuffer          = core::Move(cpuMesh.UVBuffer);
+  mesh->VertexBuffer      = core::Move(cpuMesh.VertexBuffer);
+  mesh->NormalBuffer      = core::Move(cpuMesh.NormalBuffer);
+  mesh->ColorBuffer       = core::Move(cpuMesh.ColorBuffer);
+  mesh->BlendIndexBuffer  = core::Move(cpuMesh.BlendIndexBuffer);
+  mesh->BlendWeightBuffer = core::Move(cpuMesh.BlendWeightBuffer);
+  mesh->Meshlets          = core::Move(cpuMesh.Meshlets);
+  mesh->SetArmature(cpuMesh.GetArmature());
+
+  for (auto& animation : cpuMesh.GetAnimations()) {
+    mesh->AddAnimation(animation);
+  }
+
   mesh->Upload();
   return mesh;
 }
@@ -0,0 +1,746 @@
+#include "resource_management/mesh/GltfImport.h"
+#include "filesystem/MappedFile.h"
+#include "render/AnimatedMesh.h"
+#include "util/Json.h"
+#include <cstring>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace res::mesh {
+namespace {
+constexpr uint32_t GlbMagic      = 0x46546c67; // "glTF"
+constexpr uint32_t JsonChunkType = 0x4e4f534a; // "JSON"
+constexpr uint32_t BinChunkType  = 0x004e4942; // "BIN\0"
+constexpr uint32_t GlbHeaderSize = 12;
+constexpr int32_t TrianglesMode  = 4;
+/// Assimp converts gltf seconds to milliseconds, animations from both loaders play the same.
+constexpr float TicksPerSecond = 1000.f;
+
+enum ComponentType
+{
+  Byte          = 5120,
+  UnsignedByte  = 5121,
+  Short         = 5122,
+  UnsignedShort = 5123,
+  UnsignedInt   = 5125,
+  Float         = 5126
+};
+
+uint32_t ComponentSize(int32_t type)
+{
+  switch (type) {
+  case Byte:
+  case UnsignedByte:
+    return 1;
+  case Short:
+  case UnsignedShort:
+    return 2;
+  case UnsignedInt:
+  case Float:
+    return 4;
+  default:
+    return 0;
+  }
+}
+
+uint32_t ComponentCount(const core::String& type)
+{
+  if (type == "SCALAR")
+    return 1;
+  if (type == "VEC2")
+    return 2;
+  if (type == "VEC3")
+    return 3;
+  if (type == "VEC4")
+    return 4;
+  if (type == "MAT4")
+    return 16;
+  return 0;
+}
+
+template <class T> T Load(const uint8_t* p)
+{
+  T value;
+  memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+float ReadComponent(const uint8_t* p, int32_t type, bool normalized)
+{
+  switch (type) {
+  case Byte:
+    return normalized ? std::max(Load<int8_t>(p) / 127.f, -1.f) : Load<int8_t>(p);
+  case UnsignedByte:
+    return normalized ? Load<uint8_t>(p) / 255.f : Load<uint8_t>(p);
+  case Short:
+    return normalized ? std::max(Load<int16_t>(p) / 32767.f, -1.f) : Load<int16_t>(p);
+  case UnsignedShort:
+    return normalized ? Load<uint16_t>(p) / 65535.f : Load<uint16_t>(p);
+  case UnsignedInt:
+    return (float)Load<uint32_t>(p);
+  default:
+    return Load<float>(p);
+  }
+}
+
+uint32_t ReadIndex(const uint8_t* p, int32_t type)
+{
+  switch (type) {
+  case UnsignedByte:
+    return Load<uint8_t>(p);
+  case UnsignedShort:
+    return Load<uint16_t>(p);
+  default:
+    return Load<uint32_t>(p);
+  }
+}
+
+/// Byte range of a buffer view, starting at an accessor offset.
+struct View
+{
+  const uint8_t* Data;
+  size_t Size;
+  uint32_t Stride;
+};
+
+class GltfDocument
+{
+  public:
+  GltfDocument(const util::JsonValue& json, const uint8_t* bin, size_t binSize)
+      : m_json(json)
+      , m_bin(bin)
+      , m_binSize(binSize)
+  {
+  }
+
+  const util::JsonValue& operator[](const char* key) const
+  {
+    return m_json[key];
+  }
+
+  const core::String& GetError() const
+  {
+    return m_error;
+  }
+
+  /// Element layout of T has to be 'components' floats, any component type is converted.
+  template <class T> bool ReadAccessor(int32_t index, core::Vector<T>& out)
+  {
+    static_assert(sizeof(T) % sizeof(float) == 0, "accessors are read as floats");
+    uint32_t count = 0;
+
+    if (!ReadHeader(index, sizeof(T) / sizeof(float), count))
+      return false;
+
+    out.resize(count);
+    return ReadFloats(m_json["accessors"][index], (float*)out.data(), sizeof(T) / sizeof(float));
+  }
+
+  bool ReadIndices(int32_t index, core::Vector<uint32_t>& out);
+  glm::mat4 GetLocalTransform(int32_t node) const;
+
+  private:
+  bool Fail(const core::String& error)
+  {
+    m_error = error;
+    return false;
+  }
+
+  bool ReadHeader(int32_t index, uint32_t components, uint32_t& count);
+  bool ResolveView(int32_t viewIndex, double byteOffset, View& out);
+  bool ReadFloats(const util::JsonValue& accessor, float* out, uint32_t components);
+  bool ApplySparse(const util::JsonValue& accessor, float* out, uint32_t components);
+
+  private:
+  const util::JsonValue& m_json;
+  const uint8_t* m_bin;
+  size_t m_binSize;
+  core::String m_error;
+};
+
+bool GltfDocument::ReadHeader(int32_t index, uint32_t components, uint32_t& count)
+{
+  auto& accessor = m_json["accessors"][index];
+
+  if (accessor.IsNull())
+    return Fail(core::string::format("accessor {} does not exist", index));
+
+  if (ComponentCount(accessor["type"].AsString()) != components)
+    return Fail(core::string::format("accessor {} has unexpected type '{}'", index,
+                                     accessor["type"].AsString()));
+
+  auto elemSize = ComponentSize(accessor["componentType"].AsInt()) * components;
+  if (elemSize == 0)
+    return Fail(core::string::format("accessor {} has invalid component type", index));
+
+  // the count sizes the output before any view is checked, views have to fit in the chunk
+  auto accessorCount = accessor["count"].AsNumber(0);
+  if (accessorCount < 0 || accessorCount > INT32_MAX ||
+      (accessor.Has("bufferView") && accessorCount * elemSize > m_binSize)) {
+    return Fail(core::string::format("accessor {} has invalid count", index));
+  }
+
+  count = (uint32_t)accessorCount;
+  return true;
+}
+
+bool GltfDocument::ResolveView(int32_t viewIndex, double byteOffset, View& out)
+{
+  auto& view = m_json["bufferViews"][viewIndex];
+
+  if (view.IsNull())
+    return Fail(core::string::format("buffer view {} does not exist", viewIndex));
+
+  // glb files only reference the embedded binary chunk
+  if (view["buffer"].AsInt() != 0 || !m_bin)
+    return Fail(core::string::format("buffer view {} does not point into the binary chunk",
+                                     viewIndex));
+
+  // checked as doubles, negative values must not wrap around when converted
+  auto offset = view["byteOffset"].AsNumber(0);
+  auto length = view["byteLength"].AsNumber(0);
+
+  if (offset < 0 || length < 0 || byteOffset < 0 || offset + length > m_binSize ||
+      byteOffset > length) {
+    return Fail(core::string::format("buffer view {} is out of bounds", viewIndex));
+  }
+
+  out.Data   = m_bin + (size_t)offset + (size_t)byteOffset;
+  out.Size   = (size_t)length - (size_t)byteOffset;
+  out.Stride = view["byteStride"].AsInt(0);
+  return true;
+}
+
+bool GltfDocument::ReadFloats(const util::JsonValue& accessor, float* out, uint32_t components)
+{
+  uint32_t count    = accessor["count"].AsInt(0);
+  int32_t type      = accessor["componentType"].AsInt();
+  bool normalized   = accessor["normalized"].AsBool();
+  uint32_t compSize = ComponentSize(type);
+  uint32_t elemSize = compSize * components;
+
+  if (!accessor.Has("bufferView")) {
+    // sparse accessors without a view start out zeroed
+    memset(out, 0, count * components * sizeof(float));
+    return ApplySparse(accessor, out, components);
+  }
+
+  View view;
+  if (!ResolveView(accessor["bufferView"].AsInt(), accessor["byteOffset"].AsNumber(0), view))
+    return false;
+
+  auto stride = view.Stride ? view.Stride : elemSize;
+
+  if (count > 0 && (size_t)stride * (count - 1) + elemSize > view.Size)
+    return Fail("accessor reads past the end of its buffer view");
+
+  if (type == Float && stride == elemSize) {
+    memcpy(out, view.Data, (size_t)count * elemSize);
+  }
+  else {
+    for (uint32_t i = 0; i < count; i++) {
+      auto element = view.Data + (size_t)i * stride;
+
+      for (uint32_t c = 0; c < components; c++) {
+        out[i * components + c] = ReadComponent(element + c * compSize, type, normalized);
+      }
+    }
+  }
+
+  return ApplySparse(accessor, out, components);
+}
+
+bool GltfDocument::ApplySparse(const util::JsonValue& accessor, float* out, uint32_t components)
+{
+  auto& sparse = accessor["sparse"];
+
+  if (sparse.IsNull())
+    return true;
+
+  uint32_t count     = accessor["count"].AsInt(0);
+  uint32_t sparseLen = sparse["count"].AsInt(0);
+  int32_t type       = accessor["componentType"].AsInt();
+  bool normalized    = accessor["normalized"].AsBool();
+  int32_t indexType  = sparse["indices"]["componentType"].AsInt();
+  uint32_t indexSize = ComponentSize(indexType);
+  uint32_t compSize  = ComponentSize(type);
+
+  View indices, values;
+  if (!ResolveView(sparse["indices"]["bufferView"].AsInt(),
+                   sparse["indices"]["byteOffset"].AsNumber(0), indices) ||
+      !ResolveView(sparse["values"]["bufferView"].AsInt(),
+                   sparse["values"]["byteOffset"].AsNumber(0), values)) {
+    return false;
+  }
+
+  if (indexSize == 0 || (size_t)sparseLen * indexSize > indices.Size ||
+      (size_t)sparseLen * compSize * components > values.Size) {
+    return Fail("sparse accessor is out of bounds");
+  }
+
+  for (uint32_t i = 0; i < sparseLen; i++) {
+    auto target = ReadIndex(indices.Data + (size_t)i * indexSize, indexType);
+
+    if (target >= count)
+      return Fail("sparse index is out of range");
+
+    auto element = values.Data + (size_t)i * compSize * components;
+    for (uint32_t c = 0; c < components; c++) {
+      out[target * components + c] = ReadComponent(element + c * compSize, type, normalized);
+    }
+  }
+
+  return true;
+}
+
+bool GltfDocument::ReadIndices(int32_t index, core::Vector<uint32_t>& out)
+{
+  uint32_t count = 0;
+
+  if (!ReadHeader(index, 1, count))
+    return false;
+
+  auto& accessor = m_json["accessors"][index];
+  int32_t type   = accessor["componentType"].AsInt();
+
+  if (type != UnsignedByte && type != UnsignedShort && type != UnsignedInt)
+    return Fail("indices have to be unsigned integers");
+
+  View view;
+  if (!ResolveView(accessor["bufferView"].AsInt(), accessor["byteOffset"].AsNumber(0), view))
+    return false;
+
+  uint32_t size   = ComponentSize(type);
+  uint32_t stride = view.Stride ? view.Stride : size;
+
+  if (count > 0 && (size_t)stride * (count - 1) + size > view.Size)
+    return Fail("indices read past the end of their buffer view");
+
+  out.resize(count);
+
+  if (type == UnsignedInt && stride == size) {
+    memcpy(out.data(), view.Data, (size_t)count * size);
+  }
+  else {
+    for (uint32_t i = 0; i < count; i++) {
+      out[i] = ReadIndex(view.Data + (size_t)i * stride, type);
+    }
+  }
+
+  return true;
+}
+
+glm::mat4 GltfDocument::GetLocalTransform(int32_t nodeIndex) const
+{
+  auto& node = m_json["nodes"][nodeIndex];
+  auto& m    = node["matrix"];
+
+  if (m.Size() == 16) {
+    glm::mat4 matrix;
+    for (int i = 0; i < 16; i++) {
+      matrix[i / 4][i % 4] = m[i].AsNumber();
+    }
+    return matrix;
+  }
+
+  auto& t = node["translation"];
+  auto& r = node["rotation"];
+  auto& s = node["scale"];
+
+  glm::vec3 translation(t[0].AsNumber(0), t[1].AsNumber(0), t[2].AsNumber(0));
+  glm::quat rotation(r[3].AsNumber(1), r[0].AsNumber(0), r[1].AsNumber(0), r[2].AsNumber(0));
+  glm::vec3 scale(s[0].AsNumber(1), s[1].AsNumber(1), s[2].AsNumber(1));
+
+  return glm::translate(glm::mat4(1), translation) * glm::mat4_cast(rotation) *
+         glm::scale(glm::mat4(1), scale);
+}
+
+/// Moves 'from' into 'to' for the first primitive, appends afterwards.
+/// Streams missing in a primitive are zero filled so all streams stay aligned with positions.
+template <class T> void AppendStream(core::Vector<T>& to, core::Vector<T>& from, size_t vertexCount)
+{
+  if (from.empty())
+    from.resize(vertexCount, T(0));
+
+  if (to.empty())
+    to = core::Move(from);
+  else
+    to.insert(to.end(), from.begin(), from.end());
+}
+
+bool ReadPrimitives(GltfDocument& doc, const util::JsonValue& mesh, render::AnimatedMesh& out)
+{
+  bool hasNormals = false, hasUVs = false;
+
+  for (auto& primitive : mesh["primitives"].GetElements()) {
+    if (primitive["mode"].AsInt(TrianglesMode) != TrianglesMode) {
+      elog::LogWarning("Skipping glb primitive which is not a triangle list");
+      continue;
+    }
+
+    auto& attributes = primitive["attributes"];
+    core::Vector<glm::vec3> positions, normals;
+    core::Vector<glm::vec2> uvs;
+    core::Vector<glm::vec4> joints, weights;
+    core::Vector<uint32_t> indices;
+
+    if (!doc.ReadAccessor(attributes["POSITION"].AsInt(), positions))
+      return false;
+
+    if ((attributes.Has("NORMAL") && !doc.ReadAccessor(attributes["NORMAL"].AsInt(), normals)) ||
+        (attributes.Has("TEXCOORD_0") &&
+         !doc.ReadAccessor(attributes["TEXCOORD_0"].AsInt(), uvs)) ||
+        (attributes.Has("JOINTS_0") && !doc.ReadAccessor(attributes["JOINTS_0"].AsInt(), joints)) ||
+        (attributes.Has("WEIGHTS_0") &&
+         !doc.ReadAccessor(attributes["WEIGHTS_0"].AsInt(), weights))) {
+      return false;
+    }
+
+    auto base  = out.VertexBuffer.size();
+    auto count = positions.size();
+
+    for (auto stream : { normals.size(), uvs.size(), joints.size(), weights.size() }) {
+      if (stream != 0 && stream != count) {
+        elog::LogWarning("Glb primitive attributes have mismatched counts");
+        break;
+      }
+    }
+
+    hasNormals |= !normals.empty();
+    hasUVs |= !uvs.empty();
+
+    auto fit = [count](auto& stream) {
+      if (!stream.empty())
+        stream.resize(count);
+    };
+    fit(normals);
+    fit(uvs);
+    fit(joints);
+    fit(weights);
+
+    AppendStream(out.VertexBuffer, positions, count);
+    AppendStream(out.NormalBuffer, normals, count);
+    AppendStream(out.UVBuffer, uvs, count);
+    AppendStream(out.BlendIndexBuffer, joints, count);
+    AppendStream(out.BlendWeightBuffer, weights, count);
+
+    if (primitive.Has("indices")) {
+      if (!doc.ReadIndices(primitive["indices"].AsInt(), indices))
+        return false;
+    }
+    else {
+      indices.resize(count);
+      for (uint32_t i = 0; i < count; i++) {
+        indices[i] = i;
+      }
+    }
+
+    for (auto& index : indices) {
+      if (index >= count) {
+        elog::LogError("Glb primitive index is out of range");
+        return false;
+      }
+      index += base;
+    }
+
+    AppendStream(out.IndexBuffer, indices, 0);
+  }
+
+  if (!hasNormals)
+    out.NormalBuffer.clear();
+  if (!hasUVs)
+    out.UVBuffer.clear();
+
+  return !out.VertexBuffer.empty();
+}
+
+core::String GetNodeName(GltfDocument& doc, int32_t node)
+{
+  return doc["nodes"][node]["name"].AsString();
+}
+
+bool ReadSkin(GltfDocument& doc, int32_t skinIndex, core::Vector<int32_t>& jointOfNode,
+              render::AnimatedMesh& out)
+{
+  auto& nodes = doc["nodes"];
+  auto& skin  = doc["skins"][skinIndex];
+  auto& scene = doc["scenes"][doc["scene"].AsInt(0)];
+  core::Vector<int32_t> parentOfNode(nodes.Size(), -1);
+
+  for (uint32_t n = 0; n < nodes.Size(); n++) {
+    for (auto& child : nodes[n]["children"].GetElements()) {
+      if ((uint32_t)child.AsInt() < nodes.Size())
+        parentOfNode[child.AsInt()] = n;
+    }
+  }
+
+  // same convention as assimp, single scene root becomes the armature root
+  glm::mat4 globalInverse(1);
+  if (scene["nodes"].Size() == 1)
+    globalInverse = glm::inverse(doc.GetLocalTransform(scene["nodes"][0].AsInt()));
+
+  if (skin.IsNull()) {
+    out.SetArmature(render::anim::Armature(globalInverse, {}));
+    return true;
+  }
+
+  auto& joints = skin["joints"];
+  core::Vector<glm::mat4> inverseBind;
+
+  if (skin.Has("inverseBindMatrices") &&
+      !doc.ReadAccessor(skin["inverseBindMatrices"].AsInt(), inverseBind)) {
+    return false;
+  }
+
+  inverseBind.resize(joints.Size(), glm::mat4(1));
+
+  for (uint32_t i = 0; i < joints.Size(); i++) {
+    auto node = joints[i].AsInt();
+    if ((uint32_t)node >= nodes.Size()) {
+      elog::LogError("Glb skin references a missing node");
+      return false;
+    }
+    jointOfNode[node] = i;
+  }
+
+  core::Vector<render::anim::Bone> bones(joints.Size());
+
+  for (uint32_t i = 0; i < joints.Size(); i++) {
+    auto node  = joints[i].AsInt();
+    auto& bone = bones[i];
+
+    bone.name      = GetNodeName(doc, node);
+    bone.transform = doc.GetLocalTransform(node);
+    bone.offset    = inverseBind[i];
+    bone.bone_end  = glm::mat4(1);
+    bone.pos       = glm::vec3(bone.transform[3]);
+    bone.scale     = glm::vec3(glm::length(glm::vec3(bone.transform[0])),
+                           glm::length(glm::vec3(bone.transform[1])),
+                           glm::length(glm::vec3(bone.transform[2])));
+    bone.rot       = glm::quat(1, 0, 0, 0);
+
+    // a zero scale axis leaves no rotation to recover
+    if (bone.scale.x > 0 && bone.scale.y > 0 && bone.scale.z > 0) {
+      bone.rot = glm::quat_cast(glm::mat3(glm::vec3(bone.transform[0]) / bone.scale.x,
+                                          glm::vec3(bone.transform[1]) / bone.scale.y,
+                                          glm::vec3(bone.transform[2]) / bone.scale.z));
+    }
+
+    // nodes between joints are skipped, the same way assimp bone lookup does it
+    auto parent = parentOfNode[node];
+    for (uint32_t depth = 0; parent >= 0 && jointOfNode[parent] < 0; depth++) {
+      // malformed files can list a node among its own descendants
+      if (depth >= nodes.Size()) {
+        elog::LogError("Glb node hierarchy contains a cycle");
+        return false;
+      }
+      parent = parentOfNode[parent];
+    }
+    bone.parent = parent >= 0 ? jointOfNode[parent] : -1;
+
+    for (auto& child : nodes[node]["children"].GetElements()) {
+      if (GetNodeName(doc, child.AsInt()) == bone.name + "_end") {
+        bone.bone_end = doc.GetLocalTransform(child.AsInt());
+        break;
+      }
+    }
+  }
+
+  out.SetArmature(render::anim::Armature(globalInverse, core::Move(bones)));
+  return true;
+}
+
+template <class TValue, class TSource, class TConvert>
+bool ReadKeys(GltfDocument& doc, const util::JsonValue& sampler,
+              core::Vector<render::anim::AnimKey<TValue>>& keys, float& duration, TConvert convert)
+{
+  core::Vector<float> times;
+  core::Vector<TSource> values;
+
+  if (!doc.ReadAccessor(sampler["input"].AsInt(), times) ||
+      !doc.ReadAccessor(sampler["output"].AsInt(), values)) {
+    return false;
+  }
+
+  // cubic spline samplers store in-tangent, value and out-tangent per key
+  uint32_t valueStride = sampler["interpolation"].AsString() == "CUBICSPLINE" ? 3 : 1;
+  uint32_t valueOffset = valueStride == 3 ? 1 : 0;
+
+  if (values.size() < times.size() * valueStride) {
+    elog::LogError("Glb animation sampler has fewer values than keys");
+    return false;
+  }
+
+  keys.resize(times.size());
+  for (uint32_t i = 0; i < times.size(); i++) {
+    keys[i].Time  = times[i] * TicksPerSecond;
+    keys[i].Value = convert(values[i * valueStride + valueOffset]);
+    duration      = std::max(duration, keys[i].Time);
+  }
+
+  return true;
+}
+
+bool ReadAnimations(GltfDocument& doc, const core::Vector<int32_t>& jointOfNode,
+                    render::AnimatedMesh& out)
+{
+  auto boneCount = out.GetArmature().GetBones().size();
+
+  for (auto& gltfAnimation : doc["animations"].GetElements()) {
+    render::anim::Animation animation;
+    animation.Name     = gltfAnimation["name"].AsString();
+    animation.Fps      = TicksPerSecond;
+    animation.Duration = 0;
+    animation.BoneKeys.resize(boneCount);
+
+    for (auto& channel : gltfAnimation["channels"].GetElements()) {
+      auto node     = channel["target"]["node"].AsInt();
+      auto& path    = channel["target"]["path"].AsString();
+      auto& sampler = gltfAnimation["samplers"][channel["sampler"].AsInt()];
+
+      if ((uint32_t)node >= jointOfNode.size() || sampler.IsNull())
+        continue;
+
+      // channels of nodes outside of the skin drive the whole armature, as with assimp
+      auto joint = jointOfNode[node];
+      auto& keys = joint >= 0 ? animation.BoneKeys[joint] : animation.ArmatureKeys;
+      keys.BoneIndex = joint >= 0 ? joint : 0;
+
+      auto toVec3 = [](const glm::vec3& v) { return v; };
+      bool read   = true;
+
+      if (path == "translation") {
+        read = ReadKeys<glm::vec3, glm::vec3>(doc, sampler, keys.PositionKeys, animation.Duration,
+                                              toVec3);
+      }
+      else if (path == "scale") {
+        read = ReadKeys<glm::vec3, glm::vec3>(doc, sampler, keys.ScaleKeys, animation.Duration,
+                                              toVec3);
+      }
+      else if (path == "rotation") {
+        read = ReadKeys<glm::quat, glm::vec4>(
+            doc, sampler, keys.RotationKeys, animation.Duration,
+            [](const glm::vec4& v) { return glm::quat(v.w, v.x, v.y, v.z); });
+      }
+
+      if (!read)
+        return false;
+    }
+
+    out.AddAnimation(animation);
+  }
+
+  return true;
+}
+} // namespace
+
+bool GltfImport::IsGlb(const void* data, size_t size)
+{
+  return size >= GlbHeaderSize && Load<uint32_t>((const uint8_t*)data) == GlbMagic;
+}
+
+core::UniquePtr<render::AnimatedMesh> GltfImport::ImportGlb(const void* data, size_t size,
+                                                            const core::String& name,
+                                                            bool* unsupported)
+{
+  if (unsupported)
+    *unsupported = false;
+
+  auto bytes = static_cast<const uint8_t*>(data);
+  auto fail  = [&](const core::String& error) -> core::UniquePtr<render::AnimatedMesh> {
+    elog::LogError(core::string::format("Failed to import glb '{}': {}", name, error));
+    return nullptr;
+  };
+
+  if (!IsGlb(data, size) || Load<uint32_t>(bytes + 4) != 2)
+    return fail("not a glTF 2.0 binary file");
+
+  // chunks are 4 byte aligned, json comes first and binary chunk is optional
+  size_t length = std::min<size_t>(Load<uint32_t>(bytes + 8), size);
+  size_t offset = GlbHeaderSize;
+  const char* jsonText = nullptr;
+  const uint8_t* bin   = nullptr;
+  size_t jsonSize = 0, binSize = 0;
+
+  while (offset + 8 <= length) {
+    auto chunkSize = Load<uint32_t>(bytes + offset);
+    auto chunkType = Load<uint32_t>(bytes + offset + 4);
+    offset += 8;
+
+    if (chunkSize > length - offset)
+      return fail("chunk is out of bounds");
+
+    if (chunkType == JsonChunkType && !jsonText) {
+      jsonText = (const char*)bytes + offset;
+      jsonSize = chunkSize;
+    }
+    else if (chunkType == BinChunkType && !bin) {
+      bin     = bytes + offset;
+      binSize = chunkSize;
+    }
+
+    offset += (chunkSize + 3) & ~3u;
+  }
+
+  if (!jsonText)
+    return fail("json chunk is missing");
+
+  auto json = util::JsonValue::Parse(jsonText, jsonSize);
+  if (!json)
+    return fail("json chunk is malformed");
+
+  GltfDocument doc(json.value(), bin, binSize);
+  auto& buffers = doc["buffers"];
+
+  for (uint32_t i = 0; i < buffers.Size(); i++) {
+    if (i == 0 && !buffers[i].Has("uri"))
+      continue;
+
+    if (!unsupported)
+      return fail("buffers outside of the binary chunk are not supported");
+
+    *unsupported = true;
+    return nullptr;
+  }
+
+  auto& meshes = doc["meshes"];
+
+  if (meshes.Size() == 0)
+    return fail("file does not contain any meshes");
+
+  // skin comes from the first node which instantiates the mesh
+  int32_t skinIndex = -1;
+  for (auto& node : doc["nodes"].GetElements()) {
+    if (node["mesh"].AsInt() == 0) {
+      skinIndex = node["skin"].AsInt();
+      break;
+    }
+  }
+
+  auto mesh = core::MakeUnique<render::AnimatedMesh>();
+  core::Vector<int32_t> jointOfNode(doc["nodes"].Size(), -1);
+
+  if (!ReadPrimitives(doc, meshes[0], *mesh) || !ReadSkin(doc, skinIndex, jointOfNode, *mesh) ||
+      !ReadAnimations(doc, jointOfNode, *mesh)) {
+    return fail(doc.GetError().empty() ? "invalid mesh data" : doc.GetError());
+  }
+
+  elog::LogInfo(core::string::format("Loaded glb '{}', vertices: {}, bones: {}, animations: {}",
+                                     name, mesh->VertexBuffer.size(),
+                                     mesh->GetArmature().GetBones().size(),
+                                     mesh->GetAnimations().size()));
+  return mesh;
+}
+
+core::UniquePtr<render::AnimatedMesh> GltfImport::ImportGlbFile(const core::String& nativePath)
+{
+  auto file = io::MappedFile::Open(nativePath);
+
+  if (!file) {
+    elog::LogError(core::string::format("Failed to map glb file '{}'", nativePath));
+    return nullptr;
+  }
+
+  return ImportGlb(file->GetData(), file->GetSize(), nativePath);
+}
+} // namespace res::mesh
@@ -1,6 +1,7 @@
 #include "resource_management/mesh/IQMLoader.h"
 #include "IQM.h"
 #include "filesystem/IFileSystem.h"
+#include "filesystem/IoBufferPool.h"
 #include "filesystem/Path.h"
 #include <cstring>
 #include <random>
@@ -9,7 +10,7 @@
 
 namespace res {
 bool load_header(const uint8_t* data, iqm::iqmheader& header);
-void load_mesh(render::AnimatedMesh* mesh, const core::TByteArray& data,
+void load_mesh(render::AnimatedMesh* mesh, const uint8_t* data,
                const iqm::iqmheader& header);
 
 IQMLoader::IQMLoader(io::IFileSystem* fileSystem)
@@ -23,14 +24,14 @@ void IQMLoader::Load(render::AnimatedMesh* mesh, io::Path path)
     return;
   }
 
-  core::TByteArray contents;
-  if (!file->Read(contents)) {
+  io::IoBuffer contents;
+  if (file->Read(contents) < static_cast<std::intmax_t>(sizeof(iqm::iqmheader))) {
     return;
   }
 
   iqm::iqmheader header;
-  load_header(contents.data(), header);
-  load_mesh(mesh, contents, header);
+  load_header(contents.GetData(), header);
+  load_mesh(mesh, contents.GetData(), header);
 }
 
 bool load_header(const uint8_t* data, iqm::iqmheader& header)
@@ -50,7 +51,7 @@ bool load_header(const uint8_t* data, iqm::iqmheader& header)
 }
 
 template <class T>
-void LoadArray(const core::TByteArray& data, core::Vector<T>& bufferOut, uint32_t start,
+void LoadArray(const uint8_t* data, core::Vector<T>& bufferOut, uint32_t start,
                uint32_t count)
 {
   bufferOut.resize(count);
@@ -64,10 +65,10 @@ void InvertFaceWinding(core::Vector<uint32_t>& indexBuffer)
   }
 }
 
-void load_animation(render::Animation& animOut, const core::TByteArray& data,
+void load_animation(render::Animation& animOut, const uint8_t* data,
                     const iqm::iqmheader& header);
 
-void load_mesh(render::AnimatedMesh* mesh, const core::TByteArray& data,
+void load_mesh(render::AnimatedMesh* mesh, const uint8_t* data,
                const iqm::iqmheader& header)
 {
   const uint8_t* texts              = (const uint8_t*)&data[header.ofs_text];
@@ -129,7 +130,7 @@ void assign_bone_colors(render::Animation& animOut)
   }
 }
 
-void load_animation(render::Animation& animOut, const core::TByteArray& data,
+void load_animation(render::Animation& animOut, const uint8_t* data,
                     const iqm::iqmheader& header)
 {
   elog::LogInfo(core::string::format("\nnum_anims: {}\n"
@@ -21,17 +21,12 @@ struct RawBone
 
 core::Vector<Bone> MBDLoader::LoadMBD(io::IFileSystem* fs, io::Path path)
 {
-  auto file = fs->OpenRead(path);
-  if (!file) {
+  auto mapping = fs->MapFile(path);
+  if (!mapping || mapping->GetSize() == 0) {
     return core::Vector<Bone>();
   }
 
-  core::TByteArray contents;
-  if (!file->Read(contents)) {
-    return core::Vector<Bone>();
-  }
-
-  const uint8_t* data = contents.data();
+  const uint8_t* data = mapping->GetData();
 
   mbd::Header header;
   memcpy((void*)&header, (void*)data, sizeof(header));
@@ -53,19 +48,19 @@ core::Vector<Bone> MBDLoader::LoadMBD(io::IFileSystem* fs, io::Path path)
     });
   }
 
-  elog::LogInfo(core::string::format("\nMBD Header \n{{\n"
-                                     "magic = '{}'\n"
-                                     "text_offset = {}\n"
-                                     "text_num = {}\n"
-                                     "bone_offset = {}\n"
-                                     "bone_num = {}\n"
-                                     "}}\n",
-                                     header.magic, header.text_offset, header.text_num,
-                                     header.bone_offset, header.bone_num));
+  ELOG_DEBUG("\nMBD Header \n{{\n"
+             "magic = '{}'\n"
+             "text_offset = {}\n"
+             "text_num = {}\n"
+             "bone_offset = {}\n"
+             "bone_num = {}\n"
+             "}}\n",
+             header.magic, header.text_offset, header.text_num, header.bone_offset,
+             header.bone_num);
 
   for (auto& bone : bones) {
-    elog::LogInfo(core::string::format("Bone [{}:{}] = parent: {}, head: {}, tail: {}", bone.index,
-                                       bone.name.c_str(), bone.parent, bone.head, bone.tail));
+    ELOG_DEBUG("Bone [{}:{}] = parent: {}, head: {}, tail: {}", bone.index, bone.name.c_str(),
+               bone.parent, bone.head, bone.tail);
   }
 
   return bones;
@@ -0,0 +1,198 @@
+#include "resource_management/mesh/MeshletBuilder.h"
+#include "render/BaseMesh.h"
+#include <algorithm>
+
+namespace res::mesh {
+namespace {
+constexpr uint32_t NoMeshlet = ~0u;
+
+/// Triangles using each vertex, in compressed row form.
+struct Adjacency
+{
+  core::Vector<uint32_t> Offsets;
+  core::Vector<uint32_t> Triangles;
+
+  Adjacency(const core::Vector<uint32_t>& indices, size_t vertexCount)
+      : Offsets(vertexCount + 1, 0)
+      , Triangles(indices.size())
+  {
+    for (auto index : indices) {
+      Offsets[index + 1]++;
+    }
+
+    for (size_t i = 0; i < vertexCount; i++) {
+      Offsets[i + 1] += Offsets[i];
+    }
+
+    core::Vector<uint32_t> fill(Offsets.begin(), Offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++) {
+      Triangles[fill[indices[i]]++] = i / 3;
+    }
+  }
+};
+
+void ComputeBounds(render::Meshlet& meshlet, const core::Vector<uint32_t>& indices,
+                   const core::Vector<glm::vec3>& positions)
+{
+  glm::vec3 min = positions[indices[meshlet.IndexOffset]], max = min;
+
+  for (uint32_t i = meshlet.IndexOffset; i < meshlet.IndexOffset + meshlet.IndexCount; i++) {
+    min = glm::min(min, positions[indices[i]]);
+    max = glm::max(max, positions[indices[i]]);
+  }
+
+  meshlet.Center = (min + max) * 0.5f;
+  meshlet.Radius = 0;
+
+  glm::vec3 normalSum(0.f);
+  core::Vector<glm::vec3> normals;
+  normals.reserve(meshlet.IndexCount / 3);
+
+  for (uint32_t i = meshlet.IndexOffset; i < meshlet.IndexOffset + meshlet.IndexCount; i += 3) {
+    const auto& a = positions[indices[i]];
+    const auto& b = positions[indices[i + 1]];
+    const auto& c = positions[indices[i + 2]];
+
+    for (const auto* p : { &a, &b, &c }) {
+      meshlet.Radius = std::max(meshlet.Radius, glm::length(*p - meshlet.Center));
+    }
+
+    auto normal = glm::cross(b - a, c - a);
+    auto length = glm::length(normal);
+
+    // degenerate triangles are invisible and do not constrain the cone
+    if (length > 0) {
+      normals.push_back(normal / length);
+      normalSum = normalSum + normals.back();
+    }
+  }
+
+  auto sumLength   = glm::length(normalSum);
+  meshlet.ConeAxis = sumLength > 0 ? normalSum / sumLength : glm::vec3(0, 0, 1);
+
+  float minDot = 1;
+  for (const auto& normal : normals) {
+    minDot = std::min(minDot, glm::dot(normal, meshlet.ConeAxis));
+  }
+
+  // wider than ~84 degrees the cone almost never culls, disable it instead of testing
+  meshlet.ConeCutoff = sumLength > 0 && minDot > 0.1f ? std::sqrt(1 - minDot * minDot) : 1.f;
+}
+} // namespace
+
+bool MeshletBuilder::Build(render::BaseMesh& mesh, const MeshletLimits& limits)
+{
+  auto& indices      = mesh.IndexBuffer;
+  auto& positions    = mesh.VertexBuffer;
+  auto triangleCount = (uint32_t)(indices.size() / 3);
+
+  mesh.Meshlets.clear();
+
+  if (triangleCount < limits.MinMeshTriangles || indices.size() % 3 != 0 ||
+      limits.MaxVertices < 3 || limits.MaxTriangles == 0)
+    return false;
+
+  for (auto index : indices) {
+    if (index >= positions.size())
+      return false;
+  }
+
+  Adjacency adjacency(indices, positions.size());
+  core::Vector<uint32_t> vertexMeshlet(positions.size(), NoMeshlet);
+  core::Vector<bool> emitted(triangleCount, false);
+  // meshlet whose candidate list already holds the triangle, avoids duplicates
+  core::Vector<uint32_t> candidateOf(triangleCount, NoMeshlet);
+  core::Vector<uint32_t> candidates, meshletTriangles;
+  core::Vector<uint32_t> ordered;
+  ordered.reserve(indices.size());
+
+  render::Meshlet current{};
+  uint32_t cursor = 0;
+
+  auto newVertexCount = [&](uint32_t triangle) {
+    uint32_t count = 0;
+    for (uint32_t k = 0; k < 3; k++) {
+      count += vertexMeshlet[indices[triangle * 3 + k]] != mesh.Meshlets.size();
+    }
+    return count;
+  };
+
+  auto flush = [&]() {
+    current.IndexOffset = ordered.size();
+    current.IndexCount  = meshletTriangles.size() * 3;
+
+    for (auto triangle : meshletTriangles) {
+      auto first = indices.begin() + triangle * 3;
+      ordered.insert(ordered.end(), first, first + 3);
+    }
+
+    mesh.Meshlets.push_back(current);
+    meshletTriangles.clear();
+    candidates.clear();
+    current = {};
+  };
+
+  for (uint32_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+    // best connected candidate, stale entries are dropped while scanning
+    uint32_t best = NoMeshlet, bestNew = 4;
+    for (size_t i = 0; i < candidates.size();) {
+      if (emitted[candidates[i]]) {
+        candidates[i] = candidates.back();
+        candidates.pop_back();
+        continue;
+      }
+
+      auto count = newVertexCount(candidates[i]);
+      if (count < bestNew) {
+        best    = candidates[i];
+        bestNew = count;
+      }
+
+      if (bestNew == 0)
+        break;
+      i++;
+    }
+
+    // nothing connected left, continue with the next triangle in index order
+    if (best == NoMeshlet) {
+      while (emitted[cursor])
+        cursor++;
+      best    = cursor;
+      bestNew = newVertexCount(best);
+    }
+
+    if (current.VertexCount + bestNew > limits.MaxVertices ||
+        meshletTriangles.size() == limits.MaxTriangles) {
+      flush();
+      bestNew = newVertexCount(best);
+    }
+
+    emitted[best] = true;
+    meshletTriangles.push_back(best);
+    current.VertexCount += bestNew;
+
+    for (uint32_t k = 0; k < 3; k++) {
+      auto vertex           = indices[best * 3 + k];
+      vertexMeshlet[vertex] = mesh.Meshlets.size();
+
+      for (auto j = adjacency.Offsets[vertex]; j < adjacency.Offsets[vertex + 1]; j++) {
+        auto triangle = adjacency.Triangles[j];
+
+        if (!emitted[triangle] && candidateOf[triangle] != mesh.Meshlets.size()) {
+          candidateOf[triangle] = mesh.Meshlets.size();
+          candidates.push_back(triangle);
+        }
+      }
+    }
+  }
+
+  flush();
+  indices = core::Move(ordered);
+
+  for (auto& meshlet : mesh.Meshlets) {
+    ComputeBounds(meshlet, indices, positions);
+  }
+
+  return true;
+}
+} // namespace res::mesh
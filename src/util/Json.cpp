@@ -0,0 +1,347 @@
+#include "util/Json.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace util {
+namespace {
+constexpr uint32_t MaxDepth = 256;
+
+const JsonValue& GetNull()
+{
+  static const JsonValue null;
+  return null;
+}
+
+void AppendUtf8(core::String& out, uint32_t codepoint)
+{
+  if (codepoint < 0x80) {
+    out += (char)codepoint;
+  }
+  else if (codepoint < 0x800) {
+    out += (char)(0xc0 | (codepoint >> 6));
+    out += (char)(0x80 | (codepoint & 0x3f));
+  }
+  else if (codepoint < 0x10000) {
+    out += (char)(0xe0 | (codepoint >> 12));
+    out += (char)(0x80 | ((codepoint >> 6) & 0x3f));
+    out += (char)(0x80 | (codepoint & 0x3f));
+  }
+  else {
+    out += (char)(0xf0 | (codepoint >> 18));
+    out += (char)(0x80 | ((codepoint >> 12) & 0x3f));
+    out += (char)(0x80 | ((codepoint >> 6) & 0x3f));
+    out += (char)(0x80 | (codepoint & 0x3f));
+  }
+}
+} // namespace
+
+class JsonParser
+{
+  public:
+  JsonParser(const char* text, size_t size)
+      : m_text(text)
+      , m_end(text + size)
+      , m_pos(text)
+  {
+  }
+
+  bool ParseDocument(JsonValue& out)
+  {
+    if (!ParseValue(out, 0))
+      return false;
+
+    SkipWhitespace();
+    return m_pos == m_end || Fail("trailing characters");
+  }
+
+  private:
+  bool Fail(const char* error)
+  {
+    elog::LogError(
+        core::string::format("Json parse error at offset {}: {}", m_pos - m_text, error));
+    return false;
+  }
+
+  void SkipWhitespace()
+  {
+    while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\n' || *m_pos == '\r'))
+      m_pos++;
+  }
+
+  bool Consume(const char* literal)
+  {
+    auto length = strlen(literal);
+
+    if ((size_t)(m_end - m_pos) < length || memcmp(m_pos, literal, length) != 0)
+      return false;
+
+    m_pos += length;
+    return true;
+  }
+
+  bool ParseValue(JsonValue& out, uint32_t depth)
+  {
+    if (depth > MaxDepth)
+      return Fail("nesting too deep");
+
+    SkipWhitespace();
+
+    if (m_pos == m_end)
+      return Fail("unexpected end of input");
+
+    switch (*m_pos) {
+    case '{':
+      return ParseObject(out, depth);
+    case '[':
+      return ParseArray(out, depth);
+    case '"':
+      out.m_type = JsonValue::Type::String;
+      return ParseString(out.m_string);
+    case 't':
+    case 'f':
+      out.m_type = JsonValue::Type::Bool;
+      out.m_bool = *m_pos == 't';
+      return Consume(out.m_bool ? "true" : "false") || Fail("invalid literal");
+    case 'n':
+      return Consume("null") || Fail("invalid literal");
+    default:
+      return ParseNumber(out);
+    }
+  }
+
+  bool ParseNumber(JsonValue& out)
+  {
+    // strtod needs a terminated string, numbers are short so copy them out
+    char buffer[64];
+    size_t length = 0;
+
+    while (m_pos + length < m_end && length < sizeof(buffer) - 1 &&
+           strchr("+-0123456789.eE", m_pos[length])) {
+      buffer[length] = m_pos[length];
+      length++;
+    }
+
+    buffer[length] = '\0';
+    char* end      = nullptr;
+    out.m_number   = strtod(buffer, &end);
+
+    if (length == 0 || end != buffer + length)
+      return Fail("invalid number");
+
+    out.m_type = JsonValue::Type::Number;
+    m_pos += length;
+    return true;
+  }
+
+  bool ParseHex(uint32_t& out)
+  {
+    if (m_end - m_pos < 4)
+      return Fail("truncated escape");
+
+    out = 0;
+    for (int i = 0; i < 4; i++) {
+      char c = *m_pos++;
+      out <<= 4;
+
+      if (c >= '0' && c <= '9')
+        out |= c - '0';
+      else if (c >= 'a' && c <= 'f')
+        out |= c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        out |= c - 'A' + 10;
+      else
+        return Fail("invalid escape");
+    }
+
+    return true;
+  }
+
+  bool ParseString(core::String& out)
+  {
+    m_pos++;
+
+    while (m_pos < m_end) {
+      char c = *m_pos++;
+
+      if (c == '"')
+        return true;
+
+      if (c != '\\') {
+        out += c;
+        continue;
+      }
+
+      if (m_pos == m_end)
+        break;
+
+      switch (char e = *m_pos++) {
+      case 'b':
+        out += '\b';
+        break;
+      case 'f':
+        out += '\f';
+        break;
+      case 'n':
+        out += '\n';
+        break;
+      case 'r':
+        out += '\r';
+        break;
+      case 't':
+        out += '\t';
+        break;
+      case 'u': {
+        uint32_t codepoint, low;
+        if (!ParseHex(codepoint))
+          return false;
+
+        // surrogate pair
+        if (codepoint >= 0xd800 && codepoint < 0xdc00 && Consume("\\u")) {
+          if (!ParseHex(low))
+            return false;
+          codepoint = 0x10000 + ((codepoint - 0xd800) << 10) + (low - 0xdc00);
+        }
+
+        AppendUtf8(out, codepoint);
+        break;
+      }
+      default:
+        out += e;
+      }
+    }
+
+    return Fail("unterminated string");
+  }
+
+  bool ParseArray(JsonValue& out, uint32_t depth)
+  {
+    out.m_type = JsonValue::Type::Array;
+    m_pos++;
+    SkipWhitespace();
+
+    if (Consume("]"))
+      return true;
+
+    while (true) {
+      out.m_elements.emplace_back();
+      if (!ParseValue(out.m_elements.back(), depth + 1))
+        return false;
+
+      SkipWhitespace();
+      if (Consume("]"))
+        return true;
+      if (!Consume(","))
+        return Fail("expected ',' or ']'");
+    }
+  }
+
+  bool ParseObject(JsonValue& out, uint32_t depth)
+  {
+    out.m_type = JsonValue::Type::Object;
+    m_pos++;
+    SkipWhitespace();
+
+    if (Consume("}"))
+      return true;
+
+    while (true) {
+      SkipWhitespace();
+      if (m_pos == m_end || *m_pos != '"')
+        return Fail("expected key");
+
+      out.m_keys.emplace_back();
+      if (!ParseString(out.m_keys.back()))
+        return false;
+
+      SkipWhitespace();
+      if (!Consume(":"))
+        return Fail("expected ':'");
+
+      out.m_elements.emplace_back();
+      if (!ParseValue(out.m_elements.back(), depth + 1))
+        return false;
+
+      SkipWhitespace();
+      if (Consume("}"))
+        return true;
+      if (!Consume(","))
+        return Fail("expected ',' or '}'");
+    }
+  }
+
+  private:
+  const char* m_text;
+  const char* m_end;
+  const char* m_pos;
+};
+
+JsonValue::JsonValue()
+    : m_type(Type::Null)
+    , m_bool(false)
+    , m_number(0)
+{
+}
+
+core::Optional<JsonValue> JsonValue::Parse(const char* text, size_t size)
+{
+  JsonValue value;
+  JsonParser parser(text, size);
+
+  if (!parser.ParseDocument(value))
+    return {};
+
+  return value;
+}
+
+bool JsonValue::Has(const char* key) const
+{
+  return !(*this)[key].IsNull();
+}
+
+const JsonValue& JsonValue::operator[](const char* key) const
+{
+  if (m_type != Type::Object)
+    return GetNull();
+
+  for (size_t i = 0; i < m_keys.size(); i++) {
+    if (m_keys[i] == key)
+      return m_elements[i];
+  }
+
+  return GetNull();
+}
+
+const JsonValue& JsonValue::At(size_t index) const
+{
+  if (m_type != Type::Array || index >= m_elements.size())
+    return GetNull();
+
+  return m_elements[index];
+}
+
+size_t JsonValue::Size() const
+{
+  return m_type == Type::Array || m_type == Type::Object ? m_elements.size() : 0;
+}
+
+double JsonValue::AsNumber(double defaultValue) const
+{
+  return m_type == Type::Number ? m_number : defaultValue;
+}
+
+int32_t JsonValue::AsInt(int32_t defaultValue) const
+{
+  return m_type == Type::Number ? (int32_t)m_number : defaultValue;
+}
+
+bool JsonValue::AsBool(bool defaultValue) const
+{
+  return m_type == Type::Bool ? m_bool : defaultValue;
+}
+
+const core::String& JsonValue::AsString() const
+{
+  static const core::String empty;
+  return m_type == Type::String ? m_string : empty;
+}
+} // namespace util
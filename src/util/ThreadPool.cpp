@@ -0,0 +1,59 @@
+#include "util/ThreadPool.h"
+
+namespace util {
+ThreadPool::ThreadPool(uint32_t threadCount)
+    : m_stopping(false)
+{
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  m_threads.reserve(threadCount);
+  for (uint32_t i = 0; i < threadCount; i++) {
+    m_threads.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_condition.notify_all();
+
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+}
+
+void ThreadPool::Enqueue(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push(core::Move(task));
+  }
+  m_condition.notify_one();
+}
+
+void ThreadPool::WorkerLoop()
+{
+  while (true) {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+      // drain remaining work before exiting so pending futures are always satisfied
+      if (m_tasks.empty())
+        return;
+
+      task = core::Move(m_tasks.front());
+      m_tasks.pop();
+    }
+
+    task();
+  }
+}
+} // namespace util
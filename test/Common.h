@@ -0,0 +1,18 @@
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+namespace Common {
+/// Path under the system temp directory for files of one test, nothing is created. The suffix
+/// differs per call, so test runs started within the same second do not share files.
+std::filesystem::path GetTempPath(const std::string& name)
+{
+    auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+    return std::filesystem::temp_directory_path() / (name + "_" + std::to_string(ticks));
+}
+}
+
+#endif
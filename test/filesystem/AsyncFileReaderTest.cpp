@@ -0,0 +1,201 @@
+#include "Common.h"
+#include "filesystem/AsyncFileReader.h"
+#include "filesystem/BlockCompression.h"
+#include "filesystem/IFileSystem.h"
+#include "filesystem/MemoryFileReader.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+/// Files under "loose/" are real files in the working directory, everything else is served from
+/// memory like an archive would be.
+class TestFileSystem : public io::IFileSystem
+{
+public:
+    ~TestFileSystem()
+    {
+        for (auto& file : looseFiles) {
+            std::remove(file.c_str());
+        }
+    }
+
+    void AddLooseFile(const core::String& name, const core::TByteArray& contents)
+    {
+        looseFiles.push_back(NativeName(name));
+        std::ofstream(looseFiles.back(), std::ios::binary)
+            .write((const char*)contents.data(), contents.size());
+    }
+
+    /// Compressed on disk, OpenRead returns the contents like FileSystem decompresses them.
+    void AddCompressedLooseFile(const core::String& name, const core::TByteArray& contents)
+    {
+        core::TByteArray compressed;
+        io::compression::CompressFile(contents.data(), contents.size(), compressed, 4096);
+        AddLooseFile(name, compressed);
+        archived["loose/" + name] = contents;
+    }
+
+    core::String NativeName(const core::String& name)
+    {
+        return "AsyncFileReaderTest_" + name;
+    }
+
+    bool SetWriteDirectory(const io::Path&) override { return false; }
+    io::Path GetWriteDirectory() override { return {}; }
+    io::Path GetWorkingDirectory() override { return {}; }
+    bool AddSearchDirectory(const io::Path&) override { return false; }
+    void RescanMounts() override {}
+    bool DirectoryExists(const io::Path&) override { return false; }
+    bool FileExists(const io::Path&) override { return false; }
+    bool CreateDirectory(const io::Path&) override { return false; }
+    bool Delete(const io::Path&) override { return false; }
+    core::UniquePtr<io::IFileWriter> OpenWrite(const io::Path&, bool) override { return nullptr; }
+    core::UniquePtr<io::IFileMapping> MapFile(const io::Path&) override { return nullptr; }
+    core::Vector<io::Path> GetFilesInDirectory(const io::Path&) override { return {}; }
+
+    core::UniquePtr<io::IFileReader> OpenRead(const io::Path& path) override
+    {
+        auto it = archived.find(path.AsString());
+        if (it == archived.end())
+            return nullptr;
+        return core::MakeUnique<io::MemoryFileReader>(it->second);
+    }
+
+    core::String GetNativePath(const io::Path& path) override
+    {
+        auto name = path.AsString();
+        if (name.rfind("loose/", 0) != 0)
+            return "";
+        return NativeName(name.substr(6));
+    }
+
+    core::Vector<core::String> looseFiles;
+    core::UnorderedMap<core::String, core::TByteArray> archived;
+};
+
+class AsyncFileReaderTest : public ::testing::TestWithParam<bool>
+{
+};
+} // namespace
+
+TEST_P(AsyncFileReaderTest, ReadsLooseAndArchivedFiles)
+{
+    TestFileSystem fs;
+    io::AsyncFileReader reader(&fs, 8, GetParam());
+
+    const uint32_t fileCount = 40;
+    core::Vector<core::TByteArray> expected, buffers(fileCount);
+    core::Vector<std::intmax_t> results(fileCount, -2);
+    core::Vector<io::AsyncReadRequest> requests;
+
+    for (uint32_t i = 0; i < fileCount; i++) {
+        expected.push_back(Common::MakePattern(1000 + i * 97, i));
+        auto name = core::string::format("file{}.bin", i);
+
+        // every other file comes from the fallback path
+        if (i % 2) {
+            fs.AddLooseFile(name, expected[i]);
+            name = "loose/" + name;
+        }
+        else {
+            fs.archived[name] = expected[i];
+        }
+
+        buffers[i].resize(expected[i].size());
+        io::AsyncReadRequest request;
+        request.File        = io::Path(name);
+        request.Length      = buffers[i].size();
+        request.Destination = buffers[i].data();
+        request.OnComplete  = [&results, i](std::intmax_t bytesRead) { results[i] = bytesRead; };
+        requests.push_back(request);
+    }
+
+    reader.Submit(requests);
+    reader.WaitAll();
+
+    ASSERT_EQ(reader.GetPendingCount(), 0u);
+    for (uint32_t i = 0; i < fileCount; i++) {
+        ASSERT_EQ(results[i], (std::intmax_t)expected[i].size());
+        ASSERT_EQ(buffers[i], expected[i]);
+    }
+}
+
+TEST_P(AsyncFileReaderTest, ReadsRangesAndReportsFailures)
+{
+    TestFileSystem fs;
+    io::AsyncFileReader reader(&fs, 1, GetParam());
+
+    auto contents = Common::MakePattern(4096, 3);
+    fs.AddLooseFile("data.bin", contents);
+
+    core::TByteArray range(100), tail(100);
+    std::intmax_t rangeResult = -2, tailResult = -2, missingResult = -2;
+
+    io::AsyncReadRequest request;
+    request.File        = io::Path("loose/data.bin");
+    request.Offset      = 1000;
+    request.Length      = range.size();
+    request.Destination = range.data();
+    request.OnComplete  = [&](std::intmax_t bytes) { rangeResult = bytes; };
+    reader.Submit(request);
+
+    // past the end only the remaining bytes arrive
+    request.Offset      = 4046;
+    request.Destination = tail.data();
+    request.OnComplete  = [&](std::intmax_t bytes) { tailResult = bytes; };
+    reader.Submit(request);
+
+    request.File       = io::Path("missing.bin");
+    request.Offset     = 0;
+    request.OnComplete = [&](std::intmax_t bytes) { missingResult = bytes; };
+    reader.Submit(request);
+
+    // callbacks never run outside of polling
+    ASSERT_EQ(rangeResult, -2);
+
+    reader.WaitAll();
+    ASSERT_EQ(rangeResult, 100);
+    ASSERT_TRUE(std::equal(range.begin(), range.end(), contents.begin() + 1000));
+    ASSERT_EQ(tailResult, 50);
+    ASSERT_TRUE(std::equal(tail.begin(), tail.begin() + 50, contents.begin() + 4046));
+    ASSERT_EQ(missingResult, -1);
+}
+
+TEST_P(AsyncFileReaderTest, ReadsCompressedLooseFilesDecompressed)
+{
+    TestFileSystem fs;
+    io::AsyncFileReader reader(&fs, 4, GetParam());
+
+    core::TByteArray contents(20000);
+    for (size_t i = 0; i < contents.size(); i++) {
+        contents[i] = (uint8_t)(i % 13);
+    }
+    fs.AddCompressedLooseFile("packed.bin", contents);
+
+    core::TByteArray all(contents.size()), range(300);
+    std::intmax_t allResult = -2, rangeResult = -2;
+
+    io::AsyncReadRequest request;
+    request.File        = io::Path("loose/packed.bin");
+    request.Length      = all.size();
+    request.Destination = all.data();
+    request.OnComplete  = [&](std::intmax_t bytes) { allResult = bytes; };
+    reader.Submit(request);
+
+    // offsets are into the decompressed contents, across a block boundary
+    request.Offset      = 8000;
+    request.Length      = range.size();
+    request.Destination = range.data();
+    request.OnComplete  = [&](std::intmax_t bytes) { rangeResult = bytes; };
+    reader.Submit(request);
+
+    reader.WaitAll();
+    ASSERT_EQ(allResult, (std::intmax_t)contents.size());
+    ASSERT_EQ(all, contents);
+    ASSERT_EQ(rangeResult, 300);
+    ASSERT_TRUE(std::equal(range.begin(), range.end(), contents.begin() + 8000));
+}
+
+INSTANTIATE_TEST_CASE_P(Backends, AsyncFileReaderTest, ::testing::Values(true, false));
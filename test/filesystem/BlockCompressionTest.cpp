@@ -0,0 +1,161 @@
+#include "filesystem/BlockCompressedReader.h"
+#include "filesystem/BlockCompression.h"
+#include "filesystem/MemoryFileReader.h"
+#include "gtest/gtest.h"
+#include "util/ThreadPool.h"
+#include <cstring>
+#include <random>
+
+namespace {
+/// Text like data with repeats at many distances, and runs that need overlapping copies.
+core::TByteArray MakeCompressible(size_t size)
+{
+    core::TByteArray data;
+    std::mt19937 random(7);
+
+    while (data.size() < size) {
+        auto line = "vertex " + std::to_string(random() % 50) + " " + std::to_string(random() % 8) + "\n";
+        data.insert(data.end(), line.begin(), line.end());
+        data.insert(data.end(), random() % 40, (uint8_t)'0');
+    }
+
+    data.resize(size);
+    return data;
+}
+
+core::TByteArray MakeRandom(size_t size)
+{
+    core::TByteArray data(size);
+    std::mt19937 random(11);
+    for (auto& byte : data) {
+        byte = (uint8_t)random();
+    }
+    return data;
+}
+
+core::UniquePtr<io::BlockCompressedReader> Open(const core::TByteArray& compressed,
+                                                core::SharedPtr<util::ThreadPool> pool = nullptr)
+{
+    return io::BlockCompressedReader::Open(core::MakeUnique<io::MemoryFileReader>(compressed),
+                                           core::Move(pool));
+}
+} // namespace
+
+TEST(BlockCompressionTest, BlocksRoundTrip)
+{
+    for (auto& data : { MakeCompressible(65536), MakeRandom(65536), MakeCompressible(3),
+                        core::TByteArray(65536, 0) }) {
+        core::TByteArray compressed(data.size() * 2 + 16), decompressed(data.size());
+
+        auto size = io::compression::CompressBlock(data.data(), data.size(), compressed.data(),
+                                                   compressed.size());
+        ASSERT_GT(size, 0u);
+        ASSERT_TRUE(io::compression::DecompressBlock(compressed.data(), size, decompressed.data(),
+                                                     decompressed.size()));
+        ASSERT_EQ(data, decompressed);
+    }
+}
+
+TEST(BlockCompressionTest, CorruptBlocksAreRejected)
+{
+    auto data = MakeCompressible(10000);
+    core::TByteArray compressed(data.size()), decompressed(data.size());
+
+    auto size = io::compression::CompressBlock(data.data(), data.size(), compressed.data(),
+                                               compressed.size());
+    ASSERT_GT(size, 0u);
+    ASSERT_EQ(io::compression::CompressBlock(data.data(), data.size(), compressed.data(), size - 1), 0u);
+
+    ASSERT_FALSE(io::compression::DecompressBlock(compressed.data(), size - 1, decompressed.data(),
+                                                  decompressed.size()));
+    ASSERT_FALSE(io::compression::DecompressBlock(compressed.data(), size, decompressed.data(),
+                                                  decompressed.size() - 1));
+}
+
+TEST(BlockCompressionTest, FilesShrinkAndReadBack)
+{
+    auto data = MakeCompressible(1000000);
+    core::TByteArray compressed;
+    io::compression::CompressFile(data.data(), data.size(), compressed);
+
+    ASSERT_TRUE(io::compression::IsCompressed(compressed.data(), compressed.size()));
+    ASSERT_LT(compressed.size(), data.size() / 2);
+
+    for (auto pool : { core::SharedPtr<util::ThreadPool>(), core::MakeShared<util::ThreadPool>(4) }) {
+        auto reader = Open(compressed, pool);
+        ASSERT_NE(reader, nullptr);
+        ASSERT_EQ(reader->GetLength(), (std::intmax_t)data.size());
+        ASSERT_EQ(reader->GetCompressedSize(), compressed.size());
+
+        core::TByteArray read, part;
+        while (reader->Read(part, 10007) > 0) {
+            read.insert(read.end(), part.begin(), part.end());
+        }
+        ASSERT_EQ(read, data);
+    }
+}
+
+TEST(BlockCompressionTest, SeeksReadAnyPosition)
+{
+    auto data = MakeCompressible(500000);
+    core::TByteArray compressed;
+    io::compression::CompressFile(data.data(), data.size(), compressed, 4096);
+
+    auto reader = Open(compressed, core::MakeShared<util::ThreadPool>(2));
+    std::mt19937 random(3);
+
+    for (uint32_t i = 0; i < 200; i++) {
+        size_t position = random() % data.size();
+        size_t size     = random() % 9000;
+        core::TByteArray part;
+
+        ASSERT_TRUE(reader->Seek(position));
+        ASSERT_EQ(reader->Read(part, size), (std::intmax_t)std::min(size, data.size() - position));
+        ASSERT_TRUE(std::equal(part.begin(), part.end(), data.begin() + position));
+    }
+
+    ASSERT_FALSE(reader->Seek(data.size() + 1));
+}
+
+TEST(BlockCompressionTest, IncompressibleFilesAreStoredRaw)
+{
+    auto data = MakeRandom(200000);
+    core::TByteArray compressed;
+    io::compression::CompressFile(data.data(), data.size(), compressed);
+
+    // header and offset table only
+    ASSERT_LT(compressed.size(), data.size() + 100);
+
+    core::TByteArray read;
+    ASSERT_EQ(Open(compressed)->Read(read), (std::intmax_t)data.size());
+    ASSERT_EQ(read, data);
+}
+
+TEST(BlockCompressionTest, CorruptFilesFail)
+{
+    auto data = MakeCompressible(100000);
+    core::TByteArray compressed;
+    io::compression::CompressFile(data.data(), data.size(), compressed);
+
+    auto truncated = compressed;
+    truncated.resize(truncated.size() - 100);
+    ASSERT_EQ(Open(truncated), nullptr);
+    ASSERT_EQ(Open(core::TByteArray(compressed.begin(), compressed.begin() + 10)), nullptr);
+
+    // a consistent header with a block count the file cannot hold
+    auto oversized = compressed;
+    io::compression::Header header;
+    memcpy(&header, oversized.data(), sizeof(header));
+    header.BlockCount       = 0xffffffff;
+    header.UncompressedSize = (uint64_t)header.BlockCount * header.BlockSize;
+    memcpy(oversized.data(), &header, sizeof(header));
+    ASSERT_EQ(Open(oversized), nullptr);
+
+    // damage the last block, everything before it is still readable
+    compressed[compressed.size() - 10] ^= 0x5a;
+    compressed[compressed.size() - 11] ^= 0x5a;
+    auto reader = Open(compressed);
+    core::TByteArray read;
+    ASSERT_EQ(reader->Read(read, 65536), 65536);
+    ASSERT_EQ(reader->Read(read), -1);
+}
@@ -0,0 +1,152 @@
+#include "filesystem/BufferedFileWriter.h"
+#include "gtest/gtest.h"
+#include <thread>
+
+using namespace std::literals::string_literals;
+
+namespace {
+/// Collects written bytes in memory, shared with the test so they can be checked after the
+/// buffered writer took ownership.
+struct TestFile
+{
+    std::string contents;
+    std::intmax_t position = 0;
+    uint32_t writeCount    = 0;
+    uint32_t flushCount    = 0;
+    bool failWrites        = false;
+    std::thread::id writerThread;
+};
+
+class TestFileWriter : public io::IFileWriter
+{
+public:
+    TestFileWriter(TestFile& file)
+        : file(file)
+    {
+    }
+
+    std::intmax_t GetPosition() const override { return file.position; }
+
+    std::intmax_t Write(const core::TByteArray& array, std::intmax_t size) override
+    {
+        return WriteBytes((const char*)array.data(), std::min<std::uintmax_t>(size, array.size()));
+    }
+
+    std::intmax_t Write(const std::string& string, std::uintmax_t size) override
+    {
+        return WriteBytes(string.data(), std::min<std::uintmax_t>(size, string.size()));
+    }
+
+    bool Seek(std::uintmax_t position) override
+    {
+        if (position > file.contents.size())
+            return false;
+
+        file.position = position;
+        return true;
+    }
+
+    bool Flush() override
+    {
+        file.flushCount++;
+        return true;
+    }
+
+private:
+    std::intmax_t WriteBytes(const char* data, size_t size)
+    {
+        file.writeCount++;
+        file.writerThread = std::this_thread::get_id();
+
+        if (file.failWrites)
+            return -1;
+
+        file.contents.resize(std::max<size_t>(file.contents.size(), file.position + size));
+        file.contents.replace(file.position, size, data, size);
+        file.position += size;
+        return size;
+    }
+
+    TestFile& file;
+};
+} // namespace
+
+class BufferedFileWriterTest : public ::testing::Test
+{
+protected:
+    core::UniquePtr<io::BufferedFileWriter> Open(size_t bufferSize)
+    {
+        return core::MakeUnique<io::BufferedFileWriter>(core::MakeUnique<TestFileWriter>(file),
+                                                        bufferSize);
+    }
+
+    TestFile file;
+};
+
+TEST_F(BufferedFileWriterTest, SmallWritesAreBatched)
+{
+    auto writer = Open(64);
+    std::string expected;
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        auto line = std::to_string(i) + "\n";
+        ASSERT_EQ(writer->Write(line), (std::intmax_t)line.size());
+        expected += line;
+    }
+
+    ASSERT_EQ(writer->GetPosition(), (std::intmax_t)expected.size());
+    ASSERT_TRUE(writer->Flush());
+
+    ASSERT_EQ(file.contents, expected);
+    ASSERT_EQ(file.flushCount, 1u);
+    ASSERT_LE(file.writeCount, expected.size() / 64 + 1);
+    ASSERT_NE(file.writerThread, std::this_thread::get_id());
+}
+
+TEST_F(BufferedFileWriterTest, WritesLargerThanBufferKeepOrder)
+{
+    auto writer = Open(16);
+    std::string big(1000, 'b');
+
+    ASSERT_EQ(writer->Write("head"s), 4);
+    ASSERT_EQ(writer->Write(big), 1000);
+    ASSERT_EQ(writer->Write("tail"s, 2), 2);
+    writer.reset();
+
+    ASSERT_EQ(file.contents, "head" + big + "ta");
+    // destruction writes out, it does not sync
+    ASSERT_EQ(file.flushCount, 0u);
+}
+
+TEST_F(BufferedFileWriterTest, SeekWritesOutBufferFirst)
+{
+    auto writer = Open(1024);
+
+    ASSERT_EQ(writer->Write("Hello World"s), 11);
+    ASSERT_TRUE(writer->Seek(6));
+    ASSERT_EQ(writer->GetPosition(), 6);
+    ASSERT_EQ(writer->Write("There"s), 5);
+    ASSERT_FALSE(writer->Seek(100));
+    ASSERT_TRUE(writer->Flush());
+
+    ASSERT_EQ(file.contents, "Hello There");
+}
+
+TEST_F(BufferedFileWriterTest, BackgroundFailureIsReported)
+{
+    file.failWrites = true;
+    auto writer     = Open(8);
+
+    ASSERT_EQ(writer->Write("buffered"s), 8);
+    ASSERT_FALSE(writer->Flush());
+    ASSERT_EQ(writer->Write("more"s), -1);
+    ASSERT_FALSE(writer->Seek(0));
+}
+
+TEST_F(BufferedFileWriterTest, MissingWriterFails)
+{
+    io::BufferedFileWriter writer(nullptr);
+
+    ASSERT_EQ(writer.Write("text"s), -1);
+    ASSERT_FALSE(writer.Flush());
+}
@@ -1,6 +1,7 @@
-#ifndef TEST_COMMON_H
-#define TEST_COMMON_H
+#ifndef TEST_FILESYSTEM_COMMON_H
+#define TEST_FILESYSTEM_COMMON_H
 
+#include "../Common.h"
 #include "filesystem/Path.h"
 #include <chrono>
 #include <iostream>
@@ -22,6 +23,16 @@ std::string GetTimestampString()
 {
     return std::to_string(GetTimestamp());
 }
+
+/// Bytes that do not repeat with a period of 256, so shifted or misplaced reads are noticed.
+core::TByteArray MakePattern(size_t size, uint8_t seed = 0)
+{
+    core::TByteArray bytes(size);
+    for (size_t i = 0; i < size; i++) {
+        bytes[i] = (uint8_t)(i * 31 + i / 251 + seed);
+    }
+    return bytes;
+}
 }
 
 #endif
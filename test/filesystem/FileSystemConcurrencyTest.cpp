@@ -0,0 +1,145 @@
+#include "Common.h"
+#include "filesystem/IFileSystem.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+
+namespace {
+const char* argv0;
+const uint32_t ReaderCount = 8;
+}
+
+int main(int argc, char** argv)
+{
+    argv0 = argv[0];
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+/// Meant to run under ThreadSanitizer, configure with ENGINE_THREAD_SANITIZER=ON.
+class FileSystemConcurrencyTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        ASSERT_NE(argv0, nullptr);
+
+        readFilePath      = "testdata/TestReadFile.txt"s;
+        readFileContents  = "Hello?!\n"
+                           "World!";
+        testDirectoryPath = io::Path(std::string(argv0)).GetParentDirectory();
+
+        fileSystem = io::CreateFileSystem(testDirectoryPath);
+        ASSERT_NE(fileSystem, nullptr);
+        ASSERT_TRUE(fileSystem->AddSearchDirectory(testDirectoryPath));
+        ASSERT_TRUE(fileSystem->SetWriteDirectory(testDirectoryPath));
+    }
+
+    virtual void TearDown() override
+    {
+        // a failed assertion returns from the test body with the readers still running
+        StopReaders();
+
+        for (auto& directory : createdDirectories) {
+            fileSystem->Delete(directory.Append("marker.txt"s));
+            fileSystem->Delete(directory);
+        }
+    }
+
+    /// Reads the test file every way there is until stopped, counts anything that went wrong.
+    void StartReaders()
+    {
+        for (uint32_t i = 0; i < ReaderCount; i++) {
+            readers.emplace_back([this]() {
+                while (!stop) {
+                    auto file = fileSystem->OpenRead(readFilePath);
+                    std::string contents;
+
+                    if (!file || file->Read(contents) < 0 || contents != readFileContents)
+                        failures++;
+
+                    auto mapping = fileSystem->MapFile(readFilePath);
+                    if (!mapping || std::string((const char*)mapping->GetData(),
+                                                mapping->GetSize()) != readFileContents)
+                        failures++;
+
+                    if (!fileSystem->FileExists(readFilePath) ||
+                        fileSystem->GetWriteDirectory().AsString().empty())
+                        failures++;
+
+                    reads++;
+                }
+            });
+        }
+    }
+
+    /// Does nothing once the readers are stopped.
+    void StopReaders()
+    {
+        if (readers.empty())
+            return;
+
+        // make sure readers overlapped with the whole test body
+        while (reads < ReaderCount * 10) {
+            std::this_thread::yield();
+        }
+
+        stop = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        readers.clear();
+    }
+
+protected:
+    io::Path testDirectoryPath, readFilePath;
+    std::string readFileContents;
+    core::UniquePtr<io::IFileSystem> fileSystem;
+    core::Vector<io::Path> createdDirectories;
+
+    core::Vector<std::thread> readers;
+    std::atomic<bool> stop{ false };
+    std::atomic<uint32_t> reads{ 0 };
+    std::atomic<uint32_t> failures{ 0 };
+};
+
+TEST_F(FileSystemConcurrencyTest, ReadsSucceedWhileMountsChange)
+{
+    StartReaders();
+
+    for (uint32_t i = 0; i < 32; i++) {
+        io::Path directory("ConcurrencyMount"s + std::to_string(i) + "_" +
+                           Common::GetTimestampString());
+        ASSERT_TRUE(fileSystem->CreateDirectory(directory));
+        createdDirectories.push_back(directory);
+
+        auto marker = directory.Append("marker.txt"s);
+        ASSERT_NE(fileSystem->OpenWrite(marker), nullptr);
+
+        // newest mount has priority, the marker is visible without its directory
+        ASSERT_TRUE(fileSystem->AddSearchDirectory(testDirectoryPath.Append(directory)));
+        ASSERT_TRUE(fileSystem->FileExists("marker.txt"s));
+        ASSERT_TRUE(fileSystem->SetWriteDirectory(testDirectoryPath));
+    }
+
+    StopReaders();
+    ASSERT_EQ(failures, 0u);
+}
+
+TEST_F(FileSystemConcurrencyTest, InstancesShareOneInitialization)
+{
+    StartReaders();
+
+    for (uint32_t i = 0; i < 32; i++) {
+        auto other = io::CreateFileSystem(testDirectoryPath);
+        ASSERT_NE(other, nullptr);
+        ASSERT_TRUE(other->FileExists(readFilePath));
+    }
+
+    StopReaders();
+    ASSERT_EQ(failures, 0u);
+
+    // the last instance going away must not have torn down physfs
+    ASSERT_TRUE(fileSystem->FileExists(readFilePath));
+    ASSERT_NE(fileSystem->OpenRead(readFilePath), nullptr);
+}
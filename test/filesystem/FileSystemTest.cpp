@@ -1,6 +1,9 @@
 #include "Common.h"
+#include "filesystem/BlockCompression.h"
 #include "filesystem/IFileSystem.h"
 #include "gtest/gtest.h"
+#include <filesystem>
+#include <fstream>
 
 namespace {
 const char* argv0;
@@ -171,6 +174,27 @@ TEST_F(FileSystemTest, ByteBufferContentsReadFromFileAreCorrect)
     ASSERT_EQ(correctArray, testByteArray);
 }
 
+TEST_F(FileSystemTest, MappedContentsAreCorrect)
+{
+    auto mapping = fileSystem->MapFile(readFilePath);
+    ASSERT_NE(nullptr, mapping.get());
+
+    std::string mapped((const char*)mapping->GetData(), mapping->GetSize());
+    ASSERT_EQ(readFileContents, mapped);
+}
+
+TEST_F(FileSystemTest, CanMapEmptyFile)
+{
+    auto mapping = fileSystem->MapFile(emptyReadFile);
+    ASSERT_NE(nullptr, mapping.get());
+    ASSERT_EQ(0u, mapping->GetSize());
+}
+
+TEST_F(FileSystemTest, MappingMissingFileFails)
+{
+    ASSERT_EQ(nullptr, fileSystem->MapFile("testdata/DoesNotExist.txt"s));
+}
+
 TEST_F(FileSystemTest, CanRandomAccessFile)
 {
     auto file = fileSystem->OpenRead(readFilePath);
@@ -203,3 +227,113 @@ TEST_F(FileSystemTest, CanFindFileWithoutSpecifyingDirectoryAfterAddingSearchDir
     fileSystem->AddSearchDirectory(readFilePath.GetParentDirectory());
     ASSERT_TRUE(fileSystem->FileExists(readFilePath.GetFileName()));
 }
+
+TEST_F(FileSystemTest, DeletedFileIsNotFound)
+{
+    ASSERT_NE(nullptr, fileSystem->OpenWrite(writeFilePath));
+    ASSERT_TRUE(fileSystem->FileExists(writeFilePath));
+    ASSERT_TRUE(fileSystem->Delete(writeFilePath));
+    ASSERT_FALSE(fileSystem->FileExists(writeFilePath));
+    ASSERT_EQ(nullptr, fileSystem->OpenRead(writeFilePath));
+}
+
+TEST_F(FileSystemTest, FileInCreatedDirectoryIsFound)
+{
+    auto nestedPath = directoryPath.Append("nested"s);
+    auto filePath   = nestedPath.Append("file.txt"s);
+
+    ASSERT_TRUE(fileSystem->CreateDirectory(nestedPath));
+    ASSERT_TRUE(fileSystem->DirectoryExists(directoryPath));
+    ASSERT_NE(nullptr, fileSystem->OpenWrite(filePath));
+    ASSERT_TRUE(fileSystem->FileExists(filePath));
+    ASSERT_FALSE(fileSystem->DirectoryExists(filePath));
+
+    ASSERT_TRUE(fileSystem->Delete(filePath));
+    ASSERT_TRUE(fileSystem->Delete(nestedPath));
+}
+
+TEST_F(FileSystemTest, ExternallyAddedFileIsFoundAfterRescan)
+{
+    auto nativePath = testDirectoryPath.Append(writeFilePath).AsString();
+    std::ofstream(nativePath) << readFileContents;
+
+    ASSERT_FALSE(fileSystem->FileExists(writeFilePath));
+    fileSystem->RescanMounts();
+    ASSERT_TRUE(fileSystem->FileExists(writeFilePath));
+}
+
+TEST_F(FileSystemTest, FileBelowTheScanDepthIsFound)
+{
+    auto nestedPath = directoryPath;
+    for (int i = 0; i < 40; i++) {
+        nestedPath = nestedPath.Append("d"s);
+    }
+    auto filePath = nestedPath.Append("deep.txt"s);
+
+    std::filesystem::create_directories(testDirectoryPath.Append(nestedPath).AsString());
+    std::ofstream(testDirectoryPath.Append(filePath).AsString()) << readFileContents;
+    fileSystem->RescanMounts();
+
+    EXPECT_TRUE(fileSystem->FileExists(filePath));
+    EXPECT_FALSE(fileSystem->FileExists(nestedPath.Append("missing.txt"s)));
+    std::filesystem::remove_all(testDirectoryPath.Append(directoryPath).AsString());
+    fileSystem->RescanMounts();
+}
+
+TEST_F(FileSystemTest, CompressedFileIsReadTransparently)
+{
+    std::string contents;
+    for (uint32_t i = 0; i < 20000; i++) {
+        contents += "line " + std::to_string(i % 97) + "\n";
+    }
+
+    core::TByteArray compressed;
+    io::compression::CompressFile((const uint8_t*)contents.data(), contents.size(), compressed, 4096);
+    ASSERT_LT(compressed.size(), contents.size());
+    fileSystem->OpenWrite(writeFilePath)->Write(compressed);
+
+    auto file = fileSystem->OpenRead(writeFilePath);
+    ASSERT_NE(nullptr, file);
+    ASSERT_EQ((std::intmax_t)contents.size(), file->GetLength());
+
+    std::string read;
+    ASSERT_TRUE(file->Seek(50000));
+    ASSERT_EQ(file->Read(read, 10), 10);
+    ASSERT_EQ(contents.substr(50000, 10), read);
+    ASSERT_TRUE(file->Seek(0));
+    ASSERT_EQ((std::intmax_t)contents.size(), file->Read(read));
+    ASSERT_EQ(contents, read);
+
+    auto mapping = fileSystem->MapFile(writeFilePath);
+    ASSERT_NE(nullptr, mapping);
+    ASSERT_EQ(contents, std::string((const char*)mapping->GetData(), mapping->GetSize()));
+}
+
+TEST_F(FileSystemTest, NativeAndPhysfsReadsAgree)
+{
+    std::string contents;
+    for (uint32_t i = 0; i < 300000; i++) {
+        contents += (char)('a' + i * 7 % 26);
+    }
+    fileSystem->OpenWrite(writeFilePath)->Write(contents);
+
+    io::FileSystemOptions physfsOptions;
+    physfsOptions.NativeReads = false;
+    io::FileSystemOptions directOptions;
+    directOptions.DirectReadThreshold = 1;
+
+    for (auto& options : { physfsOptions, directOptions }) {
+        auto otherFileSystem = io::CreateFileSystem(testDirectoryPath, options);
+        auto file            = otherFileSystem->OpenRead(writeFilePath);
+        ASSERT_NE(nullptr, file);
+
+        // page aligned so the middle of the read can go around the page cache
+        core::UniquePtr<char, void (*)(void*)> buffer((char*)std::aligned_alloc(4096, 303104), std::free);
+        ASSERT_TRUE(file->Seek(100));
+        ASSERT_EQ(10, file->Read(buffer.get() + 100, 10));
+        ASSERT_EQ(contents.substr(100, 10), std::string(buffer.get() + 100, 10));
+        ASSERT_EQ((std::intmax_t)contents.size() - 110, file->Read(buffer.get() + 110));
+        ASSERT_EQ(contents.substr(100), std::string(buffer.get() + 100, contents.size() - 100));
+        ASSERT_EQ(0, file->Read(buffer.get(), 10));
+    }
+}
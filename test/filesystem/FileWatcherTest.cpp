@@ -0,0 +1,171 @@
+#include "Common.h"
+#include "filesystem/FileWatcher.h"
+#include "gtest/gtest.h"
+#include "resource_management/ResourceDependencies.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace {
+const char* argv0;
+const auto QuietPeriod = std::chrono::milliseconds(50);
+} // namespace
+
+int main(int argc, char** argv)
+{
+    argv0 = argv[0];
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class FileWatcherTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        ASSERT_NE(argv0, nullptr);
+
+        directory = Common::GetTempPath("file_watcher_test");
+        std::filesystem::create_directories(directory / "shaders");
+        std::filesystem::create_directories(directory / "textures");
+
+        for (auto name : { "shaders/lit.vert", "shaders/lit.frag", "shaders/sky.vert",
+                           "shaders/sky.frag", "textures/grass.png", "textures/rock.png" }) {
+            Write(name, "original");
+        }
+
+        fileSystem = io::CreateFileSystem(io::Path(std::string(argv0)));
+        ASSERT_NE(fileSystem, nullptr);
+        ASSERT_TRUE(fileSystem->AddSearchDirectory(directory.string()));
+
+        watcher = core::MakeUnique<io::FileWatcher>(fileSystem.get(), QuietPeriod);
+        ASSERT_TRUE(watcher->AddDirectory(directory.string()));
+    }
+
+    virtual void TearDown() override
+    {
+        watcher.reset();
+        fileSystem.reset();
+        std::filesystem::remove_all(directory);
+    }
+
+    void Write(const std::string& name, const std::string& contents)
+    {
+        std::ofstream(directory / name, std::ios::binary | std::ios::trunc) << contents;
+    }
+
+    /// Polls like a frame loop until changes arrive and settle, sorted.
+    core::Vector<std::string> WaitForChanges()
+    {
+        core::Vector<std::string> changed;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+        while (changed.empty() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            for (auto& path : watcher->TakeChanged()) {
+                changed.push_back(path.AsString());
+            }
+        }
+
+        std::sort(changed.begin(), changed.end());
+        return changed;
+    }
+
+    std::filesystem::path directory;
+    core::UniquePtr<io::IFileSystem> fileSystem;
+    core::UniquePtr<io::FileWatcher> watcher;
+};
+
+TEST_F(FileWatcherTest, NothingChangedReportsNothing)
+{
+    std::this_thread::sleep_for(QuietPeriod * 2);
+    ASSERT_TRUE(watcher->TakeChanged().empty());
+}
+
+TEST_F(FileWatcherTest, BurstOfWritesIsReportedOnce)
+{
+    for (uint32_t i = 0; i < 20; i++) {
+        Write("shaders/lit.frag", "edit " + std::to_string(i));
+    }
+
+    ASSERT_EQ(core::Vector<std::string>{ "shaders/lit.frag" }, WaitForChanges());
+
+    std::this_thread::sleep_for(QuietPeriod * 2);
+    ASSERT_TRUE(watcher->TakeChanged().empty());
+}
+
+TEST_F(FileWatcherTest, ChangeIsHeldBackUntilQuiet)
+{
+    Write("textures/rock.png", "edited");
+    ASSERT_TRUE(watcher->TakeChanged().empty());
+
+    ASSERT_EQ(core::Vector<std::string>{ "textures/rock.png" }, WaitForChanges());
+}
+
+TEST_F(FileWatcherTest, RenamedOverFileIsReported)
+{
+    // how most editors save
+    Write("shaders/sky.vert.tmp", "saved");
+    std::filesystem::rename(directory / "shaders/sky.vert.tmp", directory / "shaders/sky.vert");
+
+    auto changed = WaitForChanges();
+    ASSERT_NE(changed.end(), std::find(changed.begin(), changed.end(), "shaders/sky.vert"s));
+}
+
+TEST_F(FileWatcherTest, NewFilesAreVisibleInFileSystem)
+{
+    ASSERT_FALSE(fileSystem->FileExists("shaders/lit.geom"s));
+    std::filesystem::create_directories(directory / "shaders/new");
+    Write("shaders/lit.geom", "added");
+
+    ASSERT_EQ(core::Vector<std::string>{ "shaders/lit.geom" }, WaitForChanges());
+    ASSERT_TRUE(fileSystem->FileExists("shaders/lit.geom"s));
+
+    // directories created after the watch started are watched too
+    Write("shaders/new/water.frag", "added");
+    ASSERT_EQ(core::Vector<std::string>{ "shaders/new/water.frag" }, WaitForChanges());
+}
+
+TEST_F(FileWatcherTest, OnlyAffectedResourcesAreInvalidated)
+{
+    // programs built from their stages, materials from programs and textures
+    res::ResourceDependencies dependencies;
+    io::PathId lit("shaders/lit"s), sky("shaders/sky"s), grass("textures/grass.png"s),
+        rock("textures/rock.png"s), ground("materials/ground"s), skybox("materials/skybox"s);
+
+    for (auto stage : { ".vert", ".frag", ".geom" }) {
+        dependencies.Add(lit, io::PathId("shaders/lit"s + stage));
+        dependencies.Add(sky, io::PathId("shaders/sky"s + stage));
+    }
+    dependencies.Add(grass, grass);
+    dependencies.Add(rock, rock);
+    dependencies.Add(ground, lit);
+    dependencies.Add(ground, grass);
+    dependencies.Add(skybox, sky);
+
+    Write("shaders/lit.frag", "edited");
+    Write("textures/rock.png", "edited");
+
+    auto changed = WaitForChanges();
+    core::Vector<io::Path> changedPaths(changed.begin(), changed.end());
+    auto affected = dependencies.CollectAffected(changedPaths);
+
+    core::Vector<std::string> names;
+    for (auto id : affected) {
+        names.push_back(id.AsString());
+    }
+
+    // every resource before the ones built from it
+    auto position = [&](const std::string& name) {
+        return std::find(names.begin(), names.end(), name) - names.begin();
+    };
+    ASSERT_LT(position("shaders/lit"), position("materials/ground"));
+
+    std::sort(names.begin(), names.end());
+    ASSERT_EQ((core::Vector<std::string>{ "materials/ground", "shaders/lit", "textures/rock.png" }),
+              names);
+
+    dependencies.Remove(ground);
+    ASSERT_EQ(1u, dependencies.CollectAffected({ "shaders/lit.frag"s }).size());
+}
@@ -0,0 +1,105 @@
+#include "Common.h"
+#include "filesystem/IoBufferPool.h"
+#include "filesystem/MemoryFileReader.h"
+#include "gtest/gtest.h"
+#include <cstring>
+
+TEST(IoBufferPoolTest, BuffersAreAlignedAndRoundedToSizeClasses)
+{
+    auto pool = core::MakeShared<io::IoBufferPool>(1u << 20);
+
+    const std::pair<size_t, size_t> expected[] = {
+        { 0, 4096 }, { 1, 4096 }, { 4096, 4096 }, { 4097, 5120 }, { 8192, 8192 }, { 8193, 10240 }, { 100000, 114688 }
+    };
+
+    for (auto& sizes : expected) {
+        auto buffer = pool->Acquire(sizes.first);
+        EXPECT_EQ(sizes.first, buffer.GetSize());
+        EXPECT_EQ(sizes.second, buffer.GetCapacity());
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(buffer.GetData()) % io::IoBufferPool::Alignment);
+    }
+}
+
+TEST(IoBufferPoolTest, ReleasedBuffersAreReused)
+{
+    auto pool = core::MakeShared<io::IoBufferPool>(1u << 20);
+
+    uint8_t* data = nullptr;
+    {
+        auto buffer = pool->Acquire(20000);
+        data        = buffer.GetData();
+    }
+
+    auto sameClass = pool->Acquire(19000);
+    auto other     = pool->Acquire(40000);
+
+    EXPECT_EQ(data, sameClass.GetData());
+    EXPECT_NE(data, other.GetData());
+
+    auto stats = pool->GetStats();
+    EXPECT_EQ(3u, stats.Acquired);
+    EXPECT_EQ(2u, stats.Allocations);
+    EXPECT_EQ(0u, stats.RetainedBytes);
+}
+
+TEST(IoBufferPoolTest, RetainedBytesAreCapped)
+{
+    auto pool = core::MakeShared<io::IoBufferPool>(8192);
+    {
+        auto first  = pool->Acquire(8192);
+        auto second = pool->Acquire(8192);
+    }
+
+    EXPECT_EQ(8192u, pool->GetStats().RetainedBytes);
+}
+
+TEST(IoBufferPoolTest, BufferKeepsPoolAlive)
+{
+    auto pool   = core::MakeShared<io::IoBufferPool>(1u << 20);
+    auto buffer = pool->Acquire(100);
+    pool.reset();
+
+    std::memset(buffer.GetData(), 1, buffer.GetCapacity());
+    io::IoBuffer moved = core::Move(buffer);
+
+    EXPECT_EQ(nullptr, buffer.GetData());
+    EXPECT_EQ(100u, moved.GetSize());
+}
+
+TEST(IoBufferPoolTest, ReaderFillsBufferAndReusesIt)
+{
+    auto bytes = Common::MakePattern(50000);
+    core::UniquePtr<io::IFileReader> reader = core::MakeUnique<io::MemoryFileReader>(bytes);
+
+    io::IoBuffer buffer;
+    ASSERT_EQ(50000, reader->Read(buffer));
+    ASSERT_EQ(50000u, buffer.GetSize());
+    EXPECT_EQ(0, std::memcmp(bytes.data(), buffer.GetData(), bytes.size()));
+
+    auto data = buffer.GetData();
+    ASSERT_TRUE(reader->Seek(1000));
+    ASSERT_EQ(300, reader->Read(buffer, 300));
+    EXPECT_EQ(data, buffer.GetData());
+    EXPECT_EQ(300u, buffer.GetSize());
+    EXPECT_EQ(0, std::memcmp(bytes.data() + 1000, buffer.GetData(), 300));
+
+    ASSERT_TRUE(reader->Seek(bytes.size()));
+    EXPECT_EQ(0, reader->Read(buffer));
+    EXPECT_EQ(0u, buffer.GetSize());
+}
+
+TEST(IoBufferPoolTest, ReadAllMapsRestOfFile)
+{
+    auto pool  = core::MakeShared<io::IoBufferPool>(1u << 20);
+    auto bytes = Common::MakePattern(10000);
+    io::MemoryFileReader reader(bytes);
+    reader.Seek(16);
+
+    auto mapping = pool->ReadAll(&reader);
+    ASSERT_NE(nullptr, mapping);
+    ASSERT_EQ(bytes.size() - 16, mapping->GetSize());
+    EXPECT_EQ(0, std::memcmp(bytes.data() + 16, mapping->GetData(), mapping->GetSize()));
+
+    mapping.reset();
+    EXPECT_EQ(10240u, pool->GetStats().RetainedBytes);
+}
@@ -0,0 +1,170 @@
+#include "filesystem/MemoryFileSystem.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+
+using namespace std::literals::string_literals;
+
+namespace {
+core::TByteArray ToBytes(const std::string& string)
+{
+    return core::TByteArray(string.begin(), string.end());
+}
+
+std::string ReadAll(io::IFileSystem& fileSystem, const io::Path& path)
+{
+    auto file = fileSystem.OpenRead(path);
+    std::string contents;
+
+    if (!file || file->Read(contents) < 0)
+        return "<failed>";
+    return contents;
+}
+
+core::Vector<std::string> List(io::IFileSystem& fileSystem, const io::Path& directory)
+{
+    core::Vector<std::string> names;
+    for (auto& path : fileSystem.GetFilesInDirectory(directory)) {
+        names.push_back(path.AsString());
+    }
+
+    std::sort(names.begin(), names.end());
+    return names;
+}
+} // namespace
+
+class MemoryFileSystemTest : public ::testing::Test
+{
+protected:
+    io::MemoryFileSystem fileSystem;
+};
+
+TEST_F(MemoryFileSystemTest, AddedFilesCanBeRead)
+{
+    fileSystem.AddFile("shaders/basic.vert"s, ToBytes("void main() {}"));
+
+    ASSERT_TRUE(fileSystem.FileExists("shaders/basic.vert"s));
+    ASSERT_TRUE(fileSystem.FileExists("/shaders/basic.vert"s));
+    ASSERT_TRUE(fileSystem.DirectoryExists("shaders"s));
+    ASSERT_FALSE(fileSystem.FileExists("shaders"s));
+    ASSERT_FALSE(fileSystem.FileExists("shaders/basic.frag"s));
+    ASSERT_EQ(fileSystem.OpenRead("shaders/basic.frag"s), nullptr);
+
+    ASSERT_EQ(ReadAll(fileSystem, "shaders\\basic.vert"s), "void main() {}");
+    ASSERT_TRUE(fileSystem.GetNativePath("shaders/basic.vert"s).empty());
+}
+
+TEST_F(MemoryFileSystemTest, WrittenFilesCanBeRead)
+{
+    ASSERT_EQ(fileSystem.OpenWrite("missing/file.txt"s), nullptr);
+    ASSERT_TRUE(fileSystem.CreateDirectory("logs/old"s));
+
+    {
+        auto writer = fileSystem.OpenWrite("logs/game.log"s);
+        ASSERT_NE(writer, nullptr);
+        ASSERT_TRUE(fileSystem.FileExists("logs/game.log"s));
+
+        writer->Write("Hello World"s);
+        ASSERT_TRUE(writer->Seek(6));
+        writer->Write("There"s);
+        ASSERT_TRUE(writer->Flush());
+        ASSERT_EQ(ReadAll(fileSystem, "logs/game.log"s), "Hello There");
+    }
+
+    fileSystem.OpenWrite("logs/game.log"s, true)->Write("!"s);
+    ASSERT_EQ(ReadAll(fileSystem, "logs/game.log"s), "Hello There!");
+
+    fileSystem.OpenWrite("logs/game.log"s)->Write("new"s);
+    ASSERT_EQ(ReadAll(fileSystem, "logs/game.log"s), "new");
+}
+
+TEST_F(MemoryFileSystemTest, ReadersKeepContentsWhenReplaced)
+{
+    fileSystem.AddFile("config.json"s, ToBytes("old"));
+    auto reader  = fileSystem.OpenRead("config.json"s);
+    auto mapping = fileSystem.MapFile("config.json"s);
+
+    fileSystem.AddFile("config.json"s, ToBytes("new"));
+    ASSERT_TRUE(fileSystem.Delete("config.json"s));
+    ASSERT_FALSE(fileSystem.FileExists("config.json"s));
+
+    std::string contents;
+    ASSERT_EQ(reader->Read(contents), 3);
+    ASSERT_EQ(contents, "old");
+    ASSERT_EQ(std::string((const char*)mapping->GetData(), mapping->GetSize()), "old");
+}
+
+TEST_F(MemoryFileSystemTest, DirectoriesAreListedAndDeletedWhenEmpty)
+{
+    fileSystem.AddFile("textures/a.png"s, core::TByteArray());
+    fileSystem.AddFile("textures/ui/b.png"s, core::TByteArray());
+
+    ASSERT_EQ(List(fileSystem, "textures"s),
+              (core::Vector<std::string>{ "textures/a.png", "textures/ui" }));
+    ASSERT_EQ(List(fileSystem, ""s), (core::Vector<std::string>{ "textures" }));
+
+    ASSERT_FALSE(fileSystem.Delete("textures/ui"s));
+    ASSERT_TRUE(fileSystem.Delete("textures/ui/b.png"s));
+    ASSERT_TRUE(fileSystem.Delete("textures/ui"s));
+    ASSERT_FALSE(fileSystem.DirectoryExists("textures/ui"s));
+    ASSERT_EQ(List(fileSystem, "textures"s), (core::Vector<std::string>{ "textures/a.png" }));
+}
+
+TEST_F(MemoryFileSystemTest, MountedBlobIsNotCopied)
+{
+    auto blob = core::MakeShared<const core::TByteArray>(ToBytes("firstsecond"));
+
+    ASSERT_FALSE(fileSystem.MountBlob("pack"s, blob, { { "bad.bin"s, 8, 4 } }));
+    ASSERT_FALSE(fileSystem.FileExists("pack/bad.bin"s));
+
+    ASSERT_TRUE(fileSystem.MountBlob("pack"s, blob, { { "first.bin"s, 0, 5 }, { "sub/second.bin"s, 5, 6 } }));
+    ASSERT_EQ(ReadAll(fileSystem, "pack/first.bin"s), "first");
+    ASSERT_EQ(ReadAll(fileSystem, "pack/sub/second.bin"s), "second");
+
+    auto mapping = fileSystem.MapFile("pack/sub/second.bin"s);
+    ASSERT_EQ(mapping->GetData(), blob->data() + 5);
+    ASSERT_EQ(mapping->GetSize(), 6u);
+}
+
+TEST(MemoryFileSystemOverlayTest, MemoryShadowsFallback)
+{
+    auto fallback = core::MakeUnique<io::MemoryFileSystem>();
+    fallback->AddFile("startup/logo.png"s, ToBytes("disk logo"));
+    fallback->AddFile("level.bin"s, ToBytes("level"));
+
+    auto fallbackPtr = fallback.get();
+    io::MemoryFileSystem overlay(core::Move(fallback));
+    overlay.AddFile("level.bin"s, ToBytes("patched level"));
+
+    ASSERT_EQ(ReadAll(overlay, "level.bin"s), "patched level");
+    ASSERT_EQ(ReadAll(overlay, "startup/logo.png"s), "disk logo");
+    ASSERT_EQ(List(overlay, ""s), (core::Vector<std::string>{ "level.bin", "startup" }));
+
+    // pinned files stay readable after the fallback lost them
+    ASSERT_TRUE(overlay.Pin("startup/logo.png"s));
+    ASSERT_FALSE(overlay.Pin("startup/missing.png"s));
+    ASSERT_TRUE(fallbackPtr->Delete("startup/logo.png"s));
+    ASSERT_EQ(ReadAll(overlay, "startup/logo.png"s), "disk logo");
+
+    // writes go to the fallback
+    overlay.OpenWrite("save.dat"s)->Write("saved"s);
+    ASSERT_TRUE(fallbackPtr->FileExists("save.dat"s));
+    ASSERT_EQ(ReadAll(overlay, "save.dat"s), "saved");
+}
+
+TEST(MemoryFileSystemOverlayTest, WritesReplaceMemoryCopies)
+{
+    auto fallback = core::MakeUnique<io::MemoryFileSystem>();
+    fallback->AddFile("config.json"s, ToBytes("disk config"));
+
+    io::MemoryFileSystem overlay(core::Move(fallback));
+    overlay.AddFile("save.dat"s, ToBytes("old save"));
+    ASSERT_TRUE(overlay.Pin("config.json"s));
+
+    overlay.OpenWrite("save.dat"s)->Write("new save"s);
+    ASSERT_EQ(ReadAll(overlay, "save.dat"s), "new save");
+    ASSERT_EQ(std::string((const char*)overlay.MapFile("save.dat"s)->GetData(), 8), "new save");
+
+    overlay.OpenWrite("config.json"s, true)->Write(", edited"s);
+    ASSERT_EQ(ReadAll(overlay, "config.json"s), "disk config, edited");
+    ASSERT_EQ(List(overlay, ""s), (core::Vector<std::string>{ "config.json", "save.dat" }));
+}
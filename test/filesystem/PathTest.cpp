@@ -1,4 +1,5 @@
 #include "filesystem/Path.h"
+#include "filesystem/PathId.h"
 #include "gtest/gtest.h"
 #include <iostream>
 
@@ -139,4 +140,37 @@ TEST_F(PathTest, DirSeparatorsAreNormalizedOnConstruction)
 
     ASSERT_EQ(goodPath, Path(badUnixSeparatorPath));
     ASSERT_EQ(goodPath, Path(badWinSeparatorPath));
-}
\ No newline at end of file
+}
+TEST_F(PathTest, ViewsMatchAllocatingAccessors)
+{
+    for (auto& string : { absolutePath, relativePath, emptyPath, unixRootPath,
+                          absolutePath + path::Separator + fileNameWithExtension }) {
+        Path path(string);
+
+        ASSERT_EQ(path.GetFileName().AsString(), path.GetFileNameView());
+        ASSERT_EQ(path.GetExtension().AsString(), path.GetExtensionView());
+        ASSERT_EQ(path.GetParentDirectory().AsString(), path.GetParentDirectoryView());
+    }
+}
+
+TEST_F(PathTest, InternedPathsShareId)
+{
+    PathId first(Path(relativePath).Append(fileNameWithExtension));
+    PathId second(relativePath + "\\" + fileNameWithExtension);
+
+    ASSERT_FALSE(first.IsEmpty());
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(first.GetHash(), second.GetHash());
+    ASSERT_EQ(Path(relativePath).Append(fileNameWithExtension).AsString(), first.AsString());
+    ASSERT_NE(first, PathId(absolutePath));
+}
+
+TEST_F(PathTest, FindDoesNotIntern)
+{
+    auto name = "never/interned/" + fileNameWithExtension;
+
+    ASSERT_TRUE(PathId::Find(name).IsEmpty());
+    PathId id(name);
+    ASSERT_EQ(id, PathId::Find(name));
+    ASSERT_TRUE(PathId(emptyPath).IsEmpty());
+}
@@ -0,0 +1,123 @@
+#include "Common.h"
+#include "filesystem/MemoryFileReader.h"
+#include "filesystem/StreamingFileReader.h"
+#include "gtest/gtest.h"
+
+namespace {
+/// Serves a file whose reads start failing past 'failAt'.
+class FailingFileReader : public io::MemoryFileReader
+{
+public:
+    FailingFileReader(core::TByteArray data, std::uintmax_t failAt)
+        : io::MemoryFileReader(core::Move(data))
+        , failAt(failAt)
+    {
+    }
+
+    std::intmax_t Read(void* buffer, std::uintmax_t size) override
+    {
+        if ((std::uintmax_t)GetPosition() >= failAt)
+            return -1;
+
+        return io::MemoryFileReader::Read(buffer, size);
+    }
+
+private:
+    std::uintmax_t failAt;
+};
+} // namespace
+
+class StreamingFileReaderTest : public ::testing::Test
+{
+protected:
+    core::UniquePtr<io::StreamingFileReader> Open(size_t chunkSize, uint32_t chunkCount)
+    {
+        return core::MakeUnique<io::StreamingFileReader>(
+            core::MakeUnique<io::MemoryFileReader>(contents), chunkSize, chunkCount);
+    }
+
+    core::TByteArray Slice(std::uintmax_t offset, std::uintmax_t size)
+    {
+        return core::TByteArray(contents.begin() + offset, contents.begin() + offset + size);
+    }
+
+    core::TByteArray contents = Common::MakePattern(100000);
+};
+
+TEST_F(StreamingFileReaderTest, SequentialReadsMatchFile)
+{
+    for (uint32_t chunkCount : { 2u, 3u }) {
+        auto reader = Open(4096, chunkCount);
+        core::TByteArray read, part;
+
+        ASSERT_EQ(reader->GetLength(), (std::intmax_t)contents.size());
+
+        // odd sizes so reads straddle chunk boundaries
+        while (reader->Read(part, 1237) > 0) {
+            read.insert(read.end(), part.begin(), part.end());
+        }
+
+        ASSERT_EQ(read, contents);
+        ASSERT_EQ(reader->GetPosition(), (std::intmax_t)contents.size());
+        ASSERT_EQ(reader->Read(part, 10), 0);
+
+        auto stats = reader->GetStats();
+        ASSERT_EQ(stats.BytesRead, contents.size());
+        ASSERT_EQ(stats.BytesPrefetched, contents.size());
+    }
+}
+
+TEST_F(StreamingFileReaderTest, SeeksInsideAndOutsideWindow)
+{
+    auto reader = Open(4096, 3);
+    core::TByteArray part;
+
+    ASSERT_EQ(reader->Read(part, 5000), 5000);
+    ASSERT_EQ(part, Slice(0, 5000));
+
+    // back into the current chunk and forward into one that may be prefetched
+    ASSERT_TRUE(reader->Seek(4500));
+    ASSERT_EQ(reader->Read(part, 100), 100);
+    ASSERT_EQ(part, Slice(4500, 100));
+    ASSERT_TRUE(reader->Seek(9000));
+    ASSERT_EQ(reader->Read(part, 100), 100);
+    ASSERT_EQ(part, Slice(9000, 100));
+
+    // far outside restarts the read-ahead
+    ASSERT_TRUE(reader->Seek(80001));
+    ASSERT_EQ(reader->Read(part, 10000), 10000);
+    ASSERT_EQ(part, Slice(80001, 10000));
+    ASSERT_TRUE(reader->Seek(3));
+    ASSERT_EQ(reader->Read(part, 10), 10);
+    ASSERT_EQ(part, Slice(3, 10));
+
+    ASSERT_FALSE(reader->Seek(contents.size() + 1));
+    ASSERT_TRUE(reader->Seek(contents.size()));
+    ASSERT_EQ(reader->Read(part), 0);
+}
+
+TEST_F(StreamingFileReaderTest, ReadFailureIsReported)
+{
+    io::StreamingFileReader reader(core::MakeUnique<FailingFileReader>(contents, 8192), 4096, 2);
+    core::TByteArray part;
+
+    ASSERT_EQ(reader.Read(part, 8192), 8192);
+    ASSERT_EQ(part, Slice(0, 8192));
+    ASSERT_EQ(reader.Read(part, 10), -1);
+    ASSERT_TRUE(part.empty());
+
+    // seeking back gives the read-ahead another chance
+    ASSERT_TRUE(reader.Seek(100));
+    ASSERT_EQ(reader.Read(part, 10), 10);
+    ASSERT_EQ(part, Slice(100, 10));
+}
+
+TEST_F(StreamingFileReaderTest, MissingReaderFails)
+{
+    io::StreamingFileReader reader(nullptr);
+    std::string text;
+
+    ASSERT_EQ(reader.GetLength(), -1);
+    ASSERT_EQ(reader.Read(text), -1);
+    ASSERT_FALSE(reader.Seek(0));
+}
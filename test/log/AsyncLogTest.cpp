@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+/// Keeps what reached it, optionally holds the log thread in the first Log call until released.
+class RecordingStream : public elog::ILogStream
+{
+public:
+    void Log(const elog::LogSource, const elog::LogSeverity severity,
+             const core::String& logString) override
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        records.push_back(logString);
+        severities.push_back(severity);
+        entered = true;
+        condition.notify_all();
+        condition.wait(lock, [this]() { return !hold; });
+    }
+
+    /// The next Log call blocks until Release.
+    void Hold()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        hold    = true;
+        entered = false;
+    }
+
+    void WaitUntilEntered()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return entered; });
+    }
+
+    void Release()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        hold = false;
+        condition.notify_all();
+    }
+
+    core::Vector<core::String> Records()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return records;
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    core::Vector<core::String> records;
+    core::Vector<elog::LogSeverity> severities;
+    bool hold    = false;
+    bool entered = false;
+};
+
+class AsyncLogTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        stream = core::MakeShared<RecordingStream>();
+        elog::AddLogStream(stream);
+    }
+
+    virtual void TearDown() override
+    {
+        stream->Release();
+        elog::StopAsyncLogging();
+        elog::ClearStreams();
+    }
+
+    core::SharedPtr<RecordingStream> stream;
+};
+} // namespace
+
+TEST_F(AsyncLogTest, KeepsOrderPerThread)
+{
+    const uint32_t PerThread = 5000;
+    elog::StartAsyncLogging();
+
+    core::Vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; t++) {
+        threads.emplace_back([t]() {
+            for (uint32_t i = 0; i < PerThread; i++) {
+                elog::LogInfo(std::to_string(t) + " " + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    elog::FlushLog();
+
+    auto records = stream->Records();
+    ASSERT_EQ(records.size(), 4 * PerThread);
+
+    uint32_t next[4] = {};
+    for (auto& record : records) {
+        auto t = std::stoul(record.substr(0, 1));
+        ASSERT_EQ(record, std::to_string(t) + " " + std::to_string(next[t]++));
+    }
+}
+
+TEST_F(AsyncLogTest, CountsAndReportsDroppedRecords)
+{
+    elog::AsyncLogOptions options;
+    options.Capacity = 16;
+    options.Overflow = elog::LogOverflowPolicy::DropAndCount;
+    elog::StartAsyncLogging(options);
+
+    stream->Hold();
+    elog::LogInfo("first");
+    stream->WaitUntilEntered();
+
+    // the log thread is stuck in the stream, the ring takes 16 more records
+    auto droppedBefore = elog::GetDroppedLogCount();
+    for (uint32_t i = 0; i < 20; i++) {
+        elog::LogInfo(std::to_string(i));
+    }
+    ASSERT_EQ(elog::GetDroppedLogCount() - droppedBefore, 4u);
+
+    stream->Release();
+    elog::FlushLog();
+
+    auto records = stream->Records();
+    ASSERT_EQ(records.size(), 18u);
+    ASSERT_EQ(records[0], "first");
+    for (uint32_t i = 0; i < 16; i++) {
+        ASSERT_EQ(records[i + 1], std::to_string(i));
+    }
+    ASSERT_EQ(records[17], "4 log messages were dropped, the log ring was full");
+    ASSERT_EQ(stream->severities[17], elog::LogSeverity::Warn);
+}
+
+TEST_F(AsyncLogTest, FlushWaitsAfterRestart)
+{
+    elog::StartAsyncLogging();
+    for (uint32_t i = 0; i < 100; i++) {
+        elog::LogInfo("before restart");
+    }
+    elog::StopAsyncLogging();
+
+    elog::StartAsyncLogging();
+    stream->Hold();
+    elog::LogInfo("after restart");
+    stream->WaitUntilEntered();
+
+    // the log thread holds the record, a flush returning now would have skipped it
+    std::atomic<bool> flushed{ false };
+    std::thread flusher([&]() {
+        elog::FlushLog();
+        flushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(flushed.load());
+
+    stream->Release();
+    flusher.join();
+    ASSERT_EQ(stream->Records().size(), 101u);
+    ASSERT_EQ(stream->Records().back(), "after restart");
+}
+
+TEST_F(AsyncLogTest, StopKeepsRecordsOfRacingProducers)
+{
+    const uint32_t PerThread = 20000;
+    std::atomic<bool> done{ false };
+
+    core::Vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; t++) {
+        threads.emplace_back([]() {
+            for (uint32_t i = 0; i < PerThread; i++) {
+                elog::LogInfo("racing");
+            }
+        });
+    }
+
+    // every stop races with producers that already decided to push
+    std::thread toggler([&]() {
+        while (!done.load()) {
+            elog::StartAsyncLogging();
+            elog::StopAsyncLogging();
+        }
+    });
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    toggler.join();
+
+    ASSERT_EQ(stream->Records().size(), 4 * PerThread);
+}
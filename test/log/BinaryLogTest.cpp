@@ -0,0 +1,198 @@
+#include "../Common.h"
+#include "gtest/gtest.h"
+#include "log/BinaryLogReader.h"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+class BinaryLogTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        path = Common::GetTempPath("binary_log_test");
+        sink = elog::BinaryLogSink::Open(path.string());
+        ASSERT_NE(sink, nullptr);
+        elog::SetBinaryLogSink(sink);
+    }
+
+    virtual void TearDown() override
+    {
+        elog::SetBinaryLogSink(nullptr);
+        elog::SetLogLevel(elog::LogSource::Engine, elog::LogSeverity::Debug);
+        std::filesystem::remove(path);
+    }
+
+    core::Vector<elog::BinaryLogRecord> ReadBack(bool expectError = false)
+    {
+        elog::SetBinaryLogSink(nullptr);
+
+        core::Vector<elog::BinaryLogRecord> records;
+        auto reader = elog::BinaryLogReader::Open(path.string());
+        EXPECT_NE(reader, nullptr);
+        if (!reader)
+            return records;
+
+        elog::BinaryLogRecord record;
+        while (reader->Next(record)) {
+            records.push_back(record);
+        }
+        EXPECT_EQ(reader->HasError(), expectError);
+        return records;
+    }
+
+    std::filesystem::path path;
+    core::SharedPtr<elog::BinaryLogSink> sink;
+};
+
+TEST_F(BinaryLogTest, ArgumentsRoundTrip)
+{
+    core::String name = "armature";
+    glm::vec3 head(1.5f, -2, 0.25f);
+
+    ELOG_INFO("bone {} of {}: {}, head {}, weight {:.2f}, scale {}, visible {}", -3, 70000u, name,
+              head, 0.125f, 2.5, true);
+    ELOG_WARNING("literal {} and pointer {}, axis {}", "text", name.c_str(), 'x');
+    ELOG_ERROR("no arguments");
+
+    auto records = ReadBack();
+    ASSERT_EQ(records.size(), 3u);
+
+    auto& bone = records[0];
+    EXPECT_EQ(bone.Severity, elog::LogSeverity::Info);
+    EXPECT_EQ(bone.Source, elog::LogSource::Engine);
+    ASSERT_EQ(bone.Arguments.size(), 7u);
+    EXPECT_EQ(bone.Arguments[0].Type, elog::LogArgType::Int);
+    EXPECT_EQ(bone.Arguments[0].Int, -3);
+    EXPECT_EQ(bone.Arguments[1].Type, elog::LogArgType::UInt);
+    EXPECT_EQ(bone.Arguments[1].UInt, 70000u);
+    EXPECT_EQ(bone.Arguments[2].Text, name);
+    EXPECT_EQ(bone.Arguments[3].Vec3, head);
+    EXPECT_EQ(bone.Arguments[4].Type, elog::LogArgType::Float);
+    EXPECT_EQ(bone.Arguments[5].Type, elog::LogArgType::Double);
+    EXPECT_EQ(bone.Arguments[6].Type, elog::LogArgType::Bool);
+    EXPECT_EQ(elog::BinaryLogReader::FormatMessage(bone),
+              core::string::format("bone {} of {}: {}, head {}, weight {:.2f}, scale {}, visible {}",
+                                   -3, 70000u, name, head, 0.125f, 2.5, true));
+
+    EXPECT_EQ(elog::BinaryLogReader::FormatMessage(records[1]),
+              "literal text and pointer armature, axis x");
+    EXPECT_EQ(records[1].Arguments[2].Type, elog::LogArgType::String);
+    EXPECT_EQ(records[1].Severity, elog::LogSeverity::Warn);
+    EXPECT_EQ(elog::BinaryLogReader::FormatMessage(records[2]), "no arguments");
+    EXPECT_LE(records[0].Time, records[2].Time);
+}
+
+TEST_F(BinaryLogTest, TextRecordsAndFilteredStatements)
+{
+    elog::AddLogStream(sink);
+    elog::SetLogLevel(elog::LogSource::Engine, elog::LogSeverity::Warn);
+
+    ELOG_INFO("filtered {}", 1);
+    ELOG_WARNING("kept {}", 2);
+    elog::LogWarning("already formatted");
+
+    auto records = ReadBack();
+    elog::ClearStreams();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(elog::BinaryLogReader::FormatMessage(records[0]), "kept 2");
+    EXPECT_EQ(records[1].Format, "{}");
+    EXPECT_EQ(elog::BinaryLogReader::FormatMessage(records[1]), "already formatted");
+}
+
+TEST_F(BinaryLogTest, TextRecordsStayBufferedUntilAnError)
+{
+    elog::AddLogStream(sink);
+
+    for (uint32_t i = 0; i < 100; i++) {
+        elog::LogInfo("buffered text record");
+    }
+    EXPECT_EQ(std::filesystem::file_size(path), 0u);
+
+    elog::LogError("written right away");
+    EXPECT_EQ(std::filesystem::file_size(path), sink->GetBytesWritten());
+
+    auto records = ReadBack();
+    elog::ClearStreams();
+    EXPECT_EQ(records.size(), 101u);
+}
+
+TEST_F(BinaryLogTest, ThreadsGetTheirOwnIndex)
+{
+    const uint32_t PerThread = 1000;
+    core::Vector<std::thread> threads;
+
+    for (uint32_t t = 0; t < 4; t++) {
+        threads.emplace_back([t]() {
+            for (uint32_t i = 0; i < PerThread; i++) {
+                ELOG_INFO("thread {} record {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto records = ReadBack();
+    ASSERT_EQ(records.size(), 4 * PerThread);
+
+    core::UnorderedMap<uint64_t, uint32_t> threadOf;
+    core::UnorderedMap<uint64_t, uint64_t> next;
+    for (auto& record : records) {
+        auto t = record.Arguments[0].UInt;
+        if (!threadOf.count(t))
+            threadOf[t] = record.Thread;
+        EXPECT_EQ(threadOf[t], record.Thread);
+        EXPECT_EQ(record.Arguments[1].UInt, next[t]++);
+    }
+    EXPECT_EQ(threadOf.size(), 4u);
+}
+
+TEST_F(BinaryLogTest, TruncatedFileKeepsCompleteRecords)
+{
+    for (uint32_t i = 0; i < 10; i++) {
+        ELOG_INFO("record {} of a truncated log", i);
+    }
+    elog::SetBinaryLogSink(nullptr);
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+    auto records = ReadBack(true);
+    EXPECT_EQ(records.size(), 9u);
+}
+
+TEST_F(BinaryLogTest, RejectsOtherFiles)
+{
+    elog::SetBinaryLogSink(nullptr);
+    std::ofstream(path) << "Engine log: plain text";
+
+    EXPECT_EQ(elog::BinaryLogReader::Open(path.string()), nullptr);
+}
+
+TEST_F(BinaryLogTest, CorruptFormatTablesAreErrors)
+{
+    elog::SetBinaryLogSink(nullptr);
+
+    auto writeFormat = [&](uint64_t id, uint64_t count) {
+        core::Vector<uint8_t> data(std::begin(elog::detail::BinaryLogMagic),
+                                   std::end(elog::detail::BinaryLogMagic));
+        data.resize(data.size() + sizeof(uint32_t) + sizeof(uint64_t));
+        memcpy(data.data() + sizeof(elog::detail::BinaryLogMagic), &elog::detail::BinaryLogVersion,
+               sizeof(uint32_t));
+
+        data.push_back(elog::detail::BinaryLogFormatTag);
+        elog::detail::WriteVarint(data, id);
+        elog::detail::WriteVarint(data, count);
+        data.push_back(0);
+        elog::detail::WriteString(data, "{}", 2);
+        std::ofstream(path, std::ios::binary).write((const char*)data.data(), data.size());
+    };
+
+    // argument count and id both would size allocations from corrupt data
+    writeFormat(1, 1ull << 40);
+    EXPECT_TRUE(ReadBack(true).empty());
+    writeFormat(1ull << 31, 1);
+    EXPECT_TRUE(ReadBack(true).empty());
+    writeFormat(1, 1);
+    EXPECT_TRUE(ReadBack().empty());
+}
@@ -0,0 +1,119 @@
+#include "render/BaseMesh.h"
+#include "render/Meshlet.h"
+#include "resource_management/mesh/MeshletBuilder.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <array>
+#include <set>
+
+namespace {
+/// Flat grid in the xy plane facing +z, side*side quads.
+void MakeGrid(render::BaseMesh& mesh, uint32_t side)
+{
+    for (uint32_t y = 0; y <= side; y++) {
+        for (uint32_t x = 0; x <= side; x++) {
+            mesh.VertexBuffer.push_back(glm::vec3((float)x, (float)y, 0));
+        }
+    }
+
+    for (uint32_t y = 0; y < side; y++) {
+        for (uint32_t x = 0; x < side; x++) {
+            uint32_t a = y * (side + 1) + x, b = a + side + 1;
+            mesh.IndexBuffer.insert(mesh.IndexBuffer.end(), { a, a + 1, b, a + 1, b + 1, b });
+        }
+    }
+}
+
+std::multiset<std::array<uint32_t, 3>> Triangles(const core::Vector<uint32_t>& indices)
+{
+    std::multiset<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        triangles.insert({ indices[i], indices[i + 1], indices[i + 2] });
+    }
+    return triangles;
+}
+
+render::Meshlet MakeMeshlet(uint32_t offset, glm::vec3 center, glm::vec3 axis, float cutoff)
+{
+    render::Meshlet meshlet{};
+    meshlet.IndexOffset = offset;
+    meshlet.IndexCount  = 3;
+    meshlet.Center      = center;
+    meshlet.Radius      = 0.1f;
+    meshlet.ConeAxis    = axis;
+    meshlet.ConeCutoff  = cutoff;
+    return meshlet;
+}
+} // namespace
+
+TEST(MeshletTest, BuildRespectsLimitsAndKeepsTriangles)
+{
+    render::BaseMesh mesh;
+    MakeGrid(mesh, 40);
+    auto original = Triangles(mesh.IndexBuffer);
+
+    ASSERT_TRUE(res::mesh::MeshletBuilder::Build(mesh));
+    ASSERT_EQ(Triangles(mesh.IndexBuffer), original);
+
+    uint32_t nextOffset = 0;
+    for (const auto& meshlet : mesh.Meshlets) {
+        ASSERT_EQ(meshlet.IndexOffset, nextOffset);
+        ASSERT_LE(meshlet.IndexCount, 124u * 3);
+        nextOffset += meshlet.IndexCount;
+
+        std::set<uint32_t> vertices(mesh.IndexBuffer.begin() + meshlet.IndexOffset,
+                                    mesh.IndexBuffer.begin() + nextOffset);
+        ASSERT_EQ(vertices.size(), meshlet.VertexCount);
+        ASSERT_LE(meshlet.VertexCount, 64u);
+
+        // flat grid, every cluster is a single facing direction
+        ASSERT_NEAR(std::abs(meshlet.ConeAxis.z), 1.f, 1e-5f);
+        ASSERT_NEAR(meshlet.ConeCutoff, 0.f, 1e-3f);
+    }
+    ASSERT_EQ(nextOffset, mesh.IndexBuffer.size());
+
+    // a connected grid should fill clusters well, 3200 triangles fit in under 100 of them
+    ASSERT_LT(mesh.Meshlets.size(), 100u);
+}
+
+TEST(MeshletTest, SmallMeshesStayWhole)
+{
+    render::BaseMesh mesh;
+    MakeGrid(mesh, 4);
+    auto indices = mesh.IndexBuffer;
+
+    ASSERT_FALSE(res::mesh::MeshletBuilder::Build(mesh));
+    ASSERT_TRUE(mesh.Meshlets.empty());
+    ASSERT_EQ(mesh.IndexBuffer, indices);
+}
+
+TEST(MeshletTest, CullRemovesOutsideAndBackfacing)
+{
+    // identity matrix makes the frustum the [-1, 1] cube
+    glm::mat4 mvp(0.f);
+    for (int i = 0; i < 4; i++) {
+        mvp[i][i] = 1;
+    }
+
+    core::Vector<render::Meshlet> meshlets = {
+        MakeMeshlet(0, glm::vec3(0, 0, 0), glm::vec3(0, 0, 1), 0),
+        MakeMeshlet(3, glm::vec3(0.5f, 0, 0), glm::vec3(0, 0, 1), 0),
+        MakeMeshlet(6, glm::vec3(5, 0, 0), glm::vec3(0, 0, 1), 0),
+        MakeMeshlet(9, glm::vec3(0, 0.5f, 0), glm::vec3(0, 0, -1), 0),
+        MakeMeshlet(12, glm::vec3(0, -0.5f, 0), glm::vec3(0, 0, -1), 1),
+    };
+
+    core::Vector<render::DrawRange> ranges;
+    auto stats = render::CullMeshlets(meshlets, mvp, glm::vec3(0, 0, 5), ranges);
+
+    ASSERT_EQ(stats.Visible, 3u);
+    ASSERT_EQ(stats.FrustumCulled, 1u);
+    ASSERT_EQ(stats.ConeCulled, 1u);
+
+    // first two are adjacent and merge into one draw
+    ASSERT_EQ(ranges.size(), 2u);
+    ASSERT_EQ(ranges[0].IndexOffset, 0u);
+    ASSERT_EQ(ranges[0].IndexCount, 6u);
+    ASSERT_EQ(ranges[1].IndexOffset, 12u);
+    ASSERT_EQ(ranges[1].IndexCount, 3u);
+}
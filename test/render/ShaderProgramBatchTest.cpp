@@ -0,0 +1,173 @@
+#include "render/ShaderProgramBatch.h"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_literals;
+
+namespace {
+/// Records every call, sources containing "error" fail to compile, "nolink" fail to link.
+class StubShaderCompiler : public render::IShaderCompiler
+{
+public:
+    uint32_t CompileShader(render::ShaderStage stage, const core::String& source) override
+    {
+        calls.push_back("compile");
+        uint32_t handle = nextHandle++;
+        compileStatus[handle] = source.find("error") == core::String::npos;
+        linkStatus[handle]    = source.find("nolink") == core::String::npos;
+        return handle;
+    }
+
+    uint32_t LinkProgram(const render::ShaderStageHandles& shaders) override
+    {
+        calls.push_back("link");
+        uint32_t handle = nextHandle++;
+        bool linked     = true;
+        for (auto shader : shaders) {
+            if (shader)
+                linked = linked && compileStatus[shader] && linkStatus[shader];
+        }
+        linkStatus[handle] = linked;
+        return handle;
+    }
+
+    bool IsProgramReady(uint32_t program) override
+    {
+        calls.push_back("ready");
+        return readyPrograms;
+    }
+
+    bool GetShaderStatus(uint32_t shader, core::String& log) override
+    {
+        calls.push_back("shader_status");
+        log = "stub compile error";
+        return compileStatus[shader];
+    }
+
+    bool GetProgramStatus(uint32_t program, core::String& log) override
+    {
+        calls.push_back("program_status");
+        log = "stub link error";
+        return linkStatus[program];
+    }
+
+    void DetachShaders(uint32_t program, const render::ShaderStageHandles& shaders) override
+    {
+        calls.push_back("detach");
+    }
+
+    void DeleteShader(uint32_t shader) override
+    {
+        deletedShaders.push_back(shader);
+    }
+
+    void DeleteProgram(uint32_t program) override
+    {
+        deletedPrograms.push_back(program);
+    }
+
+    std::size_t CountCalls(const std::string& name) const
+    {
+        return std::count(calls.begin(), calls.end(), name);
+    }
+
+    std::size_t FirstCall(const std::string& name) const
+    {
+        return std::find(calls.begin(), calls.end(), name) - calls.begin();
+    }
+
+    std::size_t LastCall(const std::string& name) const
+    {
+        return calls.rend() - std::find(calls.rbegin(), calls.rend(), name) - 1;
+    }
+
+    uint32_t nextHandle = 1;
+    bool readyPrograms  = true;
+    std::vector<std::string> calls;
+    std::vector<uint32_t> deletedShaders, deletedPrograms;
+    std::unordered_map<uint32_t, bool> compileStatus, linkStatus;
+};
+} // namespace
+
+class ShaderProgramBatchTest : public ::testing::Test
+{
+protected:
+    render::ShaderProgramSource MakeSource(const std::string& vert, const std::string& frag,
+                                           const std::string& geom = ""s)
+    {
+        return render::ShaderProgramSource{ vert, frag, geom };
+    }
+
+protected:
+    StubShaderCompiler compiler;
+};
+
+TEST_F(ShaderProgramBatchTest, SubmitsAllWorkBeforeQueryingStatus)
+{
+    render::ShaderProgramBatch batch(&compiler);
+    for (int i = 0; i < 8; i++)
+        batch.Add(MakeSource("vert"s, "frag"s, "geom"s));
+
+    batch.Submit();
+    ASSERT_EQ(0u, compiler.CountCalls("shader_status"));
+    ASSERT_EQ(0u, compiler.CountCalls("program_status"));
+
+    auto programs = batch.Finish();
+    ASSERT_EQ(8u, programs.size());
+    ASSERT_EQ(24u, compiler.CountCalls("compile"));
+    ASSERT_EQ(8u, compiler.CountCalls("link"));
+    ASSERT_LT(compiler.LastCall("compile"), compiler.FirstCall("link"));
+    ASSERT_LT(compiler.LastCall("link"), compiler.FirstCall("shader_status"));
+    ASSERT_LT(compiler.LastCall("link"), compiler.FirstCall("program_status"));
+
+    for (const auto& program : programs)
+        ASSERT_TRUE(program.Linked);
+}
+
+TEST_F(ShaderProgramBatchTest, SkipsEmptyStages)
+{
+    render::ShaderProgramBatch batch(&compiler);
+    batch.Add(MakeSource("vert"s, "frag"s));
+    batch.Submit();
+    auto programs = batch.Finish();
+
+    ASSERT_EQ(2u, compiler.CountCalls("compile"));
+    ASSERT_TRUE(programs[0].Linked);
+    ASSERT_EQ(0u, programs[0].Shaders[(uint32_t)render::ShaderStage::Geometry]);
+}
+
+TEST_F(ShaderProgramBatchTest, FailedProgramsAreReleasedWithoutAffectingOthers)
+{
+    render::ShaderProgramBatch batch(&compiler);
+    batch.Add(MakeSource("vert"s, "frag"s));
+    batch.Add(MakeSource("vert"s, "frag error"s));
+    batch.Add(MakeSource("vert nolink"s, "frag"s));
+    batch.Add(MakeSource("vert"s, "frag"s));
+    batch.Submit();
+    auto programs = batch.Finish();
+
+    ASSERT_EQ(4u, programs.size());
+    ASSERT_TRUE(programs[0].Linked);
+    ASSERT_FALSE(programs[1].Linked);
+    ASSERT_FALSE(programs[2].Linked);
+    ASSERT_TRUE(programs[3].Linked);
+
+    ASSERT_EQ(0u, programs[1].Program);
+    ASSERT_EQ(2u, compiler.deletedPrograms.size());
+    ASSERT_EQ(4u, compiler.deletedShaders.size());
+    ASSERT_EQ(2u, compiler.CountCalls("detach"));
+}
+
+TEST_F(ShaderProgramBatchTest, ReadinessIsPolledWithoutQueryingStatus)
+{
+    render::ShaderProgramBatch batch(&compiler);
+    batch.Add(MakeSource("vert"s, "frag"s));
+    batch.Submit();
+
+    compiler.readyPrograms = false;
+    ASSERT_FALSE(batch.IsReady());
+    compiler.readyPrograms = true;
+    ASSERT_TRUE(batch.IsReady());
+
+    ASSERT_EQ(0u, compiler.CountCalls("shader_status"));
+    ASSERT_EQ(0u, compiler.CountCalls("program_status"));
+}
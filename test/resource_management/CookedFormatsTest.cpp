@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "filesystem/MemoryFileReader.h"
+#include "render/AnimatedMesh.h"
+#include "render/ShaderProgramBatch.h"
+#include "resource_management/CookedFormats.h"
+
+using namespace res;
+
+namespace {
+LoadedImage MakeImage(int32_t width, int32_t height, int32_t channels)
+{
+    auto bytes = (size_t)width * height * channels;
+
+    LoadedImage image;
+    image.size     = { width, height };
+    image.channels = channels;
+    image.data     = core::UniquePtr<uint8_t[], void (*)(void*)>((uint8_t*)malloc(bytes), free);
+
+    for (size_t i = 0; i < bytes; i++) {
+        image.data[i] = (uint8_t)(i * 7);
+    }
+
+    return image;
+}
+}
+
+TEST(CookedFormatsTest, DetectIgnoresSourceAssets)
+{
+    const uint8_t png[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    ASSERT_FALSE(cooked::Detect(png, sizeof(png)).has_value());
+    ASSERT_FALSE(cooked::Detect("ETEX", 4).has_value());
+}
+
+TEST(CookedFormatsTest, TextureRoundTrip)
+{
+    auto image = MakeImage(5, 3, 3);
+    core::TByteArray cookedData;
+    cooked::WriteTexture(image, cookedData);
+
+    ASSERT_EQ(cooked::Detect(cookedData.data(), cookedData.size()), cooked::CookedType::Texture);
+
+    io::MemoryFileReader reader(cookedData);
+    auto loaded = cooked::ReadTexture(&reader);
+
+    ASSERT_TRUE(loaded.data);
+    ASSERT_EQ(loaded.size.x, 5);
+    ASSERT_EQ(loaded.size.y, 3);
+    ASSERT_EQ(loaded.channels, 3);
+    ASSERT_EQ(memcmp(loaded.data.get(), image.data.get(), 5 * 3 * 3), 0);
+}
+
+TEST(CookedFormatsTest, TruncatedTextureFails)
+{
+    auto image = MakeImage(4, 4, 4);
+    core::TByteArray cookedData;
+    cooked::WriteTexture(image, cookedData);
+    cookedData.resize(cookedData.size() - 1);
+
+    io::MemoryFileReader reader(cookedData);
+    ASSERT_FALSE(cooked::ReadTexture(&reader).data);
+}
+
+TEST(CookedFormatsTest, ProgramRoundTrip)
+{
+    render::ShaderProgramSource source{ "void main() {}", "out vec4 color;", "" };
+    core::TByteArray cookedData;
+    cooked::WriteProgram(source, cookedData);
+
+    render::ShaderProgramSource loaded;
+    ASSERT_TRUE(cooked::ReadProgram(cookedData.data(), cookedData.size(), loaded));
+    ASSERT_EQ(loaded.Vertex, source.Vertex);
+    ASSERT_EQ(loaded.Fragment, source.Fragment);
+    ASSERT_TRUE(loaded.Geometry.empty());
+
+    ASSERT_FALSE(cooked::ReadProgram(cookedData.data(), cookedData.size() - 2, loaded));
+}
+
+TEST(CookedFormatsTest, MeshRoundTrip)
+{
+    render::AnimatedMesh mesh;
+    mesh.IndexBuffer  = { 0, 1, 2 };
+    mesh.VertexBuffer = { glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0) };
+    mesh.NormalBuffer = { glm::vec3(0, 0, 1), glm::vec3(0, 0, 1), glm::vec3(0, 0, 1) };
+    mesh.Meshlets.push_back({ 0, 3, 3, glm::vec3(0.5f, 0.5f, 0), 0.8f, glm::vec3(0, 0, 1), 0 });
+
+    core::TByteArray cookedData;
+    cooked::WriteMesh(mesh, cookedData);
+
+    render::AnimatedMesh loaded;
+    ASSERT_TRUE(cooked::ReadMesh(cookedData.data(), cookedData.size(), loaded));
+    ASSERT_EQ(loaded.IndexBuffer, mesh.IndexBuffer);
+    ASSERT_EQ(loaded.VertexBuffer, mesh.VertexBuffer);
+    ASSERT_EQ(loaded.NormalBuffer, mesh.NormalBuffer);
+    ASSERT_EQ(loaded.Meshlets.size(), 1u);
+    ASSERT_EQ(loaded.Meshlets[0].IndexCount, 3u);
+    ASSERT_TRUE(loaded.GetAnimations().empty());
+}
@@ -0,0 +1,283 @@
+#include "gtest/gtest.h"
+#include "render/AnimatedMesh.h"
+#include "resource_management/mesh/GltfImport.h"
+#include <cstring>
+
+using namespace res::mesh;
+
+namespace {
+/// Assembles a glb from a json document and binary chunk contents.
+class GlbBuilder
+{
+    public:
+    template <class T> uint32_t Add(std::initializer_list<T> values)
+    {
+        uint32_t offset = bin.size();
+        bin.resize(offset + values.size() * sizeof(T));
+        memcpy(bin.data() + offset, values.begin(), values.size() * sizeof(T));
+
+        while (bin.size() % 4)
+            bin.push_back(0);
+
+        return offset;
+    }
+
+    core::TByteArray Build(core::String json) const
+    {
+        while (json.size() % 4)
+            json += ' ';
+
+        core::TByteArray glb;
+        auto put = [&](uint32_t v) {
+            glb.insert(glb.end(), (uint8_t*)&v, (uint8_t*)&v + 4);
+        };
+
+        put(0x46546c67);
+        put(2);
+        put(12 + 8 + json.size() + 8 + bin.size());
+        put(json.size());
+        put(0x4e4f534a);
+        glb.insert(glb.end(), json.begin(), json.end());
+        put(bin.size());
+        put(0x004e4942);
+        glb.insert(glb.end(), bin.begin(), bin.end());
+        return glb;
+    }
+
+    core::TByteArray bin;
+};
+
+core::UniquePtr<render::AnimatedMesh> Import(const core::TByteArray& glb)
+{
+    return GltfImport::ImportGlb(glb.data(), glb.size(), "test.glb");
+}
+}
+
+TEST(GltfImportTest, ReadsTriangleStreams)
+{
+    GlbBuilder builder;
+    auto positions = builder.Add<float>({ 0, 0, 0, 1, 0, 0, 0, 1, 0 });
+    auto uvs       = builder.Add<uint16_t>({ 0, 0, 65535, 0, 0, 65535 });
+    auto indices   = builder.Add<uint8_t>({ 0, 1, 2 });
+
+    auto glb = builder.Build(core::string::format(R"({{
+        "asset": {{"version": "2.0"}},
+        "bufferViews": [
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 36}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 12}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 3}}
+        ],
+        "accessors": [
+            {{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3"}},
+            {{"bufferView": 1, "componentType": 5123, "normalized": true, "count": 3, "type": "VEC2"}},
+            {{"bufferView": 2, "componentType": 5121, "count": 3, "type": "SCALAR"}}
+        ],
+        "meshes": [{{"primitives": [{{"attributes": {{"POSITION": 0, "TEXCOORD_0": 1}}, "indices": 2}}]}}]
+    }})", positions, uvs, indices));
+
+    auto mesh = Import(glb);
+    ASSERT_TRUE(mesh);
+    ASSERT_EQ(mesh->VertexBuffer.size(), 3u);
+    ASSERT_EQ(mesh->VertexBuffer[1], glm::vec3(1, 0, 0));
+    ASSERT_EQ(mesh->UVBuffer.size(), 3u);
+    ASSERT_FLOAT_EQ(mesh->UVBuffer[1].x, 1.f);
+    ASSERT_FLOAT_EQ(mesh->UVBuffer[2].y, 1.f);
+    ASSERT_EQ(mesh->IndexBuffer, (core::Vector<uint32_t>{ 0, 1, 2 }));
+    ASSERT_TRUE(mesh->NormalBuffer.empty());
+    ASSERT_EQ(mesh->BlendWeightBuffer.size(), 3u);
+}
+
+TEST(GltfImportTest, AppliesSparseAccessors)
+{
+    GlbBuilder builder;
+    auto positions = builder.Add<float>({ 0, 0, 0, 1, 0, 0, 0, 1, 0 });
+    auto sparseIdx = builder.Add<uint16_t>({ 2 });
+    auto sparseVal = builder.Add<float>({ 5, 6, 7 });
+
+    auto glb = builder.Build(core::string::format(R"({{
+        "bufferViews": [
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 36}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 2}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 12}}
+        ],
+        "accessors": [{{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3",
+            "sparse": {{"count": 1, "indices": {{"bufferView": 1, "componentType": 5123}},
+                        "values": {{"bufferView": 2}}}}}}],
+        "meshes": [{{"primitives": [{{"attributes": {{"POSITION": 0}}}}]}}]
+    }})", positions, sparseIdx, sparseVal));
+
+    auto mesh = Import(glb);
+    ASSERT_TRUE(mesh);
+    ASSERT_EQ(mesh->VertexBuffer[1], glm::vec3(1, 0, 0));
+    ASSERT_EQ(mesh->VertexBuffer[2], glm::vec3(5, 6, 7));
+    // non indexed primitives get sequential indices
+    ASSERT_EQ(mesh->IndexBuffer, (core::Vector<uint32_t>{ 0, 1, 2 }));
+}
+
+TEST(GltfImportTest, ReadsSkinAndAnimation)
+{
+    GlbBuilder builder;
+    auto positions = builder.Add<float>({ 0, 0, 0, 1, 0, 0, 0, 1, 0 });
+    auto joints    = builder.Add<uint8_t>({ 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0 });
+    auto weights   = builder.Add<float>({ 1, 0, 0, 0, 0.5f, 0.5f, 0, 0, 0, 1, 0, 0 });
+    auto times     = builder.Add<float>({ 0, 0.5f });
+    auto rotations = builder.Add<float>({ 0, 0, 0, 1, 0, 1, 0, 0 });
+
+    // node 0 is the armature, 1 and 3 are joints separated by a plain node 2
+    auto glb = builder.Build(core::string::format(R"({{
+        "scene": 0,
+        "scenes": [{{"nodes": [0]}}],
+        "nodes": [
+            {{"name": "Armature", "children": [1, 4]}},
+            {{"name": "Hip", "children": [2]}},
+            {{"name": "Offset", "children": [3]}},
+            {{"name": "Knee", "children": [5]}},
+            {{"name": "Body", "mesh": 0, "skin": 0}},
+            {{"name": "Knee_end", "translation": [0, 1, 0]}}
+        ],
+        "skins": [{{"joints": [1, 3]}}],
+        "bufferViews": [
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 36}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 12}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 48}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 8}},
+            {{"buffer": 0, "byteOffset": {}, "byteLength": 32}}
+        ],
+        "accessors": [
+            {{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3"}},
+            {{"bufferView": 1, "componentType": 5121, "count": 3, "type": "VEC4"}},
+            {{"bufferView": 2, "componentType": 5126, "count": 3, "type": "VEC4"}},
+            {{"bufferView": 3, "componentType": 5126, "count": 2, "type": "SCALAR"}},
+            {{"bufferView": 4, "componentType": 5126, "count": 2, "type": "VEC4"}}
+        ],
+        "meshes": [{{"primitives": [{{"attributes": {{"POSITION": 0, "JOINTS_0": 1, "WEIGHTS_0": 2}}}}]}}],
+        "animations": [{{"name": "Bend",
+            "samplers": [{{"input": 3, "output": 4}}],
+            "channels": [{{"sampler": 0, "target": {{"node": 3, "path": "rotation"}}}}]}}]
+    }})", positions, joints, weights, times, rotations));
+
+    auto mesh = Import(glb);
+    ASSERT_TRUE(mesh);
+
+    auto& bones = mesh->GetArmature().GetBones();
+    ASSERT_EQ(bones.size(), 2u);
+    ASSERT_EQ(bones[0].name, "Hip");
+    ASSERT_EQ(bones[0].parent, -1);
+    ASSERT_EQ(bones[1].name, "Knee");
+    ASSERT_EQ(bones[1].parent, 0);
+
+    ASSERT_EQ(mesh->BlendIndexBuffer[1], glm::vec4(1, 0, 0, 0));
+    ASSERT_EQ(mesh->BlendWeightBuffer[1], glm::vec4(0.5f, 0.5f, 0, 0));
+
+    ASSERT_EQ(mesh->GetAnimations().size(), 1u);
+    auto& animation = mesh->GetAnimations()[0];
+    ASSERT_EQ(animation.Name, "Bend");
+    ASSERT_FLOAT_EQ(animation.Duration, 500.f);
+    ASSERT_EQ(animation.BoneKeys.size(), 2u);
+
+    auto& keys = animation.BoneKeys[1].RotationKeys;
+    ASSERT_EQ(keys.size(), 2u);
+    ASSERT_FLOAT_EQ(keys[1].Time, 500.f);
+    ASSERT_FLOAT_EQ(keys[1].Value.y, 1.f);
+    ASSERT_FLOAT_EQ(keys[1].Value.w, 0.f);
+}
+
+TEST(GltfImportTest, RejectsOutOfBoundsAccessors)
+{
+    GlbBuilder builder;
+    auto positions = builder.Add<float>({ 0, 0, 0, 1, 0, 0 });
+
+    auto glb = builder.Build(core::string::format(R"({{
+        "bufferViews": [{{"buffer": 0, "byteOffset": {}, "byteLength": 24}}],
+        "accessors": [{{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3"}}],
+        "meshes": [{{"primitives": [{{"attributes": {{"POSITION": 0}}}}]}}]
+    }})", positions));
+
+    ASSERT_FALSE(Import(glb));
+
+    glb.resize(glb.size() - 8);
+    ASSERT_FALSE(Import(glb));
+    ASSERT_FALSE(GltfImport::IsGlb("glTF", 4));
+}
+
+TEST(GltfImportTest, ReportsBuffersOutsideOfTheBinaryChunkAsUnsupported)
+{
+    GlbBuilder builder;
+    auto positions = builder.Add<float>({ 0, 0, 0, 1, 0, 0, 0, 1, 0 });
+
+    auto build = [&](const char* buffers) {
+        return builder.Build(core::string::format(R"({{
+            "buffers": {},
+            "bufferViews": [{{"buffer": 0, "byteOffset": {}, "byteLength": 36}}],
+            "accessors": [{{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3"}}],
+            "meshes": [{{"primitives": [{{"attributes": {{"POSITION": 0}}}}]}}]
+        }})", buffers, positions));
+    };
+
+    bool unsupported = true;
+    auto embedded    = build(R"([{"byteLength": 36}])");
+    ASSERT_TRUE(GltfImport::ImportGlb(embedded.data(), embedded.size(), "test.glb", &unsupported));
+    ASSERT_FALSE(unsupported);
+
+    for (auto buffers : { R"([{"uri": "mesh.bin", "byteLength": 36}])",
+                          R"([{"byteLength": 36}, {"uri": "skin.bin", "byteLength": 8}])",
+                          R"([{"uri": "data:application/octet-stream;base64,AAAA", "byteLength": 3}])" }) {
+        auto glb = build(buffers);
+        ASSERT_FALSE(GltfImport::ImportGlb(glb.data(), glb.size(), "test.glb", &unsupported));
+        ASSERT_TRUE(unsupported);
+        // without a fallback it is an error
+        ASSERT_FALSE(Import(glb));
+    }
+}
+
+TEST(GltfImportTest, RejectsNegativeCountsAndOffsets)
+{
+    GlbBuilder builder;
+    builder.Add<float>({ 0, 0, 0, 1, 0, 0, 0, 1, 0 });
+
+    auto build = [&](const char* view, const char* accessor) {
+        return builder.Build(core::string::format(R"({{
+            "bufferViews": [{{"buffer": 0, {}}}],
+            "accessors": [{{"bufferView": 0, "componentType": 5126, "type": "VEC3", {}}}],
+            "meshes": [{{"primitives": [{{"attributes": {{"POSITION": 0}}}}]}}]
+        }})", view, accessor));
+    };
+
+    ASSERT_TRUE(Import(build(R"("byteLength": 36)", R"("count": 3)")));
+    ASSERT_FALSE(Import(build(R"("byteLength": 36)", R"("count": -1)")));
+    ASSERT_FALSE(Import(build(R"("byteLength": 36)", R"("count": 1e12)")));
+    ASSERT_FALSE(Import(build(R"("byteLength": 36)", R"("count": 1, "byteOffset": -12)")));
+    ASSERT_FALSE(Import(build(R"("byteOffset": -12, "byteLength": 48)", R"("count": 3)")));
+    ASSERT_FALSE(Import(build(R"("byteOffset": 12, "byteLength": -12)", R"("count": 0)")));
+}
+
+TEST(GltfImportTest, RejectsCyclicNodeHierarchy)
+{
+    GlbBuilder builder;
+    auto positions = builder.Add<float>({ 0, 0, 0, 1, 0, 0, 0, 1, 0 });
+
+    // joint 'Hip' hangs below nodes 1 and 2, which list each other as children
+    auto build = [&](const char* loopChildren) {
+        return builder.Build(core::string::format(R"({{
+            "nodes": [
+                {{"name": "Body", "mesh": 0, "skin": 0}},
+                {{"name": "A", "children": [2, 3]}},
+                {{"name": "B", "children": {}}},
+                {{"name": "Hip", "scale": [0, 1, 1]}}
+            ],
+            "skins": [{{"joints": [3]}}],
+            "bufferViews": [{{"buffer": 0, "byteOffset": {}, "byteLength": 36}}],
+            "accessors": [{{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3"}}],
+            "meshes": [{{"primitives": [{{"attributes": {{"POSITION": 0}}}}]}}]
+        }})", loopChildren, positions));
+    };
+
+    auto mesh = Import(build("[]"));
+    ASSERT_TRUE(mesh);
+    ASSERT_EQ(mesh->GetArmature().GetBones().size(), 1u);
+    // zero scale leaves the rotation at identity instead of dividing by zero
+    ASSERT_FLOAT_EQ(mesh->GetArmature().GetBones()[0].rot.w, 1.f);
+    ASSERT_FLOAT_EQ(mesh->GetArmature().GetBones()[0].rot.x, 0.f);
+
+    ASSERT_FALSE(Import(build("[1]")));
+}
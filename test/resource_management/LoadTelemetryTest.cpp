@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+#include "resource_management/LoadTelemetry.h"
+
+using namespace res;
+
+namespace {
+LoadRecord MakeRecord(const core::String& path, uint64_t bytes, uint64_t decode, bool hit = false)
+{
+    LoadRecord record;
+    record.Path       = path;
+    record.Type       = ResourceType::Texture;
+    record.Bytes      = bytes;
+    record.DecodeTime = decode;
+    record.UploadTime = decode / 2;
+    record.CacheHit   = hit;
+    return record;
+}
+}
+
+TEST(LoadTelemetryTest, TopListsAreOrderedAndSkipCacheHits)
+{
+    LoadTelemetry telemetry;
+    telemetry.Record(MakeRecord("a.png", 100, 10));
+    telemetry.Record(MakeRecord("b.png", 300, 5));
+    telemetry.Record(MakeRecord("c.png", 200, 30));
+    telemetry.Record(MakeRecord("d.png", 900, 900, true));
+
+    auto slowest = telemetry.GetSlowest(2);
+    ASSERT_EQ(slowest.size(), 2u);
+    ASSERT_EQ(slowest[0].Path, "c.png");
+    ASSERT_EQ(slowest[1].Path, "a.png");
+
+    auto largest = telemetry.GetLargest(10);
+    ASSERT_EQ(largest.size(), 3u);
+    ASSERT_EQ(largest[0].Path, "b.png");
+}
+
+TEST(LoadTelemetryTest, ThreadsGetSequentialIds)
+{
+    LoadTelemetry telemetry;
+    telemetry.Record(MakeRecord("main.png", 1, 1));
+    std::thread([&]() { telemetry.Record(MakeRecord("worker.png", 1, 1)); }).join();
+    telemetry.Record(MakeRecord("main2.png", 1, 1));
+
+    auto records = telemetry.GetRecords();
+    ASSERT_EQ(records[0].Thread, 0u);
+    ASSERT_EQ(records[1].Thread, 1u);
+    ASSERT_EQ(records[2].Thread, 0u);
+}
+
+TEST(LoadTelemetryTest, QueryFiltersRecords)
+{
+    LoadTelemetry telemetry;
+    telemetry.Record(MakeRecord("a.png", 1, 1));
+    telemetry.Record(MakeRecord("a.png", 0, 0, true));
+
+    auto hits = telemetry.Query([](const LoadRecord& r) { return r.CacheHit; });
+    ASSERT_EQ(hits.size(), 1u);
+}
+
+TEST(LoadTelemetryTest, CsvEscapesPaths)
+{
+    LoadTelemetry telemetry;
+    telemetry.Record(MakeRecord("dir,with\"comma.png", 12, 4));
+
+    auto csv = telemetry.Serialize(TelemetryFormat::Csv);
+    ASSERT_NE(csv.find("\"dir,with\"\"comma.png\",texture,12,0,4,2,0,0,0\n"), core::String::npos);
+}
+
+TEST(LoadTelemetryTest, ChromeTraceHasDecodeAndUploadSpans)
+{
+    LoadTelemetry telemetry;
+    telemetry.Record(MakeRecord("a\\b.png", 1, 10));
+
+    auto trace = telemetry.Serialize(TelemetryFormat::ChromeTrace);
+    ASSERT_NE(trace.find("\"name\": \"decode a\\\\b.png\""), core::String::npos);
+    ASSERT_NE(trace.find("\"ph\": \"X\", \"ts\": 10, \"dur\": 5"), core::String::npos);
+}
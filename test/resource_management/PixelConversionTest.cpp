@@ -0,0 +1,100 @@
+#include "../filesystem/Common.h"
+#include "gtest/gtest.h"
+#include "resource_management/PixelConversion.h"
+
+using namespace res;
+
+namespace {
+/// Odd sizes make sure both vector body and scalar tail are covered.
+const size_t PixelCounts[] = { 1, 5, 6, 7, 15, 16, 17, 33, 1001 };
+
+uint8_t Premultiplied(uint8_t c, uint8_t a)
+{
+    return (uint8_t)((c * a + 127) / 255);
+}
+}
+
+TEST(PixelConversionTest, RgbToRgbaAddsOpaqueAlpha)
+{
+    for (auto count : PixelCounts) {
+        auto src = Common::MakePattern(count * 3);
+        core::TByteArray dst(count * 4);
+        pixel::RgbToRgba(src.data(), dst.data(), count);
+
+        for (size_t i = 0; i < count; i++) {
+            ASSERT_EQ(dst[i * 4 + 0], src[i * 3 + 0]);
+            ASSERT_EQ(dst[i * 4 + 1], src[i * 3 + 1]);
+            ASSERT_EQ(dst[i * 4 + 2], src[i * 3 + 2]);
+            ASSERT_EQ(dst[i * 4 + 3], 255);
+        }
+    }
+}
+
+TEST(PixelConversionTest, GrayIsReplicatedIntoColorChannels)
+{
+    for (auto count : PixelCounts) {
+        auto gray = Common::MakePattern(count);
+        auto grayAlpha = Common::MakePattern(count * 2);
+        core::TByteArray fromGray(count * 4), fromGrayAlpha(count * 4);
+        pixel::GrayToRgba(gray.data(), fromGray.data(), count);
+        pixel::GrayAlphaToRgba(grayAlpha.data(), fromGrayAlpha.data(), count);
+
+        for (size_t i = 0; i < count; i++) {
+            for (int c = 0; c < 3; c++) {
+                ASSERT_EQ(fromGray[i * 4 + c], gray[i]);
+                ASSERT_EQ(fromGrayAlpha[i * 4 + c], grayAlpha[i * 2]);
+            }
+            ASSERT_EQ(fromGray[i * 4 + 3], 255);
+            ASSERT_EQ(fromGrayAlpha[i * 4 + 3], grayAlpha[i * 2 + 1]);
+        }
+    }
+}
+
+TEST(PixelConversionTest, PremultiplyRoundsToNearest)
+{
+    for (auto count : PixelCounts) {
+        auto original = Common::MakePattern(count * 4);
+        auto pixels   = original;
+        pixel::PremultiplyRgba(pixels.data(), count);
+
+        for (size_t i = 0; i < count * 4; i += 4) {
+            auto a = original[i + 3];
+            ASSERT_EQ(pixels[i + 0], Premultiplied(original[i + 0], a));
+            ASSERT_EQ(pixels[i + 1], Premultiplied(original[i + 1], a));
+            ASSERT_EQ(pixels[i + 2], Premultiplied(original[i + 2], a));
+            ASSERT_EQ(pixels[i + 3], a);
+        }
+    }
+}
+
+TEST(PixelConversionTest, PremultiplyGrayAlphaKeepsAlpha)
+{
+    for (auto count : PixelCounts) {
+        auto original = Common::MakePattern(count * 2);
+        auto pixels   = original;
+        pixel::PremultiplyGrayAlpha(pixels.data(), count);
+
+        for (size_t i = 0; i < count * 2; i += 2) {
+            ASSERT_EQ(pixels[i], Premultiplied(original[i], original[i + 1]));
+            ASSERT_EQ(pixels[i + 1], original[i + 1]);
+        }
+    }
+}
+
+TEST(PixelConversionTest, PremultiplyIsExactForAllInputs)
+{
+    core::TByteArray pixels;
+    for (int c = 0; c < 256; c++) {
+        for (int a = 0; a < 256; a++) {
+            pixels.insert(pixels.end(), { (uint8_t)c, (uint8_t)c, (uint8_t)c, (uint8_t)a });
+        }
+    }
+
+    pixel::PremultiplyRgba(pixels.data(), pixels.size() / 4);
+
+    for (int c = 0; c < 256; c++) {
+        for (int a = 0; a < 256; a++) {
+            ASSERT_EQ(pixels[(c * 256 + a) * 4], Premultiplied(c, a));
+        }
+    }
+}
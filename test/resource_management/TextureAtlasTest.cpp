@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+#include "resource_management/atlas/TextureAtlas.h"
+
+using namespace res::atlas;
+
+namespace {
+core::TByteArray MakeImage(uint32_t w, uint32_t h, uint8_t value)
+{
+    return core::TByteArray(w * h * 4, value);
+}
+
+bool Overlaps(const PackedRect& a, const PackedRect& b)
+{
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+AtlasDescriptor SmallAtlas(uint32_t maxPages)
+{
+    AtlasDescriptor desc;
+    desc.PageSize = 64;
+    desc.Gutter   = 1;
+    desc.MaxPages = maxPages;
+    return desc;
+}
+}
+
+TEST(SkylinePackerTest, PackedRectsDoNotOverlap)
+{
+    SkylinePacker packer(128, 128);
+    core::Vector<PackedRect> rects;
+
+    for (uint32_t i = 0; i < 40; i++) {
+        auto rect = packer.Insert(8 + i % 13, 6 + i % 7);
+        ASSERT_TRUE(rect);
+        ASSERT_LE(rect->x + rect->w, 128u);
+        ASSERT_LE(rect->y + rect->h, 128u);
+
+        for (const auto& other : rects) {
+            ASSERT_FALSE(Overlaps(*rect, other));
+        }
+        rects.push_back(*rect);
+    }
+}
+
+TEST(SkylinePackerTest, InsertFailsWhenFull)
+{
+    SkylinePacker packer(32, 32);
+
+    ASSERT_TRUE(packer.Insert(32, 32));
+    ASSERT_FALSE(packer.Insert(1, 1));
+    ASSERT_FLOAT_EQ(packer.GetOccupancy(), 1.f);
+
+    packer.Reset();
+    ASSERT_TRUE(packer.Insert(1, 1));
+}
+
+TEST(TextureAtlasTest, RegionUvMatchesInnerRect)
+{
+    TextureAtlas atlas(SmallAtlas(1));
+    auto img = MakeImage(8, 4, 0xff);
+    auto id  = atlas.Insert(img.data(), 8, 4);
+
+    ASSERT_NE(id, TextureAtlas::InvalidId);
+    auto region = atlas.GetRegion(id);
+    ASSERT_TRUE(region);
+    ASSERT_EQ(region->Rect.w, 8u);
+    ASSERT_EQ(region->Rect.h, 4u);
+    ASSERT_FLOAT_EQ(region->UvMin.x, region->Rect.x / 64.f);
+    ASSERT_FLOAT_EQ(region->UvMax.y, (region->Rect.y + 4) / 64.f);
+}
+
+TEST(TextureAtlasTest, GutterRepeatsEdgePixels)
+{
+    TextureAtlas atlas(SmallAtlas(1));
+    auto img = MakeImage(4, 4, 0xab);
+    auto id  = atlas.Insert(img.data(), 4, 4);
+    auto& rect = atlas.GetRegion(id)->Rect;
+
+    auto pixels = atlas.GetPagePixels(0);
+    auto at     = [&](uint32_t x, uint32_t y) { return pixels[(y * 64 + x) * 4]; };
+
+    ASSERT_EQ(at(rect.x - 1, rect.y - 1), 0xab);
+    ASSERT_EQ(at(rect.x + rect.w, rect.y + rect.h), 0xab);
+    ASSERT_EQ(at(rect.x + rect.w + 1, rect.y), 0);
+}
+
+TEST(TextureAtlasTest, EmptyImagesAreRejected)
+{
+    TextureAtlas atlas(SmallAtlas(1));
+    auto img = MakeImage(4, 4, 1);
+
+    ASSERT_EQ(atlas.Insert(img.data(), 0, 4), TextureAtlas::InvalidId);
+    ASSERT_EQ(atlas.Insert(img.data(), 4, 0), TextureAtlas::InvalidId);
+    ASSERT_NE(atlas.Insert(img.data(), 4, 4), TextureAtlas::InvalidId);
+}
+
+TEST(TextureAtlasTest, NewPageIsAddedWhenFull)
+{
+    TextureAtlas atlas(SmallAtlas(2));
+    auto img = MakeImage(40, 40, 1);
+
+    ASSERT_NE(atlas.Insert(img.data(), 40, 40), TextureAtlas::InvalidId);
+    ASSERT_NE(atlas.Insert(img.data(), 40, 40), TextureAtlas::InvalidId);
+    ASSERT_EQ(atlas.GetPageCount(), 2u);
+    ASSERT_EQ(atlas.Insert(img.data(), 40, 40), TextureAtlas::InvalidId);
+}
+
+TEST(TextureAtlasTest, RemovedSpaceIsReclaimedByRepack)
+{
+    TextureAtlas atlas(SmallAtlas(1));
+    auto small = MakeImage(30, 30, 7);
+    core::Vector<uint32_t> ids;
+
+    for (int i = 0; i < 4; i++) {
+        ids.push_back(atlas.Insert(small.data(), 30, 30));
+        ASSERT_NE(ids.back(), TextureAtlas::InvalidId);
+    }
+
+    atlas.Remove(ids[0]);
+    atlas.Remove(ids[2]);
+    ASSERT_FALSE(atlas.GetRegion(ids[0]));
+    ASSERT_GT(atlas.GetFragmentation(), 0.25f);
+
+    // does not fit into the skyline until removed images are packed away
+    auto wide = MakeImage(62, 30, 9);
+    auto id   = atlas.Insert(wide.data(), 62, 30);
+    ASSERT_NE(id, TextureAtlas::InvalidId);
+    ASSERT_FLOAT_EQ(atlas.GetFragmentation(), 0.f);
+
+    auto region = atlas.GetRegion(ids[1]);
+    ASSERT_TRUE(region);
+    ASSERT_EQ(atlas.GetPagePixels(0)[(region->Rect.y * 64 + region->Rect.x) * 4], 7);
+}
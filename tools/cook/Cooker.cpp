@@ -0,0 +1,322 @@
+#include "Cooker.h"
+#include "filesystem/BlockCompression.h"
+#include "filesystem/MemoryFileReader.h"
+#include "render/AnimatedMesh.h"
+#include "render/ShaderProgramBatch.h"
+#include "resource_management/CookedFormats.h"
+#include "resource_management/ImageLoader.h"
+#include "resource_management/mesh/AssimpImport.h"
+#include "util/Hash.h"
+#include "util/ThreadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+namespace fs = std::filesystem;
+
+namespace cook {
+namespace {
+const char* ManifestName   = ".cook_manifest";
+const char* ManifestHeader = "# cook manifest v1\n";
+
+const char* TextureExtensions[] = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd", ".gif" };
+const char* MeshExtensions[]    = { ".fbx", ".obj", ".dae", ".gltf", ".glb", ".3ds" };
+const char* StageExtensions[]   = { ".vert", ".frag", ".geom" };
+
+template <size_t N> bool HasExtension(const char* (&extensions)[N], const core::String& ext)
+{
+  return std::any_of(std::begin(extensions), std::end(extensions),
+                     [&](const char* e) { return ext == e; });
+}
+
+core::String ToLower(core::String str)
+{
+  std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+  return str;
+}
+
+bool ReadFile(const fs::path& path, core::TByteArray& out)
+{
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+  if (!file)
+    return false;
+
+  out.resize(file.tellg());
+  file.seekg(0);
+  return (bool)file.read((char*)out.data(), out.size());
+}
+
+bool WriteFile(const fs::path& path, const core::TByteArray& data)
+{
+  std::error_code error;
+  fs::create_directories(path.parent_path(), error);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  return file && file.write((const char*)data.data(), data.size());
+}
+
+const char* ToString(AssetKind kind)
+{
+  switch (kind) {
+  case AssetKind::Texture:
+    return "texture";
+  case AssetKind::Mesh:
+    return "mesh";
+  case AssetKind::Program:
+    return "program";
+  default:
+    return "copy";
+  }
+}
+} // namespace
+
+Cooker::Cooker(const CookOptions& options)
+    : m_options(options)
+{
+}
+
+core::Vector<CookJob> Cooker::CollectJobs(const fs::path& input)
+{
+  core::Vector<CookJob> jobs;
+  // stages of one program are cooked together, ordered map keeps output deterministic
+  std::map<core::String, core::Vector<fs::path>> programs;
+
+  for (auto& entry : fs::recursive_directory_iterator(input)) {
+    if (!entry.is_regular_file())
+      continue;
+
+    auto relative = fs::relative(entry.path(), input);
+    auto ext      = ToLower(relative.extension().string());
+
+    if (relative.filename() == ManifestName)
+      continue;
+
+    if (HasExtension(StageExtensions, ext)) {
+      auto program = relative;
+      programs[program.replace_extension().generic_string()].push_back(entry.path());
+      continue;
+    }
+
+    auto kind = AssetKind::Copy;
+    if (HasExtension(TextureExtensions, ext))
+      kind = AssetKind::Texture;
+    else if (HasExtension(MeshExtensions, ext))
+      kind = AssetKind::Mesh;
+
+    jobs.push_back(CookJob{ kind, relative.generic_string(), { entry.path() } });
+  }
+
+  for (auto& it : programs) {
+    std::sort(it.second.begin(), it.second.end());
+    jobs.push_back(
+        CookJob{ AssetKind::Program, it.first + res::cooked::ProgramExtension, it.second });
+  }
+
+  std::sort(jobs.begin(), jobs.end(),
+            [](const CookJob& a, const CookJob& b) { return a.Name < b.Name; });
+  return jobs;
+}
+
+bool Cooker::Run()
+{
+  auto start = std::chrono::steady_clock::now();
+
+  if (!fs::is_directory(m_options.Input)) {
+    elog::LogError(core::string::format("Input '{}' is not a directory", m_options.Input.string()));
+    return false;
+  }
+
+  if (!m_options.Force)
+    ReadManifest();
+
+  auto jobs = CollectJobs(m_options.Input);
+  util::ThreadPool workers(m_options.Threads);
+  core::Vector<std::future<CookResult>> futures;
+
+  for (auto& job : jobs) {
+    auto it       = m_manifest.find(job.Name);
+    uint64_t hash = it != m_manifest.end() ? it->second : 0;
+    futures.push_back(workers.Submit([this, &job, hash]() { return Cook(job, hash); }));
+  }
+
+  core::Vector<CookResult> results;
+  uint32_t cooked = 0, skipped = 0, failed = 0;
+  uint64_t cookTime = 0, inputBytes = 0, outputBytes = 0;
+
+  for (uint32_t i = 0; i < jobs.size(); i++) {
+    results.push_back(futures[i].get());
+    auto& r = results.back();
+
+    switch (r.Status) {
+    case CookStatus::Skipped:
+      skipped++;
+      continue;
+    case CookStatus::Failed:
+      failed++;
+      std::printf("  FAILED  %-8s %s\n", ToString(jobs[i].Kind), jobs[i].Name.c_str());
+      continue;
+    case CookStatus::Cooked:
+      break;
+    }
+
+    cooked++;
+    cookTime += r.Time;
+    inputBytes += r.InputBytes;
+    outputBytes += r.OutputBytes;
+    std::printf("  %8.2f ms  %-8s %s (%llu -> %llu bytes)\n", r.Time / 1000.0,
+                ToString(jobs[i].Kind), jobs[i].Name.c_str(), (unsigned long long)r.InputBytes,
+                (unsigned long long)r.OutputBytes);
+  }
+
+  WriteManifest(jobs, results);
+
+  auto wallTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+  std::printf("Cooked %u, skipped %u, failed %u of %zu assets on %u threads\n", cooked, skipped,
+              failed, jobs.size(), workers.GetThreadCount());
+  std::printf("Cook time %.2f ms, wall time %.2f ms, %llu -> %llu bytes\n", cookTime / 1000.0,
+              wallTime.count(), (unsigned long long)inputBytes, (unsigned long long)outputBytes);
+
+  return failed == 0;
+}
+
+CookResult Cooker::Cook(const CookJob& job, uint64_t previousHash) const
+{
+  auto start = std::chrono::steady_clock::now();
+  CookResult result{ CookStatus::Failed, 0, 0, 0, 0 };
+
+  // version is part of the hash so format changes invalidate every output
+  result.Hash = util::HashBytes(&res::cooked::FormatVersion, sizeof(res::cooked::FormatVersion));
+  if (m_options.Compress)
+    result.Hash = util::HashBytes("compress", 8, result.Hash);
+  core::Vector<core::TByteArray> inputs(job.Inputs.size());
+
+  for (uint32_t i = 0; i < job.Inputs.size(); i++) {
+    if (!ReadFile(job.Inputs[i], inputs[i])) {
+      elog::LogError(core::string::format("Failed to read '{}'", job.Inputs[i].string()));
+      return result;
+    }
+
+    auto name   = job.Inputs[i].filename().string();
+    result.Hash = util::HashBytes(name.data(), name.size(), result.Hash);
+    result.Hash = util::HashBytes(inputs[i], result.Hash);
+    result.InputBytes += inputs[i].size();
+  }
+
+  auto outputPath = m_options.Output / job.Name;
+
+  if (result.Hash == previousHash && fs::exists(outputPath)) {
+    result.Status = CookStatus::Skipped;
+    return result;
+  }
+
+  core::TByteArray output;
+  bool converted = Convert(job, inputs, output);
+
+  if (converted && m_options.Compress) {
+    core::TByteArray compressed;
+    io::compression::CompressFile(output.data(), output.size(), compressed);
+    output = core::Move(compressed);
+  }
+
+  if (!converted || !WriteFile(outputPath, output)) {
+    elog::LogError(core::string::format("Failed to cook '{}'", job.Name));
+    return result;
+  }
+
+  result.Status      = CookStatus::Cooked;
+  result.OutputBytes = output.size();
+  result.Time        = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  return result;
+}
+
+bool Cooker::Convert(const CookJob& job, const core::Vector<core::TByteArray>& inputs,
+                     core::TByteArray& out) const
+{
+  switch (job.Kind) {
+  case AssetKind::Texture: {
+    io::MemoryFileReader reader(inputs[0]);
+    auto image = res::ImageLoader::DecodeImage(&reader);
+
+    if (!image.data)
+      return false;
+
+    res::cooked::WriteTexture(image, out);
+    return true;
+  }
+  case AssetKind::Mesh: {
+    auto mesh = res::mesh::AssimpImport::ImportMesh(job.Name, inputs[0]);
+
+    if (!mesh)
+      return false;
+
+    res::cooked::WriteMesh(*mesh, out);
+    return true;
+  }
+  case AssetKind::Program: {
+    render::ShaderProgramSource source;
+
+    for (uint32_t i = 0; i < inputs.size(); i++) {
+      auto ext = ToLower(job.Inputs[i].extension().string());
+      core::String text(inputs[i].begin(), inputs[i].end());
+
+      if (ext == ".vert")
+        source.Vertex = core::Move(text);
+      else if (ext == ".frag")
+        source.Fragment = core::Move(text);
+      else if (ext == ".geom")
+        source.Geometry = core::Move(text);
+    }
+
+    if (source.Vertex.empty() || source.Fragment.empty()) {
+      elog::LogError(
+          core::string::format("Program '{}' needs vertex and fragment stages", job.Name));
+      return false;
+    }
+
+    res::cooked::WriteProgram(source, out);
+    return true;
+  }
+  case AssetKind::Copy:
+    out = inputs[0];
+    return true;
+  }
+
+  return false;
+}
+
+void Cooker::ReadManifest()
+{
+  std::ifstream file(m_options.Output / ManifestName);
+  core::String line;
+
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    auto separator = line.find(' ');
+    if (separator == core::String::npos)
+      continue;
+
+    m_manifest[line.substr(separator + 1)] = std::strtoull(line.c_str(), nullptr, 16);
+  }
+}
+
+void Cooker::WriteManifest(const core::Vector<CookJob>& jobs,
+                           const core::Vector<CookResult>& results) const
+{
+  core::String contents = ManifestHeader;
+
+  for (uint32_t i = 0; i < jobs.size(); i++) {
+    // failed assets are left out so the next run retries them
+    if (results[i].Status != CookStatus::Failed)
+      contents += core::string::format("{:016x} {}\n", results[i].Hash, jobs[i].Name);
+  }
+
+  if (!WriteFile(m_options.Output / ManifestName, core::TByteArray(contents.begin(), contents.end())))
+    elog::LogError("Failed to write cook manifest");
+}
+} // namespace cook
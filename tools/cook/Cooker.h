@@ -0,0 +1,79 @@
+#ifndef THEPROJECT2_TOOLS_COOK_COOKER_H_
+#define THEPROJECT2_TOOLS_COOK_COOKER_H_
+
+#include <filesystem>
+
+namespace cook {
+struct CookOptions
+{
+  std::filesystem::path Input;
+  std::filesystem::path Output;
+  /// 0 uses every hardware thread.
+  uint32_t Threads = 0;
+  /// Ignores the manifest and cooks everything.
+  bool Force = false;
+  /// Stores outputs block compressed, FileSystem decompresses them transparently.
+  bool Compress = false;
+};
+
+enum class AssetKind
+{
+  Texture,
+  Mesh,
+  Program,
+  Copy
+};
+
+enum class CookStatus
+{
+  Cooked,
+  Skipped,
+  Failed
+};
+
+struct CookJob
+{
+  AssetKind Kind;
+  /// Output path relative to the output directory, also the manifest key.
+  core::String Name;
+  core::Vector<std::filesystem::path> Inputs;
+};
+
+struct CookResult
+{
+  CookStatus Status;
+  uint64_t Hash;
+  uint64_t InputBytes;
+  uint64_t OutputBytes;
+  uint64_t Time;
+};
+
+/// Converts an asset tree into load-ready files, see resource_management/CookedFormats.h.
+/// Inputs are hashed together with the format version, outputs whose hash matches the
+/// manifest of the previous run are left untouched.
+class Cooker
+{
+  public:
+  Cooker(const CookOptions& options);
+
+  /// Returns false when any asset failed to cook.
+  bool Run();
+
+  static core::Vector<CookJob> CollectJobs(const std::filesystem::path& input);
+
+  private:
+  CookResult Cook(const CookJob& job, uint64_t previousHash) const;
+  bool Convert(const CookJob& job, const core::Vector<core::TByteArray>& inputs,
+               core::TByteArray& out) const;
+
+  void ReadManifest();
+  void WriteManifest(const core::Vector<CookJob>& jobs,
+                     const core::Vector<CookResult>& results) const;
+
+  private:
+  CookOptions m_options;
+  core::UnorderedMap<core::String, uint64_t> m_manifest;
+};
+} // namespace cook
+
+#endif // THEPROJECT2_TOOLS_COOK_COOKER_H_
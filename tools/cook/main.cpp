@@ -0,0 +1,50 @@
+#include "Cooker.h"
+#include "log/DefaultCoutLogPipe.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+void PrintUsage()
+{
+  std::printf("usage: engine_cook <input_dir> <output_dir> [-j threads] [--force] [--compress]\n");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto logPipe = core::MakeShared<elog::DefaultCoutLogPipe>();
+  elog::AddLogStream(logPipe);
+
+  cook::CookOptions options;
+  core::Vector<const char*> positional;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+      options.Threads = std::strtoul(argv[++i], nullptr, 10);
+    }
+    else if (!strcmp(argv[i], "--force")) {
+      options.Force = true;
+    }
+    else if (!strcmp(argv[i], "--compress")) {
+      options.Compress = true;
+    }
+    else if (argv[i][0] == '-') {
+      PrintUsage();
+      return 1;
+    }
+    else {
+      positional.push_back(argv[i]);
+    }
+  }
+
+  if (positional.size() != 2) {
+    PrintUsage();
+    return 1;
+  }
+
+  options.Input  = positional[0];
+  options.Output = positional[1];
+
+  cook::Cooker cooker(options);
+  return cooker.Run() ? 0 : 1;
+}
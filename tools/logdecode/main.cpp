@@ -0,0 +1,142 @@
+#include "log/BinaryLogReader.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace {
+/// Reader errors go to stderr, stdout only carries the decoded records.
+class StderrLogPipe : public elog::ILogStream
+{
+  public:
+  void Log(const elog::LogSource, const elog::LogSeverity, const core::String& logStr) override
+  {
+    std::fprintf(stderr, "engine_logdecode: %s\n", logStr.c_str());
+  }
+};
+
+void PrintUsage()
+{
+  std::fprintf(stderr, "usage: engine_logdecode <binary_log> [--json]\n");
+}
+
+core::String EscapeJson(const core::String& str)
+{
+  core::String escaped;
+  escaped.reserve(str.size());
+
+  for (auto c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    }
+    else if ((unsigned char)c < 0x20) {
+      escaped += core::string::format("\\u{:04x}", (int)c);
+    }
+    else {
+      escaped += c;
+    }
+  }
+
+  return escaped;
+}
+
+/// UTC, with microseconds.
+core::String FormatTime(uint64_t time)
+{
+  std::time_t seconds = time / 1000000000;
+  char date[32];
+  std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", std::gmtime(&seconds));
+  return core::string::format("{}.{:06}", date, time % 1000000000 / 1000);
+}
+
+core::String ToJson(const elog::LogArgument& argument)
+{
+  switch (argument.Type) {
+  case elog::LogArgType::Int: return core::string::format("{}", argument.Int);
+  case elog::LogArgType::UInt: return core::string::format("{}", argument.UInt);
+  case elog::LogArgType::Bool: return argument.Int ? "true" : "false";
+  case elog::LogArgType::Float:
+  case elog::LogArgType::Double:
+    // json has no nan or infinity
+    if (!std::isfinite(argument.Real))
+      return core::string::format("\"{}\"", argument.Real);
+    return core::string::format("{}", argument.Real);
+  case elog::LogArgType::String: return "\"" + EscapeJson(argument.Text) + "\"";
+  case elog::LogArgType::Vec3:
+    return core::string::format("[{}, {}, {}]", argument.Vec3.x, argument.Vec3.y,
+                                argument.Vec3.z);
+  }
+  return "null";
+}
+
+core::String ToJson(const elog::BinaryLogRecord& record)
+{
+  core::String args;
+  for (auto& argument : record.Arguments) {
+    args += (args.empty() ? "" : ", ") + ToJson(argument);
+  }
+
+  return core::string::format(
+      "{{\"time_ns\": {}, \"thread\": {}, \"severity\": \"{}\", \"source\": \"{}\", "
+      "\"format\": \"{}\", \"args\": [{}], \"message\": \"{}\"}}",
+      record.Time, record.Thread, elog::GetSeverityName(record.Severity),
+      elog::GetSourceName(record.Source), EscapeJson(record.Format), args,
+      EscapeJson(elog::BinaryLogReader::FormatMessage(record)));
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto logPipe = core::MakeShared<StderrLogPipe>();
+  elog::AddLogStream(logPipe);
+
+  bool json        = false;
+  const char* path = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--json")) {
+      json = true;
+    }
+    else if (argv[i][0] == '-' || path) {
+      PrintUsage();
+      return 1;
+    }
+    else {
+      path = argv[i];
+    }
+  }
+
+  if (!path) {
+    PrintUsage();
+    return 1;
+  }
+
+  auto reader = elog::BinaryLogReader::Open(core::String(path));
+  if (!reader)
+    return 1;
+
+  // records are written as they are decoded, logs can be much larger than memory
+  elog::BinaryLogRecord record;
+  bool first = true;
+
+  if (json)
+    std::printf("[");
+
+  while (reader->Next(record)) {
+    if (json) {
+      std::printf("%s\n  %s", first ? "" : ",", ToJson(record).c_str());
+    }
+    else {
+      std::printf("%s [%u] %s %s: %s\n", FormatTime(record.Time).c_str(), record.Thread,
+                  elog::GetSeverityName(record.Severity), elog::GetSourceName(record.Source),
+                  elog::BinaryLogReader::FormatMessage(record).c_str());
+    }
+    first = false;
+  }
+
+  if (json)
+    std::printf("\n]\n");
+
+  return reader->HasError() ? 1 : 0;
+}